@@ -10,7 +10,9 @@
 #include "include/core/SkFontMgr.h"
 #include "include/core/SkPicture.h"
 #include "include/core/SkPictureRecorder.h"
+#include "include/core/SkStream.h"
 #include "modules/skottie/include/Skottie.h"
+#include "src/utils/SkJSON.h"
 #include "tools/DecodeUtils.h"
 #include "tools/Resources.h"
 #include "tools/fonts/FontToolUtils.h"
@@ -78,6 +80,35 @@ private:
     using INHERITED = DecodeBench;
 };
 
+// Like SkottieDecodeBench, but builds the animation from a binary DOM image of the source.
+class SkottieBinaryDecodeBench final : public DecodeBench {
+public:
+    SkottieBinaryDecodeBench(const char* name, const char* source)
+        : INHERITED(name, source)
+    {}
+
+    void onDelayedSetup() override {
+        this->INHERITED::onDelayedSetup();
+
+        const skjson::DOM dom(reinterpret_cast<const char*>(fData->data()), fData->size());
+        SkDynamicMemoryWStream stream;
+        SkAssertResult(dom.writeBinary(&stream));
+        fData = stream.detachAsData();
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        while (loops-- > 0) {
+            const auto anim = skottie::Animation::Builder()
+                .setFontManager(ToolUtils::TestFontMgr())
+                .make(reinterpret_cast<const char*>(fData->data()),
+                                                    fData->size());
+        }
+    }
+
+private:
+    using INHERITED = DecodeBench;
+};
+
 class SkottiePictureDecodeBench final : public DecodeBench {
 public:
     SkottiePictureDecodeBench(const char* name, const char* source)
@@ -108,6 +139,13 @@ DEF_BENCH(return new SkottieDecodeBench("skottie_medium", //  10947
                                         "skottie/skottie-sphere-effect.json"));
 DEF_BENCH(return new SkottieDecodeBench("skottie_small",  //   1112
                                         "skottie/skottie_sample_multiframe.json"));
+
+DEF_BENCH(return new SkottieBinaryDecodeBench("skottiebin_large",
+                                              "skottie/skottie-text-scale-to-fit-minmax.json"));
+DEF_BENCH(return new SkottieBinaryDecodeBench("skottiebin_medium",
+                                              "skottie/skottie-sphere-effect.json"));
+DEF_BENCH(return new SkottieBinaryDecodeBench("skottiebin_small",
+                                              "skottie/skottie_sample_multiframe.json"));
 // Created from PhoneHub assets SVG source, with https://lottiefiles.com/svg-to-lottie
 DEF_BENCH(return new SkottieDecodeBench("skottie_phonehub_connecting.json",    // 216x216
                                         "skottie/skottie-phonehub-connecting.json"));
@@ -8,13 +8,20 @@
 #include "bench/Benchmark.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkFont.h"
+#include "include/core/SkFontMgr.h"
+#include "include/core/SkFontStyle.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkPath.h"
 #include "include/core/SkString.h"
+#include "include/core/SkTypeface.h"
 #include "include/private/base/SkTemplates.h"
 #include "src/core/SkChecksum.h"
 #include "tools/fonts/FontToolUtils.h"
 
+#if defined(SK_FONTMGR_FONTCONFIG_AVAILABLE)
+#include "include/ports/SkFontMgr_fontconfig.h"
+#endif
+
 #include "bench/gUniqueGlyphIDs.h"
 
 #define gUniqueGlyphIDs_Sentinel    0xFFFF
@@ -198,3 +205,50 @@ private:
 };
 DEF_BENCH( return new FontPathBench(true); )
 DEF_BENCH( return new FontPathBench(false); )
+
+///////////////////////////////////////////////////////////////////////////////
+
+#if defined(SK_FONTMGR_FONTCONFIG_AVAILABLE)
+
+// Asks the system fontconfig font manager for the fallback of each character of some mixed-script
+// text, the way a text shaper does for characters its font is missing.
+class FontFallbackBench : public Benchmark {
+    sk_sp<SkFontMgr> fFontMgr;
+
+public:
+    FontFallbackBench() {}
+
+protected:
+    const char* onGetName() override {
+        return "font-fallback";
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+
+    void onDelayedSetup() override {
+        fFontMgr = SkFontMgr_New_FontConfig(nullptr);
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        static constexpr SkUnichar kCharacters[] = {
+            0x0041, 0x00E9, 0x0416, 0x03A9, 0x05D0, 0x0627, 0x0915, 0x0E01,  // Latin .. Thai
+            0x3042, 0x30A2, 0x4E2D, 0x6587, 0xAC00, 0x1F600, 0x2603, 0x20AC,  // CJK, emoji, symbols
+            0x10FFFD,                                                         // in no font
+        };
+        const char* bcp47[] = { "en-US" };
+        for (int loop = 0; loop < loops; ++loop) {
+            for (SkUnichar character : kCharacters) {
+                sk_sp<SkTypeface> face = fFontMgr->matchFamilyStyleCharacter(
+                        "sans-serif", SkFontStyle(), bcp47, std::size(bcp47), character);
+            }
+        }
+    }
+
+private:
+    using INHERITED = Benchmark;
+};
+DEF_BENCH( return new FontFallbackBench(); )
+
+#endif  // SK_FONTMGR_FONTCONFIG_AVAILABLE
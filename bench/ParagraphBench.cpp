@@ -8,6 +8,7 @@
 #include "bench/Benchmark.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkFontMgr.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkString.h"
@@ -18,7 +19,9 @@
 
 #include "modules/skparagraph/include/FontCollection.h"
 #include "modules/skparagraph/include/ParagraphBuilder.h"
+#include "modules/skparagraph/include/ParagraphCache.h"
 #include "modules/skparagraph/include/ParagraphStyle.h"
+#include "src/core/SkTaskGroup.h"
 
 class ParagraphBench final : public Benchmark {
     SkString fName;
@@ -97,4 +100,327 @@ private:
 
 DEF_BENCH( return new ParagraphBench; )
 
+// Lays out a chat log worth of distinct short messages on several threads sharing one
+// FontCollection (and therefore one ParagraphCache). Every message is laid out twice with
+// different colors, so half of the layouts should reuse the shaping results.
+class ParagraphCacheBench final : public Benchmark {
+    static constexpr int kMessages = 2000;
+
+    SkString fName;
+    int fThreads;
+    int fShards;
+    sk_sp<skia::textlayout::FontCollection> fFontCollection;
+    std::vector<SkString> fMessages;
+
+public:
+    ParagraphCacheBench(int threads, int shards) : fThreads(threads), fShards(shards) {
+        fName.printf("skparagraph_cache_%dthreads_%dshards", threads, shards);
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+
+    void onDelayedSetup() override {
+        fFontCollection = sk_make_sp<skia::textlayout::FontCollection>();
+        fFontCollection->setDefaultFontManager(ToolUtils::TestFontMgr());
+        skia::textlayout::ParagraphCache::Options options;
+        options.fMaxEntries = kMessages;
+        options.fShardCount = fShards;
+        fFontCollection->getParagraphCache()->setOptions(options);
+
+        for (int i = 0; i < kMessages; ++i) {
+            fMessages.push_back(SkStringPrintf("Message %d: Lorem ipsum dolor sit amet, "
+                                               "consectetur adipiscing elit %d", i, i * 7));
+        }
+        // FontCollection resolves the typefaces lazily; do it once before going wide
+        this->layout(0, SK_ColorBLACK);
+    }
+
+    void onPreDraw(SkCanvas*) override {
+        fFontCollection->getParagraphCache()->reset();
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        for (int i = 0; i < loops; ++i) {
+            SkTaskGroup().batch(fThreads, [&](int thread) {
+                for (int m = thread; m < kMessages; m += fThreads) {
+                    this->layout(m, SK_ColorBLACK);
+                    this->layout(m, SK_ColorBLUE);
+                }
+            });
+        }
+    }
+
+    void onPostDraw(SkCanvas*) override {
+        auto stats = fFontCollection->getParagraphCache()->stats();
+        if (stats.fLookups > 0) {
+            SkDebugf("%s: paragraph cache hit rate %.1f%% (%d paragraphs, %zu bytes)\n",
+                     fName.c_str(), 100.0 * stats.fHits / stats.fLookups, stats.fCount,
+                     stats.fBytes);
+        }
+    }
+
+private:
+    void layout(int message, SkColor color) {
+        skia::textlayout::TextStyle style;
+        style.setFontFamilies({SkString("Roboto")});
+        style.setColor(color);
+        skia::textlayout::ParagraphStyle paragraphStyle;
+        auto builder = skia::textlayout::ParagraphBuilder::make(paragraphStyle, fFontCollection);
+        if (!builder) {
+            return;
+        }
+        builder->pushStyle(style);
+        builder->addText(fMessages[message].c_str());
+        builder->pop();
+        builder->Build()->layout(300);
+    }
+
+    using INHERITED = Benchmark;
+};
+
+// Measures a keystroke in a long paragraph: typing a character and laying the paragraph out
+// again, either with Paragraph::updateText or by building a new paragraph.
+class ParagraphEditBench final : public Benchmark {
+    SkString fName;
+    bool fIncremental;
+    sk_sp<skia::textlayout::FontCollection> fFontCollection;
+    skia::textlayout::TextStyle fTStyle;
+    SkString fText;
+    std::unique_ptr<skia::textlayout::Paragraph> fParagraph;
+
+public:
+    explicit ParagraphEditBench(bool incremental) : fIncremental(incremental) {
+        fName.printf("skparagraph_edit_10k_%s", incremental ? "incremental" : "rebuild");
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+
+    void onDelayedSetup() override {
+        fFontCollection = sk_make_sp<skia::textlayout::FontCollection>();
+        fFontCollection->setDefaultFontManager(ToolUtils::TestFontMgr());
+        // Every keystroke produces a new text; do not let the cache hide the shaping
+        fFontCollection->getParagraphCache()->turnOn(false);
+        fTStyle.setFontFamilies({SkString("Roboto")});
+        fTStyle.setColor(SK_ColorBLACK);
+
+        while (fText.size() < 10000) {
+            fText.append("Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do "
+                         "eiusmod tempor incididunt ut labore et dolore magna aliqua. ");
+        }
+        fParagraph = this->build();
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        if (!fParagraph) {
+            return;
+        }
+        for (int i = 0; i < loops; ++i) {
+            // Type in the middle of the paragraph
+            const size_t position = fText.size() / 2 + (i % 64);
+            fText.insert(position, "x");
+            if (fIncremental) {
+                fParagraph->updateText(position, position, SkString("x"));
+            } else {
+                fParagraph = this->build();
+            }
+            fParagraph->layout(300);
+        }
+    }
+
+private:
+    std::unique_ptr<skia::textlayout::Paragraph> build() {
+        skia::textlayout::ParagraphStyle paragraph_style;
+        auto builder =
+            skia::textlayout::ParagraphBuilder::make(paragraph_style, fFontCollection);
+        if (!builder) {
+            return nullptr;
+        }
+        builder->pushStyle(fTStyle);
+        builder->addText(fText.c_str(), fText.size());
+        builder->pop();
+        auto paragraph = builder->Build();
+        paragraph->layout(300);
+        return paragraph;
+    }
+
+    using INHERITED = Benchmark;
+};
+
+// Re-lays out a set of shaped paragraphs at alternating widths, as a sizing pass
+// would, with or without ParagraphBuilder::setMeasureOnly. The cold variant builds the
+// paragraphs and lays them out once instead, so shaping and the cluster tables, which
+// measure-only mode still produces, are part of the measurement.
+class ParagraphMeasureBench final : public Benchmark {
+    static constexpr int kParagraphs = 200;
+
+    SkString fName;
+    bool fMeasureOnly;
+    bool fCold;
+    sk_sp<skia::textlayout::FontCollection> fFontCollection;
+    skia::textlayout::TextStyle fTStyle;
+    std::vector<std::unique_ptr<skia::textlayout::Paragraph>> fParagraphs;
+
+public:
+    ParagraphMeasureBench(bool measureOnly, bool cold) : fMeasureOnly(measureOnly), fCold(cold) {
+        fName.printf("skparagraph_measure_%s%s",
+                     cold ? "cold_" : "", measureOnly ? "only" : "full");
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+
+    void onDelayedSetup() override {
+        fFontCollection = sk_make_sp<skia::textlayout::FontCollection>();
+        fFontCollection->setDefaultFontManager(ToolUtils::TestFontMgr());
+        if (fCold) {
+            // Every paragraph is shaped again
+            fFontCollection->getParagraphCache()->turnOn(false);
+        }
+        fTStyle.setFontFamilies({SkString("Roboto")});
+        fTStyle.setColor(SK_ColorBLACK);
+        fTStyle.setDecoration(skia::textlayout::TextDecoration::kUnderline);
+        if (!fCold) {
+            for (int p = 0; p < kParagraphs; ++p) {
+                auto paragraph = this->build(p);
+                if (!paragraph) {
+                    return;
+                }
+                fParagraphs.push_back(std::move(paragraph));
+            }
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; ++i) {
+            if (fCold) {
+                for (int p = 0; p < kParagraphs; ++p) {
+                    if (auto paragraph = this->build(p)) {
+                        paragraph->layout(300);
+                    }
+                }
+                continue;
+            }
+            for (auto& paragraph : fParagraphs) {
+                paragraph->layout(i % 2 ? 150 : 300);
+            }
+        }
+    }
+
+private:
+    std::unique_ptr<skia::textlayout::Paragraph> build(int p) {
+        skia::textlayout::ParagraphStyle paragraph_style;
+        auto builder = skia::textlayout::ParagraphBuilder::make(paragraph_style, fFontCollection);
+        if (!builder) {
+            return nullptr;
+        }
+        builder->setMeasureOnly(fMeasureOnly);
+        builder->pushStyle(fTStyle);
+        builder->addText(SkStringPrintf("Item %d. Lorem ipsum dolor sit amet, consectetur "
+                                        "adipiscing elit, sed do eiusmod tempor incididunt ut "
+                                        "labore et dolore magna aliqua.", p).c_str());
+        return builder->Build();
+    }
+
+    using INHERITED = Benchmark;
+};
+
+// Lays out a page of a table: lots of small independent paragraphs, with
+// ParagraphBuilder::BuildAndLayout on a thread pool of the given size.
+class ParagraphBatchBench final : public Benchmark {
+    static constexpr int kParagraphs = 5000;
+
+    SkString fName;
+    int fThreads;
+    std::unique_ptr<SkExecutor> fExecutor;
+    sk_sp<skia::textlayout::FontCollection> fFontCollection;
+    skia::textlayout::TextStyle fTStyle;
+
+public:
+    explicit ParagraphBatchBench(int threads) : fThreads(threads) {
+        fName.printf("skparagraph_batch_%dthreads", threads);
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+
+    void onDelayedSetup() override {
+        fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+        fFontCollection = sk_make_sp<skia::textlayout::FontCollection>();
+        fFontCollection->setDefaultFontManager(ToolUtils::TestFontMgr());
+        skia::textlayout::ParagraphCache::Options options;
+        options.fShardCount = fThreads;
+        fFontCollection->getParagraphCache()->setOptions(options);
+        fTStyle.setFontFamilies({SkString("Roboto")});
+        fTStyle.setColor(SK_ColorBLACK);
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; ++i) {
+            // Every cell is different so the paragraph cache does not help
+            fFontCollection->getParagraphCache()->reset();
+            std::vector<std::unique_ptr<skia::textlayout::ParagraphBuilder>> builders;
+            std::vector<skia::textlayout::ParagraphBuilder*> inputs;
+            for (int p = 0; p < kParagraphs; ++p) {
+                skia::textlayout::ParagraphStyle paragraph_style;
+                auto builder = skia::textlayout::ParagraphBuilder::make(paragraph_style,
+                                                                        fFontCollection);
+                if (!builder) {
+                    return;
+                }
+                builder->pushStyle(fTStyle);
+                builder->addText(SkStringPrintf("Row %d, cell %d: %d units", p / 8, p % 8,
+                                                p * 37 % 1000).c_str());
+                inputs.push_back(builder.get());
+                builders.push_back(std::move(builder));
+            }
+            skia::textlayout::ParagraphBuilder::BuildAndLayout(inputs, 120, fExecutor.get());
+        }
+    }
+
+    using INHERITED = Benchmark;
+};
+
+DEF_BENCH( return new ParagraphMeasureBench(true, false); )
+DEF_BENCH( return new ParagraphMeasureBench(false, false); )
+DEF_BENCH( return new ParagraphMeasureBench(true, true); )
+DEF_BENCH( return new ParagraphMeasureBench(false, true); )
+
+DEF_BENCH( return new ParagraphBatchBench(1); )
+DEF_BENCH( return new ParagraphBatchBench(2); )
+DEF_BENCH( return new ParagraphBatchBench(4); )
+DEF_BENCH( return new ParagraphBatchBench(8); )
+
+DEF_BENCH( return new ParagraphEditBench(true); )
+DEF_BENCH( return new ParagraphEditBench(false); )
+
+DEF_BENCH( return new ParagraphCacheBench(1, 1); )
+DEF_BENCH( return new ParagraphCacheBench(4, 1); )
+DEF_BENCH( return new ParagraphCacheBench(4, 8); )
+
 #endif // SK_ENABLE_PARAGRAPH
@@ -9,21 +9,45 @@
 #include "tools/Resources.h"
 #include "tools/fonts/FontToolUtils.h"
 
+#if defined(SK_SHAPER_HARFBUZZ_AVAILABLE)
+#include "modules/skshaper/include/SkShaper_harfbuzz.h"
+#endif
+
 #include <cfloat>
 
 namespace {
 struct ShaperBench : public Benchmark {
-    ShaperBench(const char* r, const char* n) : fResource(r), fName(n) {}
+    ShaperBench(const char* r, const char* n, bool wordCache = false)
+        : fResource(r), fName(n), fWordCache(wordCache) {}
     std::unique_ptr<SkShaper> fShaper;
     sk_sp<SkData> fData;
     const char* fResource;
     const char* fName;
+    bool fWordCache;
     const char* onGetName() override { return fName; }
     bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
     void onDelayedSetup() override {
         fShaper = SkShaper::Make();
         fData = GetResourceAsData(fResource);
     }
+#if defined(SK_SHAPER_HARFBUZZ_AVAILABLE)
+    void onPreDraw(SkCanvas*) override {
+        if (fWordCache) {
+            SkShapers::HB::SetWordCacheLimit(4096);
+            SkShapers::HB::ResetWordCacheStats();
+        }
+    }
+    void onPostDraw(SkCanvas*) override {
+        if (fWordCache) {
+            SkShapers::HB::WordCacheStats stats = SkShapers::HB::GetWordCacheStats();
+            if (uint64_t lookups = stats.fHits + stats.fMisses) {
+                SkDebugf("%s: word cache hit rate %.1f%% (%d words cached)\n",
+                         fName, 100.0 * stats.fHits / lookups, stats.fCount);
+            }
+            SkShapers::HB::SetWordCacheLimit(0);
+        }
+    }
+#endif
     void onDraw(int loops, SkCanvas*) override {
         if (!fData || !fShaper) { return; }
         SkFont font = ToolUtils::DefaultFont();
@@ -75,4 +99,19 @@ SHAPER_BENCH(tifnagh)
 SHAPER_BENCH(vai)
 #undef SHAPER_BENCH
 
+#if defined(SK_SHAPER_HARFBUZZ_AVAILABLE)
+// The same corpora, shaped with the HarfBuzz word cache enabled. After the first loop, every
+// repeated word is served from the cache.
+#define SHAPER_WORD_CACHE_BENCH(X) \
+    DEF_BENCH(return new ShaperBench("text/" #X ".txt", "shaper_word_cache_" #X, true);)
+SHAPER_WORD_CACHE_BENCH(arabic)
+SHAPER_WORD_CACHE_BENCH(cyrillic)
+SHAPER_WORD_CACHE_BENCH(devanagari)
+SHAPER_WORD_CACHE_BENCH(english)
+SHAPER_WORD_CACHE_BENCH(greek)
+SHAPER_WORD_CACHE_BENCH(hebrew)
+SHAPER_WORD_CACHE_BENCH(thai)
+#undef SHAPER_WORD_CACHE_BENCH
+#endif
+
 #endif  // !defined(SK_BUILD_FOR_ANDROID_FRAMEWORK) && !defined(SK_BUILD_FOR_GOOGLE3)
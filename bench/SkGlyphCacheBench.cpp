@@ -10,18 +10,24 @@
 #include "bench/Benchmark.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColorSpace.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkFontMgr.h"
 #include "include/core/SkGraphics.h"
 #include "include/core/SkTypeface.h"
 #include "include/private/chromium/SkChromeRemoteGlyphCache.h"
 #include "src/base/SkTLazy.h"
+#include "src/core/SkGlyphImageAllocator.h"
 #include "src/core/SkStrikeSpec.h"
 #include "src/core/SkTaskGroup.h"
+#include "src/utils/SkOSPath.h"
+#include "tools/ProcStats.h"
 #include "tools/Resources.h"
 #include "tools/ToolUtils.h"
 #include "tools/fonts/FontToolUtils.h"
 #include "tools/text/SkTextBlobTrace.h"
 
+#include <cstdlib>
+
 using namespace skia_private;
 
 static void do_font_stuff(SkFont* font) {
@@ -117,10 +123,249 @@ private:
     SkString fName;
 };
 
+// Keeps creating new strikes under a small cache budget, so strikes are purged all the time, and
+// reports how much memory the glyph images hold on to.
+class SkGlyphCacheChurn : public Benchmark {
+public:
+    explicit SkGlyphCacheChurn(size_t cacheSize) : fCacheSize(cacheSize) { }
+
+protected:
+    const char* onGetName() override {
+        fName.printf("SkGlyphCacheChurn%dK", (int)(fCacheSize >> 10));
+        return fName.c_str();
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        size_t oldCacheLimitSize = SkGraphics::GetFontCacheLimit();
+        SkGraphics::SetFontCacheLimit(fCacheSize);
+        SkFont font = ToolUtils::DefaultFont();
+        font.setEdging(SkFont::Edging::kAntiAlias);
+        font.setTypeface(ToolUtils::CreatePortableTypeface("serif", SkFontStyle::Normal()));
+        SkPaint defaultPaint;
+
+        SkPackedGlyphID glyphs['z' - ' '];
+        for (int c = ' '; c < 'z'; c++) {
+            glyphs[c - ' '] = SkPackedGlyphID{font.unicharToGlyph(c)};
+        }
+        for (int work = 0; work < loops; work++) {
+            // A quarter point step gives a new strike every time for a long while.
+            font.setSize(8 + (fStep++ % 1024) * 0.25f);
+            auto strikeSpec = SkStrikeSpec::MakeMask(
+                    font, defaultPaint, SkSurfaceProps(0, kUnknown_SkPixelGeometry),
+                    SkScalerContextFlags::kNone, SkMatrix::I());
+            SkBulkGlyphMetricsAndImages images{strikeSpec};
+            (void)images.glyphs(SkSpan<const SkPackedGlyphID>{glyphs, std::size(glyphs)});
+        }
+        SkGraphics::SetFontCacheLimit(oldCacheLimitSize);
+    }
+
+    void onPostDraw(SkCanvas*) override {
+        SkGlyphImageAllocator* allocator = SkGlyphImageAllocator::Global();
+        SkDebugf("%s: glyph images %zuK in use, %zuK reserved, RSS %dMB\n",
+                 fName.c_str(), allocator->bytesInUse() >> 10, allocator->bytesReserved() >> 10,
+                 sk_tools::getCurrResidentSetSizeMB());
+    }
+
+private:
+    using INHERITED = Benchmark;
+    const size_t fCacheSize;
+    SkString fName;
+    int fStep = 0;
+};
+
+// Fills a set of strikes from an empty strike cache, as the first frames of a new process would.
+// With fromDisk, the glyphs were saved with SkGraphics::SaveFontCacheToDisk() beforehand, so they
+// are loaded from the disk cache instead of being rasterized.
+class SkGlyphCacheColdStart : public Benchmark {
+public:
+    explicit SkGlyphCacheColdStart(bool fromDisk) : fFromDisk(fromDisk) {
+        fName.printf("SkGlyphCacheColdStart_%s", fromDisk ? "disk" : "rasterize");
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+
+    void onDelayedSetup() override {
+        fFont = ToolUtils::DefaultFont();
+        fFont.setEdging(SkFont::Edging::kAntiAlias);
+        fFont.setTypeface(ToolUtils::CreatePortableTypeface("serif", SkFontStyle::Normal()));
+        for (int c = ' '; c < 'z'; c++) {
+            fGlyphs[c - ' '] = SkPackedGlyphID{fFont.unicharToGlyph(c)};
+        }
+
+#if defined(SK_BUILD_FOR_WIN)
+        const char* tmpDir = getenv("TEMP");
+#else
+        const char* tmpDir = getenv("TMPDIR");
+        if (tmpDir == nullptr) {
+            tmpDir = "/tmp";
+        }
+#endif
+        if (tmpDir != nullptr) {
+            fDirectory = SkOSPath::Join(tmpDir, "SkGlyphCacheColdStart");
+        }
+    }
+
+    void onPreDraw(SkCanvas*) override {
+        SkGraphics::SetFontCacheDiskDirectory(nullptr);
+        if (fFromDisk && !fDirectory.isEmpty()) {
+            SkGraphics::SetFontCacheDiskDirectory(fDirectory.c_str());
+            SkGraphics::PurgeFontCache();
+            this->fillStrikes();
+            SkGraphics::SaveFontCacheToDisk();
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int work = 0; work < loops; work++) {
+            SkGraphics::PurgeFontCache();
+            this->fillStrikes();
+        }
+    }
+
+    void onPostDraw(SkCanvas*) override {
+        SkGraphics::SetFontCacheDiskDirectory(nullptr);
+    }
+
+private:
+    void fillStrikes() {
+        SkPaint defaultPaint;
+        SkFont font = fFont;
+        for (SkScalar size = 12; size <= 44; size += 2) {
+            font.setSize(size);
+            auto strikeSpec = SkStrikeSpec::MakeMask(
+                    font, defaultPaint, SkSurfaceProps(0, kUnknown_SkPixelGeometry),
+                    SkScalerContextFlags::kNone, SkMatrix::I());
+            SkBulkGlyphMetricsAndImages images{strikeSpec};
+            (void)images.glyphs(SkSpan<const SkPackedGlyphID>{fGlyphs, std::size(fGlyphs)});
+        }
+    }
+
+    using INHERITED = Benchmark;
+    const bool fFromDisk;
+    SkFont fFont;
+    SkPackedGlyphID fGlyphs['z' - ' '];
+    SkString fDirectory;
+    SkString fName;
+};
+
+// Allocates and releases glyph image sized blocks from several threads at once, to show how much
+// the threads contend for the allocator's locks.
+class SkGlyphImageAllocatorBench : public Benchmark {
+public:
+    explicit SkGlyphImageAllocatorBench(int threads) : fThreads(threads) {
+        fName.printf("SkGlyphImageAllocator_%dthreads", threads);
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+
+    void onDelayedSetup() override {
+        fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        // A8 masks of 10 to 48 pixel glyphs, and an LCD mask of a 24 pixel glyph.
+        static constexpr size_t kSizes[] = {120, 224, 360, 528, 736, 960, 1408, 2304, 1728};
+        static constexpr int kBlocks = 256;
+
+        SkGlyphImageAllocator allocator;
+        for (int work = 0; work < loops; work++) {
+            SkTaskGroup(*fExecutor).batch(fThreads, [&](int threadIndex) {
+                void* blocks[kBlocks];
+                for (int i = 0; i < kBlocks; ++i) {
+                    const size_t size = kSizes[(threadIndex + i) % std::size(kSizes)];
+                    blocks[i] = allocator.makeBytesAlignedTo(size, 4);
+                }
+                for (int i = 0; i < kBlocks; ++i) {
+                    const size_t size = kSizes[(threadIndex + i) % std::size(kSizes)];
+                    allocator.release(blocks[i], size);
+                }
+            });
+        }
+    }
+
+private:
+    using INHERITED = Benchmark;
+    const int fThreads;
+    std::unique_ptr<SkExecutor> fExecutor;
+    SkString fName;
+};
+
+// Rasterizes the same glyphs from a cold cache every time, so the time is spent generating and
+// post-processing the glyph masks rather than looking them up.
+class SkGlyphRasterizeBench : public Benchmark {
+public:
+    SkGlyphRasterizeBench(const char* name, SkFont::Edging edging, SkPixelGeometry geometry)
+            : fEdging(edging), fGeometry(geometry) {
+        fName.printf("SkGlyphRasterize_%s", name);
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkFont font = ToolUtils::DefaultFont();
+        font.setEdging(fEdging);
+        font.setSize(24);
+        font.setTypeface(ToolUtils::CreatePortableTypeface("serif", SkFontStyle::Normal()));
+        SkPaint defaultPaint;
+
+        SkPackedGlyphID glyphs['z' - ' '];
+        for (int c = ' '; c < 'z'; c++) {
+            glyphs[c - ' '] = SkPackedGlyphID{font.unicharToGlyph(c)};
+        }
+        auto strikeSpec = SkStrikeSpec::MakeMask(
+                font, defaultPaint, SkSurfaceProps(0, fGeometry),
+                SkScalerContextFlags::kNone, SkMatrix::I());
+        for (int work = 0; work < loops; work++) {
+            SkGraphics::PurgeFontCache();
+            SkBulkGlyphMetricsAndImages images{strikeSpec};
+            (void)images.glyphs(SkSpan<const SkPackedGlyphID>{glyphs, std::size(glyphs)});
+        }
+    }
+
+private:
+    using INHERITED = Benchmark;
+    const SkFont::Edging fEdging;
+    const SkPixelGeometry fGeometry;
+    SkString fName;
+};
+
+DEF_BENCH( return new SkGlyphRasterizeBench("bw", SkFont::Edging::kAlias,
+                                            kUnknown_SkPixelGeometry); )
+DEF_BENCH( return new SkGlyphRasterizeBench("a8", SkFont::Edging::kAntiAlias,
+                                            kUnknown_SkPixelGeometry); )
+DEF_BENCH( return new SkGlyphRasterizeBench("lcd", SkFont::Edging::kSubpixelAntiAlias,
+                                            kRGB_H_SkPixelGeometry); )
+
 DEF_BENCH( return new SkGlyphCacheBasic(256 * 1024); )
 DEF_BENCH( return new SkGlyphCacheBasic(32 * 1024 * 1024); )
 DEF_BENCH( return new SkGlyphCacheStressTest(256 * 1024); )
 DEF_BENCH( return new SkGlyphCacheStressTest(32 * 1024 * 1024); )
+DEF_BENCH( return new SkGlyphCacheChurn(256 * 1024); )
+DEF_BENCH( return new SkGlyphCacheChurn(2 * 1024 * 1024); )
+DEF_BENCH( return new SkGlyphCacheColdStart(false); )
+DEF_BENCH( return new SkGlyphCacheColdStart(true); )
+DEF_BENCH( return new SkGlyphImageAllocatorBench(1); )
+DEF_BENCH( return new SkGlyphImageAllocatorBench(4); )
+DEF_BENCH( return new SkGlyphImageAllocatorBench(8); )
 
 namespace {
 class DiscardableManager : public SkStrikeServer::DiscardableHandleManager,
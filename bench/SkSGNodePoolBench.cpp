@@ -0,0 +1,86 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkMatrix.h"
+#include "include/core/SkRect.h"
+#include "modules/sksg/include/SkSGDraw.h"
+#include "modules/sksg/include/SkSGGroup.h"
+#include "modules/sksg/include/SkSGInvalidationController.h"
+#include "modules/sksg/include/SkSGNodePool.h"
+#include "modules/sksg/include/SkSGPaint.h"
+#include "modules/sksg/include/SkSGRect.h"
+#include "modules/sksg/include/SkSGTransform.h"
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+// Revalidates a large scene (~16k nodes) after invalidating all of its transforms, as an
+// animation would on every frame, with nodes allocated from a pool or individually on the heap.
+class SkSGNodePoolBench final : public Benchmark {
+public:
+    explicit SkSGNodePoolBench(bool pooled)
+        : fName(SkStringPrintf("sksg_revalidate_%s", pooled ? "pooled" : "heap"))
+        , fPooled(pooled) {}
+
+private:
+    static constexpr int kGroupCount = 64,
+                         kGroupSize  = 64;
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        // Interleave with unrelated heap allocations, as a long-running client would.
+        std::vector<std::unique_ptr<char[]>> noise;
+
+        std::optional<sksg::NodePool::Scope> scope;
+        if (fPooled) {
+            scope.emplace(sksg::NodePool::Make());
+        }
+
+        fRoot = sksg::Group::Make();
+        for (int i = 0; i < kGroupCount; ++i) {
+            auto group = sksg::Group::Make();
+            for (int j = 0; j < kGroupSize; ++j) {
+                auto matrix = sksg::Matrix<SkMatrix>::Make(SkMatrix::Translate(i, j));
+                auto draw   = sksg::Draw::Make(sksg::Rect::Make(SkRect::MakeWH(10, 10)),
+                                               sksg::Color::Make(SK_ColorBLACK));
+                group->addChild(sksg::TransformEffect::Make(std::move(draw), matrix));
+                fMatrices.push_back(std::move(matrix));
+
+                noise.push_back(std::make_unique<char[]>(64 + (i * j) % 256));
+            }
+            fRoot->addChild(std::move(group));
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; ++i) {
+            for (const auto& matrix : fMatrices) {
+                matrix->setMatrix(SkMatrix::Translate(i, 0));
+            }
+
+            sksg::InvalidationController ic;
+            fRoot->revalidate(&ic, SkMatrix::I());
+        }
+    }
+
+    const SkString                              fName;
+    const bool                                  fPooled;
+
+    sk_sp<sksg::Group>                          fRoot;
+    std::vector<sk_sp<sksg::Matrix<SkMatrix>>> fMatrices;
+};
+
+DEF_BENCH(return new SkSGNodePoolBench(false);)
+DEF_BENCH(return new SkSGNodePoolBench(true );)
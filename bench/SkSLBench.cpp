@@ -8,8 +8,14 @@
 #include "bench/ResultsWriter.h"
 #include "bench/SkSLBench.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkSurface.h"
+#include "include/effects/SkRuntimeEffect.h"
 #include "src/base/SkArenaAlloc.h"
 #include "src/core/SkRasterPipeline.h"
+#include "src/core/SkRuntimeEffectPriv.h"
 #include "src/gpu/ganesh/GrCaps.h"
 #include "src/gpu/ganesh/GrRecordingContextPriv.h"
 #include "src/gpu/ganesh/mock/GrMockCaps.h"
@@ -729,8 +735,11 @@ void RunSkSLModuleBenchmarks(NanoJSONResultsWriter* log) {
 
 class SkSLModuleLoaderBench : public Benchmark {
 public:
-    SkSLModuleLoaderBench(const char* name, std::vector<SkSL::ProgramKind> moduleList)
-            : fName(name), fModuleList(std::move(moduleList)) {}
+    // When `threads` is nonzero, the modules are loaded via ModuleLoader::WarmUp on a thread pool
+    // of that size; otherwise they are loaded serially on the calling thread.
+    SkSLModuleLoaderBench(const char* name, std::vector<SkSL::ProgramKind> moduleList,
+                          int threads = 0)
+            : fName(name), fModuleList(std::move(moduleList)), fThreads(threads) {}
 
     const char* onGetName() override {
         return fName;
@@ -744,12 +753,22 @@ public:
         return false;
     }
 
+    void onDelayedSetup() override {
+        if (fThreads > 0) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+        }
+    }
+
     void onPreDraw(SkCanvas*) override {
         SkSL::ModuleLoader::Get().unloadModules();
     }
 
     void onDraw(int loops, SkCanvas*) override {
         SkASSERT(loops == 1);
+        if (fExecutor) {
+            SkSL::ModuleLoader::WarmUp(fModuleList, *fExecutor);
+            return;
+        }
         SkSL::Compiler compiler;
         for (SkSL::ProgramKind kind : fModuleList) {
             compiler.moduleForProgramKind(kind);
@@ -758,6 +777,8 @@ public:
 
     const char* fName;
     std::vector<SkSL::ProgramKind> fModuleList;
+    int fThreads;
+    std::unique_ptr<SkExecutor> fExecutor;
 };
 
 DEF_BENCH(return new SkSLModuleLoaderBench("sksl_module_loader_ganesh",
@@ -787,3 +808,182 @@ DEF_BENCH(return new SkSLModuleLoaderBench("sksl_module_loader_graphite",
                                                    SkSL::ProgramKind::kGraphiteVertex,
                                                    SkSL::ProgramKind::kGraphiteFragment,
                                            });)
+
+static std::vector<SkSL::ProgramKind> ganesh_module_kinds() {
+    return {SkSL::ProgramKind::kVertex,
+            SkSL::ProgramKind::kFragment,
+            SkSL::ProgramKind::kPrivateRuntimeShader,
+            SkSL::ProgramKind::kRuntimeShader,
+            SkSL::ProgramKind::kCompute};
+}
+
+DEF_BENCH(return new SkSLModuleLoaderBench("sksl_module_loader_ganesh_1_thread",
+                                           ganesh_module_kinds(), /*threads=*/1);)
+DEF_BENCH(return new SkSLModuleLoaderBench("sksl_module_loader_ganesh_2_threads",
+                                           ganesh_module_kinds(), /*threads=*/2);)
+DEF_BENCH(return new SkSLModuleLoaderBench("sksl_module_loader_ganesh_4_threads",
+                                           ganesh_module_kinds(), /*threads=*/4);)
+DEF_BENCH(return new SkSLModuleLoaderBench("sksl_module_loader_ganesh_8_threads",
+                                           ganesh_module_kinds(), /*threads=*/8);)
+
+// Measures the per-pixel cost of running a loop- and math-heavy runtime shader on the raster
+// backend. The `no_rp_store_opts` variant only skips the RP dead-store elimination and copy fusion
+// passes, so comparing it against the default variant isolates their benefit. The unoptimized
+// variant also disables the SkSL optimizer and inliner, which gives a rough overall baseline.
+class SkSLRuntimeEffectDrawBench : public Benchmark {
+public:
+    enum class Optimization {
+        kAll,
+        kNoRPStoreOptimizations,
+        kNone,
+    };
+
+    SkSLRuntimeEffectDrawBench(Optimization optimization)
+            : fName(optimization == Optimization::kAll ? "sksl_rt_effect_draw" :
+                    optimization == Optimization::kNone ? "sksl_rt_effect_draw_unoptimized"
+                                                        : "sksl_rt_effect_draw_no_rp_store_opts")
+            , fOptimization(optimization) {}
+
+    const char* onGetName() override {
+        return fName;
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+
+    void onDelayedSetup() override {
+        static constexpr char kSource[] = R"(
+            uniform float4 colors[4];
+
+            half4 main(float2 p) {
+                float4 sum = float4(0);
+                float2 q = p * 0.01;
+                for (int i = 0; i < 8; ++i) {
+                    float2 r = float2(q.x * q.x - q.y * q.y, 2 * q.x * q.y) + float2(0.3, 0.5);
+                    q = r;
+                    sum += colors[i / 2] * saturate(dot(q, q));
+                }
+                return half4(sum / 8);
+            }
+        )";
+        SkRuntimeEffect::Options options;
+        options.forceUnoptimized = fOptimization == Optimization::kNone;
+        if (fOptimization == Optimization::kNoRPStoreOptimizations) {
+            SkRuntimeEffectPriv::DisableRPStoreOptimizations(&options);
+        }
+        auto [effect, err] = SkRuntimeEffect::MakeForShader(SkString(kSource), options);
+        if (!effect) {
+            SK_ABORT("runtime effect compilation failed: %s\n", err.c_str());
+        }
+        fPaint.setShader(effect->makeShader(SkData::MakeZeroInitialized(effect->uniformSize()),
+                                            /*children=*/{}));
+        fSurface = SkSurfaces::Raster(SkImageInfo::MakeN32Premul(kSize, kSize));
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; i++) {
+            fSurface->getCanvas()->drawPaint(fPaint);
+        }
+    }
+
+private:
+    static constexpr int kSize = 256;
+
+    const char* fName;
+    Optimization fOptimization;
+    SkPaint fPaint;
+    sk_sp<SkSurface> fSurface;
+};
+
+DEF_BENCH(return new SkSLRuntimeEffectDrawBench(SkSLRuntimeEffectDrawBench::Optimization::kAll);)
+DEF_BENCH(return new SkSLRuntimeEffectDrawBench(
+        SkSLRuntimeEffectDrawBench::Optimization::kNoRPStoreOptimizations);)
+DEF_BENCH(return new SkSLRuntimeEffectDrawBench(SkSLRuntimeEffectDrawBench::Optimization::kNone);)
+
+// Measures the cost of creating a runtime effect and drawing with it for the first time on the
+// raster backend, which is what a process pays for each effect at startup. The `cached` variant
+// supplies a persistent cache which was populated by an earlier run, so the RP program is
+// deserialized rather than inlined and regenerated.
+class SkSLRuntimeEffectStartupBench : public Benchmark {
+public:
+    SkSLRuntimeEffectStartupBench(bool cached)
+            : fName(cached ? "sksl_rt_effect_startup_cached" : "sksl_rt_effect_startup")
+            , fCached(cached) {}
+
+    const char* onGetName() override {
+        return fName;
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+
+    void onDelayedSetup() override {
+        fSurface = SkSurfaces::Raster(SkImageInfo::MakeN32Premul(1, 1));
+        if (fCached) {
+            fOptions.persistentCache = &fCache;
+            this->createAndDraw();
+            SkASSERT(fCache.fData);
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; i++) {
+            this->createAndDraw();
+        }
+    }
+
+private:
+    // A single-entry cache is sufficient here, since every iteration compiles the same effect.
+    class SingleEntryCache : public SkRuntimeEffect::PersistentCache {
+    public:
+        sk_sp<SkData> load(const SkData& key) override {
+            return (fKey && fKey->equals(&key)) ? fData : nullptr;
+        }
+        void store(const SkData& key, const SkData& data) override {
+            fKey = SkData::MakeWithCopy(key.data(), key.size());
+            fData = SkData::MakeWithCopy(data.data(), data.size());
+        }
+
+        sk_sp<SkData> fKey;
+        sk_sp<SkData> fData;
+    };
+
+    void createAndDraw() {
+        static constexpr char kSource[] = R"(
+            uniform float4 colors[4];
+            uniform float scale;
+
+            half4 blend(half4 a, half4 b, half t) {
+                return mix(a, b, smoothstep(0, 1, t));
+            }
+
+            half4 main(float2 p) {
+                half4 c = half4(0);
+                for (int i = 0; i < 4; ++i) {
+                    float d = length(p * scale - float2(i, 3 - i));
+                    c = blend(c, half4(colors[i]), half(fract(d)));
+                }
+                return c;
+            }
+        )";
+        auto [effect, err] = SkRuntimeEffect::MakeForShader(SkString(kSource), fOptions);
+        if (!effect) {
+            SK_ABORT("runtime effect compilation failed: %s\n", err.c_str());
+        }
+        SkPaint paint;
+        paint.setShader(effect->makeShader(SkData::MakeZeroInitialized(effect->uniformSize()),
+                                           /*children=*/{}));
+        fSurface->getCanvas()->drawPaint(paint);
+    }
+
+    const char* fName;
+    bool fCached;
+    SingleEntryCache fCache;
+    SkRuntimeEffect::Options fOptions;
+    sk_sp<SkSurface> fSurface;
+};
+
+DEF_BENCH(return new SkSLRuntimeEffectStartupBench(/*cached=*/false);)
+DEF_BENCH(return new SkSLRuntimeEffectStartupBench(/*cached=*/true);)
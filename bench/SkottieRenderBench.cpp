@@ -0,0 +1,198 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkSurface.h"
+#include "modules/skottie/include/Skottie.h"
+#include "modules/skottie/utils/SkottieUtils.h"
+#include "tools/Resources.h"
+#include "tools/fonts/FontToolUtils.h"
+
+#include <memory>
+#include <vector>
+
+// Renders the frames of an animation into raster surfaces with a ParallelFrameRenderer, as an
+// offline exporter would.  Compare the frames/sec across thread counts.
+class SkottieParallelRenderBench final : public Benchmark {
+public:
+    SkottieParallelRenderBench(const char* source, int threads)
+        : fName(SkStringPrintf("skottie_parallel_render_%dthreads", threads))
+        , fSource(source)
+        , fThreads(threads) {}
+
+private:
+    inline static constexpr int kFrames = 30;
+    inline static constexpr int kSize   = 256;
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        auto data = GetResourceAsData(fSource);
+        SkASSERT(data);
+        auto instances = skottie::Animation::Builder()
+                .setFontManager(ToolUtils::TestFontMgr())
+                .makeInstances(static_cast<const char*>(data->data()), data->size(), fThreads);
+        SkASSERT(!instances.empty());
+        fDuration = instances[0]->duration() * instances[0]->fps();
+
+        if (fThreads > 1) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+        }
+        fRenderer = std::make_unique<skottie_utils::ParallelFrameRenderer>(std::move(instances),
+                                                                           fExecutor.get());
+        for (int i = 0; i < kFrames; ++i) {
+            fSurfaces.push_back(SkSurfaces::Raster(SkImageInfo::MakeN32Premul(kSize, kSize)));
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        while (loops-- > 0) {
+            fRenderer->renderFrames(0, fDuration / kFrames, kFrames,
+                                    [this](int i) { return fSurfaces[i]; },
+                                    [](int, sk_sp<SkSurface>) {});
+        }
+    }
+
+    const SkString                                        fName;
+    const char*                                           fSource;
+    const int                                             fThreads;
+    double                                                fDuration = 0;
+    std::unique_ptr<SkExecutor>                           fExecutor;
+    std::unique_ptr<skottie_utils::ParallelFrameRenderer> fRenderer;
+    std::vector<sk_sp<SkSurface>>                         fSurfaces;
+};
+
+DEF_BENCH(return new SkottieParallelRenderBench("skottie/skottie_sample_2.json", 1);)
+DEF_BENCH(return new SkottieParallelRenderBench("skottie/skottie_sample_2.json", 2);)
+DEF_BENCH(return new SkottieParallelRenderBench("skottie/skottie_sample_2.json", 4);)
+DEF_BENCH(return new SkottieParallelRenderBench("skottie/skottie_sample_2.json", 8);)
+
+// Plays back an animation into a raster surface, repainting either the whole frame or only the
+// damaged pixels (see skottie_utils::PartialFrameRenderer).
+class SkottiePartialRenderBench final : public Benchmark {
+public:
+    SkottiePartialRenderBench(const char* name, const char* source, bool partial)
+        : fName(SkStringPrintf("skottie_%s_render_%s", partial ? "partial" : "full", name))
+        , fSource(source)
+        , fPartial(partial) {}
+
+private:
+    inline static constexpr int kSize = 512;
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        auto data = GetResourceAsData(fSource);
+        SkASSERT(data);
+        auto animation = skottie::Animation::Builder()
+                .setFontManager(ToolUtils::TestFontMgr())
+                .make(static_cast<const char*>(data->data()), data->size());
+        SkASSERT(animation);
+        fFrames = animation->duration() * animation->fps();
+
+        fRenderer = std::make_unique<skottie_utils::PartialFrameRenderer>(
+                std::move(animation),
+                SkSurfaces::Raster(SkImageInfo::MakeN32Premul(kSize, kSize)),
+                SK_ColorWHITE);
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        while (loops-- > 0) {
+            for (double frame = 0; frame < fFrames; ++frame) {
+                if (!fPartial) {
+                    fRenderer->invalidate();
+                }
+                fRenderer->renderFrame(frame);
+            }
+        }
+    }
+
+    const SkString                                       fName;
+    const char*                                          fSource;
+    const bool                                           fPartial;
+    double                                               fFrames = 0;
+    std::unique_ptr<skottie_utils::PartialFrameRenderer> fRenderer;
+};
+
+DEF_BENCH(return new SkottiePartialRenderBench("phonehub_connecting",
+                                               "skottie/skottie-phonehub-connecting.json",
+                                               false);)
+DEF_BENCH(return new SkottiePartialRenderBench("phonehub_connecting",
+                                               "skottie/skottie-phonehub-connecting.json",
+                                               true);)
+
+// Plays back an animation into a raster surface, with or without caching the rendered content
+// of precomps and static layers (see skottie::Animation::Builder::kCacheStaticLayers).
+class SkottieLayerCacheBench final : public Benchmark {
+public:
+    SkottieLayerCacheBench(const char* name, const char* source, bool cached)
+        : fName(SkStringPrintf("skottie_%s_render_%s", cached ? "cached" : "uncached", name))
+        , fSource(source)
+        , fCached(cached) {}
+
+private:
+    inline static constexpr int kSize = 512;
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        auto data = GetResourceAsData(fSource);
+        SkASSERT(data);
+        fAnimation = skottie::Animation::Builder(
+                             fCached ? skottie::Animation::Builder::kCacheStaticLayers : 0)
+                .setFontManager(ToolUtils::TestFontMgr())
+                .make(static_cast<const char*>(data->data()), data->size());
+        SkASSERT(fAnimation);
+        fSurface = SkSurfaces::Raster(SkImageInfo::MakeN32Premul(kSize, kSize));
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        const auto frames = fAnimation->duration() * fAnimation->fps();
+        const auto dst = SkRect::MakeIWH(kSize, kSize);
+        while (loops-- > 0) {
+            for (double frame = 0; frame < frames; ++frame) {
+                fAnimation->seekFrame(frame);
+                fSurface->getCanvas()->clear(SK_ColorWHITE);
+                fAnimation->render(fSurface->getCanvas(), &dst);
+            }
+        }
+    }
+
+    const SkString            fName;
+    const char*               fSource;
+    const bool                fCached;
+    sk_sp<skottie::Animation> fAnimation;
+    sk_sp<SkSurface>          fSurface;
+};
+
+#define DEF_SKOTTIE_LAYER_CACHE_BENCH(name, source)                    \
+    DEF_BENCH(return new SkottieLayerCacheBench(name, source, false);) \
+    DEF_BENCH(return new SkottieLayerCacheBench(name, source, true);)
+
+DEF_SKOTTIE_LAYER_CACHE_BENCH("levels_effect", "skottie/skottie-levels-effect.json")
+DEF_SKOTTIE_LAYER_CACHE_BENCH("phonehub_connecting", "skottie/skottie-phonehub-connecting.json")
+DEF_SKOTTIE_LAYER_CACHE_BENCH("sample_2", "skottie/skottie_sample_2.json")
+
+#undef DEF_SKOTTIE_LAYER_CACHE_BENCH
@@ -0,0 +1,54 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkData.h"
+#include "modules/skottie/include/Skottie.h"
+#include "tools/Resources.h"
+#include "tools/fonts/FontToolUtils.h"
+
+// Seeks through the frames of an animation without rendering them, as a player would when
+// playing it back, so the cost is the evaluation of the animated properties.
+class SkottieSeekBench final : public Benchmark {
+public:
+    SkottieSeekBench(const char* name, const char* source)
+        : fName(SkStringPrintf("skottie_seek_%s", name))
+        , fSource(source) {}
+
+private:
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        auto data = GetResourceAsData(fSource);
+        SkASSERT(data);
+        fAnimation = skottie::Animation::Builder()
+                .setFontManager(ToolUtils::TestFontMgr())
+                .make(static_cast<const char*>(data->data()), data->size());
+        SkASSERT(fAnimation);
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        const double frames = fAnimation->duration() * fAnimation->fps();
+        while (loops-- > 0) {
+            for (double frame = 0; frame < frames; ++frame) {
+                fAnimation->seekFrame(frame);
+            }
+        }
+    }
+
+    const SkString            fName;
+    const char*               fSource;
+    sk_sp<skottie::Animation> fAnimation;
+};
+
+DEF_BENCH(return new SkottieSeekBench("large", "skottie/skottie-text-scale-to-fit-minmax.json");)
+DEF_BENCH(return new SkottieSeekBench("medium", "skottie/skottie-sphere-effect.json");)
+DEF_BENCH(return new SkottieSeekBench("phonehub_onboard", "skottie/skottie-phonehub-onboard.json");)
@@ -0,0 +1,102 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkString.h"
+#include "modules/skottie/include/Skottie.h"
+#include "tools/Resources.h"
+#include "tools/fonts/FontToolUtils.h"
+
+#include <memory>
+#include <utility>
+
+namespace {
+
+// A text heavy animation: text layers cycling through keyframed documents.
+SkString make_text_json(int layer_count, int keyframe_count) {
+    SkString json;
+    json.appendf(R"({"v":"5.2.1","w":500,"h":500,"fr":30,"ip":0,"op":%d,)"
+                 R"("fonts":{"list":[{"fFamily":"Serif","fName":"Serif","fStyle":"Regular"}]},)"
+                 R"("layers":[)", keyframe_count);
+    for (int i = 0; i < layer_count; ++i) {
+        json.appendf(R"(%s{"ty":5,"ip":0,"op":%d,"ks":{},"t":{"d":{"k":[)",
+                     i ? "," : "", keyframe_count);
+        for (int j = 0; j < keyframe_count; ++j) {
+            json.appendf(R"(%s{"t":%d,"s":{"f":"Serif","s":18,"lh":22,"fc":[0,0,0,1],)"
+                         R"("ps":[0,%d],"sz":[500,100],)"
+                         R"("t":"Layer %d, document %d: the quick brown fox jumps over )"
+                         R"(the lazy dog."}})",
+                         j ? "," : "", j, i * 10, i, j);
+        }
+        json.append("]}}}");
+    }
+    json.append("]}");
+
+    return json;
+}
+
+// Measures the animation load time, with text shaped on demand or ahead of time on a thread
+// pool.
+class SkottieTextShapingBench final : public Benchmark {
+public:
+    SkottieTextShapingBench(const char* name, sk_sp<SkData> data, bool parallel)
+        : fName(SkStringPrintf("skottie_text_shaping_%s_%s",
+                               parallel ? "parallel" : "serial", name))
+        , fData(std::move(data))
+        , fParallel(parallel) {}
+
+private:
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        SkASSERT(fData);
+        if (fParallel) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool();
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        while (loops-- > 0) {
+            auto animation = skottie::Animation::Builder()
+                    .setFontManager(ToolUtils::TestFontMgr())
+                    .setTextShapingExecutor(fExecutor.get())
+                    .make(static_cast<const char*>(fData->data()), fData->size());
+            SkASSERT(animation);
+
+            // Animated text is shaped on the first seek, unless shaped ahead of time.
+            animation->seekFrame(0);
+        }
+    }
+
+    const SkString              fName;
+    const sk_sp<SkData>         fData;
+    const bool                  fParallel;
+
+    std::unique_ptr<SkExecutor> fExecutor;
+};
+
+sk_sp<SkData> make_text_data(int layer_count, int keyframe_count) {
+    const auto json = make_text_json(layer_count, keyframe_count);
+    return SkData::MakeWithCopy(json.c_str(), json.size());
+}
+
+} // namespace
+
+DEF_BENCH(return new SkottieTextShapingBench("32x16",
+                                             make_text_data(32, 16), false);)
+DEF_BENCH(return new SkottieTextShapingBench("32x16",
+                                             make_text_data(32, 16), true );)
+DEF_BENCH(return new SkottieTextShapingBench("minmax",
+        GetResourceAsData("skottie/skottie-text-scale-to-fit-minmax.json"), false);)
+DEF_BENCH(return new SkottieTextShapingBench("minmax",
+        GetResourceAsData("skottie/skottie-text-scale-to-fit-minmax.json"), true );)
@@ -7,18 +7,24 @@
 
 #include "bench/Benchmark.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkFont.h"
+#include "include/core/SkGraphics.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkString.h"
 #include "include/core/SkTextBlob.h"
 #include "include/core/SkTypeface.h"
 #include "include/private/base/SkTemplates.h"
+#include "include/utils/SkGlyphPrefetcher.h"
 #include "src/base/SkRandom.h"
 #include "tools/Resources.h"
 #include "tools/ToolUtils.h"
 #include "tools/fonts/FontToolUtils.h"
 
+#include <memory>
+#include <vector>
+
 /*
  * A trivial test which benchmarks the performance of a textblob with a single run.
  */
@@ -109,3 +115,68 @@ class TextBlobMakeBench : public SkTextBlobBench {
     }
 };
 DEF_BENCH( return new TextBlobMakeBench(); )
+
+/*
+ * Draws text with a cold glyph cache: every glyph is rasterized during the draw, or, when
+ * prefetching, by an SkGlyphPrefetcher on a thread pool while the draws are issued. Each blob
+ * uses its own size, so the prefetcher has a strike per blob to rasterize in parallel.
+ */
+class TextBlobColdCacheBench : public Benchmark {
+public:
+    explicit TextBlobColdCacheBench(bool prefetch) : fPrefetch(prefetch) {}
+
+private:
+    const char* onGetName() override {
+        return fPrefetch ? "TextBlobColdCache_prefetch" : "TextBlobColdCache";
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kRaster;
+    }
+
+    void onDelayedSetup() override {
+        const char* text = "Keep your sentences short, but not overly so.";
+        SkFont font{ToolUtils::CreatePortableTypeface("serif", SkFontStyle())};
+        for (int i = 0; i < kBlobCount; ++i) {
+            font.setSize(12 + i);
+            fBlobs.push_back(SkTextBlob::MakeFromString(text, font));
+        }
+        fThreadPool = SkExecutor::MakeFIFOThreadPool();
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkPaint paint;
+        SkSurfaceProps props;
+        canvas->getProps(&props);
+        for (int loop = 0; loop < loops; ++loop) {
+            SkGraphics::PurgeFontCache();
+            if (fPrefetch) {
+                SkGlyphPrefetcher prefetcher{canvas->imageInfo(), props, fThreadPool.get()};
+                for (int i = 0; i < kBlobCount; ++i) {
+                    prefetcher.prefetch(fBlobs[i], this->origin(i), paint,
+                                        canvas->getLocalToDeviceAs3x3());
+                }
+                // Draw while the prefetcher is still working; a draw waits for its strike if
+                // the strike is being prefetched.
+                this->drawBlobs(canvas, paint);
+            } else {
+                this->drawBlobs(canvas, paint);
+            }
+        }
+    }
+
+    SkPoint origin(int i) const { return {10, 20.0f + 30 * i}; }
+
+    void drawBlobs(SkCanvas* canvas, const SkPaint& paint) const {
+        for (int i = 0; i < kBlobCount; ++i) {
+            canvas->drawTextBlob(fBlobs[i], this->origin(i).x(), this->origin(i).y(), paint);
+        }
+    }
+
+    inline static constexpr int kBlobCount = 16;
+    const bool fPrefetch;
+    std::vector<sk_sp<SkTextBlob>> fBlobs;
+    std::unique_ptr<SkExecutor> fThreadPool;
+};
+DEF_BENCH( return new TextBlobColdCacheBench(false); )
+DEF_BENCH( return new TextBlobColdCacheBench(true); )
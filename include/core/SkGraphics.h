@@ -96,6 +96,22 @@ public:
      */
     static void PurgePinnedFontCache();
 
+    /**
+     *  Specify a directory in which the font cache can store the glyph images and paths it
+     *  generates, so that later runs of the process load them instead of rasterizing the same
+     *  glyphs again. Pass nullptr (the default) to stop using the directory.
+     *
+     *  Glyphs are only stored by SaveFontCacheToDisk(), and only for the strikes still in the
+     *  font cache at that time. Typefaces without font data are never stored.
+     */
+    static void SetFontCacheDiskDirectory(const char* directory);
+
+    /**
+     *  Store the glyphs generated since the last save in the directory given to
+     *  SetFontCacheDiskDirectory(). Returns the number of strikes written.
+     */
+    static int SaveFontCacheToDisk();
+
     /**
      *  This function returns the memory used for temporary images and other resources.
      */
@@ -120,6 +120,25 @@ public:
         int              index;
     };
 
+    /**
+     * Abstract class to provide persistent storage for compiled runtime effects, so that the work
+     * of optimizing and lowering an effect to a raster-pipeline program can be skipped when the
+     * same effect is created again in a later process. Keys and data are opaque; they are only
+     * valid for the build of Skia which produced them. Implementations must be thread-safe, since
+     * effects are compiled lazily on whichever thread first draws with them.
+     */
+    class SK_API PersistentCache {
+    public:
+        virtual ~PersistentCache() = default;
+
+        /**
+         * Returns the data previously stored for `key`, or null if there is none.
+         */
+        virtual sk_sp<SkData> load(const SkData& key) = 0;
+
+        virtual void store(const SkData& key, const SkData& data) = 0;
+    };
+
     class Options {
     public:
         // For testing purposes, disables optimization and inlining. (Normally, Runtime Effects
@@ -127,6 +146,11 @@ public:
         // painted.)
         bool forceUnoptimized = false;
 
+        // When set, the effect's compiled raster-pipeline program is loaded from this cache if it
+        // is present, and stored into it after compilation otherwise. The cache must outlive any
+        // effects created with it.
+        PersistentCache* persistentCache = nullptr;
+
     private:
         friend class SkRuntimeEffect;
         friend class SkRuntimeEffectPriv;
@@ -134,6 +158,9 @@ public:
         // This flag allows Runtime Effects to access Skia implementation details like sk_FragCoord
         // and functions with private identifiers (e.g. $rgb_to_hsl).
         bool allowPrivateAccess = false;
+        // For benchmarking, skips the raster-pipeline dead-store elimination and copy fusion
+        // passes, while keeping every other optimization.
+        bool disableRPStoreOptimizations = false;
         // When not 0, this field allows Skia to assign a stable key to a known runtime effect
         uint32_t fStableKey = 0;
 
@@ -243,6 +270,24 @@ public:
     };
     static TracedShader MakeTraced(sk_sp<SkShader> shader, const SkIPoint& traceCoord);
 
+    /**
+     * Returns a variant of this effect in which the named uniforms are compile-time constants.
+     * Their values are read from `uniforms`, which uses the same layout as the data passed to
+     * makeShader (and must be uniformSize() bytes). This lets the compiler fold away branches and
+     * arithmetic that depend only on those uniforms, producing a faster program on both the raster
+     * and GPU backends.
+     *
+     * The specialized effect keeps the original's uniform layout, so the same uniform data can be
+     * used with either effect; the data supplied at draw time should continue to hold the
+     * specialized values. Specialized effects are cached by the original effect, so asking for the
+     * same specialization again is cheap.
+     *
+     * Returns null if a name does not refer to a uniform, or refers to an array or to a
+     * layout(color) uniform, which cannot be specialized.
+     */
+    sk_sp<SkRuntimeEffect> makeSpecialized(sk_sp<const SkData> uniforms,
+                                           SkSpan<const std::string_view> uniformNames) const;
+
     // Returns the SkSL source of the runtime effect shader.
     const std::string& source() const;
 
@@ -290,6 +335,8 @@ private:
 
     sk_sp<SkRuntimeEffect> makeUnoptimizedClone();
 
+    struct SpecializationCache;
+
     static Result MakeFromSource(SkString sksl, const Options& options, SkSL::ProgramKind kind);
 
     static Result MakeInternal(std::unique_ptr<SkSL::Program> program,
@@ -306,6 +353,7 @@ private:
     bool isAlphaUnchanged()   const { return (fFlags & kAlphaUnchanged_Flag);     }
 
     const SkSL::RP::Program* getRPProgram(SkSL::DebugTracePriv* debugTrace) const;
+    sk_sp<SkData> persistentCacheKey() const;
 
     friend class GrSkSLFP;              // usesColorTransform
     friend class SkRuntimeShader;       // fBaseProgram, fMain, fSampleUsages, getRPProgram()
@@ -320,6 +368,9 @@ private:
     std::unique_ptr<SkSL::Program> fBaseProgram;
     std::unique_ptr<SkSL::RP::Program> fRPProgram;
     mutable SkOnce fCompileRPProgramOnce;
+    PersistentCache* fPersistentCache;
+    mutable SkOnce fSpecializationCacheOnce;
+    mutable std::unique_ptr<SpecializationCache> fSpecializationCache;
     const SkSL::FunctionDefinition& fMain;
     std::vector<Uniform> fUniforms;
     std::vector<Child> fChildren;
@@ -0,0 +1,76 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkGlyphPrefetcher_DEFINED
+#define SkGlyphPrefetcher_DEFINED
+
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkMatrix.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkPoint.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkSurfaceProps.h"
+#include "include/core/SkTypes.h"
+
+#include <memory>
+
+class SkExecutor;
+class SkPicture;
+class SkTaskGroup;
+class SkTextBlob;
+
+/**
+ *  SkGlyphPrefetcher rasterizes the glyphs a raster canvas will need to draw some text ahead of
+ *  the draw, filling the process wide glyph cache on an SkExecutor. Drawing the text afterwards
+ *  only blits the cached masks. A draw that happens while its glyphs are still being prefetched
+ *  waits for them rather than rasterizing them a second time.
+ *
+ *  The glyphs are rasterized for a destination with the given image info and surface props;
+ *  prefetching for a different destination still works, but may fill the cache with glyphs the
+ *  draw does not use.
+ */
+class SK_API SkGlyphPrefetcher {
+public:
+    /**
+     *  If executor is null, the prefetch calls do their work before returning.
+     */
+    SkGlyphPrefetcher(const SkImageInfo& dstInfo,
+                      const SkSurfaceProps& props,
+                      SkExecutor* executor);
+
+    /** Waits for all the prefetches to finish. */
+    ~SkGlyphPrefetcher();
+
+    SkGlyphPrefetcher(const SkGlyphPrefetcher&) = delete;
+    SkGlyphPrefetcher& operator=(const SkGlyphPrefetcher&) = delete;
+
+    /**
+     *  Prefetches the glyphs of canvas->drawTextBlob(blob, origin.x(), origin.y(), paint), with
+     *  ctm being the canvas's matrix at the time of the draw.
+     */
+    void prefetch(sk_sp<SkTextBlob> blob,
+                  SkPoint origin,
+                  const SkPaint& paint,
+                  const SkMatrix& ctm = SkMatrix::I());
+
+    /**
+     *  Prefetches the glyphs of all the text in canvas->drawPicture(picture), with ctm being the
+     *  canvas's matrix at the time of the draw. Text outside of the destination's bounds is
+     *  skipped.
+     */
+    void prefetch(sk_sp<SkPicture> picture, const SkMatrix& ctm = SkMatrix::I());
+
+    /** Blocks until all the prefetches started so far have finished. */
+    void wait();
+
+private:
+    const SkImageInfo fDstInfo;
+    const SkSurfaceProps fProps;
+    std::unique_ptr<SkTaskGroup> fTaskGroup;  // null when prefetching synchronously
+};
+
+#endif  // SkGlyphPrefetcher_DEFINED
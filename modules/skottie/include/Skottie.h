@@ -26,6 +26,7 @@
 #include <vector>
 
 class SkCanvas;
+class SkExecutor;
 class SkStream;
 struct SkRect;
 
@@ -38,9 +39,11 @@ class RenderNode;
 
 namespace SkShapers { class Factory; }
 
+namespace skjson { class ObjectValue; }
+
 namespace skottie {
 
-namespace internal { class Animator; }
+namespace internal { class Animator; class SharedInstanceData; }
 
 using ImageAsset = skresources::ImageAsset;
 using ResourceProvider = skresources::ResourceProvider;
@@ -100,6 +103,10 @@ public:
                                          // frames are only resolved when needed, at seek() time.
             kPreferEmbeddedFonts = 0x02, // Attempt to use the embedded fonts (glyph paths,
                                          // normally used as fallback) over native Skia typefaces.
+            kCacheStaticLayers   = 0x04, // Cache the rendered content of precomp layers, and of
+                                         // shape and text layers with no animated content, as
+                                         // device resolution images.  Animations built with
+                                         // this flag must not be rendered concurrently.
         };
 
         explicit Builder(uint32_t flags = 0);
@@ -108,11 +115,14 @@ public:
         ~Builder();
 
         struct Stats {
-            float  fTotalLoadTimeMS  = 0, // Total animation instantiation time.
-                   fJsonParseTimeMS  = 0, // Time spent building a JSON DOM.
-                   fSceneParseTimeMS = 0; // Time spent constructing the animation scene graph.
-            size_t fJsonSize         = 0, // Input JSON size.
-                   fAnimatorCount    = 0; // Number of dynamically animated properties.
+            float  fTotalLoadTimeMS    = 0, // Total animation instantiation time.
+                   fJsonParseTimeMS    = 0, // Time spent building a JSON DOM.
+                   fSceneParseTimeMS   = 0, // Time spent constructing the animation scene graph.
+                   fTextShapingTimeMS  = 0; // Time spent shaping text ahead of time, with a
+                                            // text shaping executor (part of the scene time).
+            size_t fJsonSize           = 0, // Input JSON size.
+                   fAnimatorCount      = 0, // Number of dynamically animated properties.
+                   fShapedTextCount    = 0; // Number of text documents shaped ahead of time.
         };
 
         /**
@@ -169,19 +179,68 @@ public:
          */
         Builder& setTextShapingFactory(sk_sp<SkShapers::Factory>);
 
+        /**
+         * Registers an executor for shaping text while building the animation.
+         *
+         * When specified, the text documents known at build time (including the keyframed
+         * ones, up to 64 per layer) are shaped concurrently on the executor, once the scene graph
+         * is built.  Their shaping results are kept, and reused when the text animates back to a
+         * known document.  Otherwise, text is shaped on demand, on the calling thread, and only
+         * the current document is kept.
+         *
+         * The executor must outlive the calls to make().
+         */
+        Builder& setTextShapingExecutor(SkExecutor*);
+
         /**
          * Animation factories.
+         *
+         * The data is either Lottie JSON, or a binary image of it as written by
+         * skottie_precompile_tool, which loads without parsing.
          */
         sk_sp<Animation> make(SkStream*);
         sk_sp<Animation> make(const char* data, size_t length);
         sk_sp<Animation> makeFromFile(const char path[]);
 
+        /**
+         * Builds |count| independent instances of the same animation, which can be seeked and
+         * rendered concurrently from different threads (e.g. to render a frame range in
+         * parallel for offline export).
+         *
+         * The JSON is parsed once for all instances, and the instances share the static image
+         * assets and typefaces loaded through the resource provider, the keyframes of animated
+         * properties and the shaped text documents of text layers.  Multi-frame image assets are
+         * loaded by each instance, and each instance has its own scene graph and animators (sized
+         * by the animated properties, not by their keyframe counts).
+         *
+         * Only the first instance reports to the property observer, the marker observer and the
+         * logger, and getSlotManager() controls the first instance.  The precomp interceptor and
+         * expression manager are used by all instances.
+         *
+         * getStats() describes a single instance (e.g. fAnimatorCount is the count of one
+         * instance), except for fSceneParseTimeMS and fTotalLoadTimeMS, which cover building all
+         * of them.
+         *
+         * Returns an empty vector if the animation cannot be built.
+         */
+        std::vector<sk_sp<Animation>> makeInstances(const char* data, size_t length, int count);
+
         /**
          * Get handle for SlotManager after animation is built.
          */
         const sk_sp<SlotManager>& getSlotManager() const {return fSlotManager;}
 
     private:
+        sk_sp<Animation> makeFromJson(const skjson::ObjectValue&,
+                                      sk_sp<ResourceProvider>,
+                                      sk_sp<PropertyObserver>,
+                                      sk_sp<Logger>,
+                                      sk_sp<MarkerObserver>,
+                                      sk_sp<PrecompInterceptor>,
+                                      sk_sp<ExpressionManager>,
+                                      internal::SharedInstanceData*,
+                                      Stats*);
+
         const uint32_t          fFlags;
 
         sk_sp<ResourceProvider>   fResourceProvider;
@@ -192,6 +251,7 @@ public:
         sk_sp<PrecompInterceptor> fPrecompInterceptor;
         sk_sp<ExpressionManager>  fExpressionManager;
         sk_sp<SkShapers::Factory> fShapingFactory;
+        SkExecutor*               fTextShapingExecutor = nullptr;
         sk_sp<SlotManager>        fSlotManager;
         Stats                     fStats;
     };
@@ -25,6 +25,7 @@
 #include "modules/skottie/src/animator/Animator.h"
 #include "modules/skottie/src/effects/Effects.h"
 #include "modules/skottie/src/effects/MotionBlurEffect.h"
+#include "modules/sksg/include/SkSGCacheEffect.h"
 #include "modules/sksg/include/SkSGClipEffect.h"
 #include "modules/sksg/include/SkSGDraw.h"
 #include "modules/sksg/include/SkSGGeometryNode.h"
@@ -446,18 +447,22 @@ sk_sp<sksg::RenderNode> LayerBuilder::buildRenderTree(const AnimationBuilder& ab
     enum : uint32_t {
         kTransformEffects = 0x01, // The layer transform also applies to its effects.
         kForceSeek        = 0x02, // Dispatch all seek() events even when the layer is inactive.
+        kCacheContent     = 0x04, // Cache the content (with kCacheStaticLayers).
+        kCacheIfStatic    = 0x08, // Cache the content when it has no animators
+                                  // (with kCacheStaticLayers).
     };
 
     static constexpr struct {
         LayerBuilder                      fBuilder;
         uint32_t                          fFlags;
     } gLayerBuildInfo[] = {
-        { &AnimationBuilder::attachPrecompLayer, kTransformEffects },  // 'ty':  0 -> precomp
+        { &AnimationBuilder::attachPrecompLayer, kTransformEffects
+                                                 | kCacheContent     },  // 'ty':  0 -> precomp
         { &AnimationBuilder::attachSolidLayer  , kTransformEffects },  // 'ty':  1 -> solid
         { &AnimationBuilder::attachFootageLayer, kTransformEffects },  // 'ty':  2 -> image
         { &AnimationBuilder::attachNullLayer   ,                 0 },  // 'ty':  3 -> null
-        { &AnimationBuilder::attachShapeLayer  ,                 0 },  // 'ty':  4 -> shape
-        { &AnimationBuilder::attachTextLayer   ,                 0 },  // 'ty':  5 -> text
+        { &AnimationBuilder::attachShapeLayer  ,    kCacheIfStatic },  // 'ty':  4 -> shape
+        { &AnimationBuilder::attachTextLayer   ,    kCacheIfStatic },  // 'ty':  5 -> text
         { &AnimationBuilder::attachAudioLayer  ,        kForceSeek },  // 'ty':  6 -> audio
         { nullptr                              ,                 0 },  // 'ty':  7 -> pholderVideo
         { nullptr                              ,                 0 },  // 'ty':  8 -> imageSeq
@@ -481,9 +486,26 @@ sk_sp<sksg::RenderNode> LayerBuilder::buildRenderTree(const AnimationBuilder& ab
     // Potentially null.
     sk_sp<sksg::RenderNode> layer;
 
+    // Content nested in cached content (precomp layers) is not cached again.
+    const auto cache_content = (abuilder.fFlags & Animation::Builder::kCacheStaticLayers) &&
+                               (build_info.fFlags & (kCacheContent | kCacheIfStatic)) &&
+                               !abuilder.fIsCachingContent;
+
     // Build the layer content fragment.
     if (build_info.fBuilder) {
+        const bool was_caching_content = abuilder.fIsCachingContent;
+        abuilder.fIsCachingContent = was_caching_content || cache_content;
         layer = (abuilder.*(build_info.fBuilder))(fJlayer, &fInfo);
+        abuilder.fIsCachingContent = was_caching_content;
+    }
+
+    // Nested precomp layers always bind animators (for their in/out points at least), so precomp
+    // content is cached regardless.  The cache only engages for content which renders unchanged
+    // across frames anyway.
+    if (cache_content &&
+        ((build_info.fFlags & kCacheContent) ||
+         abuilder.fCurrentAnimatorScope->size() == fTransformAnimatorCount)) {
+        layer = sksg::CacheEffect::Make(std::move(layer));
     }
 
     // Clip layers with explicit dimensions.
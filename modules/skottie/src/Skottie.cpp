@@ -13,8 +13,10 @@
 #include "include/core/SkMatrix.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkStream.h"
+#include "include/core/SkTypeface.h"
 #include "include/private/base/SkDebug.h"
 #include "include/private/base/SkFloatingPoint.h"
+#include "include/private/base/SkMutex.h"
 #include "include/private/base/SkTPin.h"
 #include "include/private/base/SkTo.h"
 #include "modules/skottie/include/ExternalLayer.h"
@@ -28,10 +30,13 @@
 #include "modules/skottie/src/Transform.h"  // IWYU pragma: keep
 #include "modules/skottie/src/animator/Animator.h"
 #include "modules/skottie/src/text/TextAdapter.h"
+#include "modules/skresources/include/SkResources.h"
+#include "modules/sksg/include/SkSGNodePool.h"
 #include "modules/sksg/include/SkSGOpacityEffect.h"
 #include "modules/sksg/include/SkSGRenderNode.h"
 #include "modules/skshaper/include/SkShaper_factory.h"
 #include "src/core/SkTHash.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/core/SkTraceEvent.h"
 #include "src/utils/SkJSON.h"
 
@@ -45,6 +50,7 @@
 #include <memory>
 #include <ratio>
 #include <utility>
+#include <vector>
 
 #if !defined(SK_DISABLE_LEGACY_SHAPER_FACTORY)
 #include "modules/skshaper/utils/FactoryHelpers.h"
@@ -142,6 +148,8 @@ AnimationBuilder::AnimationBuilder(sk_sp<ResourceProvider> rp, sk_sp<SkFontMgr>
                                    sk_sp<MarkerObserver> mobserver, sk_sp<PrecompInterceptor> pi,
                                    sk_sp<ExpressionManager> expressionmgr,
                                    sk_sp<SkShapers::Factory> shapingFactory,
+                                   SkExecutor* textShapingExecutor,
+                                   SharedInstanceData* sharedInstanceData,
                                    Animation::Builder::Stats* stats,
                                    const SkSize& comp_size, float duration, float framerate,
                                    uint32_t flags)
@@ -153,6 +161,8 @@ AnimationBuilder::AnimationBuilder(sk_sp<ResourceProvider> rp, sk_sp<SkFontMgr>
     , fPrecompInterceptor(std::move(pi))
     , fExpressionManager(std::move(expressionmgr))
     , fShapingFactory(std::move(shapingFactory))
+    , fTextShapingExecutor(textShapingExecutor)
+    , fSharedInstanceData(sharedInstanceData)
     , fRevalidator(sk_make_sp<SceneGraphRevalidator>())
     , fSlotManager(sk_make_sp<SlotManager>(fRevalidator))
     , fStats(stats)
@@ -160,7 +170,8 @@ AnimationBuilder::AnimationBuilder(sk_sp<ResourceProvider> rp, sk_sp<SkFontMgr>
     , fDuration(duration)
     , fFrameRate(framerate)
     , fFlags(flags)
-    , fHasNontrivialBlending(false) {}
+    , fHasNontrivialBlending(false)
+    , fIsCachingContent(false) {}
 
 AnimationBuilder::AnimationInfo AnimationBuilder::parse(const skjson::ObjectValue& jroot) {
     this->dispatchMarkers(jroot["markers"]);
@@ -173,6 +184,7 @@ AnimationBuilder::AnimationInfo AnimationBuilder::parse(const skjson::ObjectValu
     fSlotsRoot = jroot["slots"];
 
     auto root = CompositionBuilder(*this, fCompSize, jroot).build(*this);
+    this->shapeDeferredText();
 
     auto animators = ascope.release();
     fStats->fAnimatorCount = animators.size();
@@ -184,6 +196,39 @@ AnimationBuilder::AnimationInfo AnimationBuilder::parse(const skjson::ObjectValu
     return { std::move(root), std::move(animators), std::move(fSlotManager)};
 }
 
+void AnimationBuilder::shapeDeferredText() {
+    if (fDeferredTextAdapters.empty()) {
+        return;
+    }
+
+    SkASSERT(fTextShapingExecutor);
+    const auto t0 = std::chrono::steady_clock::now();
+
+    // One task per document, to balance layers with many keyframes.
+    std::vector<std::pair<TextAdapter*, size_t>> jobs;
+    for (const auto& deferred : fDeferredTextAdapters) {
+        for (size_t i = 0; i < deferred.fAdapter->shapingCacheSize(); ++i) {
+            jobs.emplace_back(deferred.fAdapter.get(), i);
+        }
+    }
+
+    SkTaskGroup(*fTextShapingExecutor).batch(SkToInt(jobs.size()), [&jobs](int i) {
+        jobs[SkToSizeT(i)].first->preshape(jobs[SkToSizeT(i)].second);
+    });
+
+    // Static text can now be synced, from the cache.
+    for (const auto& deferred : fDeferredTextAdapters) {
+        if (deferred.fIsStatic) {
+            deferred.fAdapter->seek(0);
+        }
+    }
+    fDeferredTextAdapters.clear();
+
+    const auto t1 = std::chrono::steady_clock::now();
+    fStats->fTextShapingTimeMS += std::chrono::duration<float, std::milli>{t1-t0}.count();
+    fStats->fShapedTextCount   += jobs.size();
+}
+
 void AnimationBuilder::parseAssets(const skjson::ArrayValue* jassets) {
     if (!jassets) {
         return;
@@ -346,6 +391,11 @@ Animation::Builder& Animation::Builder::setTextShapingFactory(sk_sp<SkShapers::F
     return *this;
 }
 
+Animation::Builder& Animation::Builder::setTextShapingExecutor(SkExecutor* executor) {
+    fTextShapingExecutor = executor;
+    return *this;
+}
+
 sk_sp<Animation> Animation::Builder::make(SkStream* stream) {
     if (!stream->hasLength()) {
         // TODO: handle explicit buffering?
@@ -394,6 +444,162 @@ sk_sp<Animation> Animation::Builder::make(const char* data, size_t data_len) {
     const auto t1 = std::chrono::steady_clock::now();
     fStats.fJsonParseTimeMS = std::chrono::duration<float, std::milli>{t1-t0}.count();
 
+    auto animation = this->makeFromJson(json,
+                                        std::move(resolvedProvider),
+                                        std::move(fPropertyObserver),
+                                        std::move(fLogger),
+                                        std::move(fMarkerObserver),
+                                        std::move(fPrecompInterceptor),
+                                        std::move(fExpressionManager),
+                                        nullptr,
+                                        &fStats);
+
+    const auto t2 = std::chrono::steady_clock::now();
+    fStats.fSceneParseTimeMS = std::chrono::duration<float, std::milli>{t2-t1}.count();
+    fStats.fTotalLoadTimeMS  = std::chrono::duration<float, std::milli>{t2-t0}.count();
+
+    return animation;
+}
+
+namespace {
+
+// Static image assets are resolved once at load time and are immutable afterwards, and
+// typefaces are immutable, so the instances of an animation can share them.  Multi-frame image
+// assets are seeked by each instance, so each instance loads its own.
+class InstanceResourceProvider final : public skresources::ResourceProviderProxyBase {
+public:
+    InstanceResourceProvider(sk_sp<ResourceProvider> rp, bool shareImages)
+        : INHERITED(std::move(rp))
+        , fShareImages(shareImages) {}
+
+private:
+    sk_sp<ImageAsset> loadImageAsset(const char path[],
+                                     const char name[],
+                                     const char id[]) const override {
+        if (!fShareImages) {
+            return this->INHERITED::loadImageAsset(path, name, id);
+        }
+
+        const auto key = SkStringPrintf("%s/%s/%s", path, name, id);
+        {
+            SkAutoMutexExclusive amx(fMutex);
+            if (const auto* asset = fImageCache.find(key)) {
+                return *asset;
+            }
+        }
+
+        auto asset = this->INHERITED::loadImageAsset(path, name, id);
+        if (asset && !asset->isMultiFrame()) {
+            SkAutoMutexExclusive amx(fMutex);
+            fImageCache.set(key, asset);
+        }
+        return asset;
+    }
+
+    sk_sp<SkTypeface> loadTypeface(const char name[], const char url[]) const override {
+        const auto key = SkStringPrintf("%s/%s", name, url);
+        SkAutoMutexExclusive amx(fMutex);
+        if (const auto* typeface = fTypefaceCache.find(key)) {
+            return *typeface;
+        }
+
+        auto typeface = this->INHERITED::loadTypeface(name, url);
+        fTypefaceCache.set(key, typeface);
+        return typeface;
+    }
+
+    const bool                                                   fShareImages;
+
+    mutable SkMutex                                              fMutex;
+    mutable skia_private::THashMap<SkString, sk_sp<ImageAsset>>  fImageCache;
+    mutable skia_private::THashMap<SkString, sk_sp<SkTypeface>>  fTypefaceCache;
+
+    using INHERITED = skresources::ResourceProviderProxyBase;
+};
+
+} // namespace
+
+std::vector<sk_sp<Animation>> Animation::Builder::makeInstances(const char* data,
+                                                                size_t data_len,
+                                                                int count) {
+    TRACE_EVENT0("skottie", TRACE_FUNC);
+
+    class NullResourceProvider final : public ResourceProvider {
+        sk_sp<SkData> load(const char[], const char[]) const override { return nullptr; }
+    };
+    // With deferred image loading, static frames are resolved at seek() time.
+    auto resolvedProvider = sk_make_sp<InstanceResourceProvider>(
+            fResourceProvider ? fResourceProvider : sk_make_sp<NullResourceProvider>(),
+            !(fFlags & Flags::kDeferImageLoading));
+
+    fStats = Stats{};
+
+    fStats.fJsonSize = data_len;
+    const auto t0 = std::chrono::steady_clock::now();
+
+    const skjson::DOM dom(data, data_len);
+    if (!dom.root().is<skjson::ObjectValue>()) {
+        if (fLogger) {
+            fLogger->log(Logger::Level::kError, "Failed to parse JSON input.\n");
+        }
+        return {};
+    }
+    const auto& json = dom.root().as<skjson::ObjectValue>();
+
+    const auto t1 = std::chrono::steady_clock::now();
+    fStats.fJsonParseTimeMS = std::chrono::duration<float, std::milli>{t1-t0}.count();
+
+    // The first instance parses the keyframes and shapes the text, for all of them.
+    internal::SharedInstanceData shared;
+    std::vector<sk_sp<Animation>> instances;
+    instances.reserve(std::max(count, 0));
+    sk_sp<SlotManager> slotManager;
+    for (int i = 0; i < count; ++i) {
+        // Only the first instance reports to the observers and the logger.
+        const bool first = i == 0;
+        // The instances are identical, so the stats of the first one are reported.
+        Stats instanceStats;
+        auto animation = this->makeFromJson(json,
+                                            resolvedProvider,
+                                            first ? std::move(fPropertyObserver) : nullptr,
+                                            first ? std::move(fLogger) : nullptr,
+                                            first ? std::move(fMarkerObserver) : nullptr,
+                                            fPrecompInterceptor,
+                                            fExpressionManager,
+                                            &shared,
+                                            &instanceStats);
+        if (!animation) {
+            instances.clear();
+            break;
+        }
+        if (first) {
+            slotManager = fSlotManager;
+            fStats.fAnimatorCount     = instanceStats.fAnimatorCount;
+            fStats.fShapedTextCount   = instanceStats.fShapedTextCount;
+            fStats.fTextShapingTimeMS = instanceStats.fTextShapingTimeMS;
+        }
+        instances.push_back(std::move(animation));
+    }
+    fSlotManager = std::move(slotManager);
+    fPrecompInterceptor.reset();
+    fExpressionManager.reset();
+
+    const auto t2 = std::chrono::steady_clock::now();
+    fStats.fSceneParseTimeMS = std::chrono::duration<float, std::milli>{t2-t1}.count();
+    fStats.fTotalLoadTimeMS  = std::chrono::duration<float, std::milli>{t2-t0}.count();
+
+    return instances;
+}
+
+sk_sp<Animation> Animation::Builder::makeFromJson(const skjson::ObjectValue& json,
+                                                  sk_sp<ResourceProvider> resourceProvider,
+                                                  sk_sp<PropertyObserver> propertyObserver,
+                                                  sk_sp<Logger> logger,
+                                                  sk_sp<MarkerObserver> markerObserver,
+                                                  sk_sp<PrecompInterceptor> precompInterceptor,
+                                                  sk_sp<ExpressionManager> expressionManager,
+                                                  internal::SharedInstanceData* shared,
+                                                  Stats* stats) {
     const auto version  = ParseDefault<SkString>(json["v"], SkString());
     const auto size     = SkSize::Make(ParseDefault<float>(json["w"], 0.0f),
                                        ParseDefault<float>(json["h"], 0.0f));
@@ -404,12 +610,12 @@ sk_sp<Animation> Animation::Builder::make(const char* data, size_t data_len) {
 
     if (size.isEmpty() || version.isEmpty() || fps <= 0 ||
         !SkIsFinite(inPoint, outPoint, duration)) {
-        if (fLogger) {
+        if (logger) {
             const auto msg = SkStringPrintf(
                          "Invalid animation params (version: %s, size: [%f %f], frame rate: %f, "
                          "in-point: %f, out-point: %f)\n",
                          version.c_str(), size.width(), size.height(), fps, inPoint, outPoint);
-            fLogger->log(Logger::Level::kError, msg.c_str());
+            logger->log(Logger::Level::kError, msg.c_str());
         }
         return nullptr;
     }
@@ -419,25 +625,29 @@ sk_sp<Animation> Animation::Builder::make(const char* data, size_t data_len) {
 #else
     auto factory = fShapingFactory ? fShapingFactory : ::SkShapers::BestAvailable();
 #endif
-    SkASSERT(resolvedProvider);
-    internal::AnimationBuilder builder(std::move(resolvedProvider), fFontMgr,
-                                       std::move(fPropertyObserver),
-                                       std::move(fLogger),
-                                       std::move(fMarkerObserver),
-                                       std::move(fPrecompInterceptor),
-                                       std::move(fExpressionManager),
+    SkASSERT(resourceProvider);
+    // Keep a ref for error reporting below; the animation builder takes the other one.
+    const auto errorLogger = logger;
+    internal::AnimationBuilder builder(std::move(resourceProvider), fFontMgr,
+                                       std::move(propertyObserver),
+                                       std::move(logger),
+                                       std::move(markerObserver),
+                                       std::move(precompInterceptor),
+                                       std::move(expressionManager),
                                        std::move(factory),
-                                       &fStats, size, duration, fps, fFlags);
-    auto ainfo = builder.parse(json);
+                                       fTextShapingExecutor,
+                                       shared,
+                                       stats, size, duration, fps, fFlags);
+    // Lay out the scene graph compactly: it lives as long as the animation.
+    auto ainfo = [&] {
+        sksg::NodePool::Scope pool_scope(sksg::NodePool::Make());
+        return builder.parse(json);
+    }();
 
     fSlotManager = ainfo.fSlotManager;
 
-    const auto t2 = std::chrono::steady_clock::now();
-    fStats.fSceneParseTimeMS = std::chrono::duration<float, std::milli>{t2-t1}.count();
-    fStats.fTotalLoadTimeMS  = std::chrono::duration<float, std::milli>{t2-t0}.count();
-
-    if (!ainfo.fSceneRoot && fLogger) {
-        fLogger->log(Logger::Level::kError, "Could not parse animation.\n");
+    if (!ainfo.fSceneRoot && errorLogger) {
+        errorLogger->log(Logger::Level::kError, "Could not parse animation.\n");
     }
 
     uint32_t flags = 0;
@@ -25,6 +25,8 @@
 
 #include "modules/skshaper/include/SkShaper_factory.h"
 
+#include <cstdint>
+#include <utility>
 #include <vector>
 
 namespace skjson {
@@ -63,12 +65,50 @@ private:
     sk_sp<sksg::RenderNode> fRoot;
 };
 
+// Data shared by the instances built by Animation::Builder::makeInstances(): the keyframes of
+// animated properties and the shaped documents of text layers.  The instances are built from the
+// same DOM, so entries are keyed on the JSON value they are built from, on their type and on an
+// optional variant (for values parsed in several ways).  Entries are added while the instances are
+// built, one at a time.
+class SharedInstanceData final : public SkNoncopyable {
+public:
+    template <typename T>
+    sk_sp<T> find(const skjson::Value& json, uintptr_t variant = 0) const {
+        const auto* data = fData.find({&json, TypeTag<T>(), variant});
+        return data ? sk_ref_sp(static_cast<T*>(data->get())) : nullptr;
+    }
+
+    template <typename T>
+    void set(const skjson::Value& json, sk_sp<T> data, uintptr_t variant = 0) {
+        fData.set({&json, TypeTag<T>(), variant}, std::move(data));
+    }
+
+private:
+    template <typename T>
+    static const void* TypeTag() {
+        static constexpr char kTag = 0;
+        return &kTag;
+    }
+
+    struct Key {
+        const void* fJson;
+        const void* fType;
+        uintptr_t   fVariant;
+
+        bool operator==(const Key& other) const {
+            return fJson == other.fJson && fType == other.fType && fVariant == other.fVariant;
+        }
+    };
+
+    skia_private::THashMap<Key, sk_sp<SkRefCnt>> fData;
+};
+
 class AnimationBuilder final : public SkNoncopyable {
 public:
     AnimationBuilder(sk_sp<ResourceProvider>, sk_sp<SkFontMgr>, sk_sp<PropertyObserver>,
                      sk_sp<Logger>, sk_sp<MarkerObserver>, sk_sp<PrecompInterceptor>,
-                     sk_sp<ExpressionManager>, sk_sp<SkShapers::Factory>,
-                     Animation::Builder::Stats*, const SkSize& comp_size,
+                     sk_sp<ExpressionManager>, sk_sp<SkShapers::Factory>, SkExecutor*,
+                     SharedInstanceData*, Animation::Builder::Stats*, const SkSize& comp_size,
                      float duration, float framerate, uint32_t flags);
 
     struct AnimationInfo {
@@ -109,6 +149,12 @@ public:
 
     bool hasNontrivialBlending() const { return fHasNontrivialBlending; }
 
+    // Text is shaped ahead of time, concurrently, when an executor is set.
+    bool shapesTextAheadOfTime() const { return fTextShapingExecutor != nullptr; }
+
+    // Data shared with the other instances of the animation, when building several of them.
+    SharedInstanceData* sharedInstanceData() const { return fSharedInstanceData; }
+
     class AutoScope final {
     public:
         explicit AutoScope(const AnimationBuilder* builder) : AutoScope(builder, AnimatorScope()) {}
@@ -220,6 +266,10 @@ private:
 
     void dispatchMarkers(const skjson::ArrayValue*) const;
 
+    // Shapes the text deferred by attachTextLayer() on the text shaping executor, then syncs
+    // static text.
+    void shapeDeferredText();
+
     sk_sp<sksg::RenderNode> attachBlendMode(const skjson::ObjectValue&,
                                             sk_sp<sksg::RenderNode>) const;
 
@@ -247,6 +297,8 @@ private:
     sk_sp<PrecompInterceptor>    fPrecompInterceptor;
     sk_sp<ExpressionManager>     fExpressionManager;
     sk_sp<SkShapers::Factory>    fShapingFactory;
+    SkExecutor* const            fTextShapingExecutor;
+    SharedInstanceData* const    fSharedInstanceData;
     sk_sp<SceneGraphRevalidator> fRevalidator;
     sk_sp<SlotManager>           fSlotManager;
     Animation::Builder::Stats*   fStats;
@@ -257,6 +309,7 @@ private:
     mutable AnimatorScope*       fCurrentAnimatorScope;
     mutable const char*          fPropertyObserverContext = nullptr;
     mutable bool                 fHasNontrivialBlending : 1;
+    mutable bool                 fIsCachingContent      : 1;
 
     struct LayerInfo {
         SkSize      fSize;
@@ -297,6 +350,12 @@ private:
     sk_sp<CustomFont::GlyphCompMapper>                         fCustomGlyphMapper;
     mutable skia_private::THashMap<SkString, FootageAssetInfo> fImageAssetCache;
 
+    struct DeferredTextAdapter {
+        sk_sp<TextAdapter> fAdapter;
+        bool               fIsStatic;
+    };
+    mutable std::vector<DeferredTextAdapter>                   fDeferredTextAdapters;
+
     // Handle to "slots" JSON Object, used to grab slot values while building
     const skjson::ObjectValue* fSlotsRoot;
 
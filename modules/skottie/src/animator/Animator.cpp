@@ -13,14 +13,23 @@
 #include "modules/skottie/src/animator/KeyframeAnimator.h"
 #include "src/utils/SkJSON.h"
 
+#include <memory>
 #include <utility>
 
 namespace skottie::internal {
 
+AnimatablePropertyContainer::AnimatablePropertyContainer() = default;
+
+AnimatablePropertyContainer::~AnimatablePropertyContainer() = default;
+
 Animator::StateChanged AnimatablePropertyContainer::onSeek(float t) {
     // The very first seek must trigger a sync, to ensure proper SG setup.
     bool changed = !fHasSynced;
 
+    if (fKeyframeAnimators) {
+        changed |= fKeyframeAnimators->seek(t);
+    }
+
     for (const auto& animator : fAnimators) {
         changed |= animator->seek(t);
     }
@@ -49,6 +58,9 @@ void AnimatablePropertyContainer::attachDiscardableAdapter(
 
 void AnimatablePropertyContainer::shrink_to_fit() {
     fAnimators.shrink_to_fit();
+    if (fKeyframeAnimators) {
+        fKeyframeAnimators->shrink_to_fit();
+    }
 }
 
 bool AnimatablePropertyContainer::bindImpl(const AnimationBuilder& abuilder,
@@ -125,7 +137,10 @@ bool AnimatablePropertyContainer::bindImpl(const AnimationBuilder& abuilder,
         // as an animated property - apply immediately and discard the animator.
         animator->seek(0);
     } else {
-        fAnimators.push_back(std::move(animator));
+        if (!fKeyframeAnimators) {
+            fKeyframeAnimators = std::make_unique<KeyframeAnimatorBatch>();
+        }
+        fKeyframeAnimators->add(std::move(animator));
     }
 
     return true;
@@ -10,6 +10,7 @@
 
 #include "include/core/SkRefCnt.h"
 
+#include <memory>
 #include <vector>
 
 struct SkV2;
@@ -23,11 +24,13 @@ class ObjectValue;
 namespace skottie {
 
 class SlotManager;
+struct TextPropertyValue;
 
 namespace internal {
 
 class AnimationBuilder;
 class AnimatorBuilder;
+class KeyframeAnimatorBatch;
 
 class Animator : public SkRefCnt {
 public:
@@ -46,6 +49,8 @@ private:
 
 class AnimatablePropertyContainer : public Animator {
 public:
+    ~AnimatablePropertyContainer() override;
+
     // This is the workhorse for property binding: depending on whether the property is animated,
     // it will either apply immediately or instantiate and attach a keyframe animator, scoped to
     // this container.
@@ -63,10 +68,18 @@ public:
                             const skjson::ObjectValue* jobject,
                             SkV2* v, float* orientation);
 
-    bool isStatic() const { return fAnimators.empty() && !fHasSlotID; }
+    // A flavor of bind<TextValue> which also collects the keyframe values, when bound to a
+    // keyframed property.
+    bool bindTextDocuments(const AnimationBuilder&, const skjson::ObjectValue*,
+                           TextPropertyValue*, std::vector<TextPropertyValue>* keyframe_values);
+
+    bool isStatic() const { return fAnimators.empty() && !fKeyframeAnimators && !fHasSlotID; }
 
 protected:
     friend class skottie::SlotManager;
+
+    AnimatablePropertyContainer();
+
     virtual void onSync() = 0;
 
     void shrink_to_fit();
@@ -78,9 +91,11 @@ private:
 
     bool bindImpl(const AnimationBuilder&, const skjson::ObjectValue*, AnimatorBuilder&);
 
-    std::vector<sk_sp<Animator>> fAnimators;
-    bool                         fHasSynced = false;
-    bool                         fHasSlotID = false;
+    std::vector<sk_sp<Animator>>           fAnimators;
+    // Keyframed properties, which are seeked before fAnimators.
+    std::unique_ptr<KeyframeAnimatorBatch> fKeyframeAnimators;
+    bool                                   fHasSynced = false;
+    bool                                   fHasSlotID = false;
 };
 
 } // namespace internal
@@ -7,10 +7,14 @@
 
 #include "modules/skottie/src/animator/KeyframeAnimator.h"
 
+#include "include/private/base/SkFloatingPoint.h"
 #include "include/private/base/SkTo.h"
 #include "modules/skottie/src/SkottieJson.h"
+#include "src/base/SkVx.h"
 #include "src/utils/SkJSON.h"
 
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
 
 #define DUMP_KF_RECORDS 0
@@ -37,16 +41,28 @@ KeyframeAnimator::LERPInfo KeyframeAnimator::getLERPInfo(float t) const {
     }
     SkASSERT(fCurrentSegment.contains(t));
 
-    if (fCurrentSegment.kf0->mapping == Keyframe::kConstantMapping) {
+    // Linear weight.
+    const auto w = (t - fCurrentSegment.kf0->t) / (fCurrentSegment.kf1->t - fCurrentSegment.kf0->t);
+
+    return this->segment_lerp_info(fCurrentSegment, w);
+}
+
+KeyframeAnimator::LERPInfo KeyframeAnimator::segment_lerp_info(const KFSegment& seg,
+                                                               float linear_weight) const {
+    if (seg.kf0->mapping == Keyframe::kConstantMapping) {
         // Constant/hold segment.
-        return { 0, fCurrentSegment.kf0->v, fCurrentSegment.kf0->v };
+        return { 0, seg.kf0->v, seg.kf0->v };
     }
 
-    return {
-        this->compute_weight(fCurrentSegment, t),
-        fCurrentSegment.kf0->v,
-        fCurrentSegment.kf1->v,
-    };
+    auto w = linear_weight;
+
+    // Optional cubic mapper.
+    if (seg.kf0->mapping >= Keyframe::kCubicIndexOffset) {
+        const auto mapper_index = SkToSizeT(seg.kf0->mapping - Keyframe::kCubicIndexOffset);
+        w = fCMs[mapper_index].computeYFromX(w);
+    }
+
+    return { w, seg.kf0->v, seg.kf1->v };
 }
 
 KeyframeAnimator::KFSegment KeyframeAnimator::find_segment(float t) const {
@@ -54,6 +70,14 @@ KeyframeAnimator::KFSegment KeyframeAnimator::find_segment(float t) const {
     SkASSERT(t > fKFs.front().t);
     SkASSERT(t < fKFs.back().t);
 
+    // Sequential playback usually moves on to the next segment.
+    if (fCurrentSegment.kf1 && fCurrentSegment.kf1 != &fKFs.back()) {
+        const KFSegment next = { fCurrentSegment.kf1, fCurrentSegment.kf1 + 1 };
+        if (next.contains(t)) {
+            return next;
+        }
+    }
+
     auto kf0 = &fKFs.front(),
          kf1 = &fKFs.back();
 
@@ -74,19 +98,97 @@ KeyframeAnimator::KFSegment KeyframeAnimator::find_segment(float t) const {
     return {kf0, kf1};
 }
 
-float KeyframeAnimator::compute_weight(const KFSegment &seg, float t) const {
-    SkASSERT(seg.contains(t));
+KeyframeAnimatorBatch::KeyframeAnimatorBatch() = default;
 
-    // Linear weight.
-    auto w = (t - seg.kf0->t) / (seg.kf1->t - seg.kf0->t);
+KeyframeAnimatorBatch::~KeyframeAnimatorBatch() = default;
 
-    // Optional cubic mapper.
-    if (seg.kf0->mapping >= Keyframe::kCubicIndexOffset) {
-        const auto mapper_index = SkToSizeT(seg.kf0->mapping - Keyframe::kCubicIndexOffset);
-        w = fCMs[mapper_index].computeYFromX(w);
+void KeyframeAnimatorBatch::add(sk_sp<KeyframeAnimator> animator) {
+    SkASSERT(animator && !animator->isConstant());
+
+    if (fAnimators.size() == fSegments.size()) {
+        // Grow by four (never applying) segments.
+        fSegments.resize(fSegments.size() + 4, { nullptr, nullptr });
+        fLo.resize(fSegments.size(), SK_FloatInfinity);
+        fHi.resize(fSegments.size(), SK_FloatNegativeInfinity);
+        fT0.resize(fSegments.size(), 0);
+        fT1.resize(fSegments.size(), 1);
+    }
+
+    fAnimators.push_back(std::move(animator));
+}
+
+void KeyframeAnimatorBatch::shrink_to_fit() {
+    fAnimators.shrink_to_fit();
+    fSegments.shrink_to_fit();
+    fLo.shrink_to_fit();
+    fHi.shrink_to_fit();
+    fT0.shrink_to_fit();
+    fT1.shrink_to_fit();
+}
+
+Animator::StateChanged KeyframeAnimatorBatch::seek(float t) {
+    SkASSERT(fSegments.size() % 4 == 0);
+
+    bool changed = false;
+
+    for (size_t i = 0; i < fAnimators.size(); i += 4) {
+        const auto lo = skvx::float4::Load(fLo.data() + i),
+                   hi = skvx::float4::Load(fHi.data() + i),
+                   t0 = skvx::float4::Load(fT0.data() + i),
+                   t1 = skvx::float4::Load(fT1.data() + i);
+
+        // Same as getLERPInfo()'s linear weight.
+        const auto applies = (lo <= t) & (t < hi);
+        const auto weights = (t - t0) / (t1 - t0);
+
+        const auto n = std::min<size_t>(fAnimators.size() - i, 4);
+        for (size_t j = 0; j < n; ++j) {
+            if (!applies[j]) {
+                changed |= this->lookup(i + j, t);
+                continue;
+            }
+
+            auto& animator = *fAnimators[i + j];
+            const auto& seg = fSegments[i + j];
+            changed |= animator.onApply(seg.kf0 == seg.kf1
+                    ? KeyframeAnimator::LERPInfo{ 0, seg.kf0->v, seg.kf0->v }
+                    : animator.segment_lerp_info(seg, weights[j]));
+        }
+    }
+
+    return changed;
+}
+
+Animator::StateChanged KeyframeAnimatorBatch::lookup(size_t i, float t) {
+    auto& animator = *fAnimators[i];
+    const auto changed = animator.seek(t);
+
+    // Cache the segment of |t|, reproducing the cases of getLERPInfo(): times up to the first
+    // keyframe are clamped to it, even when they are also in the last or another segment.
+    const auto& kfs = animator.fKFs;
+    const auto after_front = std::nextafter(kfs.front().t, SK_FloatInfinity);
+    auto& seg = fSegments[i];
+    if (t <= kfs.front().t) {
+        seg = { &kfs.front(), &kfs.front() };
+        fLo[i] = SK_FloatNegativeInfinity;
+        fHi[i] = after_front;
+    } else if (t >= kfs.back().t) {
+        seg = { &kfs.back(), &kfs.back() };
+        fLo[i] = std::max(kfs.back().t, after_front);
+        fHi[i] = SK_FloatInfinity;
+    } else if (animator.fCurrentSegment.contains(t)) {
+        seg = animator.fCurrentSegment;
+        fLo[i] = std::max(seg.kf0->t, after_front);
+        fHi[i] = seg.kf1->t;
+        fT0[i] = seg.kf0->t;
+        fT1[i] = seg.kf1->t;
+    } else {
+        // NaN: never cached.
+        fLo[i] = SK_FloatInfinity;
+        fHi[i] = SK_FloatNegativeInfinity;
     }
 
-    return w;
+    return changed;
 }
 
 AnimatorBuilder::~AnimatorBuilder() = default;
@@ -66,6 +66,14 @@ struct Keyframe {
     inline static constexpr uint32_t kCubicIndexOffset = 2;
 };
 
+// The keyframe records of an animated property, and the values they refer to (in subclasses).
+// They are immutable once parsed, so the animators of instances built from the same JSON value
+// share them (see SharedInstanceData).
+struct KeyframeData : public SkRefCnt {
+    std::vector<Keyframe>   fKFs; // Keyframe records, one per AE/Lottie keyframe.
+    std::vector<SkCubicMap> fCMs; // Optional cubic mappers (Bezier interpolation).
+};
+
 class KeyframeAnimator : public Animator {
 public:
     ~KeyframeAnimator() override;
@@ -78,9 +86,10 @@ public:
     }
 
 protected:
-    KeyframeAnimator(std::vector<Keyframe> kfs, std::vector<SkCubicMap> cms)
-        : fKFs(std::move(kfs))
-        , fCMs(std::move(cms)) {}
+    explicit KeyframeAnimator(sk_sp<const KeyframeData> data)
+        : fData(std::move(data))
+        , fKFs(fData->fKFs)
+        , fCMs(fData->fCMs) {}
 
     struct LERPInfo {
         float           weight; // vrec0/vrec1 weight [0..1]
@@ -90,7 +99,14 @@ protected:
     // Main entry point: |t| -> LERPInfo
     LERPInfo getLERPInfo(float t) const;
 
+    // Updates the target value for the given interpolation.
+    virtual StateChanged onApply(const LERPInfo&) = 0;
+
 private:
+    friend class KeyframeAnimatorBatch;
+
+    StateChanged onSeek(float t) final { return this->onApply(this->getLERPInfo(t)); }
+
     // Two sequential KFRecs determine how the value varies within [kf0 .. kf1)
     struct KFSegment {
         const Keyframe* kf0;
@@ -107,12 +123,42 @@ private:
     // Find the KFSegment containing |t|.
     KFSegment find_segment(float t) const;
 
-    // Given a |t| and a containing KFSegment, compute the local interpolation weight.
-    float compute_weight(const KFSegment& seg, float t) const;
+    // Given a KFSegment and the linear weight of |t| within it, compute the LERPInfo.
+    LERPInfo segment_lerp_info(const KFSegment& seg, float linear_weight) const;
+
+    const sk_sp<const KeyframeData> fData;
+    const std::vector<Keyframe>&    fKFs;
+    const std::vector<SkCubicMap>&  fCMs;
+    mutable KFSegment               fCurrentSegment = { nullptr, nullptr }; // Cached segment.
+};
+
+// Seeks a group of keyframe animators to the same |t|, in structure-of-arrays form: the
+// segments cached for the animators are tested, and their linear weights computed, four
+// animators at a time, so that only the animators which move to another segment look it up.
+class KeyframeAnimatorBatch final : public SkNoncopyable {
+public:
+    KeyframeAnimatorBatch();
+    ~KeyframeAnimatorBatch();
+
+    void add(sk_sp<KeyframeAnimator>);
+
+    bool empty() const { return fAnimators.empty(); }
+
+    void shrink_to_fit();
+
+    Animator::StateChanged seek(float t);
 
-    const std::vector<Keyframe>   fKFs; // Keyframe records, one per AE/Lottie keyframe.
-    const std::vector<SkCubicMap> fCMs; // Optional cubic mappers (Bezier interpolation).
-    mutable KFSegment             fCurrentSegment = { nullptr, nullptr }; // Cached segment.
+private:
+    Animator::StateChanged lookup(size_t i, float t);
+
+    std::vector<sk_sp<KeyframeAnimator>> fAnimators;
+
+    // The segment cached for each animator, which applies while fLo[i] <= t < fHi[i]. Clamped
+    // values are cached as segments with kf0 == kf1. The arrays are padded to a multiple of four
+    // animators, with segments that never apply.
+    std::vector<KeyframeAnimator::KFSegment> fSegments;
+    std::vector<float>                       fLo, fHi,
+                                             fT0, fT1; // Keyframe times of the segments.
 };
 
 class AnimatorBuilder : public SkNoncopyable {
@@ -137,6 +183,14 @@ protected:
 
     bool parseKeyframes(const AnimationBuilder&, const skjson::ArrayValue&);
 
+    // Moves the parsed keyframe records to |data|, which holds the parsed values.
+    template <typename T>
+    sk_sp<T> finishKeyframeData(sk_sp<T> data) {
+        data->fKFs = std::move(fKFs);
+        data->fCMs = std::move(fCMs);
+        return data;
+    }
+
     std::vector<Keyframe>   fKFs; // Keyframe records, one per AE/Lottie keyframe.
     std::vector<SkCubicMap> fCMs; // Optional cubic mappers (Bezier interpolation).
 
@@ -28,17 +28,14 @@ namespace  {
     // Scalar specialization: stores scalar values (floats) inline in keyframes.
 class ScalarKeyframeAnimator final : public KeyframeAnimator {
 public:
-    ScalarKeyframeAnimator(std::vector<Keyframe> kfs,
-                           std::vector<SkCubicMap> cms,
-                           ScalarValue* target_value)
-        : INHERITED(std::move(kfs), std::move(cms))
+    ScalarKeyframeAnimator(sk_sp<const KeyframeData> data, ScalarValue* target_value)
+        : INHERITED(std::move(data))
         , fTarget(target_value) {}
 
 private:
 
-    StateChanged onSeek(float t) override {
-        const auto& lerp_info = this->getLERPInfo(t);
-        const auto  old_value = *fTarget;
+    StateChanged onApply(const LERPInfo& lerp_info) override {
+        const auto old_value = *fTarget;
 
         *fTarget = Lerp(lerp_info.vrec0.flt, lerp_info.vrec1.flt, lerp_info.weight);
 
@@ -81,12 +78,21 @@ class ScalarAnimatorBuilder final : public AnimatorBuilder {
         sk_sp<KeyframeAnimator> makeFromKeyframes(const AnimationBuilder& abuilder,
                                      const skjson::ArrayValue& jkfs) override {
             SkASSERT(jkfs.size() > 0);
-            if (!this->parseKeyframes(abuilder, jkfs)) {
-                return nullptr;
+
+            auto* shared = abuilder.sharedInstanceData();
+            auto data = shared ? shared->find<KeyframeData>(jkfs) : nullptr;
+            if (!data) {
+                if (!this->parseKeyframes(abuilder, jkfs)) {
+                    return nullptr;
+                }
+                data = this->finishKeyframeData(sk_make_sp<KeyframeData>());
+                if (shared) {
+                    shared->set(jkfs, data);
+                }
             }
 
-            return sk_sp<ScalarKeyframeAnimator>(
-                        new ScalarKeyframeAnimator(std::move(fKFs), std::move(fCMs), fTarget));
+            return sk_sp<ScalarKeyframeAnimator>(new ScalarKeyframeAnimator(std::move(data),
+                                                                            fTarget));
         }
 
         sk_sp<Animator> makeFromExpression(ExpressionManager& em, const char* expr) override {
@@ -12,6 +12,7 @@
 #include "include/private/base/SkTo.h"
 #include "modules/skottie/include/Skottie.h"
 #include "modules/skottie/include/SkottieProperty.h"
+#include "modules/skottie/src/SkottiePriv.h"
 #include "modules/skottie/src/animator/Animator.h"
 #include "modules/skottie/src/animator/KeyframeAnimator.h"
 #include "modules/skottie/src/text/TextValue.h"
@@ -24,18 +25,19 @@ namespace skottie::internal {
 class AnimationBuilder;
 
 namespace  {
+struct TextKeyframeData final : public KeyframeData {
+    std::vector<TextValue> fValues;
+};
+
 class TextKeyframeAnimator final : public KeyframeAnimator {
 public:
-    TextKeyframeAnimator(std::vector<Keyframe> kfs, std::vector<SkCubicMap> cms,
-                         std::vector<TextValue> vs, TextValue* target_value)
-        : INHERITED(std::move(kfs), std::move(cms))
-        , fValues(std::move(vs))
+    TextKeyframeAnimator(sk_sp<const TextKeyframeData> data, TextValue* target_value)
+        : INHERITED(data)
+        , fValues(data->fValues)
         , fTarget(target_value) {}
 
 private:
-    StateChanged onSeek(float t) override {
-        const auto& lerp_info = this->getLERPInfo(t);
-
+    StateChanged onApply(const LERPInfo& lerp_info) override {
         // Text value keyframes are treated as selectors, not as interpolated values.
         if (*fTarget != fValues[SkToSizeT(lerp_info.vrec0.idx)]) {
             *fTarget = fValues[SkToSizeT(lerp_info.vrec0.idx)];
@@ -45,8 +47,8 @@ private:
         return false;
     }
 
-    const std::vector<TextValue> fValues;
-    TextValue*                   fTarget;
+    const std::vector<TextValue>& fValues;
+    TextValue*                    fTarget;
 
     using INHERITED = KeyframeAnimator;
 };
@@ -74,25 +76,37 @@ private:
 
 class TextAnimatorBuilder final : public AnimatorBuilder {
 public:
-    explicit TextAnimatorBuilder(TextValue* target)
+    TextAnimatorBuilder(TextValue* target, std::vector<TextValue>* keyframe_values)
         : INHERITED(Keyframe::Value::Type::kIndex)
-        , fTarget(target) {}
+        , fTarget(target)
+        , fKeyframeValues(keyframe_values) {}
 
     sk_sp<KeyframeAnimator> makeFromKeyframes(const AnimationBuilder& abuilder,
                                     const skjson::ArrayValue& jkfs) override {
         SkASSERT(jkfs.size() > 0);
 
-        fValues.reserve(jkfs.size());
-        if (!this->parseKeyframes(abuilder, jkfs)) {
-            return nullptr;
+        auto* shared = abuilder.sharedInstanceData();
+        auto data = shared ? shared->find<TextKeyframeData>(jkfs) : nullptr;
+        if (!data) {
+            fValues.reserve(jkfs.size());
+            if (!this->parseKeyframes(abuilder, jkfs)) {
+                return nullptr;
+            }
+            fValues.shrink_to_fit();
+
+            data = this->finishKeyframeData(sk_make_sp<TextKeyframeData>());
+            data->fValues = std::move(fValues);
+            if (shared) {
+                shared->set(jkfs, data);
+            }
+        }
+
+        if (fKeyframeValues) {
+            fKeyframeValues->insert(fKeyframeValues->end(),
+                                    data->fValues.cbegin(), data->fValues.cend());
         }
-        fValues.shrink_to_fit();
 
-        return sk_sp<TextKeyframeAnimator>(
-                    new TextKeyframeAnimator(std::move(fKFs),
-                                                std::move(fCMs),
-                                                std::move(fValues),
-                                                fTarget));
+        return sk_sp<TextKeyframeAnimator>(new TextKeyframeAnimator(std::move(data), fTarget));
     }
 
     sk_sp<Animator> makeFromExpression(ExpressionManager& em, const char* expr) override {
@@ -125,20 +139,28 @@ private:
         return true;
     }
 
-    std::vector<TextValue> fValues;
-    TextValue*             fTarget;
+    std::vector<TextValue>  fValues;
+    TextValue*              fTarget;
+    std::vector<TextValue>* fKeyframeValues;
 
     using INHERITED = AnimatorBuilder;
 };
 
 } // namespace
 
+bool AnimatablePropertyContainer::bindTextDocuments(const AnimationBuilder& abuilder,
+                                                    const skjson::ObjectValue* jprop,
+                                                    TextValue* v,
+                                                    std::vector<TextValue>* keyframe_values) {
+    TextAnimatorBuilder builder(v, keyframe_values);
+    return this->bindImpl(abuilder, jprop, builder);
+}
+
 template <>
 bool AnimatablePropertyContainer::bind<TextValue>(const AnimationBuilder& abuilder,
                                                   const skjson::ObjectValue* jprop,
                                                   TextValue* v) {
-    TextAnimatorBuilder builder(v);
-    return this->bindImpl(abuilder, jprop, builder);
+    return this->bindTextDocuments(abuilder, jprop, v, nullptr);
 }
 
 } // namespace skottie::internal
@@ -34,17 +34,23 @@ namespace skottie::internal {
 namespace  {
 
 // Spatial 2D specialization: stores SkV2s and optional contour interpolators externally.
-class Vec2KeyframeAnimator final : public KeyframeAnimator {
-public:
+struct Vec2KeyframeData final : public KeyframeData {
     struct SpatialValue {
         Vec2Value               v2;
         sk_sp<SkContourMeasure> cmeasure;
     };
 
-    Vec2KeyframeAnimator(std::vector<Keyframe> kfs, std::vector<SkCubicMap> cms,
-                         std::vector<SpatialValue> vs, Vec2Value* vec_target, float* rot_target)
-        : INHERITED(std::move(kfs), std::move(cms))
-        , fValues(std::move(vs))
+    std::vector<SpatialValue> fValues;
+};
+
+class Vec2KeyframeAnimator final : public KeyframeAnimator {
+public:
+    using SpatialValue = Vec2KeyframeData::SpatialValue;
+
+    Vec2KeyframeAnimator(sk_sp<const Vec2KeyframeData> data,
+                         Vec2Value* vec_target, float* rot_target)
+        : INHERITED(data)
+        , fValues(data->fValues)
         , fVecTarget(vec_target)
         , fRotTarget(rot_target) {}
 
@@ -63,10 +69,8 @@ private:
         return changed;
     }
 
-    StateChanged onSeek(float t) override {
-        auto get_lerp_info = [this](float t) {
-            auto lerp_info = this->getLERPInfo(t);
-
+    StateChanged onApply(const LERPInfo& info) override {
+        auto get_lerp_info = [this](LERPInfo lerp_info) {
             // When tracking rotation/orientation, the last keyframe requires special handling:
             // it doesn't store any spatial information but it is expected to maintain the
             // previous orientation (per AE semantics).
@@ -90,7 +94,7 @@ private:
             return lerp_info;
         };
 
-        const auto lerp_info = get_lerp_info(t);
+        const auto lerp_info = get_lerp_info(info);
 
         const auto& v0 = fValues[lerp_info.vrec0.idx];
         if (v0.cmeasure) {
@@ -120,9 +124,9 @@ private:
         return this->update(Lerp(v0.v2, v1.v2, lerp_info.weight), tan);
     }
 
-    const std::vector<Vec2KeyframeAnimator::SpatialValue> fValues;
-    Vec2Value*                      fVecTarget;
-    float*                          fRotTarget;
+    const std::vector<SpatialValue>& fValues;
+    Vec2Value*                       fVecTarget;
+    float*                           fRotTarget;
 
     using INHERITED = KeyframeAnimator;
 };
@@ -161,18 +165,24 @@ class Vec2AnimatorBuilder final : public AnimatorBuilder {
                                      const skjson::ArrayValue& jkfs) override {
             SkASSERT(jkfs.size() > 0);
 
-            fValues.reserve(jkfs.size());
-            if (!this->parseKeyframes(abuilder, jkfs)) {
-                return nullptr;
+            auto* shared = abuilder.sharedInstanceData();
+            auto data = shared ? shared->find<Vec2KeyframeData>(jkfs) : nullptr;
+            if (!data) {
+                fValues.reserve(jkfs.size());
+                if (!this->parseKeyframes(abuilder, jkfs)) {
+                    return nullptr;
+                }
+                fValues.shrink_to_fit();
+
+                data = this->finishKeyframeData(sk_make_sp<Vec2KeyframeData>());
+                data->fValues = std::move(fValues);
+                if (shared) {
+                    shared->set(jkfs, data);
+                }
             }
-            fValues.shrink_to_fit();
 
             return sk_sp<Vec2KeyframeAnimator>(
-                        new Vec2KeyframeAnimator(std::move(fKFs),
-                                                 std::move(fCMs),
-                                                 std::move(fValues),
-                                                 fVecTarget,
-                                                 fRotTarget));
+                        new Vec2KeyframeAnimator(std::move(data), fVecTarget, fRotTarget));
         }
 
         sk_sp<Animator> makeFromExpression(ExpressionManager& em, const char* expr) override {
@@ -186,7 +196,7 @@ class Vec2AnimatorBuilder final : public AnimatorBuilder {
         }
 
     private:
-        void backfill_spatial(const Vec2KeyframeAnimator::SpatialValue& val) {
+        void backfill_spatial(const Vec2KeyframeData::SpatialValue& val) {
             SkASSERT(!fValues.empty());
             auto& prev_val = fValues.back();
             SkASSERT(!prev_val.cmeasure);
@@ -232,7 +242,7 @@ class Vec2AnimatorBuilder final : public AnimatorBuilder {
                           const skjson::ObjectValue& jkf,
                           const skjson::Value& jv,
                           Keyframe::Value* v) override {
-            Vec2KeyframeAnimator::SpatialValue val;
+            Vec2KeyframeData::SpatialValue val;
             if (!::skottie::Parse(jv, &val.v2)) {
                 return false;
             }
@@ -255,7 +265,7 @@ class Vec2AnimatorBuilder final : public AnimatorBuilder {
             return true;
         }
 
-        std::vector<Vec2KeyframeAnimator::SpatialValue> fValues;
+        std::vector<Vec2KeyframeData::SpatialValue> fValues;
         Vec2Value*                fVecTarget; // required
         float*                    fRotTarget; // optional
         SkV2                      fTi{0,0},
@@ -83,16 +83,18 @@ namespace {
 //           ^               ^                    ^
 // fKFs[]: .idx            .idx       ...       .idx
 //
+struct VectorKeyframeData final : public KeyframeData {
+    std::vector<float> fStorage;
+    size_t             fVecLen;
+};
+
 class VectorKeyframeAnimator final : public KeyframeAnimator {
 public:
-    VectorKeyframeAnimator(std::vector<Keyframe> kfs,
-                           std::vector<SkCubicMap> cms,
-                           std::vector<float> storage,
-                           size_t vec_len,
+    VectorKeyframeAnimator(sk_sp<const VectorKeyframeData> data,
                            std::vector<float>* target_value)
-        : INHERITED(std::move(kfs), std::move(cms))
-        , fStorage(std::move(storage))
-        , fVecLen(vec_len)
+        : INHERITED(data)
+        , fStorage(data->fStorage)
+        , fVecLen(data->fVecLen)
         , fTarget(target_value) {
 
         // Resize the target value appropriately.
@@ -100,9 +102,7 @@ public:
     }
 
 private:
-    StateChanged onSeek(float t) override {
-        const auto& lerp_info = this->getLERPInfo(t);
-
+    StateChanged onApply(const LERPInfo& lerp_info) override {
         SkASSERT(lerp_info.vrec0.idx + fVecLen <= fStorage.size());
         SkASSERT(lerp_info.vrec1.idx + fVecLen <= fStorage.size());
         SkASSERT(fTarget->size() == fVecLen);
@@ -149,10 +149,10 @@ private:
         return changed;
     }
 
-    const std::vector<float> fStorage;
-    const size_t             fVecLen;
+    const std::vector<float>& fStorage;
+    const size_t              fVecLen;
 
-    std::vector<float>*      fTarget;
+    std::vector<float>*       fTarget;
 
     using INHERITED = KeyframeAnimator;
 };
@@ -198,6 +198,13 @@ sk_sp<KeyframeAnimator> VectorAnimatorBuilder::makeFromKeyframes(const Animation
                                                             const skjson::ArrayValue& jkfs) {
     SkASSERT(jkfs.size() > 0);
 
+    // The same keyframes may be parsed as different kinds of vectors.
+    auto* shared = abuilder.sharedInstanceData();
+    const auto variant = reinterpret_cast<uintptr_t>(fParseData);
+    if (auto data = shared ? shared->find<VectorKeyframeData>(jkfs, variant) : nullptr) {
+        return sk_sp<VectorKeyframeAnimator>(new VectorKeyframeAnimator(std::move(data), fTarget));
+    }
+
     // peek at the first keyframe value to find our vector length
     const skjson::ObjectValue* jkf0 = jkfs[0];
     if (!jkf0 || !fParseLen((*jkf0)["s"], &fVecLen)) {
@@ -223,12 +230,14 @@ sk_sp<KeyframeAnimator> VectorAnimatorBuilder::makeFromKeyframes(const Animation
     fStorage.resize(fCurrentVec * fVecLen);
     fStorage.shrink_to_fit();
 
-    return sk_sp<VectorKeyframeAnimator>(
-                new VectorKeyframeAnimator(std::move(fKFs),
-                                           std::move(fCMs),
-                                           std::move(fStorage),
-                                           fVecLen,
-                                           fTarget));
+    auto data = this->finishKeyframeData(sk_make_sp<VectorKeyframeData>());
+    data->fStorage = std::move(fStorage);
+    data->fVecLen  = fVecLen;
+    if (shared) {
+        shared->set(jkfs, data, variant);
+    }
+
+    return sk_sp<VectorKeyframeAnimator>(new VectorKeyframeAnimator(std::move(data), fTarget));
 }
 
 sk_sp<Animator> VectorAnimatorBuilder::makeFromExpression(ExpressionManager& em, const char* expr) {
@@ -338,12 +338,35 @@ bool AnimationBuilder::resolveEmbeddedTypefaces(const skjson::ArrayValue& jchars
 
 sk_sp<sksg::RenderNode> AnimationBuilder::attachTextLayer(const skjson::ObjectValue& jlayer,
                                                           LayerInfo*) const {
-    return this->attachDiscardableAdapter<TextAdapter>(jlayer,
-                                                       this,
-                                                       fFontMgr,
-                                                       fCustomGlyphMapper,
-                                                       fLogger,
-                                                       fShapingFactory);
+    if (!fTextShapingExecutor) {
+        return this->attachDiscardableAdapter<TextAdapter>(jlayer,
+                                                           this,
+                                                           fFontMgr,
+                                                           fCustomGlyphMapper,
+                                                           fLogger,
+                                                           fShapingFactory);
+    }
+
+    auto adapter = TextAdapter::Make(jlayer,
+                                     this,
+                                     fFontMgr,
+                                     fCustomGlyphMapper,
+                                     fLogger,
+                                     fShapingFactory);
+    if (!adapter) {
+        return nullptr;
+    }
+
+    // The text is shaped once the whole scene is built, along with all other text layers
+    // (see shapeDeferredText()).  Static adapters are only synced then.
+    auto node = adapter->node();
+    const auto is_static = adapter->isStatic();
+    if (!is_static) {
+        fCurrentAnimatorScope->push_back(adapter);
+    }
+    fDeferredTextAdapters.push_back({std::move(adapter), is_static});
+
+    return node;
 }
 
 const AnimationBuilder::FontInfo* AnimationBuilder::findFont(const SkString& font_name) const {
@@ -40,6 +40,7 @@
 #include "modules/sksg/include/SkSGTransform.h"
 #include "modules/sksg/src/SkSGTransformPriv.h"
 #include "modules/skshaper/include/SkShaper_factory.h"
+#include "src/core/SkChecksum.h"
 #include "src/utils/SkJSON.h"
 
 #include <algorithm>
@@ -366,7 +367,8 @@ sk_sp<TextAdapter> TextAdapter::Make(const skjson::ObjectValue& jlayer,
                                                       std::move(factory),
                                                       gGroupingMap[SkToSizeT(apg - 1)]));
 
-    adapter->bind(*abuilder, jd, adapter->fText.fCurrentValue);
+    std::vector<TextValue> keyframe_values;
+    adapter->bindTextDocuments(*abuilder, jd, &adapter->fText.fCurrentValue, &keyframe_values);
     if (jm) {
         adapter->bind(*abuilder, (*jm)["a"], adapter->fGroupingAlignment);
     }
@@ -426,6 +428,25 @@ sk_sp<TextAdapter> TextAdapter::Make(const skjson::ObjectValue& jlayer,
     };
 
     adapter->fPathInfo = attach_path((*jt)["p"]);
+
+    // Without a shaping executor, text is shaped on demand, as it changes.  The instances of an
+    // animation share the documents shaped for each layer.
+    auto* shared = abuilder->sharedInstanceData();
+    if (abuilder->shapesTextAheadOfTime() || shared) {
+        adapter->fShapingCache = shared ? shared->find<ShapingCache>(jlayer) : nullptr;
+        if (!adapter->fShapingCache) {
+            adapter->fShapingCache = sk_make_sp<ShapingCache>();
+            adapter->cacheDocument(adapter->fText.fCurrentValue);
+            for (const auto& txt : keyframe_values) {
+                adapter->cacheDocument(txt);
+            }
+            adapter->fShapingCache->fDocuments.shrink_to_fit();
+            if (shared) {
+                shared->set(jlayer, adapter->fShapingCache);
+            }
+        }
+    }
+
     abuilder->dispatchTextProperty(adapter, jd);
 
     return adapter;
@@ -642,7 +663,80 @@ void TextAdapter::setText(const TextValue& txt) {
     this->onSync();
 }
 
-uint32_t TextAdapter::shaperFlags() const {
+namespace {
+
+uint32_t hash_text(const TextValue& txt) {
+    return SkChecksum::Hash32(txt.fText.c_str(), txt.fText.size());
+}
+
+// True if the two documents shape identically: paint properties (colors, stroke width, etc)
+// only apply to the shaped glyphs.
+bool same_shaping(const TextValue& a, const TextValue& b) {
+    return a.fTypeface       == b.fTypeface
+        && a.fText           == b.fText
+        && a.fTextSize       == b.fTextSize
+        && a.fMinTextSize    == b.fMinTextSize
+        && a.fMaxTextSize    == b.fMaxTextSize
+        && a.fLineHeight     == b.fLineHeight
+        && a.fLineShift      == b.fLineShift
+        && a.fAscent         == b.fAscent
+        && a.fMaxLines       == b.fMaxLines
+        && a.fHAlign         == b.fHAlign
+        && a.fVAlign         == b.fVAlign
+        && a.fResize         == b.fResize
+        && a.fLineBreak      == b.fLineBreak
+        && a.fDirection      == b.fDirection
+        && a.fCapitalization == b.fCapitalization
+        && a.fBox            == b.fBox
+        && !a.fDecorator     == !b.fDecorator
+        && a.fLocale         == b.fLocale
+        && a.fFontFamily     == b.fFontFamily;
+}
+
+} // namespace
+
+void TextAdapter::cacheDocument(const TextValue& txt) {
+    // Documents with no fill and no stroke are never shaped.  Past kMaxCachedDocuments (e.g.
+    // for a counter animated over many keyframes), documents are shaped on demand.
+    if ((!txt.fHasFill && !txt.fHasStroke) ||
+        fShapingCache->fDocuments.size() >= kMaxCachedDocuments ||
+        this->findCachedDocument(txt)) {
+        return;
+    }
+
+    auto doc = std::make_unique<ShapedDocument>();
+    doc->fText     = txt;
+    doc->fTextHash = hash_text(txt);
+    fShapingCache->fDocuments.push_back(std::move(doc));
+}
+
+TextAdapter::ShapedDocument* TextAdapter::findCachedDocument(const TextValue& txt) const {
+    if (!fShapingCache) {
+        return nullptr;
+    }
+
+    const auto hash = hash_text(txt);
+    for (const auto& doc : fShapingCache->fDocuments) {
+        if (doc->fTextHash == hash && same_shaping(doc->fText, txt)) {
+            return doc.get();
+        }
+    }
+
+    return nullptr;
+}
+
+const Shaper::Result& TextAdapter::shapeDocument(ShapedDocument* doc) const {
+    // The adapters sharing the document shape it the same way, and any of them can get there
+    // first.
+    doc->fShapeOnce([&] { doc->fResult = this->shape(doc->fText); });
+    return doc->fResult;
+}
+
+void TextAdapter::preshape(size_t index) {
+    this->shapeDocument(fShapingCache->fDocuments[index].get());
+}
+
+uint32_t TextAdapter::shaperFlags(const TextValue& txt) const {
     uint32_t flags = Shaper::Flags::kNone;
 
     // We need granular fragments (as opposed to consolidated blobs):
@@ -650,47 +744,57 @@ uint32_t TextAdapter::shaperFlags() const {
     //   - when positioning on a path
     //   - when clamping the number or lines (for accurate line count)
     //   - when a text decorator is present
-    if (!fAnimators.empty() || fPathInfo || fText->fMaxLines || fText->fDecorator) {
+    if (!fAnimators.empty() || fPathInfo || txt.fMaxLines || txt.fDecorator) {
         flags |= Shaper::Flags::kFragmentGlyphs;
     }
 
-    if (fRequiresAnchorPoint || fText->fDecorator) {
+    if (fRequiresAnchorPoint || txt.fDecorator) {
         flags |= Shaper::Flags::kTrackFragmentAdvanceAscent;
     }
 
-    if (fText->fDecorator) {
+    if (txt.fDecorator) {
         flags |= Shaper::Flags::kClusters;
     }
 
     return flags;
 }
 
-void TextAdapter::reshape() {
+Shaper::Result TextAdapter::shape(const TextValue& txt) const {
     // AE clamps the font size to a reasonable range.
     // We do the same, since HB is susceptible to int overflows for degenerate values.
     static constexpr float kMinSize =    0.1f,
                            kMaxSize = 1296.0f;
     const Shaper::TextDesc text_desc = {
-        fText->fTypeface,
-        SkTPin(fText->fTextSize,    kMinSize, kMaxSize),
-        SkTPin(fText->fMinTextSize, kMinSize, kMaxSize),
-        SkTPin(fText->fMaxTextSize, kMinSize, kMaxSize),
-        fText->fLineHeight,
-        fText->fLineShift,
-        fText->fAscent,
-        fText->fHAlign,
-        fText->fVAlign,
-        fText->fResize,
-        fText->fLineBreak,
-        fText->fDirection,
-        fText->fCapitalization,
-        fText->fMaxLines,
-        this->shaperFlags(),
-        fText->fLocale.isEmpty()     ? nullptr : fText->fLocale.c_str(),
-        fText->fFontFamily.isEmpty() ? nullptr : fText->fFontFamily.c_str(),
+        txt.fTypeface,
+        SkTPin(txt.fTextSize,    kMinSize, kMaxSize),
+        SkTPin(txt.fMinTextSize, kMinSize, kMaxSize),
+        SkTPin(txt.fMaxTextSize, kMinSize, kMaxSize),
+        txt.fLineHeight,
+        txt.fLineShift,
+        txt.fAscent,
+        txt.fHAlign,
+        txt.fVAlign,
+        txt.fResize,
+        txt.fLineBreak,
+        txt.fDirection,
+        txt.fCapitalization,
+        txt.fMaxLines,
+        this->shaperFlags(txt),
+        txt.fLocale.isEmpty()     ? nullptr : txt.fLocale.c_str(),
+        txt.fFontFamily.isEmpty() ? nullptr : txt.fFontFamily.c_str(),
     };
-    auto shape_result = Shaper::Shape(fText->fText, text_desc, fText->fBox, fFontMgr,
-        fShapingFactory);
+
+    return Shaper::Shape(txt.fText, text_desc, txt.fBox, fFontMgr, fShapingFactory);
+}
+
+void TextAdapter::reshape() {
+    Shaper::Result shape_result;
+    if (auto* doc = this->findCachedDocument(fText.fCurrentValue)) {
+        // N.B. the fragment glyphs are consumed below, so the cached result is copied.
+        shape_result = this->shapeDocument(doc);
+    } else {
+        shape_result = this->shape(fText.fCurrentValue);
+    }
 
     if (fLogger) {
         if (shape_result.fFragments.empty() && fText->fText.size() > 0) {
@@ -11,6 +11,7 @@
 #include "include/core/SkM44.h"
 #include "include/core/SkPoint.h"
 #include "include/core/SkRefCnt.h"
+#include "include/private/base/SkOnce.h"
 #include "modules/skottie/include/TextShaper.h"
 #include "modules/skottie/src/SkottieValue.h"
 #include "modules/skottie/src/animator/Animator.h"
@@ -60,6 +61,19 @@ public:
     const TextValue& getText() const { return fText.fCurrentValue; }
     void setText(const TextValue&);
 
+    // When text is shaped ahead of time, or when building several instances of an animation, the
+    // first kMaxCachedDocuments text documents bound at build time (the initial and keyframe
+    // values) are shaped at most once: their shaping results are cached, and reused whenever the
+    // text changes back to an equivalent document.  The instances share the cache of each layer.
+    static constexpr size_t kMaxCachedDocuments = 64;
+    size_t shapingCacheSize() const {
+        return fShapingCache ? fShapingCache->fDocuments.size() : 0;
+    }
+
+    // Shapes a cached document ahead of its first use.  Documents can be shaped concurrently, and
+    // each is shaped once.
+    void preshape(size_t index);
+
 protected:
     void onSync() override;
 
@@ -92,7 +106,22 @@ private:
                                      fAscent;  // ^
     };
 
+    struct ShapedDocument {
+        TextValue      fText;
+        uint32_t       fTextHash;
+        Shaper::Result fResult;
+        SkOnce         fShapeOnce;
+    };
+
+    struct ShapingCache final : public SkRefCnt {
+        std::vector<std::unique_ptr<ShapedDocument>> fDocuments;
+    };
+
     void reshape();
+    Shaper::Result shape(const TextValue&) const;
+    void cacheDocument(const TextValue&);
+    ShapedDocument* findCachedDocument(const TextValue&) const;
+    const Shaper::Result& shapeDocument(ShapedDocument*) const;
     void addFragment(Shaper::Fragment&, sksg::Group* container);
     void buildDomainMaps(const Shaper::Result&);
     std::vector<sk_sp<sksg::RenderNode>> buildGlyphCompNodes(Shaper::ShapedGlyphs&) const;
@@ -103,7 +132,7 @@ private:
 
     SkV2 fragmentAnchorPoint(const FragmentRec&, const SkV2&,
                              const TextAnimator::DomainSpan*) const;
-    uint32_t shaperFlags() const;
+    uint32_t shaperFlags(const TextValue&) const;
 
     SkM44 fragmentMatrix(const TextAnimator::ResolvedProps&, const FragmentRec&, const SkV2&) const;
 
@@ -117,6 +146,7 @@ private:
     std::vector<sk_sp<TextAnimator>>         fAnimators;
     std::vector<FragmentRec>                 fFragments;
     TextAnimator::DomainMaps                 fMaps;
+    sk_sp<ShapingCache>                      fShapingCache;
 
     // Helps detect external value changes.
     struct TextValueTracker {
@@ -5,6 +5,7 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkString.h"
 #include "modules/skottie/include/ExternalLayer.h"
 #include "modules/skottie/src/SkottiePriv.h"
 #include "modules/skottie/src/SkottieValue.h"
@@ -13,6 +14,7 @@
 #include "tests/Test.h"
 
 #include <cmath>
+#include <iterator>
 
 using namespace skottie;
 using namespace skottie::internal;
@@ -225,3 +227,52 @@ DEF_TEST(Skottie_Keyframe, reporter) {
         REPORTER_ASSERT(reporter, prop(1.0001f) < 400);
     }
 }
+
+DEF_TEST(Skottie_KeyframeBatch, reporter) {
+    // Properties seeked together, which are evaluated four at a time: property i ramps from 0
+    // to 10 over [i .. i + 1], holds 10 until i + 2, then 20.
+    class MockProperties final : public AnimatablePropertyContainer {
+    public:
+        MockProperties() {
+            AnimationBuilder abuilder(nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+                                      nullptr, nullptr, nullptr,
+                                      {100, 100}, 10, 1, 0);
+            for (size_t i = 0; i < std::size(fValues); ++i) {
+                const auto jprop = SkStringPrintf(R"({
+                                                    "a": 1,
+                                                    "k": [
+                                                      { "t": %zu, "s": 0 },
+                                                      { "t": %zu, "s": 10, "h": true },
+                                                      { "t": %zu, "s": 20 }
+                                                    ]
+                                                  })", i, i + 1, i + 2);
+                skjson::DOM json_dom(jprop.c_str(), jprop.size());
+                fDidBind &= this->bind(abuilder, json_dom.root(), &fValues[i]);
+            }
+        }
+
+        bool fDidBind = true;
+        ScalarValue fValues[6] = {};
+
+    private:
+        void onSync() override {}
+    };
+
+    MockProperties props;
+    REPORTER_ASSERT(reporter, props.fDidBind);
+
+    auto expected = [](size_t i, float t) {
+        t -= i;
+        return t <= 0 ? 0.f : t < 1 ? t * 10 : t < 2 ? 10.f : 20.f;
+    };
+
+    // Sequential playback, then seeks back and forth.
+    for (float t : {-1.f, 0.f, 0.25f, 0.5f, 1.f, 1.5f, 2.f, 2.75f, 3.f, 4.5f, 5.f, 6.f, 9.f,
+                    5.25f, 0.f, 3.5f, 1.f, 8.f, 2.25f}) {
+        props.seek(t);
+        for (size_t i = 0; i < std::size(props.fValues); ++i) {
+            REPORTER_ASSERT(reporter, SkScalarNearlyEqual(props.fValues[i], expected(i, t)),
+                            "t: %g, property: %zu, value: %g", t, i, props.fValues[i]);
+        }
+    }
+}
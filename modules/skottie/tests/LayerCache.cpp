@@ -0,0 +1,231 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkColorSpace.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkSamplingOptions.h"
+#include "include/core/SkScalar.h"
+#include "modules/skottie/include/Skottie.h"
+#include "modules/sksg/include/SkSGCacheEffect.h"
+#include "tests/Test.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+
+using namespace skottie;
+
+namespace {
+
+// A static precomp (overlapping shapes), translated by whole pixels at t == 3 and scaled down at
+// t == 6, over a static shape layer.
+static constexpr char kJson[] = R"({
+                                  "v": "5.2.1",
+                                  "w": 100,
+                                  "h": 100,
+                                  "fr": 10,
+                                  "ip": 0,
+                                  "op": 10,
+                                  "assets": [
+                                    {
+                                      "id": "static_comp",
+                                      "layers": [
+                                        {
+                                          "ty": 4,
+                                          "ip": 0,
+                                          "op": 10,
+                                          "shapes": [
+                                            { "ty": "el", "s": { "a": 0, "k": [40, 40] },
+                                                          "p": { "a": 0, "k": [50, 50] } },
+                                            { "ty": "fl", "c": { "a": 0, "k": [0, 1, 0, 1] },
+                                                          "o": { "a": 0, "k": 50 } }
+                                          ]
+                                        },
+                                        {
+                                          "ty": 4,
+                                          "ip": 0,
+                                          "op": 10,
+                                          "shapes": [
+                                            { "ty": "rc", "s": { "a": 0, "k": [40, 40] },
+                                                          "p": { "a": 0, "k": [30.5, 30.5] },
+                                                          "r": { "a": 0, "k": 0 } },
+                                            { "ty": "fl", "c": { "a": 0, "k": [1, 0, 0, 1] },
+                                                          "o": { "a": 0, "k": 100 } }
+                                          ]
+                                        }
+                                      ]
+                                    }
+                                  ],
+                                  "layers": [
+                                    {
+                                      "ty": 0,
+                                      "refId": "static_comp",
+                                      "w": 100,
+                                      "h": 100,
+                                      "ip": 0,
+                                      "op": 10,
+                                      "ks": {
+                                        "o": { "a": 0, "k": 60 },
+                                        "p": { "a": 1, "k": [
+                                          { "t": 0, "s": [0, 0], "h": 1 },
+                                          { "t": 3, "s": [10, 5], "h": 1 }
+                                        ]},
+                                        "s": { "a": 1, "k": [
+                                          { "t": 0, "s": [100, 100], "h": 1 },
+                                          { "t": 6, "s": [50, 50], "h": 1 }
+                                        ]}
+                                      }
+                                    },
+                                    {
+                                      "ty": 4,
+                                      "ip": 0,
+                                      "op": 10,
+                                      "shapes": [
+                                        { "ty": "rc", "s": { "a": 0, "k": [90, 20] },
+                                                      "p": { "a": 0, "k": [50, 80] },
+                                                      "r": { "a": 0, "k": 5 } },
+                                        { "ty": "fl", "c": { "a": 0, "k": [0, 0, 1, 1] },
+                                                      "o": { "a": 0, "k": 100 } }
+                                      ]
+                                    }
+                                  ]
+                                })";
+
+class DrawImageCountingCanvas final : public SkCanvas {
+public:
+    explicit DrawImageCountingCanvas(const SkBitmap& bitmap) : SkCanvas(bitmap) {}
+
+    int count() const { return fCount; }
+    // Whether all the images drawn had the color type and color space of the canvas.
+    bool imagesMatchCanvas() const { return fImagesMatchCanvas; }
+
+private:
+    void onDrawImage2(const SkImage* image, SkScalar x, SkScalar y,
+                      const SkSamplingOptions& sampling, const SkPaint* paint) override {
+        fCount++;
+        fImagesMatchCanvas &= image->imageInfo().colorInfo().makeAlphaType(kPremul_SkAlphaType) ==
+                              this->imageInfo().colorInfo().makeAlphaType(kPremul_SkAlphaType);
+        this->SkCanvas::onDrawImage2(image, x, y, sampling, paint);
+    }
+
+    int  fCount = 0;
+    bool fImagesMatchCanvas = true;
+};
+
+bool colors_match(SkColor a, SkColor b) {
+    // Cached content is blended as a group, which may round differently.
+    static constexpr int kTolerance = 2;
+    return std::abs((int)SkColorGetA(a) - (int)SkColorGetA(b)) <= kTolerance &&
+           std::abs((int)SkColorGetR(a) - (int)SkColorGetR(b)) <= kTolerance &&
+           std::abs((int)SkColorGetG(a) - (int)SkColorGetG(b)) <= kTolerance &&
+           std::abs((int)SkColorGetB(a) - (int)SkColorGetB(b)) <= kTolerance;
+}
+
+} // namespace
+
+DEF_TEST(Skottie_CacheStaticLayers, r) {
+    auto reference = Animation::Make(kJson, strlen(kJson));
+    auto cached = Animation::Builder(Animation::Builder::kCacheStaticLayers)
+                          .make(kJson, strlen(kJson));
+    REPORTER_ASSERT(r, reference && cached);
+
+    const auto info = SkImageInfo::MakeN32Premul(100, 100);
+    SkBitmap expected, actual;
+    expected.allocPixels(info);
+    actual.allocPixels(info);
+
+    SkCanvas expected_canvas(expected);
+    DrawImageCountingCanvas actual_canvas(actual);
+
+    static constexpr double kFrames[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 0, 1};
+    for (size_t i = 0; i < std::size(kFrames); ++i) {
+        const auto t = kFrames[i];
+        reference->seekFrame(t);
+        cached->seekFrame(t);
+
+        expected.eraseColor(SK_ColorWHITE);
+        actual.eraseColor(SK_ColorWHITE);
+        reference->render(&expected_canvas);
+        cached->render(&actual_canvas);
+
+        bool match = true;
+        for (int y = 0; y < info.height() && match; ++y) {
+            for (int x = 0; x < info.width() && match; ++x) {
+                match = colors_match(expected.getColor(x, y), actual.getColor(x, y));
+            }
+        }
+        REPORTER_ASSERT(r, match, "frame %g", t);
+
+        // Static content renders directly the first time, and from the cache from then on.
+        if (i == 0) {
+            REPORTER_ASSERT(r, actual_canvas.count() == 0);
+        } else if (i == 1) {
+            REPORTER_ASSERT(r, actual_canvas.count() > 0);
+        }
+    }
+}
+
+DEF_TEST(Skottie_CacheStaticLayers_Destination, r) {
+    auto cached = Animation::Builder(Animation::Builder::kCacheStaticLayers)
+                          .make(kJson, strlen(kJson));
+    REPORTER_ASSERT(r, cached);
+    cached->seekFrame(0);
+
+    SkBitmap n32, f16;
+    n32.allocPixels(SkImageInfo::MakeN32Premul(100, 100));
+    f16.allocPixels(SkImageInfo::Make(100, 100, kRGBA_F16_SkColorType, kPremul_SkAlphaType,
+                                      SkColorSpace::MakeSRGBLinear()));
+    DrawImageCountingCanvas n32_canvas(n32),
+                            f16_canvas(f16);
+
+    // The image cached for one destination is not drawn into another.
+    for (int i = 0; i < 3; ++i) {
+        cached->render(&n32_canvas);
+    }
+    REPORTER_ASSERT(r, n32_canvas.count() > 0);
+    for (int i = 0; i < 3; ++i) {
+        cached->render(&f16_canvas);
+    }
+    REPORTER_ASSERT(r, n32_canvas.imagesMatchCanvas());
+    REPORTER_ASSERT(r, f16_canvas.imagesMatchCanvas());
+}
+
+// Serial, as it changes the cache limit shared by all animations.
+DEF_SERIAL_TEST(Skottie_CacheStaticLayers_Limit, r) {
+    const auto limit = sksg::CacheEffect::SetCacheLimit(0);
+
+    {
+        auto cached = Animation::Builder(Animation::Builder::kCacheStaticLayers)
+                              .make(kJson, strlen(kJson));
+        REPORTER_ASSERT(r, cached);
+        cached->seekFrame(0);
+
+        SkBitmap bitmap;
+        bitmap.allocPixels(SkImageInfo::MakeN32Premul(100, 100));
+        DrawImageCountingCanvas canvas(bitmap);
+
+        // Nothing fits in the cache, so the content is always rendered directly.
+        for (int i = 0; i < 3; ++i) {
+            cached->render(&canvas);
+        }
+        REPORTER_ASSERT(r, canvas.count() == 0);
+
+        sksg::CacheEffect::SetCacheLimit(limit);
+        for (int i = 0; i < 3; ++i) {
+            cached->render(&canvas);
+        }
+        REPORTER_ASSERT(r, canvas.count() > 0);
+        REPORTER_ASSERT(r, sksg::CacheEffect::GetCacheUsed() > 0);
+    }
+
+    // Destroying the animation releases its images.
+    REPORTER_ASSERT(r, sksg::CacheEffect::GetCacheUsed() == 0);
+}
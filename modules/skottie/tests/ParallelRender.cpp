@@ -0,0 +1,121 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkSurface.h"
+#include "modules/skottie/include/Skottie.h"
+#include "modules/skottie/utils/SkottieUtils.h"
+#include "tests/Test.h"
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+using namespace skottie;
+
+namespace {
+
+// A solid layer fading in over 10 frames.
+static constexpr char kJson[] = R"({
+                                  "v": "5.2.1",
+                                  "w": 16,
+                                  "h": 16,
+                                  "fr": 10,
+                                  "ip": 0,
+                                  "op": 10,
+                                  "layers": [
+                                    {
+                                      "ty": 1,
+                                      "ip": 0,
+                                      "op": 10,
+                                      "ks": {
+                                        "o": { "a": 1, "k": [
+                                          { "t": 0, "s": [0] },
+                                          { "t": 9, "s": [100] }
+                                        ]}
+                                      },
+                                      "sw": 16,
+                                      "sh": 16,
+                                      "sc": "#ff0000"
+                                    }
+                                  ]
+                                })";
+
+static constexpr int kFrameCount = 10;
+
+} // namespace
+
+DEF_TEST(Skottie_MakeInstances, r) {
+    Animation::Builder builder;
+    auto instances = builder.makeInstances(kJson, strlen(kJson), 3);
+    REPORTER_ASSERT(r, instances.size() == 3);
+    for (const auto& instance : instances) {
+        REPORTER_ASSERT(r, instance);
+    }
+    REPORTER_ASSERT(r, instances[0] != instances[1] && instances[1] != instances[2]);
+
+    // The stats describe one instance, not the sum of them.
+    Animation::Builder singleBuilder;
+    REPORTER_ASSERT(r, singleBuilder.make(kJson, strlen(kJson)));
+    REPORTER_ASSERT(r, builder.getStats().fAnimatorCount > 0);
+    REPORTER_ASSERT(r, builder.getStats().fAnimatorCount ==
+                       singleBuilder.getStats().fAnimatorCount);
+
+    // Seeking one instance does not affect the others.
+    auto render = [](Animation* animation) {
+        auto surface = SkSurfaces::Raster(SkImageInfo::MakeN32Premul(16, 16));
+        animation->render(surface->getCanvas());
+        return surface->makeImageSnapshot();
+    };
+    instances[0]->seekFrame(0);
+    instances[1]->seekFrame(9);
+    SkBitmap bm0, bm1;
+    REPORTER_ASSERT(r, render(instances[0].get())->asLegacyBitmap(&bm0));
+    REPORTER_ASSERT(r, render(instances[1].get())->asLegacyBitmap(&bm1));
+    REPORTER_ASSERT(r, SkColorGetA(bm0.getColor(8, 8)) == 0);
+    REPORTER_ASSERT(r, SkColorGetA(bm1.getColor(8, 8)) == 0xff);
+
+    static constexpr char kBadJson[] = "{}";
+    REPORTER_ASSERT(r, Animation::Builder().makeInstances(kBadJson, strlen(kBadJson), 3).empty());
+}
+
+DEF_TEST(Skottie_ParallelFrameRenderer, r) {
+    // Reference frames, rendered sequentially by a single animation.
+    auto animation = Animation::Make(kJson, strlen(kJson));
+    REPORTER_ASSERT(r, animation);
+    std::vector<SkColor> expected;
+    for (int i = 0; i < kFrameCount; ++i) {
+        auto surface = SkSurfaces::Raster(SkImageInfo::MakeN32Premul(16, 16));
+        animation->seekFrame(i);
+        animation->render(surface->getCanvas());
+        SkBitmap bm;
+        REPORTER_ASSERT(r, surface->makeImageSnapshot()->asLegacyBitmap(&bm));
+        expected.push_back(bm.getColor(8, 8));
+    }
+
+    auto executor = SkExecutor::MakeFIFOThreadPool(4);
+    for (SkExecutor* e : {static_cast<SkExecutor*>(nullptr), executor.get()}) {
+        skottie_utils::ParallelFrameRenderer renderer(
+                Animation::Builder().makeInstances(kJson, strlen(kJson), 3), e);
+
+        int next = 0;
+        renderer.renderFrames(0, 1, kFrameCount,
+            [](int) { return SkSurfaces::Raster(SkImageInfo::MakeN32Premul(16, 16)); },
+            [&](int index, sk_sp<SkSurface> surface) {
+                REPORTER_ASSERT(r, index == next++);
+                REPORTER_ASSERT(r, surface);
+                SkBitmap bm;
+                REPORTER_ASSERT(r, surface->makeImageSnapshot()->asLegacyBitmap(&bm));
+                REPORTER_ASSERT(r, bm.getColor(8, 8) == expected[index]);
+            });
+        REPORTER_ASSERT(r, next == kFrameCount);
+    }
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkRegion.h"
+#include "include/core/SkSurface.h"
+#include "modules/skottie/include/Skottie.h"
+#include "modules/skottie/utils/SkottieUtils.h"
+#include "tests/Test.h"
+
+#include <cstring>
+
+using namespace skottie;
+
+namespace {
+
+// A small square moving over a static background.
+static constexpr char kJson[] = R"({
+                                  "v": "5.2.1",
+                                  "w": 64,
+                                  "h": 64,
+                                  "fr": 10,
+                                  "ip": 0,
+                                  "op": 10,
+                                  "layers": [
+                                    {
+                                      "ty": 1,
+                                      "ip": 0,
+                                      "op": 10,
+                                      "ks": {
+                                        "p": { "a": 1, "k": [
+                                          { "t": 0, "s": [0, 4] },
+                                          { "t": 9, "s": [54, 4] }
+                                        ]}
+                                      },
+                                      "sw": 10,
+                                      "sh": 10,
+                                      "sc": "#ff0000"
+                                    },
+                                    {
+                                      "ty": 1,
+                                      "ip": 0,
+                                      "op": 10,
+                                      "sw": 64,
+                                      "sh": 64,
+                                      "sc": "#0000ff"
+                                    }
+                                  ]
+                                })";
+
+static constexpr int kSize = 128;
+
+SkBitmap snapshot(SkSurface* surface) {
+    SkBitmap bm;
+    bm.allocPixels(surface->imageInfo());
+    SkAssertResult(surface->readPixels(bm, 0, 0));
+    return bm;
+}
+
+bool equal(const SkBitmap& a, const SkBitmap& b) {
+    for (int y = 0; y < a.height(); ++y) {
+        if (memcmp(a.getAddr32(0, y), b.getAddr32(0, y), a.width() * sizeof(uint32_t))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+DEF_TEST(Skottie_PartialFrameRenderer, r) {
+    auto reference = Animation::Make(kJson, strlen(kJson));
+    REPORTER_ASSERT(r, reference);
+    const auto info = SkImageInfo::MakeN32Premul(kSize, kSize);
+    auto referenceSurface = SkSurfaces::Raster(info);
+
+    skottie_utils::PartialFrameRenderer renderer(Animation::Make(kJson, strlen(kJson)),
+                                                 SkSurfaces::Raster(info), SK_ColorWHITE);
+
+    bool first = true;
+    for (double t : {0.0, 1.0, 2.0, 2.5, 3.0, 9.0, 4.0, 0.0}) {
+        // The first frame is repainted, then only the square's old and new bounds.
+        const SkRegion& damage = renderer.renderFrame(t);
+        REPORTER_ASSERT(r, first ? damage.getBounds() == SkIRect::MakeWH(kSize, kSize)
+                                 : damage.getBounds().height() < kSize / 2);
+        first = false;
+
+        referenceSurface->getCanvas()->clear(SK_ColorWHITE);
+        reference->seekFrame(t);
+        const auto dst = SkRect::MakeIWH(kSize, kSize);
+        reference->render(referenceSurface->getCanvas(), &dst);
+        REPORTER_ASSERT(r, equal(snapshot(renderer.surface().get()),
+                                 snapshot(referenceSurface.get())),
+                        "frame %g", t);
+    }
+
+    // Nothing changes.
+    REPORTER_ASSERT(r, renderer.renderFrame(0).isEmpty());
+
+    // Repaints everything after an outside draw.
+    renderer.surface()->getCanvas()->clear(SK_ColorBLACK);
+    renderer.invalidate();
+    REPORTER_ASSERT(r, renderer.renderFrame(0).getBounds() == SkIRect::MakeWH(kSize, kSize));
+    REPORTER_ASSERT(r, equal(snapshot(renderer.surface().get()),
+                             snapshot(referenceSurface.get())));
+}
@@ -5,8 +5,13 @@
  * found in the LICENSE file.
  */
 
+#include <memory>
 #include <unordered_map>
 
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkFontMgr.h"
 #include "include/core/SkFontStyle.h"
 #include "include/core/SkStream.h"
@@ -305,3 +310,114 @@ DEF_TEST(Skottie_Text_FontFamily, r) {
     const auto* style2 = fmgr->styleRequestedWhenMatchingFamily("family_2");
     REPORTER_ASSERT(r, style2);
 }
+
+DEF_TEST(Skottie_Text_ShapingExecutor, r) {
+    // A static text layer, and a text layer switching between two documents (the third
+    // keyframe only changes the fill color).
+    static constexpr char json[] =
+        R"({
+             "v": "5.2.1",
+             "w": 200,
+             "h": 100,
+             "fr": 10,
+             "ip": 0,
+             "op": 4,
+             "fonts": {
+               "list": [{
+                 "fFamily": "Serif",
+                 "fName": "Serif",
+                 "fStyle": "Regular"
+               }]
+             },
+             "layers": [
+               {
+                 "ty": 5,
+                 "ip": 0,
+                 "op": 4,
+                 "ks": {},
+                 "t": {
+                   "d": {
+                     "k": [
+                       { "t": 0, "s": { "f": "Serif", "t": "Foo", "s": 24, "lh": 30,
+                                        "fc": [1,0,0,1], "ps": [0, 0], "sz": [200, 50] } },
+                       { "t": 1, "s": { "f": "Serif", "t": "Bar Baz", "s": 24, "lh": 30,
+                                        "fc": [1,0,0,1], "ps": [0, 0], "sz": [200, 50] } },
+                       { "t": 2, "s": { "f": "Serif", "t": "Foo", "s": 24, "lh": 30,
+                                        "fc": [0,0,1,1], "ps": [0, 0], "sz": [200, 50] } },
+                       { "t": 3, "s": { "f": "Serif", "t": "Bar Baz", "s": 24, "lh": 30,
+                                        "fc": [1,0,0,1], "ps": [0, 0], "sz": [200, 50] } }
+                     ]
+                   }
+                 }
+               },
+               {
+                 "ty": 5,
+                 "ip": 0,
+                 "op": 4,
+                 "ks": {},
+                 "t": {
+                   "d": {
+                     "k": [
+                       { "t": 0, "s": { "f": "Serif", "t": "Qux", "s": 24, "lh": 30,
+                                        "fc": [0,1,0,1], "ps": [0, 50], "sz": [200, 50] } }
+                     ]
+                   }
+                 }
+               }
+             ]
+           })";
+
+    class PortableRP final : public skresources::ResourceProvider {
+    private:
+        sk_sp<SkTypeface> loadTypeface(const char[], const char[]) const override {
+            return ToolUtils::CreatePortableTypeface("Serif", SkFontStyle());
+        }
+    };
+
+    const auto make = [](SkExecutor* executor, Animation::Builder::Stats* stats) {
+        Animation::Builder builder;
+        auto anim = builder.setResourceProvider(sk_make_sp<PortableRP>())
+                           .setTextShapingFactory(SkShapers::BestAvailable())
+                           .setTextShapingExecutor(executor)
+                           .make(json, strlen(json));
+        *stats = builder.getStats();
+        return anim;
+    };
+
+    auto executor = SkExecutor::MakeFIFOThreadPool(2);
+    Animation::Builder::Stats serial_stats, parallel_stats;
+    auto serial   = make(nullptr, &serial_stats),
+         parallel = make(executor.get(), &parallel_stats);
+    REPORTER_ASSERT(r, serial && parallel);
+
+    // Documents which only differ in paint properties are shaped once.
+    REPORTER_ASSERT(r, serial_stats.fShapedTextCount == 0);
+    REPORTER_ASSERT(r, parallel_stats.fShapedTextCount == 3);
+
+    // Shaping ahead of time (cached) and on demand (uncached) render the same, across keyframes.
+    const auto render = [](Animation* anim, double frame) {
+        SkBitmap bm;
+        bm.allocN32Pixels(200, 100);
+        bm.eraseColor(SK_ColorTRANSPARENT);
+        anim->seekFrame(frame);
+        anim->render(std::make_unique<SkCanvas>(bm).get());
+        return bm;
+    };
+    for (const double frame : { 0.0, 1.0, 2.0, 3.0, 0.0 }) {
+        REPORTER_ASSERT(r, ToolUtils::equal_pixels(render(serial.get(), frame),
+                                                   render(parallel.get(), frame)));
+    }
+
+    // The cached shaping of frame 0 is reused at frame 2, which fills the text in blue.
+    const auto bm = render(parallel.get(), 2);
+    bool has_blue = false,
+         has_red  = false;
+    for (int y = 0; y < 50; ++y) {
+        for (int x = 0; x < bm.width(); ++x) {
+            const auto c = bm.getColor(x, y);
+            has_blue |= SkColorGetB(c) > 0;
+            has_red  |= SkColorGetR(c) > 0;
+        }
+    }
+    REPORTER_ASSERT(r, has_blue && !has_red);
+}
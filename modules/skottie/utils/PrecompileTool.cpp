@@ -0,0 +1,52 @@
+/*
+ * Copyright 2024 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkData.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkStream.h"
+#include "include/private/base/SkDebug.h"
+#include "src/utils/SkJSON.h"
+#include "tools/flags/CommandLineFlags.h"
+
+static DEFINE_string2(input , i, nullptr, "Input .json file.");
+static DEFINE_string2(output, o, nullptr, "Output binary file.");
+
+// Converts a Lottie .json file to the binary DOM image (see skjson::DOM::writeBinary), which
+// skottie::Animation::Builder loads without parsing.
+int main(int argc, char** argv) {
+    CommandLineFlags::Parse(argc, argv);
+
+    if (FLAGS_input.isEmpty() || FLAGS_output.isEmpty()) {
+        SkDebugf("Missing required 'input' and 'output' args.\n");
+        return 1;
+    }
+
+    const auto data = SkData::MakeFromFileName(FLAGS_input[0]);
+    if (!data) {
+        SkDebugf("Could not read file: %s\n", FLAGS_input[0]);
+        return 1;
+    }
+
+    const skjson::DOM dom(static_cast<const char*>(data->data()), data->size());
+    if (!dom.root().is<skjson::ObjectValue>()) {
+        SkDebugf("Could not parse file: %s\n", FLAGS_input[0]);
+        return 1;
+    }
+
+    SkFILEWStream out(FLAGS_output[0]);
+    if (!out.isValid()) {
+        SkDebugf("Could not write file: %s\n", FLAGS_output[0]);
+        return 1;
+    }
+
+    if (!dom.writeBinary(&out)) {
+        SkDebugf("Could not precompile: %s\n", FLAGS_input[0]);
+        return -1;
+    }
+
+    return 0;
+}
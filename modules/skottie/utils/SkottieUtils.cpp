@@ -7,18 +7,25 @@
 
 #include "modules/skottie/utils/SkottieUtils.h"
 
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkSize.h"
+#include "include/core/SkSurface.h"
 #include "include/private/base/SkAssert.h"
+#include "include/private/base/SkMutex.h"
+#include "include/private/base/SkSemaphore.h"
+#include "include/private/base/SkTo.h"
 #include "modules/skottie/include/Skottie.h"
 #include "modules/skresources/include/SkResources.h"
+#include "modules/sksg/include/SkSGInvalidationController.h"
+#include "src/core/SkTaskGroup.h"
 
 #include <cstring>
 #include <utility>
 
-class SkCanvas;
-
 namespace skottie_utils {
 
 class CustomPropertyManager::PropertyInterceptor final : public skottie::PropertyObserver {
@@ -296,4 +303,157 @@ sk_sp<skottie::ExternalLayer> ExternalAnimationPrecompInterceptor::onLoadPrecomp
                 : nullptr;
 }
 
+namespace {
+
+void render_frame(skottie::Animation* animation, double t, SkSurface* surface,
+                  SkColor background, uint32_t flags) {
+    SkCanvas* canvas = surface->getCanvas();
+    canvas->clear(background);
+
+    animation->seekFrame(t);
+    const auto dst = SkRect::MakeIWH(surface->width(), surface->height());
+    animation->render(canvas, &dst, flags);
+}
+
+} // namespace
+
+ParallelFrameRenderer::ParallelFrameRenderer(std::vector<sk_sp<skottie::Animation>> instances,
+                                             SkExecutor* executor)
+    : fInstances(std::move(instances))
+    , fExecutor(executor) {}
+
+ParallelFrameRenderer::~ParallelFrameRenderer() = default;
+
+void ParallelFrameRenderer::renderFrames(double first, double step, int count,
+                                         const SurfaceProvider& surfaceProvider,
+                                         const FrameConsumer& frameConsumer,
+                                         SkColor background,
+                                         uint32_t renderFlags) {
+    if (fInstances.empty() || count <= 0) {
+        return;
+    }
+
+    if (!fExecutor || fInstances.size() == 1) {
+        for (int i = 0; i < count; ++i) {
+            auto surface = surfaceProvider(i);
+            if (surface) {
+                render_frame(fInstances.front().get(), first + i * step, surface.get(),
+                             background, renderFlags);
+            }
+            frameConsumer(i, std::move(surface));
+        }
+        return;
+    }
+
+    // The instances not rendering a frame.
+    SkMutex mutex;
+    std::vector<skottie::Animation*> idle;
+    for (const auto& instance : fInstances) {
+        idle.push_back(instance.get());
+    }
+    SkSemaphore idleCount(SkToInt(fInstances.size()));
+
+    // Frames are delivered in order, so a slow frame holds back the ones after it; allow a few
+    // frames per instance to be queued up behind it.
+    struct Frame {
+        sk_sp<SkSurface> fSurface;
+        SkSemaphore      fRendered;
+    };
+    const int maxFramesInFlight = 2 * SkToInt(fInstances.size());
+    std::vector<Frame> frames(maxFramesInFlight);
+
+    SkTaskGroup tg(*fExecutor);
+    int delivered = 0;
+    const auto deliver = [&]() {
+        Frame& frame = frames[delivered % maxFramesInFlight];
+        frame.fRendered.wait();
+        frameConsumer(delivered, std::move(frame.fSurface));
+        delivered++;
+    };
+
+    for (int i = 0; i < count; ++i) {
+        if (i - delivered == maxFramesInFlight) {
+            deliver();
+        }
+
+        Frame* frame = &frames[i % maxFramesInFlight];
+        frame->fSurface = surfaceProvider(i);
+        tg.add([&, frame, t = first + i * step]() {
+            if (frame->fSurface) {
+                idleCount.wait();
+                skottie::Animation* animation;
+                {
+                    SkAutoMutexExclusive lock(mutex);
+                    animation = idle.back();
+                    idle.pop_back();
+                }
+
+                render_frame(animation, t, frame->fSurface.get(), background, renderFlags);
+
+                {
+                    SkAutoMutexExclusive lock(mutex);
+                    idle.push_back(animation);
+                }
+                idleCount.signal();
+            }
+            frame->fRendered.signal();
+        });
+    }
+
+    while (delivered < count) {
+        deliver();
+    }
+    tg.wait();
+}
+
+PartialFrameRenderer::PartialFrameRenderer(sk_sp<skottie::Animation> animation,
+                                           sk_sp<SkSurface> surface,
+                                           SkColor background,
+                                           uint32_t renderFlags)
+    : fAnimation(std::move(animation))
+    , fSurface(std::move(surface))
+    , fMatrix(SkMatrix::RectToRect(SkRect::MakeSize(fAnimation->size()),
+                                   SkRect::MakeIWH(fSurface->width(), fSurface->height()),
+                                   SkMatrix::kCenter_ScaleToFit))
+    , fBackground(background)
+    , fRenderFlags(renderFlags) {}
+
+PartialFrameRenderer::~PartialFrameRenderer() = default;
+
+const SkRegion& PartialFrameRenderer::renderFrame(double t) {
+    // Past this many rects, clipping to the damage costs more than it saves.
+    static constexpr int kMaxDamageRects = 16;
+
+    sksg::InvalidationController ic;
+    fAnimation->seekFrame(t, &ic);
+
+    const auto bounds = SkIRect::MakeWH(fSurface->width(), fSurface->height());
+    if (fFullRepaint) {
+        fDamage.setRect(bounds);
+        fFullRepaint = false;
+    } else {
+        fDamage.setEmpty();
+        for (const auto& r : ic) {
+            // Outset for the antialiased edges.
+            fDamage.op(fMatrix.mapRect(r).roundOut().makeOutset(1, 1), SkRegion::kUnion_Op);
+        }
+        fDamage.op(bounds, SkRegion::kIntersect_Op);
+        if (fDamage.isComplex() && fDamage.computeRegionComplexity() > kMaxDamageRects) {
+            fDamage.setRect(fDamage.getBounds());
+        }
+    }
+
+    if (!fDamage.isEmpty()) {
+        SkCanvas* canvas = fSurface->getCanvas();
+        SkAutoCanvasRestore acr(canvas, true);
+        canvas->clipRegion(fDamage);
+        canvas->clear(fBackground);
+
+        const auto dst = SkRect::Make(bounds);
+        fAnimation->render(canvas, &dst, fRenderFlags);
+    }
+
+    return fDamage;
+}
+
 } // namespace skottie_utils
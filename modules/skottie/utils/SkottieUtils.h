@@ -8,20 +8,27 @@
 #ifndef SkottieUtils_DEFINED
 #define SkottieUtils_DEFINED
 
+#include "include/core/SkColor.h"
+#include "include/core/SkMatrix.h"
 #include "include/core/SkRefCnt.h"
+#include "include/core/SkRegion.h"
 #include "include/core/SkString.h"
 #include "modules/skottie/include/ExternalLayer.h"
 #include "modules/skottie/include/SkottieProperty.h"
 
 #include <cstddef>
+#include <functional>
 #include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+class SkExecutor;
+class SkSurface;
 struct SkSize;
 
 namespace skottie {
+class Animation;
 class MarkerObserver;
 }
 
@@ -146,6 +153,92 @@ private:
     const SkString                             fPrefix;
 };
 
+/**
+ * Renders a range of animation frames concurrently, for offline export.
+ *
+ * Each frame is rendered by one of a set of instances of the same animation (see
+ * skottie::Animation::Builder::makeInstances), so there are as many frames in flight as
+ * instances.  The surfaces are requested, and the rendered frames are delivered, on the calling
+ * thread and in frame order.
+ */
+class ParallelFrameRenderer final {
+public:
+    /**
+     * If executor is null or there is a single instance, the frames are rendered on the calling
+     * thread.
+     */
+    ParallelFrameRenderer(std::vector<sk_sp<skottie::Animation>> instances, SkExecutor* executor);
+    ~ParallelFrameRenderer();
+
+    // Returns the (raster) surface to render the frame with the given index into, or nullptr to
+    // skip the frame.
+    using SurfaceProvider = std::function<sk_sp<SkSurface>(int index)>;
+
+    // Receives the surface of a frame once it has been rendered.
+    using FrameConsumer = std::function<void(int index, sk_sp<SkSurface>)>;
+
+    /**
+     * Renders |count| frames, the frame with index i being the animation at frame
+     * |first| + i * |step| (see skottie::Animation::seekFrame).  Each surface is cleared to
+     * |background|, and the frame is scaled to fit it.
+     *
+     * Blocks until all the frames have been delivered.
+     */
+    void renderFrames(double first, double step, int count,
+                      const SurfaceProvider&, const FrameConsumer&,
+                      SkColor background = SK_ColorTRANSPARENT,
+                      uint32_t renderFlags = 0);
+
+private:
+    const std::vector<sk_sp<skottie::Animation>> fInstances;
+    SkExecutor*                                  fExecutor;
+};
+
+/**
+ * Renders the frames of an animation into a surface which retains its contents between frames
+ * (e.g. a raster surface), only repainting the pixels damaged since the previous frame, so that
+ * mostly static animations cost in proportion to what changes.
+ *
+ * The damage is the previous and current bounds of the scene graph nodes invalidated when
+ * seeking (see sksg::InvalidationController).  Nothing else may draw to the surface, unless
+ * invalidate() is called before the next frame.
+ */
+class PartialFrameRenderer final {
+public:
+    /**
+     * The frames are scaled to fit |surface|, over |background|.
+     */
+    PartialFrameRenderer(sk_sp<skottie::Animation>, sk_sp<SkSurface>,
+                         SkColor background = SK_ColorTRANSPARENT,
+                         uint32_t renderFlags = 0);
+    ~PartialFrameRenderer();
+
+    /**
+     * Seeks the animation to frame |t| (see skottie::Animation::seekFrame), and repaints the
+     * damaged pixels of the surface.
+     *
+     * Returns the repainted pixels, which are empty if the frame looks the same as the previous
+     * one.  The first frame, and the frame following invalidate(), repaint the whole surface.
+     */
+    const SkRegion& renderFrame(double t);
+
+    /**
+     * Repaints the whole surface on the next frame.
+     */
+    void invalidate() { fFullRepaint = true; }
+
+    const sk_sp<SkSurface>& surface() const { return fSurface; }
+
+private:
+    const sk_sp<skottie::Animation> fAnimation;
+    const sk_sp<SkSurface>          fSurface;
+    const SkMatrix                  fMatrix;  // animation -> surface
+    const SkColor                   fBackground;
+    const uint32_t                  fRenderFlags;
+    SkRegion                        fDamage;
+    bool                            fFullRepaint = true;
+};
+
 } // namespace skottie_utils
 
 #endif // SkottieUtils_DEFINED
@@ -286,6 +286,7 @@ public:
                    std::move(fontmgr),
                    nullptr, nullptr, nullptr, nullptr, nullptr,
                    std::move(sfact),
+                   nullptr, nullptr,
                    &fStats, {0, 0}, 1, 1, 0)
         , fAlloc(4096)
     {}
@@ -53,6 +53,15 @@ private:
 
     sk_sp<SkTypeface> matchTypeface(const SkString& familyName, SkFontStyle fontStyle);
 
+    sk_sp<SkTypeface> defaultFallbackImpl(SkUnichar unicode, SkFontStyle fontStyle,
+                                          const SkString& locale);
+    sk_sp<SkTypeface> defaultEmojiFallbackImpl(SkUnichar emojiStart, SkFontStyle fontStyle,
+                                               const SkString& locale);
+    sk_sp<SkTypeface> findFallback(SkUnichar unicode, SkFontStyle fontStyle,
+                                   const SkString& locale, bool emoji);
+    // Cached fallbacks (including misses) are only valid for the current font managers
+    void resetFallbacks();
+
     struct FamilyKey {
         FamilyKey(const std::vector<SkString>& familyNames, SkFontStyle style, const std::optional<FontArguments>& args)
                 : fFamilyNames(familyNames), fFontStyle(style), fFontArguments(args) {}
@@ -70,8 +79,29 @@ private:
         };
     };
 
+    struct FallbackKey {
+        FallbackKey(SkUnichar unicode, SkFontStyle style, const SkString& locale, bool emoji)
+                : fUnicode(unicode), fFontStyle(style), fLocale(locale), fEmoji(emoji) {}
+
+        SkUnichar fUnicode;
+        SkFontStyle fFontStyle;
+        SkString fLocale;
+        bool fEmoji;
+
+        bool operator==(const FallbackKey& other) const;
+
+        struct Hasher {
+            size_t operator()(const FallbackKey& key) const;
+        };
+    };
+
     bool fEnableFontFallback;
-    skia_private::THashMap<FamilyKey, std::vector<sk_sp<SkTypeface>>, FamilyKey::Hasher> fTypefaces;
+    // Paragraphs sharing the collection can be laid out on different threads
+    SkMutex fTypefacesMutex;
+    skia_private::THashMap<FamilyKey, std::vector<sk_sp<SkTypeface>>, FamilyKey::Hasher> fTypefaces
+            SK_GUARDED_BY(fTypefacesMutex);
+    skia_private::THashMap<FallbackKey, sk_sp<SkTypeface>, FallbackKey::Hasher> fFallbacks
+            SK_GUARDED_BY(fTypefacesMutex);
     sk_sp<SkFontMgr> fDefaultFontManager;
     sk_sp<SkFontMgr> fAssetFontManager;
     sk_sp<SkFontMgr> fDynamicFontManager;
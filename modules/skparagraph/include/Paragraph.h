@@ -74,12 +74,16 @@ public:
     virtual std::unordered_set<SkUnichar> unresolvedCodepoints() = 0;
 
     // Experimental API that allows fast way to update some of "immutable" paragraph attributes
-    // but not the text itself
     virtual void updateTextAlign(TextAlign textAlign) = 0;
     virtual void updateFontSize(size_t from, size_t to, SkScalar fontSize) = 0;
     virtual void updateForegroundPaint(size_t from, size_t to, SkPaint paint) = 0;
     virtual void updateBackgroundPaint(size_t from, size_t to, SkPaint paint) = 0;
 
+    // Replaces the text in [from:to) (UTF8) with the given text; the new text takes the style
+    // of the text it replaces (or the text right after the insertion point).
+    // Edits within one word of simple text reshape only that word on the next layout
+    virtual void updateText(size_t from, size_t to, const SkString& text) = 0;
+
     enum VisitorFlags {
         kWhiteSpace_VisitorFlag = 1 << 0,
     };
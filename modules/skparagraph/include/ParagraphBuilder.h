@@ -13,6 +13,8 @@
 #include "modules/skparagraph/include/TextStyle.h"
 #include "modules/skunicode/include/SkUnicode.h"
 
+class SkExecutor;
+
 namespace skia {
 namespace textlayout {
 
@@ -58,6 +60,15 @@ public:
     // Constructs a SkParagraph object that can be used to layout and paint the text to a SkCanvas.
     virtual std::unique_ptr<Paragraph> Build() = 0;
 
+    // Paragraphs built in measure-only mode compute everything needed for their size (height,
+    // longest line, intrinsic widths, baselines, line count) but do not build the lines
+    // themselves: painting them draws nothing and line, glyph and range queries return empty
+    // results. Useful for sizing passes that never paint.
+    // Shaping still produces the glyph positions and the cluster table, since line breaking
+    // walks the clusters; only building the lines is skipped. The saving is biggest when the
+    // paragraph is laid out again at other widths, and smaller on its first layout.
+    virtual void setMeasureOnly(bool measureOnly) = 0;
+
     virtual SkSpan<char> getText() = 0;
     virtual const ParagraphStyle& getParagraphStyle() const = 0;
 
@@ -80,6 +91,16 @@ public:
     virtual void SetUnicode(sk_sp<SkUnicode> unicode) = 0;
 #endif
 
+    // Builds the paragraphs and lays them out with the given width, concurrently on the executor.
+    // Without one, SkExecutor::GetDefault() is used, which runs every task synchronously on the
+    // calling thread unless the client has installed a thread pool with SkExecutor::SetDefault().
+    // Builders can share a FontCollection but must not be used elsewhere until this returns. The
+    // paragraphs are returned in the order of the builders.
+    static std::vector<std::unique_ptr<Paragraph>> BuildAndLayout(
+            SkSpan<ParagraphBuilder* const> builders,
+            SkScalar width,
+            SkExecutor* executor = nullptr);
+
     // Resets this builder to its initial state, discarding any text, styles, placeholders that have
     // been added, but keeping the initial ParagraphStyle.
     virtual void Reset() = 0;
@@ -2,9 +2,12 @@
 #ifndef ParagraphCache_DEFINED
 #define ParagraphCache_DEFINED
 
+#include "include/core/SkString.h"
 #include "include/private/base/SkMutex.h"
 #include "src/core/SkLRUCache.h"
+#include <atomic>
 #include <functional>  // std::function
+#include <memory>
 
 #define PARAGRAPH_CACHE_STATS
 
@@ -17,9 +20,31 @@ class ParagraphCacheValue;
 
 class ParagraphCache {
 public:
+    struct Options {
+        // Maximum number of cached paragraphs (split evenly between the shards)
+        int fMaxEntries = 128;
+        // Maximum (approximate) memory used by the cached shaping results; 0 means no limit
+        size_t fMaxBytes = 0;
+        // Number of independently locked parts of the cache; more shards mean less
+        // contention when the same FontCollection is used to lay out text on several threads
+        int fShardCount = 1;
+    };
+
+    struct Stats {
+        int fLookups;   // findParagraph calls while the cache is on
+        int fHits;      // ...that found the shaping results
+        int fCount;     // paragraphs currently in the cache
+        size_t fBytes;  // approximate memory used by these paragraphs
+    };
+
     ParagraphCache();
+    explicit ParagraphCache(const Options& options);
     ~ParagraphCache();
 
+    // Drops all the cached paragraphs; must not be called while the cache is in use
+    void setOptions(const Options& options);
+    const Options& options() const { return fOptions; }
+
     void abandon();
     void reset();
     bool updateParagraph(ParagraphImpl* paragraph);
@@ -31,33 +56,42 @@ public:
     }
     void printStatistics();
     void turnOn(bool value) { fCacheIsOn = value; }
-    int count() { return fLRUCacheMap.count(); }
+    int count();
+    Stats stats();
 
     bool isPossiblyTextEditing(ParagraphImpl* paragraph);
 
  private:
 
     struct Entry;
+    struct Shard;
     void updateFrom(const ParagraphImpl* paragraph, Entry* entry);
     void updateTo(ParagraphImpl* paragraph, const Entry* entry);
+    Shard& shardFor(const ParagraphCacheKey& key);
+    void rememberLastCachedText(const SkString& text);
 
-     mutable SkMutex fParagraphMutex;
-     std::function<void(ParagraphImpl* impl, const char*, bool)> fChecker;
-
-    static const int kMaxEntries = 128;
+    std::function<void(ParagraphImpl* impl, const char*, bool)> fChecker;
 
     struct KeyHash {
         uint32_t operator()(const ParagraphCacheKey& key) const;
     };
 
-    SkLRUCache<ParagraphCacheKey, std::unique_ptr<Entry>, KeyHash> fLRUCacheMap;
-    bool fCacheIsOn;
-    ParagraphCacheValue* fLastCachedValue;
+    Options fOptions;
+    std::unique_ptr<std::unique_ptr<Shard>[]> fShards;
+    std::atomic<bool> fCacheIsOn;
+
+    // The start and the end of the last added paragraph text (see isPossiblyTextEditing)
+    SkMutex fLastCachedTextMutex;
+    bool fHasLastCachedText SK_GUARDED_BY(fLastCachedTextMutex);
+    SkString fLastCachedTextStart SK_GUARDED_BY(fLastCachedTextMutex);
+    SkString fLastCachedTextEnd SK_GUARDED_BY(fLastCachedTextMutex);
 
+    std::atomic<int> fLookups;
+    std::atomic<int> fHits;
 #ifdef PARAGRAPH_CACHE_STATS
-    int fTotalRequests;
-    int fCacheMisses;
-    int fHashMisses; // cache hit but hash table missed
+    std::atomic<int> fTotalRequests;
+    std::atomic<int> fCacheMisses;
+    std::atomic<int> fHashMisses; // cache hit but hash table missed
 #endif
 };
 
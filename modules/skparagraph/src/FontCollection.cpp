@@ -5,6 +5,7 @@
 #include "modules/skparagraph/include/Paragraph.h"
 #include "modules/skparagraph/src/ParagraphImpl.h"
 #include "modules/skshaper/include/SkShaper_harfbuzz.h"
+#include "src/core/SkChecksum.h"
 
 namespace {
 #if defined(SK_BUILD_FOR_MAC) || defined(SK_BUILD_FOR_IOS)
@@ -33,6 +34,31 @@ size_t FontCollection::FamilyKey::Hasher::operator()(const FontCollection::Famil
            std::hash<std::optional<FontArguments>>()(key.fFontArguments);
 }
 
+bool FontCollection::FallbackKey::operator==(const FontCollection::FallbackKey& other) const {
+    return fUnicode == other.fUnicode &&
+           fFontStyle == other.fFontStyle &&
+           fLocale == other.fLocale &&
+           fEmoji == other.fEmoji;
+}
+
+size_t FontCollection::FallbackKey::Hasher::operator()(const FontCollection::FallbackKey& key) const {
+    // XOR-ing the per-field hashes would collide for every codepoint whose bits happen to cancel
+    // against the style, so chain the fields through one hash instead.
+    struct {
+        SkUnichar unicode;
+        int32_t weight;
+        int32_t width;
+        int32_t slant;
+        int32_t emoji;
+    } fields = {key.fUnicode,
+                key.fFontStyle.weight(),
+                key.fFontStyle.width(),
+                (int32_t)key.fFontStyle.slant(),
+                key.fEmoji};
+    return SkChecksum::Hash32(key.fLocale.c_str(), key.fLocale.size(),
+                              SkChecksum::Hash32(&fields, sizeof(fields)));
+}
+
 FontCollection::FontCollection()
         : fEnableFontFallback(true)
         , fDefaultFamilyNames({SkString(DEFAULT_FONT_FAMILY)}) { }
@@ -41,30 +67,36 @@ size_t FontCollection::getFontManagersCount() const { return this->getFontManage
 
 void FontCollection::setAssetFontManager(sk_sp<SkFontMgr> font_manager) {
     fAssetFontManager = std::move(font_manager);
+    this->resetFallbacks();
 }
 
 void FontCollection::setDynamicFontManager(sk_sp<SkFontMgr> font_manager) {
     fDynamicFontManager = std::move(font_manager);
+    this->resetFallbacks();
 }
 
 void FontCollection::setTestFontManager(sk_sp<SkFontMgr> font_manager) {
     fTestFontManager = std::move(font_manager);
+    this->resetFallbacks();
 }
 
 void FontCollection::setDefaultFontManager(sk_sp<SkFontMgr> fontManager,
                                            const char defaultFamilyName[]) {
     fDefaultFontManager = std::move(fontManager);
     fDefaultFamilyNames.emplace_back(defaultFamilyName);
+    this->resetFallbacks();
 }
 
 void FontCollection::setDefaultFontManager(sk_sp<SkFontMgr> fontManager,
                                            const std::vector<SkString>& defaultFamilyNames) {
     fDefaultFontManager = std::move(fontManager);
     fDefaultFamilyNames = defaultFamilyNames;
+    this->resetFallbacks();
 }
 
 void FontCollection::setDefaultFontManager(sk_sp<SkFontMgr> fontManager) {
     fDefaultFontManager = std::move(fontManager);
+    this->resetFallbacks();
 }
 
 // Return the available font managers in the order they should be queried.
@@ -92,9 +124,12 @@ std::vector<sk_sp<SkTypeface>> FontCollection::findTypefaces(const std::vector<S
 std::vector<sk_sp<SkTypeface>> FontCollection::findTypefaces(const std::vector<SkString>& familyNames, SkFontStyle fontStyle, const std::optional<FontArguments>& fontArgs) {
     // Look inside the font collections cache first
     FamilyKey familyKey(familyNames, fontStyle, fontArgs);
-    auto found = fTypefaces.find(familyKey);
-    if (found) {
-        return *found;
+    {
+        SkAutoMutexExclusive lock(fTypefacesMutex);
+        auto found = fTypefaces.find(familyKey);
+        if (found) {
+            return *found;
+        }
     }
 
     std::vector<sk_sp<SkTypeface>> typefaces;
@@ -129,6 +164,7 @@ std::vector<sk_sp<SkTypeface>> FontCollection::findTypefaces(const std::vector<S
         }
     }
 
+    SkAutoMutexExclusive lock(fTypefacesMutex);
     fTypefaces.set(familyKey, typefaces);
     return typefaces;
 }
@@ -149,10 +185,48 @@ sk_sp<SkTypeface> FontCollection::matchTypeface(const SkString& familyName, SkFo
     return nullptr;
 }
 
-// Find ANY font in available font managers that resolves the unicode codepoint
+// Font managers can be slow to find a fallback (and it happens for every unresolved codepoint)
+sk_sp<SkTypeface> FontCollection::findFallback(SkUnichar unicode,
+                                               SkFontStyle fontStyle,
+                                               const SkString& locale,
+                                               bool emoji) {
+    static constexpr int kMaxFallbacks = 1024;
+    FallbackKey key(unicode, fontStyle, locale, emoji);
+    {
+        SkAutoMutexExclusive lock(fTypefacesMutex);
+        if (auto found = fFallbacks.find(key)) {
+            return *found;
+        }
+    }
+
+    // Do not hold the lock while the font manager is working
+    sk_sp<SkTypeface> typeface = emoji ? this->defaultEmojiFallbackImpl(unicode, fontStyle, locale)
+                                       : this->defaultFallbackImpl(unicode, fontStyle, locale);
+
+    SkAutoMutexExclusive lock(fTypefacesMutex);
+    if (fFallbacks.count() >= kMaxFallbacks) {
+        fFallbacks.reset();
+    }
+    fFallbacks.set(key, typeface);
+    return typeface;
+}
+
 sk_sp<SkTypeface> FontCollection::defaultFallback(SkUnichar unicode,
                                                   SkFontStyle fontStyle,
                                                   const SkString& locale) {
+    return this->findFallback(unicode, fontStyle, locale, false);
+}
+
+sk_sp<SkTypeface> FontCollection::defaultEmojiFallback(SkUnichar emojiStart,
+                                                       SkFontStyle fontStyle,
+                                                       const SkString& locale) {
+    return this->findFallback(emojiStart, fontStyle, locale, true);
+}
+
+// Find ANY font in available font managers that resolves the unicode codepoint
+sk_sp<SkTypeface> FontCollection::defaultFallbackImpl(SkUnichar unicode,
+                                                      SkFontStyle fontStyle,
+                                                      const SkString& locale) {
 
     for (const auto& manager : this->getFontManagerOrder()) {
         std::vector<const char*> bcp47;
@@ -170,9 +244,9 @@ sk_sp<SkTypeface> FontCollection::defaultFallback(SkUnichar unicode,
 }
 
 // Find ANY font in available font managers that resolves this emojiStart
-sk_sp<SkTypeface> FontCollection::defaultEmojiFallback(SkUnichar emojiStart,
-                                                       SkFontStyle fontStyle,
-                                                       const SkString& locale) {
+sk_sp<SkTypeface> FontCollection::defaultEmojiFallbackImpl(SkUnichar emojiStart,
+                                                           SkFontStyle fontStyle,
+                                                           const SkString& locale) {
 
     for (const auto& manager : this->getFontManagerOrder()) {
         std::vector<const char*> bcp47;
@@ -215,12 +289,28 @@ sk_sp<SkTypeface> FontCollection::defaultFallback() {
     return nullptr;
 }
 
-void FontCollection::disableFontFallback() { fEnableFontFallback = false; }
-void FontCollection::enableFontFallback() { fEnableFontFallback = true; }
+void FontCollection::disableFontFallback() {
+    fEnableFontFallback = false;
+    this->resetFallbacks();
+}
+
+void FontCollection::enableFontFallback() {
+    fEnableFontFallback = true;
+    this->resetFallbacks();
+}
+
+void FontCollection::resetFallbacks() {
+    SkAutoMutexExclusive lock(fTypefacesMutex);
+    fFallbacks.reset();
+}
 
 void FontCollection::clearCaches() {
     fParagraphCache.reset();
-    fTypefaces.reset();
+    {
+        SkAutoMutexExclusive lock(fTypefacesMutex);
+        fTypefaces.reset();
+        fFallbacks.reset();
+    }
     SkShapers::HB::PurgeCaches();
 }
 
@@ -1,8 +1,10 @@
 // Copyright 2019 Google LLC.
 #include "modules/skparagraph/src/ParagraphBuilderImpl.h"
 
+#include "include/core/SkExecutor.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkTypes.h"
+#include "include/private/base/SkTo.h"
 #include "modules/skparagraph/include/FontCollection.h"
 #include "modules/skparagraph/include/Paragraph.h"
 #include "modules/skparagraph/include/ParagraphBuilder.h"
@@ -11,6 +13,7 @@
 #include "modules/skparagraph/src/ParagraphImpl.h"
 #include "modules/skunicode/include/SkUnicode.h"
 #include "src/core/SkStringUtils.h"
+#include "src/core/SkTaskGroup.h"
 
 #if !defined(SK_DISABLE_LEGACY_PARAGRAPH_UNICODE)
 #if defined(SK_UNICODE_ICU_IMPLEMENTATION)
@@ -31,12 +34,35 @@
 
 #endif  // !defined(SK_DISABLE_LEGACY_PARAGRAPH_UNICODE)
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 
 namespace skia {
 namespace textlayout {
 
+std::vector<std::unique_ptr<Paragraph>> ParagraphBuilder::BuildAndLayout(
+        SkSpan<ParagraphBuilder* const> builders,
+        SkScalar width,
+        SkExecutor* executor) {
+    // Most paragraphs are small, so give each task a few of them
+    static constexpr size_t kParagraphsPerTask = 16;
+
+    std::vector<std::unique_ptr<Paragraph>> paragraphs(builders.size());
+    const size_t tasks = (builders.size() + kParagraphsPerTask - 1) / kParagraphsPerTask;
+    SkTaskGroup taskGroup(executor ? *executor : SkExecutor::GetDefault());
+    taskGroup.batch(SkToInt(tasks), [&](int task) {
+        const size_t start = task * kParagraphsPerTask;
+        const size_t end = std::min(start + kParagraphsPerTask, builders.size());
+        for (size_t i = start; i < end; ++i) {
+            paragraphs[i] = builders[i]->Build();
+            paragraphs[i]->layout(width);
+        }
+    });
+    taskGroup.wait();
+    return paragraphs;
+}
+
 #if !defined(SK_DISABLE_LEGACY_PARAGRAPH_UNICODE)
 
 namespace {
@@ -250,8 +276,10 @@ std::unique_ptr<Paragraph> ParagraphBuilderImpl::Build() {
 #endif
 
     SkASSERT_RELEASE(fUnicode);
-    return std::make_unique<ParagraphImpl>(
+    auto paragraph = std::make_unique<ParagraphImpl>(
             fUtf8, fParagraphStyle, fStyledBlocks, fPlaceholders, fFontCollection, fUnicode);
+    paragraph->setMeasureOnly(fMeasureOnly);
+    return paragraph;
 }
 
 SkSpan<char> ParagraphBuilderImpl::getText() {
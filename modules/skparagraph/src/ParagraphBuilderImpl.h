@@ -62,6 +62,8 @@ public:
     // Constructs a SkParagraph object that can be used to layout and paint the text to a SkCanvas.
     std::unique_ptr<Paragraph> Build() override;
 
+    void setMeasureOnly(bool measureOnly) override { fMeasureOnly = measureOnly; }
+
     // Support for "Client" unicode
     SkSpan<char> getText() override;
     const ParagraphStyle& getParagraphStyle() const override;
@@ -115,6 +117,7 @@ protected:
     skia_private::STArray<4, Placeholder, true> fPlaceholders;
     sk_sp<FontCollection> fFontCollection;
     ParagraphStyle fParagraphStyle;
+    bool fMeasureOnly = false;
 
     sk_sp<SkUnicode> fUnicode;
 private:
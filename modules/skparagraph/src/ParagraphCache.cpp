@@ -5,6 +5,7 @@
 #include "modules/skparagraph/include/ParagraphCache.h"
 #include "modules/skparagraph/src/ParagraphImpl.h"
 #include "src/base/SkFloatBits.h"
+#include "src/core/SkChecksum.h"
 
 using namespace skia_private;
 
@@ -33,8 +34,20 @@ public:
     ParagraphCacheKey(const ParagraphImpl* paragraph)
         : fText(paragraph->fText.c_str(), paragraph->fText.size())
         , fPlaceholders(paragraph->fPlaceholders)
-        , fTextStyles(paragraph->fTextStyles)
         , fParagraphStyle(paragraph->paragraphStyle()) {
+        // Styles that differ only by paint or decorations produce the same shaping results
+        // (OneLineShaper combines them anyway) so we merge them here
+        for (auto& block : paragraph->fTextStyles) {
+            if (!fTextStyles.empty()) {
+                auto& last = fTextStyles.back();
+                if (last.fRange.end == block.fRange.start &&
+                    last.fStyle.equalsByFonts(block.fStyle)) {
+                    last.fRange.end = block.fRange.end;
+                    continue;
+                }
+            }
+            fTextStyles.push_back(block);
+        }
         fHash = computeHash();
     }
 
@@ -80,6 +93,22 @@ public:
         , fHasWhitespacesInside(paragraph->fHasWhitespacesInside)
         , fTrailingSpaces(paragraph->fTrailingSpaces) { }
 
+    size_t approximateBytesUsed() const {
+        size_t bytes = sizeof(ParagraphCacheValue) + fKey.text().size();
+        for (auto& run : fRuns) {
+            bytes += sizeof(Run) + run.size() * (sizeof(SkGlyphID) +
+                                                 sizeof(SkPoint) * 2 +
+                                                 sizeof(uint32_t) +
+                                                 sizeof(SkScalar));
+        }
+        bytes += fClusters.size() * sizeof(Cluster);
+        bytes += fClustersIndexFromCodeUnit.size() * sizeof(size_t);
+        bytes += fCodeUnitProperties.size() * sizeof(SkUnicode::CodeUnitFlags);
+        bytes += fWords.size() * sizeof(size_t);
+        bytes += fBidiRegions.size() * sizeof(SkUnicode::BidiRegion);
+        return bytes;
+    }
+
     // Input == key
     ParagraphCacheKey fKey;
 
@@ -232,26 +261,66 @@ bool ParagraphCacheKey::operator==(const ParagraphCacheKey& other) const {
     return true;
 }
 
+struct ParagraphCache::Shard {
+    explicit Shard(int maxEntries) : fLRUCacheMap(maxEntries) {}
+
+    SkMutex fMutex;
+    SkLRUCache<ParagraphCacheKey, std::unique_ptr<Entry>, KeyHash> fLRUCacheMap SK_GUARDED_BY(fMutex);
+    // Updated by the entries themselves so the evictions made by SkLRUCache are accounted for
+    size_t fBytes = 0;
+};
+
 struct ParagraphCache::Entry {
 
-    Entry(ParagraphCacheValue* value) : fValue(value) {}
+    Entry(ParagraphCacheValue* value, Shard* shard)
+        : fValue(value), fBytes(value->approximateBytesUsed()), fShard(shard) {
+        fShard->fBytes += fBytes;
+    }
+    ~Entry() {
+        fShard->fBytes -= fBytes;
+    }
     std::unique_ptr<ParagraphCacheValue> fValue;
+    size_t fBytes;
+    Shard* fShard;
 };
 
-ParagraphCache::ParagraphCache()
+ParagraphCache::ParagraphCache() : ParagraphCache(Options()) { }
+
+ParagraphCache::ParagraphCache(const Options& options)
     : fChecker([](ParagraphImpl* impl, const char*, bool){ })
-    , fLRUCacheMap(kMaxEntries)
     , fCacheIsOn(true)
-    , fLastCachedValue(nullptr)
+    , fHasLastCachedText(false)
+    , fLookups(0)
+    , fHits(0)
 #ifdef PARAGRAPH_CACHE_STATS
     , fTotalRequests(0)
     , fCacheMisses(0)
     , fHashMisses(0)
 #endif
-{ }
+{
+    this->setOptions(options);
+}
 
 ParagraphCache::~ParagraphCache() { }
 
+void ParagraphCache::setOptions(const Options& options) {
+    fOptions = options;
+    fOptions.fShardCount = std::max(fOptions.fShardCount, 1);
+    fOptions.fMaxEntries = std::max(fOptions.fMaxEntries, fOptions.fShardCount);
+    const int entriesPerShard =
+            (fOptions.fMaxEntries + fOptions.fShardCount - 1) / fOptions.fShardCount;
+    fShards = std::make_unique<std::unique_ptr<Shard>[]>(fOptions.fShardCount);
+    for (int i = 0; i < fOptions.fShardCount; ++i) {
+        fShards[i] = std::make_unique<Shard>(entriesPerShard);
+    }
+    this->rememberLastCachedText(SkString());
+}
+
+ParagraphCache::Shard& ParagraphCache::shardFor(const ParagraphCacheKey& key) {
+    // SkLRUCache uses the low bits of the same hash, so mix it before picking the shard
+    return *fShards[SkChecksum::CheapMix(key.hash()) % fOptions.fShardCount];
+}
+
 void ParagraphCache::updateTo(ParagraphImpl* paragraph, const Entry* entry) {
 
     paragraph->fRuns.clear();
@@ -274,27 +343,50 @@ void ParagraphCache::updateTo(ParagraphImpl* paragraph, const Entry* entry) {
 
 void ParagraphCache::printStatistics() {
     SkDebugf("--- Paragraph Cache ---\n");
-    SkDebugf("Total requests: %d\n", fTotalRequests);
-    SkDebugf("Cache misses: %d\n", fCacheMisses);
+    SkDebugf("Total requests: %d\n", fTotalRequests.load());
+    SkDebugf("Cache misses: %d\n", fCacheMisses.load());
     SkDebugf("Cache miss %%: %f\n", (fTotalRequests > 0) ? 100.f * fCacheMisses / fTotalRequests : 0.f);
     int cacheHits = fTotalRequests - fCacheMisses;
     SkDebugf("Hash miss %%: %f\n", (cacheHits > 0) ? 100.f * fHashMisses / cacheHits : 0.f);
     SkDebugf("---------------------\n");
 }
 
+int ParagraphCache::count() {
+    int count = 0;
+    for (int i = 0; i < fOptions.fShardCount; ++i) {
+        SkAutoMutexExclusive lock(fShards[i]->fMutex);
+        count += fShards[i]->fLRUCacheMap.count();
+    }
+    return count;
+}
+
+ParagraphCache::Stats ParagraphCache::stats() {
+    Stats stats = {fLookups, fHits, 0, 0};
+    for (int i = 0; i < fOptions.fShardCount; ++i) {
+        SkAutoMutexExclusive lock(fShards[i]->fMutex);
+        stats.fCount += fShards[i]->fLRUCacheMap.count();
+        stats.fBytes += fShards[i]->fBytes;
+    }
+    return stats;
+}
+
 void ParagraphCache::abandon() {
     this->reset();
 }
 
 void ParagraphCache::reset() {
-    SkAutoMutexExclusive lock(fParagraphMutex);
 #ifdef PARAGRAPH_CACHE_STATS
     fTotalRequests = 0;
     fCacheMisses = 0;
     fHashMisses = 0;
 #endif
-    fLRUCacheMap.reset();
-    fLastCachedValue = nullptr;
+    fLookups = 0;
+    fHits = 0;
+    for (int i = 0; i < fOptions.fShardCount; ++i) {
+        SkAutoMutexExclusive lock(fShards[i]->fMutex);
+        fShards[i]->fLRUCacheMap.reset();
+    }
+    this->rememberLastCachedText(SkString());
 }
 
 bool ParagraphCache::findParagraph(ParagraphImpl* paragraph) {
@@ -304,9 +396,11 @@ bool ParagraphCache::findParagraph(ParagraphImpl* paragraph) {
 #ifdef PARAGRAPH_CACHE_STATS
     ++fTotalRequests;
 #endif
-    SkAutoMutexExclusive lock(fParagraphMutex);
+    ++fLookups;
     ParagraphCacheKey key(paragraph);
-    std::unique_ptr<Entry>* entry = fLRUCacheMap.find(key);
+    Shard& shard = this->shardFor(key);
+    SkAutoMutexExclusive lock(shard.fMutex);
+    std::unique_ptr<Entry>* entry = shard.fLRUCacheMap.find(key);
 
     if (!entry) {
         // We have a cache miss
@@ -316,6 +410,7 @@ bool ParagraphCache::findParagraph(ParagraphImpl* paragraph) {
         fChecker(paragraph, "missingParagraph", true);
         return false;
     }
+    ++fHits;
     updateTo(paragraph, entry->get());
     fChecker(paragraph, "foundParagraph", true);
     return true;
@@ -328,10 +423,11 @@ bool ParagraphCache::updateParagraph(ParagraphImpl* paragraph) {
 #ifdef PARAGRAPH_CACHE_STATS
     ++fTotalRequests;
 #endif
-    SkAutoMutexExclusive lock(fParagraphMutex);
-
     ParagraphCacheKey key(paragraph);
-    std::unique_ptr<Entry>* entry = fLRUCacheMap.find(key);
+    Shard& shard = this->shardFor(key);
+    SkAutoMutexExclusive lock(shard.fMutex);
+
+    std::unique_ptr<Entry>* entry = shard.fLRUCacheMap.find(key);
     if (!entry) {
         // isTooMuchMemoryWasted(paragraph) not needed for now
         if (isPossiblyTextEditing(paragraph)) {
@@ -339,9 +435,16 @@ bool ParagraphCache::updateParagraph(ParagraphImpl* paragraph) {
             return false;
         }
         ParagraphCacheValue* value = new ParagraphCacheValue(std::move(key), paragraph);
-        fLRUCacheMap.insert(value->fKey, std::make_unique<Entry>(value));
+        shard.fLRUCacheMap.insert(value->fKey, std::make_unique<Entry>(value, &shard));
+        if (fOptions.fMaxBytes > 0) {
+            // Each shard gets its part of the budget; the new entry is always kept
+            const size_t maxBytes = fOptions.fMaxBytes / fOptions.fShardCount;
+            while (shard.fBytes > maxBytes && shard.fLRUCacheMap.count() > 1) {
+                shard.fLRUCacheMap.removeLRU();
+            }
+        }
         fChecker(paragraph, "addedParagraph", true);
-        fLastCachedValue = value;
+        this->rememberLastCachedText(value->fKey.text());
         return true;
     } else {
         // We do not have to update the paragraph
@@ -352,24 +455,24 @@ bool ParagraphCache::updateParagraph(ParagraphImpl* paragraph) {
 // Special situation: (very) long paragraph that is close to the last formatted paragraph
 #define NOCACHE_PREFIX_LENGTH 40
 bool ParagraphCache::isPossiblyTextEditing(ParagraphImpl* paragraph) {
-    if (fLastCachedValue == nullptr) {
+    auto& text = paragraph->fText;
+    if (text.size() < NOCACHE_PREFIX_LENGTH) {
+        // The current text is too short
         return false;
     }
 
-    auto& lastText = fLastCachedValue->fKey.text();
-    auto& text = paragraph->fText;
-
-    if ((lastText.size() < NOCACHE_PREFIX_LENGTH) || (text.size() < NOCACHE_PREFIX_LENGTH)) {
-        // Either last text or the current are too short
+    SkAutoMutexExclusive lock(fLastCachedTextMutex);
+    if (!fHasLastCachedText) {
+        // Either there is no last text or it is too short
         return false;
     }
 
-    if (std::strncmp(lastText.c_str(), text.c_str(), NOCACHE_PREFIX_LENGTH) == 0) {
+    if (std::strncmp(fLastCachedTextStart.c_str(), text.c_str(), NOCACHE_PREFIX_LENGTH) == 0) {
         // Texts have the same starts
         return true;
     }
 
-    if (std::strncmp(lastText.c_str() + lastText.size() - NOCACHE_PREFIX_LENGTH, &text[text.size() - NOCACHE_PREFIX_LENGTH], NOCACHE_PREFIX_LENGTH) == 0) {
+    if (std::strncmp(fLastCachedTextEnd.c_str(), &text[text.size() - NOCACHE_PREFIX_LENGTH], NOCACHE_PREFIX_LENGTH) == 0) {
         // Texts have the same ends
         return true;
     }
@@ -377,5 +480,16 @@ bool ParagraphCache::isPossiblyTextEditing(ParagraphImpl* paragraph) {
     // It does not look like editing the text
     return false;
 }
+
+void ParagraphCache::rememberLastCachedText(const SkString& text) {
+    SkAutoMutexExclusive lock(fLastCachedTextMutex);
+    // Paragraphs are cached from many threads so we keep a copy of the start and the end
+    fHasLastCachedText = text.size() >= NOCACHE_PREFIX_LENGTH;
+    if (fHasLastCachedText) {
+        fLastCachedTextStart.set(text.c_str(), NOCACHE_PREFIX_LENGTH);
+        fLastCachedTextEnd.set(text.c_str() + text.size() - NOCACHE_PREFIX_LENGTH,
+                               NOCACHE_PREFIX_LENGTH);
+    }
+}
 }  // namespace textlayout
 }  // namespace skia
@@ -14,6 +14,7 @@
 #include "modules/skparagraph/include/ParagraphStyle.h"
 #include "modules/skparagraph/include/TextStyle.h"
 #include "modules/skparagraph/src/OneLineShaper.h"
+#include "modules/skparagraph/src/ParagraphBuilderImpl.h"
 #include "modules/skparagraph/src/ParagraphImpl.h"
 #include "modules/skparagraph/src/ParagraphPainterImpl.h"
 #include "modules/skparagraph/src/Run.h"
@@ -82,6 +83,7 @@ ParagraphImpl::ParagraphImpl(const SkString& text,
         , fText(text)
         , fState(kUnknown)
         , fUnresolvedGlyphs(0)
+        , fKeepLines(false)
         , fPicture(nullptr)
         , fStrutMetrics(false)
         , fOldWidth(0)
@@ -90,6 +92,8 @@ ParagraphImpl::ParagraphImpl(const SkString& text,
         , fHasLineBreaks(false)
         , fHasWhitespacesInside(false)
         , fTrailingSpaces(0)
+        , fMeasureOnly(false)
+        , fLineCount(0)
 {
     SkASSERT(fUnicode);
 }
@@ -156,6 +160,7 @@ void ParagraphImpl::layout(SkScalar rawWidth) {
     }
 
     if (fState < kShaped) {
+        fKeepLines = false;
         // Check if we have the text in the cache and don't need to shape it again
         if (!fFontCollection->getParagraphCache()->findParagraph(this)) {
             if (fState < kIndexed) {
@@ -175,6 +180,7 @@ void ParagraphImpl::layout(SkScalar rawWidth) {
                 this->resolveStrut();
                 this->computeEmptyMetrics();
                 this->fLines.clear();
+                this->fLineCount = 0;
 
                 // Set the important values that are not zero
                 fWidth = floorWidth;
@@ -204,7 +210,11 @@ void ParagraphImpl::layout(SkScalar rawWidth) {
         this->resetContext();
         this->resolveStrut();
         this->computeEmptyMetrics();
-        this->fLines.clear();
+        if (!fKeepLines || fOldWidth != floorWidth) {
+            this->fLines.clear();
+            this->fLineBreakStates.clear();
+        }
+        fKeepLines = false;
         this->breakShapedTextIntoLines(floorWidth);
         fState = kLineBroken;
     }
@@ -571,8 +581,10 @@ bool ParagraphImpl::shapeTextIntoEndlessLine() {
 }
 
 void ParagraphImpl::breakShapedTextIntoLines(SkScalar maxWidth) {
+    fLineCount = 0;
 
-    if (!fHasLineBreaks &&
+    if (fLines.empty() &&
+        !fHasLineBreaks &&
         !fHasWhitespacesInside &&
         fPlaceholders.size() == 1 &&
         fRuns.size() == 1 && fRuns[0].fAdvance.fX <= maxWidth) {
@@ -618,18 +630,24 @@ void ParagraphImpl::breakShapedTextIntoLines(SkScalar maxWidth) {
         advance.fY = metrics.height();
         auto clusterRange = ClusterRange(0, trailingSpaces);
         auto clusterRangeWithGhosts = ClusterRange(0, this->clusters().size() - 1);
-        this->addLine(SkPoint::Make(0, 0), advance,
-                      textExcludingSpaces, textRange, textRange,
-                      clusterRange, clusterRangeWithGhosts, run.advance().x(),
-                      metrics);
+        if (fMeasureOnly) {
+            fLineCount = 1;
+            fFirstLineMetrics = metrics;
+        } else {
+            this->addLine(SkPoint::Make(0, 0), advance,
+                          textExcludingSpaces, textRange, textRange,
+                          clusterRange, clusterRangeWithGhosts, run.advance().x(),
+                          metrics);
+        }
 
         fLongestLine = nearlyZero(advance.fX) ? run.advance().fX : advance.fX;
         fHeight = advance.fY;
         fWidth = maxWidth;
         fMaxIntrinsicWidth = run.advance().fX;
         fMinIntrinsicWidth = advance.fX;
-        fAlphabeticBaseline = fLines.empty() ? fEmptyMetrics.alphabeticBaseline() : fLines.front().alphabeticBaseline();
-        fIdeographicBaseline = fLines.empty() ? fEmptyMetrics.ideographicBaseline() : fLines.front().ideographicBaseline();
+        auto firstLine = this->firstLineMetrics();
+        fAlphabeticBaseline = firstLine.alphabeticBaseline();
+        fIdeographicBaseline = firstLine.ideographicBaseline();
         fExceededMaxLines = false;
         return;
     }
@@ -650,6 +668,23 @@ void ParagraphImpl::breakShapedTextIntoLines(SkScalar maxWidth) {
                 SkVector advance,
                 InternalLineMetrics metrics,
                 bool addEllipsis) {
+                if (fMeasureOnly) {
+                    SkScalar width = advance.fX;
+                    if (addEllipsis) {
+                        // The ellipsis width depends on the runs it replaces, so this one line
+                        // has to be built
+                        TextLine line(this, offset, advance, this->findAllBlocks(textExcludingSpaces),
+                                      textExcludingSpaces, text, textWithNewlines,
+                                      clusters, clustersWithGhosts, widthWithSpaces, metrics);
+                        line.createEllipsis(maxWidth, this->getEllipsis(), true);
+                        width = line.width();
+                    }
+                    if (fLineCount++ == 0) {
+                        fFirstLineMetrics = metrics;
+                    }
+                    fLongestLine = std::max(fLongestLine, nearlyZero(width) ? widthWithSpaces : width);
+                    return;
+                }
                 // TODO: Take in account clipped edges
                 auto& line = this->addLine(offset, advance, textExcludingSpaces, text, textWithNewlines, clusters, clustersWithGhosts, widthWithSpaces, metrics);
                 if (addEllipsis) {
@@ -662,8 +697,9 @@ void ParagraphImpl::breakShapedTextIntoLines(SkScalar maxWidth) {
     fWidth = maxWidth;
     fMaxIntrinsicWidth = textWrapper.maxIntrinsicWidth();
     fMinIntrinsicWidth = textWrapper.minIntrinsicWidth();
-    fAlphabeticBaseline = fLines.empty() ? fEmptyMetrics.alphabeticBaseline() : fLines.front().alphabeticBaseline();
-    fIdeographicBaseline = fLines.empty() ? fEmptyMetrics.ideographicBaseline() : fLines.front().ideographicBaseline();
+    auto firstLine = this->firstLineMetrics();
+    fAlphabeticBaseline = firstLine.alphabeticBaseline();
+    fIdeographicBaseline = firstLine.ideographicBaseline();
     fExceededMaxLines = textWrapper.exceededMaxLines();
 }
 
@@ -676,6 +712,7 @@ void ParagraphImpl::formatLines(SkScalar maxWidth) {
         // Special case: clean all text in case of maxWidth == INF & align != left
         // We had to go through shaping though because we need all the measurement numbers
         fLines.clear();
+        fLineCount = 0;
         return;
     }
 
@@ -760,6 +797,13 @@ BlockRange ParagraphImpl::findAllBlocks(TextRange textRange) {
     return { begin, end + 1 };
 }
 
+InternalLineMetrics ParagraphImpl::firstLineMetrics() const {
+    if (fMeasureOnly) {
+        return fLineCount == 0 ? fEmptyMetrics : fFirstLineMetrics;
+    }
+    return fLines.empty() ? fEmptyMetrics : fLines.front().sizes();
+}
+
 TextLine& ParagraphImpl::addLine(SkVector offset,
                                  SkVector advance,
                                  TextRange textExcludingSpaces,
@@ -996,6 +1040,7 @@ void ParagraphImpl::setState(InternalState state) {
 
         case kShaped:
             fLines.clear();
+            fLineCount = 0;
             [[fallthrough]];
 
         case kLineBroken:
@@ -1120,6 +1165,399 @@ void ParagraphImpl::updateBackgroundPaint(size_t from, size_t to, SkPaint paint)
     }
 }
 
+void ParagraphImpl::updateText(size_t from, size_t to, const SkString& text) {
+    SkASSERT(from <= to && to <= fText.size());
+
+    size_t unchangedLines = 0;
+    if (!this->reshapeEditedText(from, to, text, &unchangedLines)) {
+        this->replaceText(from, to, text);
+        fHasLineBreaks = false;
+        fHasWhitespacesInside = false;
+        fCodeUnitProperties.clear();
+        fState = kUnknown;
+    }
+
+    // The next layout keeps the lines before the edit if it has the same width
+    fLines.pop_back_n(fLines.size() - SkToInt(unchangedLines));
+    fLineBreakStates.pop_back_n(fLineBreakStates.size() - SkToInt(unchangedLines));
+    fKeepLines = unchangedLines > 0;
+    fLineCount = 0;
+    fPicture = nullptr;
+    fWords.clear();
+    if (!fKeepLines) {
+        fOldWidth = 0;
+        fOldHeight = 0;
+    }
+}
+
+void ParagraphImpl::replaceText(size_t from, size_t to, const SkString& text) {
+    const size_t oldSize = fText.size();
+    const size_t end = from + text.size();
+    auto mapStart = [&](size_t pos) {
+        return pos <= from ? pos : (pos >= to ? pos + end - to : end);
+    };
+    auto mapEnd = [&](size_t pos) {
+        if (pos < from || (pos == from && from < oldSize)) {
+            return pos;
+        }
+        return pos >= to ? pos + end - to : end;
+    };
+    // Placeholders stay after the inserted text
+    auto mapAfter = [&](size_t pos) {
+        return pos < from ? pos : (pos >= to ? pos + end - to : end);
+    };
+
+    SkString newText(fText.c_str(), from);
+    newText.append(text);
+    newText.append(fText.c_str() + to, oldSize - to);
+    fText = std::move(newText);
+
+    for (auto& block : fTextStyles) {
+        auto start = mapStart(block.fRange.start);
+        block.fRange = TextRange(start, block.fRange.width() == 0 ? start : mapEnd(block.fRange.end));
+    }
+    TextIndex textBefore = 0;
+    for (auto& placeholder : fPlaceholders) {
+        placeholder.fRange = TextRange(mapAfter(placeholder.fRange.start),
+                                       mapAfter(placeholder.fRange.end));
+        placeholder.fTextBefore = TextRange(textBefore, placeholder.fRange.start);
+        textBefore = placeholder.fRange.end;
+    }
+    for (auto& fontSwitch : fFontSwitches) {
+        fontSwitch.fTextStart = mapStart(fontSwitch.fTextStart);
+    }
+
+    // The mapping is filled lazily only once; refill it now if it has been used
+    if (!fUTF8IndexForUTF16Index.empty()) {
+        fUTF8IndexForUTF16Index.clear();
+        fUTF16IndexForUTF8Index.clear();
+        SkUnicode::extractUtfConversionMapping(
+                this->text(),
+                [&](size_t index) { fUTF8IndexForUTF16Index.emplace_back(index); },
+                [&](size_t index) { fUTF16IndexForUTF8Index.emplace_back(index); });
+    }
+}
+
+// Resizes the `count` elements at `index` to `newCount` elements, moving the elements after them
+template <typename T>
+static void resize_range(TArray<T, true>* array, int index, int count, int newCount) {
+    if (newCount > count) {
+        const int oldSize = array->size();
+        array->push_back_n(newCount - count);
+        std::move_backward(array->begin() + index + count, array->begin() + oldSize, array->end());
+    } else if (newCount < count) {
+        std::move(array->begin() + index + count, array->end(), array->begin() + index + newCount);
+        array->pop_back_n(count - newCount);
+    }
+}
+
+// Typing changes one word at a time, so instead of reshaping the entire paragraph we reshape
+// the words around the edit and splice the glyphs into the run they belong to.
+// Only the code unit properties and the clusters of these words are computed again; the runs and
+// the clusters after them are shifted in place. The lines before the words stay as they are, and
+// the next layout restarts line breaking after them (see TextWrapper::breakTextIntoLines).
+// We only do it in simple cases: left-to-right text, no placeholders, no spacing and the words
+// shaped into a single run with the same font; everything else is reshaped from scratch.
+bool ParagraphImpl::reshapeEditedText(size_t from, size_t to, const SkString& text,
+                                      size_t* unchangedLines) {
+    if (fState < kShaped || fRuns.empty() ||
+        fParagraphStyle.getTextDirection() != TextDirection::kLtr ||
+        fPlaceholders.size() != 1 ||
+        fBidiRegions.size() != 1 || fBidiRegions.front().level != 0) {
+        return false;
+    }
+    for (auto& block : fTextStyles) {
+        if (!SkScalarNearlyZero(block.fStyle.getLetterSpacing()) ||
+            !SkScalarNearlyZero(block.fStyle.getWordSpacing())) {
+            return false;
+        }
+    }
+
+    // Expand the edit to the whitespaces around it; shaping does not depend on the text beyond
+    auto isWhiteSpace = [this](size_t index) {
+        return this->codeUnitHasProperty(index, SkUnicode::CodeUnitFlags::kPartOfWhiteSpaceBreak);
+    };
+    TextIndex start = from;
+    while (start > 0 && !isWhiteSpace(start - 1)) {
+        --start;
+    }
+    TextIndex end = to;
+    while (end < fText.size() && !isWhiteSpace(end)) {
+        ++end;
+    }
+
+    // Find the run and the glyphs to replace
+    Run* edited = nullptr;
+    for (auto& run : fRuns) {
+        if (!run.leftToRight() || run.isPlaceholder()) {
+            return false;
+        }
+        if (run.fTextRange.start <= start && end <= run.fTextRange.end) {
+            edited = &run;
+        }
+    }
+    if (edited == nullptr) {
+        return false;
+    }
+    auto findGlyph = [edited](TextIndex textIndex) {
+        size_t glyph = 0;
+        while (glyph < edited->size() && edited->globalClusterIndex(glyph) < textIndex) {
+            ++glyph;
+        }
+        return glyph;
+    };
+    const size_t glyphStart = findGlyph(start);
+    const size_t glyphEnd = findGlyph(end);
+    if (edited->globalClusterIndex(glyphStart) != start ||
+        edited->globalClusterIndex(glyphEnd) != end) {
+        // A glyph cluster crosses the edit boundaries
+        return false;
+    }
+    // All the styles touching the words must have the same fonts
+    const TextStyle* style = nullptr;
+    for (auto& block : fTextStyles) {
+        if (block.fRange.width() == 0 || block.fRange.end < start || block.fRange.start > end) {
+            continue;
+        }
+        if (style == nullptr) {
+            style = &block.fStyle;
+        } else if (!style->equalsByFonts(block.fStyle)) {
+            return false;
+        }
+    }
+    if (style == nullptr) {
+        return false;
+    }
+
+    // Shape the new words on their own
+    const size_t newEnd = end + text.size() - (to - from);
+    SkString newWords(fText.c_str() + start, from - start);
+    newWords.append(text);
+    newWords.append(fText.c_str() + to, end - to);
+    SkASSERT(newWords.size() == newEnd - start);
+    std::unique_ptr<Paragraph> shaped;
+    const Run* words = nullptr;
+    if (!newWords.isEmpty()) {
+        ParagraphBuilderImpl builder(fParagraphStyle, fFontCollection, fUnicode);
+        builder.pushStyle(*style);
+        builder.addText(newWords.c_str(), newWords.size());
+        shaped = builder.Build();
+        auto impl = static_cast<ParagraphImpl*>(shaped.get());
+        if (!impl->computeCodeUnitProperties()) {
+            return false;
+        }
+        impl->fClustersIndexFromCodeUnit.push_back_n(newWords.size() + 1, EMPTY_INDEX);
+        if (!impl->shapeTextIntoEndlessLine() ||
+            impl->fRuns.size() != 1 || impl->fUnresolvedGlyphs != 0) {
+            return false;
+        }
+        words = &impl->fRuns.front();
+        if (!(words->fFont == edited->fFont) || words->fBidiLevel != edited->fBidiLevel) {
+            return false;
+        }
+    }
+
+    // Compute the properties of the new words with a word of context on either side,
+    // so the breaks at their edges are the same as in the entire text
+    TextIndex contextStart = start;
+    while (contextStart > 0 && isWhiteSpace(contextStart - 1)) {
+        --contextStart;
+    }
+    while (contextStart > 0 && !isWhiteSpace(contextStart - 1)) {
+        --contextStart;
+    }
+    TextIndex contextEnd = end;
+    while (contextEnd < fText.size() && isWhiteSpace(contextEnd)) {
+        ++contextEnd;
+    }
+    while (contextEnd < fText.size() && !isWhiteSpace(contextEnd)) {
+        ++contextEnd;
+    }
+    SkString context(fText.c_str() + contextStart, start - contextStart);
+    context.append(newWords);
+    context.append(fText.c_str() + end, contextEnd - end);
+    TArray<SkUnicode::CodeUnitFlags, true> properties;
+    if (!fUnicode->computeCodeUnitFlags(context.data(),
+                                        context.size(),
+                                        this->paragraphStyle().getReplaceTabCharacters(),
+                                        &properties)) {
+        return false;
+    }
+
+    // The lines before the words are not affected, except the line before the one starting
+    // with them: the words might fit on it now. We keep them if the lines can be broken again
+    // from there (see TextWrapper::breakTextIntoLines).
+    *unchangedLines = 0;
+    if (fState >= kLineBroken && !fMeasureOnly && fLineBreakStates.size() == fLines.size() &&
+        !fParagraphStyle.ellipsized() &&
+        fParagraphStyle.effective_align() != TextAlign::kJustify) {
+        int line = fLines.size() - 1;
+        while (line > 0 && fLines[line].textWithNewlines().start > start) {
+            --line;
+        }
+        if (line > 0 && fLines[line].textWithNewlines().start == start &&
+            !fLines[line - 1].endsWithHardLineBreak()) {
+            --line;
+        }
+        // The line breaking has to restart on a line with some clusters
+        while (line > 0 &&
+               fLines[line - 1].clustersWithSpaces().end >= SkToSizeT(fClusters.size() - 1)) {
+            --line;
+        }
+        *unchangedLines = line;
+    }
+
+    // Splice the new glyphs into the edited run and shift everything after them.
+    // Glyph data is shared with ParagraphCache so we have to copy it.
+    const SkScalar oldWidth = edited->posX(glyphEnd) - edited->posX(glyphStart);
+    const SkScalar dx = (words ? words->fAdvance.fX : 0) - oldWidth;
+    const int64_t delta = (int64_t)newEnd - (int64_t)end;
+    const size_t wordsGlyphEnd = glyphStart + (words ? words->size() : 0);
+    const int64_t glyphDelta = (int64_t)wordsGlyphEnd - (int64_t)glyphEnd;
+    {
+        auto data = std::make_shared<Run::GlyphData>();
+        data->glyphs.push_back_n(glyphStart, edited->fGlyphs.data());
+        data->positions.push_back_n(glyphStart, edited->fPositions.data());
+        data->offsets.push_back_n(glyphStart, edited->fOffsets.data());
+        data->clusterIndexes.push_back_n(glyphStart, edited->fClusterIndexes.data());
+        if (words) {
+            const SkPoint origin = edited->fPositions[glyphStart];
+            const uint32_t clusterShift =
+                    SkToU32(start + words->fClusterStart - edited->fClusterStart);
+            for (size_t i = 0; i < words->size(); ++i) {
+                data->glyphs.push_back(words->fGlyphs[i]);
+                data->positions.push_back(origin + (words->fPositions[i] - words->fOffset));
+                data->offsets.push_back(words->fOffsets[i]);
+                data->clusterIndexes.push_back(clusterShift + words->fClusterIndexes[i]);
+            }
+        }
+        // Positions, offsets and clusters have an extra element at the end
+        for (size_t i = glyphEnd; i <= edited->size(); ++i) {
+            if (i < edited->size()) {
+                data->glyphs.push_back(edited->fGlyphs[i]);
+            }
+            data->positions.push_back(edited->fPositions[i] + SkVector::Make(dx, 0));
+            data->offsets.push_back(edited->fOffsets[i]);
+            data->clusterIndexes.push_back(SkToU32(edited->fClusterIndexes[i] + delta));
+        }
+        Run spliced(*edited, std::move(data));
+        spliced.fTextRange.end += delta;
+        spliced.fAdvance.fX += dx;
+        spliced.fUtf8Range = SkShaper::RunHandler::Range(edited->fUtf8Range.begin(),
+                                                         edited->fUtf8Range.size() + delta);
+        spliced.resetJustificationShifts();
+        edited->~Run();
+        new (edited) Run(std::move(spliced));
+    }
+    // Glyph positions are only used relative to the other glyphs of their run,
+    // so the runs after the edited one keep their (shared) glyphs
+    for (auto run = edited + 1; run < fRuns.end(); ++run) {
+        run->fTextRange = TextRange(run->fTextRange.start + delta, run->fTextRange.end + delta);
+        run->fClusterStart += delta;
+        run->fOffset.fX += dx;
+        run->resetJustificationShifts();
+    }
+
+    // Clusters and code units to replace
+    const int clusterStart = SkToInt(fClustersIndexFromCodeUnit[start]);
+    const int clusterEnd = SkToInt(fClustersIndexFromCodeUnit[end]);
+    const bool hadLineBreaks = fHasLineBreaks;
+    bool removedLineBreak = false;
+    for (auto i = start; i <= end && hadLineBreaks; ++i) {
+        removedLineBreak |= SkUnicode::hasHardLineBreakFlag(fCodeUnitProperties[i]);
+    }
+
+    // Tabulations in the new text have been replaced along with the properties
+    this->replaceText(from, to, SkString(context.c_str() + (from - contextStart), text.size()));
+    fBidiRegions.front().end = fText.size();
+
+    resize_range(&fCodeUnitProperties,
+                 SkToInt(start), SkToInt(end - start + 1), SkToInt(newEnd - start + 1));
+    for (auto i = start; i <= newEnd; ++i) {
+        fCodeUnitProperties[i] = properties[i - contextStart];
+    }
+    // The properties that buildClusterTable adds to the edges of the runs
+    for (auto index : {edited->fTextRange.start, edited->fTextRange.end}) {
+        fCodeUnitProperties[index] |= SkUnicode::CodeUnitFlags::kGraphemeStart;
+        fCodeUnitProperties[index] |= SkUnicode::CodeUnitFlags::kGlyphClusterStart;
+    }
+    fCodeUnitProperties[newEnd] |= SkUnicode::CodeUnitFlags::kGlyphClusterStart;
+
+    // What computeCodeUnitProperties finds in the entire text
+    if (!hadLineBreaks || removedLineBreak) {
+        auto first = removedLineBreak ? 0 : start;
+        auto last = removedLineBreak ? fText.size() : newEnd;
+        fHasLineBreaks = false;
+        for (auto i = first; i <= last && !fHasLineBreaks; ++i) {
+            fHasLineBreaks = SkUnicode::hasHardLineBreakFlag(fCodeUnitProperties[i]);
+        }
+    }
+    int trailingSpaces = fCodeUnitProperties.size();
+    while (trailingSpaces > 0 &&
+           SkUnicode::hasPartOfWhiteSpaceBreakFlag(fCodeUnitProperties[trailingSpaces - 1])) {
+        --trailingSpaces;
+    }
+    fTrailingSpaces = trailingSpaces == fCodeUnitProperties.size() ? fText.size() : trailingSpaces;
+    fHasWhitespacesInside = false;
+    for (TextIndex i = 0; i < fTrailingSpaces && !fHasWhitespacesInside; ++i) {
+        fHasWhitespacesInside = SkUnicode::hasPartOfWhiteSpaceBreakFlag(fCodeUnitProperties[i]);
+    }
+
+    // Make the clusters of the new words (left-to-right, as in iterateThroughClustersInTextOrder)
+    resize_range(&fClustersIndexFromCodeUnit,
+                 SkToInt(start), SkToInt(end - start), SkToInt(newEnd - start));
+    STArray<16, Cluster, true> clusters;
+    for (size_t glyph = glyphStart; glyph < wordsGlyphEnd;) {
+        size_t next = glyph + 1;
+        while (next < wordsGlyphEnd && edited->clusterIndex(next) <= edited->clusterIndex(glyph)) {
+            ++next;
+        }
+        const TextRange clusterText(edited->globalClusterIndex(glyph),
+                                    edited->globalClusterIndex(next));
+        for (auto i = clusterText.start; i < clusterText.end; ++i) {
+            fClustersIndexFromCodeUnit[i] = clusterStart + clusters.size();
+        }
+        clusters.emplace_back(this, edited->index(), glyph, next, this->text(clusterText),
+                              edited->calculateWidth(glyph, next, next == edited->size()),
+                              edited->calculateHeight(LineMetricStyle::CSS, LineMetricStyle::CSS));
+        fCodeUnitProperties[clusterText.start] |= SkUnicode::CodeUnitFlags::kGlyphClusterStart;
+        glyph = next;
+    }
+    const int clusterDelta = clusters.size() - (clusterEnd - clusterStart);
+    for (auto i = newEnd; i <= fText.size(); ++i) {
+        fClustersIndexFromCodeUnit[i] += clusterDelta;
+    }
+
+    // Replace the clusters and shift the ones after them
+    resize_range(&fClusters, clusterStart, clusterEnd - clusterStart, clusters.size());
+    std::copy(clusters.begin(), clusters.end(), fClusters.begin() + clusterStart);
+    for (auto cluster = fClusters.begin() + clusterStart + clusters.size();
+         cluster < fClusters.end(); ++cluster) {
+        cluster->fTextRange = TextRange(cluster->fTextRange.start + delta,
+                                        cluster->fTextRange.end + delta);
+        if (cluster->fRunIndex == edited->index()) {
+            cluster->fStart += glyphDelta;
+            cluster->fEnd += glyphDelta;
+        }
+    }
+    // The clusters next to the words end at the properties that changed
+    for (auto index : {clusterStart - 1, clusterStart + clusters.size()}) {
+        if (index >= 0) {
+            auto& cluster = fClusters[index];
+            cluster.fIsHardBreak = this->codeUnitHasProperty(
+                    cluster.fTextRange.end, SkUnicode::CodeUnitFlags::kHardLineBreakBefore);
+        }
+    }
+    edited->setClusterRange(edited->fClusterRange.start, edited->fClusterRange.end + clusterDelta);
+    for (auto run = edited + 1; run < fRuns.end(); ++run) {
+        run->setClusterRange(run->fClusterRange.start + clusterDelta,
+                             run->fClusterRange.end + clusterDelta);
+    }
+
+    fState = kShaped;
+    return true;
+}
+
 TArray<TextIndex> ParagraphImpl::countSurroundingGraphemes(TextRange textRange) const {
     textRange = textRange.intersection({0, fText.size()});
     TArray<TextIndex> graphemes;
@@ -119,7 +119,14 @@ public:
 
     bool getApplyRoundingHack() const { return fParagraphStyle.getApplyRoundingHack(); }
 
-    size_t lineNumber() override { return fLines.size(); }
+    size_t lineNumber() override { return fMeasureOnly ? fLineCount : fLines.size(); }
+
+    // In measure-only mode line breaking only counts the lines and keeps the paragraph metrics;
+    // no TextLines are created (see ParagraphBuilder::setMeasureOnly). Runs and clusters are
+    // built as usual: TextWrapper walks the clusters, and ParagraphCache shares the runs with
+    // paragraphs that are not measure-only.
+    void setMeasureOnly(bool measureOnly) { fMeasureOnly = measureOnly; }
+    bool measureOnly() const { return fMeasureOnly; }
 
     TextLine& addLine(SkVector offset, SkVector advance,
                       TextRange textExcludingSpaces, TextRange text, TextRange textIncludingNewlines,
@@ -207,6 +214,7 @@ public:
     void updateFontSize(size_t from, size_t to, SkScalar fontSize) override;
     void updateForegroundPaint(size_t from, size_t to, SkPaint paint) override;
     void updateBackgroundPaint(size_t from, size_t to, SkPaint paint) override;
+    void updateText(size_t from, size_t to, const SkString& text) override;
 
     void visit(const Visitor&) override;
     void extendedVisit(const ExtendedVisitor&) override;
@@ -233,6 +241,7 @@ public:
     InternalLineMetrics getStrutMetrics() const { return fStrutMetrics; }
 
     BlockRange findAllBlocks(TextRange textRange);
+    InternalLineMetrics firstLineMetrics() const;
 
     void resetShifts() {
         for (auto& run : fRuns) {
@@ -257,6 +266,19 @@ private:
 
     void computeEmptyMetrics();
 
+    void replaceText(size_t from, size_t to, const SkString& text);
+    bool reshapeEditedText(size_t from, size_t to, const SkString& text, size_t* unchangedLines);
+
+    // The state of TextWrapper after a line, to restart line breaking from the next one
+    struct LineBreakState {
+        SkScalar fHeight;
+        SkScalar fMinIntrinsicWidth;
+        SkScalar fMaxIntrinsicWidth;
+        SkScalar fSoftLineMaxIntrinsicWidth;
+        SkScalar fMaxWidthWithTrailingSpaces;
+        SkScalar fLongestLine;
+    };
+
     // Input
     skia_private::TArray<StyleBlock<SkScalar>> fLetterSpaceStyles;
     skia_private::TArray<StyleBlock<SkScalar>> fWordSpaceStyles;
@@ -285,6 +307,8 @@ private:
     std::unordered_set<SkUnichar> fUnresolvedCodepoints;
 
     skia_private::TArray<TextLine, false> fLines;   // kFormatted   (cached: width, max lines, ellipsis, text align)
+    skia_private::TArray<LineBreakState, true> fLineBreakStates;    // One for each line
+    bool fKeepLines;                    // fLines holds the lines before an edit (see updateText)
     sk_sp<SkPicture> fPicture;          // kRecorded    (cached: text styles)
 
     skia_private::TArray<ResolvedFontDescriptor> fFontSwitches;
@@ -300,6 +324,10 @@ private:
     bool fHasLineBreaks;
     bool fHasWhitespacesInside;
     TextIndex fTrailingSpaces;
+
+    bool fMeasureOnly;
+    size_t fLineCount;                  // kLineBroken  (measure-only mode)
+    InternalLineMetrics fFirstLineMetrics;
 };
 }  // namespace textlayout
 }  // namespace skia
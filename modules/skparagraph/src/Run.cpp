@@ -58,6 +58,33 @@ Run::Run(ParagraphImpl* owner,
     fPlaceholderIndex = std::numeric_limits<size_t>::max();
 }
 
+Run::Run(const Run& run, std::shared_ptr<GlyphData> glyphData)
+    : fOwner(run.fOwner)
+    , fTextRange(run.fTextRange)
+    , fClusterRange(run.fClusterRange)
+    , fFont(run.fFont)
+    , fPlaceholderIndex(run.fPlaceholderIndex)
+    , fIndex(run.fIndex)
+    , fAdvance(run.fAdvance)
+    , fOffset(run.fOffset)
+    , fClusterStart(run.fClusterStart)
+    , fUtf8Range(run.fUtf8Range)
+    , fGlyphData(std::move(glyphData))
+    , fGlyphs(fGlyphData->glyphs)
+    , fPositions(fGlyphData->positions)
+    , fOffsets(fGlyphData->offsets)
+    , fClusterIndexes(fGlyphData->clusterIndexes)
+    , fJustificationShifts(run.fJustificationShifts)
+    , fFontMetrics(run.fFontMetrics)
+    , fHeightMultiplier(run.fHeightMultiplier)
+    , fUseHalfLeading(run.fUseHalfLeading)
+    , fBaselineShift(run.fBaselineShift)
+    , fCorrectAscent(run.fCorrectAscent)
+    , fCorrectDescent(run.fCorrectDescent)
+    , fCorrectLeading(run.fCorrectLeading)
+    , fEllipsis(run.fEllipsis)
+    , fBidiLevel(run.fBidiLevel) {}
+
 void Run::calculateMetrics() {
     fCorrectAscent = fFontMetrics.fAscent - fFontMetrics.fLeading * 0.5;
     fCorrectDescent = fFontMetrics.fDescent + fFontMetrics.fLeading * 0.5;
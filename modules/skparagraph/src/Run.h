@@ -199,6 +199,9 @@ private:
     skia_private::STArray<64, SkPoint, true>& fOffsets;
     skia_private::STArray<64, uint32_t, true>& fClusterIndexes;
 
+    // Copies the run but not its glyphs (used to edit the run in place, see ParagraphImpl::updateText)
+    Run(const Run& run, std::shared_ptr<GlyphData> glyphData);
+
     skia_private::STArray<64, SkPoint, true> fJustificationShifts; // For justification
                                                                    // (current and prev shifts)
 
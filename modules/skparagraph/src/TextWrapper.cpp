@@ -301,6 +301,35 @@ void TextWrapper::breakTextIntoLines(ParagraphImpl* parent,
     auto start = span.begin();
     InternalLineMetrics maxRunMetrics;
     bool needEllipsis = false;
+    // In measure-only mode addLine doesn't create TextLines, so parent->lines() can't tell us
+    // whether a line has been placed yet.
+    bool addedLine = false;
+    if (!parent->fLines.empty()) {
+        // The lines before an edit are kept (see ParagraphImpl::reshapeEditedText):
+        // restart from the line after them
+        SkASSERT(parent->fLineBreakStates.size() == parent->fLines.size());
+        const auto& state = parent->fLineBreakStates.back();
+        auto startLine = start + parent->fLines.back().clustersWithSpaces().end;
+        SkASSERT(startLine < end);
+        fEndLine = TextStretch(startLine, startLine, parent->strutForceHeight());
+        fLineNumber = parent->fLines.size() + 1;
+        fHeight = state.fHeight;
+        fMinIntrinsicWidth = state.fMinIntrinsicWidth;
+        fMaxIntrinsicWidth = state.fMaxIntrinsicWidth;
+        softLineMaxIntrinsicWidth = state.fSoftLineMaxIntrinsicWidth;
+        parent->fMaxWidthWithTrailingSpaces = state.fMaxWidthWithTrailingSpaces;
+        parent->fLongestLine = state.fLongestLine;
+        firstLine = false;
+        addedLine = true;
+    }
+    auto saveState = [&]() {
+        parent->fLineBreakStates.push_back({fHeight,
+                                            fMinIntrinsicWidth,
+                                            fMaxIntrinsicWidth,
+                                            softLineMaxIntrinsicWidth,
+                                            parent->fMaxWidthWithTrailingSpaces,
+                                            parent->fLongestLine});
+    };
     while (fEndLine.endCluster() != end) {
 
         this->lookAhead(maxWidth, end, parent->getApplyRoundingHack());
@@ -396,6 +425,7 @@ void TextWrapper::breakTextIntoLines(ParagraphImpl* parent,
                 SkVector::Make(fEndLine.width(), lineHeight),
                 fEndLine.metrics(),
                 needEllipsis && !fHardLineBreak);
+        addedLine = true;
 
         softLineMaxIntrinsicWidth += widthWithSpaces;
 
@@ -410,6 +440,7 @@ void TextWrapper::breakTextIntoLines(ParagraphImpl* parent,
         }
         fEndLine.startFrom(startLine, pos);
         parent->fMaxWidthWithTrailingSpaces = std::max(parent->fMaxWidthWithTrailingSpaces, widthWithSpaces);
+        saveState();
 
         if (hasEllipsis && unlimitedLines) {
             // There is one case when we need an ellipsis on a separate line
@@ -461,7 +492,7 @@ void TextWrapper::breakTextIntoLines(ParagraphImpl* parent,
         fMinIntrinsicWidth = std::max(fMinIntrinsicWidth, lastWordLength);
         fMaxIntrinsicWidth = std::max(fMaxIntrinsicWidth, softLineMaxIntrinsicWidth);
 
-        if (parent->lines().empty()) {
+        if (!addedLine) {
             // In case we could not place even a single cluster on the line
             if (disableFirstAscent) {
                 fEndLine.metrics().fAscent = fEndLine.metrics().fRawAscent;
@@ -498,7 +529,10 @@ void TextWrapper::breakTextIntoLines(ParagraphImpl* parent,
                 fEndLine.metrics(),
                 needEllipsis);
         fHeight += fEndLine.metrics().height();
-        parent->lines().back().setMaxRunMetrics(maxRunMetrics);
+        saveState();
+        if (!parent->measureOnly()) {
+            parent->lines().back().setMaxRunMetrics(maxRunMetrics);
+        }
     }
 
     if (parent->lines().empty()) {
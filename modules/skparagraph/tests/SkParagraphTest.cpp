@@ -7,6 +7,7 @@
 #include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkFontMgr.h"
 #include "include/core/SkFontStyle.h"
 #include "include/core/SkPaint.h"
@@ -5608,6 +5609,306 @@ UNIX_ONLY_TEST(SkParagraph_CacheStyles, reporter) {
     test(2, false);
 }
 
+UNIX_ONLY_TEST(SkParagraph_CachePaints, reporter) {
+    ParagraphCache cache;
+    cache.turnOn(true);
+    sk_sp<ResourceFontCollection> fontCollection = sk_make_sp<ResourceFontCollection>();
+    SKIP_IF_FONTS_NOT_FOUND(reporter, fontCollection)
+
+    ParagraphStyle paragraph_style;
+    paragraph_style.turnHintingOff();
+
+    TextStyle text_style;
+    text_style.setFontFamilies({SkString("Roboto")});
+    text_style.setColor(SK_ColorBLACK);
+
+    auto test = [&](SkColor color1, SkColor color2, int count, bool expectedToBeFound) {
+        ParagraphBuilderImpl builder(paragraph_style, fontCollection, get_unicode());
+        text_style.setColor(color1);
+        builder.pushStyle(text_style);
+        builder.addText("te");
+        builder.pop();
+        text_style.setColor(color2);
+        text_style.setDecoration(color1 == color2 ? TextDecoration::kNoDecoration
+                                                  : TextDecoration::kUnderline);
+        builder.pushStyle(text_style);
+        builder.addText("xt");
+        builder.pop();
+        auto paragraph = builder.Build();
+        auto impl = static_cast<ParagraphImpl*>(paragraph.get());
+
+        REPORTER_ASSERT(reporter, count == cache.count());
+        auto found = cache.findParagraph(impl);
+        REPORTER_ASSERT(reporter, found == expectedToBeFound);
+        auto added = cache.updateParagraph(impl);
+        REPORTER_ASSERT(reporter, added != expectedToBeFound);
+    };
+
+    // Paint and decorations do not affect shaping
+    test(SK_ColorBLACK, SK_ColorBLACK, 0, false);
+    test(SK_ColorBLACK, SK_ColorRED, 1, true);
+    test(SK_ColorBLUE, SK_ColorGREEN, 1, true);
+
+    auto stats = cache.stats();
+    REPORTER_ASSERT(reporter, stats.fLookups == 3);
+    REPORTER_ASSERT(reporter, stats.fHits == 2);
+    REPORTER_ASSERT(reporter, stats.fCount == 1);
+    REPORTER_ASSERT(reporter, stats.fBytes > 0);
+}
+
+UNIX_ONLY_TEST(SkParagraph_CacheLimits, reporter) {
+    sk_sp<ResourceFontCollection> fontCollection = sk_make_sp<ResourceFontCollection>();
+    SKIP_IF_FONTS_NOT_FOUND(reporter, fontCollection)
+
+    ParagraphStyle paragraph_style;
+    paragraph_style.turnHintingOff();
+
+    TextStyle text_style;
+    text_style.setFontFamilies({SkString("Roboto")});
+    text_style.setColor(SK_ColorBLACK);
+
+    auto add = [&](ParagraphCache* cache, int count) {
+        for (int i = 0; i < count; ++i) {
+            ParagraphBuilderImpl builder(paragraph_style, fontCollection, get_unicode());
+            builder.pushStyle(text_style);
+            builder.addText(SkStringPrintf("text%d", i).c_str());
+            builder.pop();
+            auto paragraph = builder.Build();
+            auto impl = static_cast<ParagraphImpl*>(paragraph.get());
+            if (!cache->findParagraph(impl)) {
+                cache->updateParagraph(impl);
+            }
+        }
+    };
+
+    ParagraphCache::Options options;
+    options.fMaxEntries = 16;
+    options.fShardCount = 4;
+    ParagraphCache cache(options);
+    add(&cache, 100);
+    REPORTER_ASSERT(reporter, cache.count() > 0);
+    REPORTER_ASSERT(reporter, cache.count() <= 16);
+
+    // Every shard keeps at least its most recent paragraph
+    options.fMaxBytes = 1;
+    cache.setOptions(options);
+    REPORTER_ASSERT(reporter, cache.count() == 0);
+    add(&cache, 100);
+    REPORTER_ASSERT(reporter, cache.count() <= options.fShardCount);
+}
+
+UNIX_ONLY_TEST(SkParagraph_UpdateText, reporter) {
+    sk_sp<ResourceFontCollection> fontCollection = sk_make_sp<ResourceFontCollection>();
+    SKIP_IF_FONTS_NOT_FOUND(reporter, fontCollection)
+    fontCollection->getParagraphCache()->turnOn(false);
+
+    ParagraphStyle paragraph_style;
+    paragraph_style.turnHintingOff();
+    TextStyle text_style;
+    text_style.setFontFamilies({SkString("Roboto")});
+    text_style.setFontSize(20);
+    text_style.setColor(SK_ColorBLACK);
+
+    auto make = [&](const SkString& text) {
+        ParagraphBuilderImpl builder(paragraph_style, fontCollection, get_unicode());
+        builder.pushStyle(text_style);
+        builder.addText(text.c_str(), text.size());
+        builder.pop();
+        auto paragraph = builder.Build();
+        paragraph->layout(300);
+        return paragraph;
+    };
+
+    SkString text("Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod");
+    auto paragraph = make(text);
+
+    struct Edit {
+        size_t from;
+        size_t to;
+        const char* text;
+    };
+    const Edit edits[] = {
+        {  6,  6, "x" },        // typing inside a word
+        {  6,  7, "" },         // backspace
+        { 12, 17, "pain" },     // replacing a word
+        {  8,  8, " " },        // splitting a word
+        {  8,  9, "" },         // joining the words back
+        { 70, 70, " tempor" },  // typing at the end
+        { 60, 60, "y" },        // typing on a later line (the lines before it are kept)
+        { 40, 40, "\n" },       // breaking the line
+        { 64, 64, "z" },        // typing after the line break
+        { 40, 41, "" },         // joining the lines back
+        {  0, 100, "short" },   // replacing everything
+    };
+    for (auto& edit : edits) {
+        auto to = std::min(edit.to, text.size());
+        SkString expected(text.c_str(), edit.from);
+        expected.append(edit.text);
+        expected.append(text.c_str() + to, text.size() - to);
+        text = expected;
+
+        paragraph->updateText(edit.from, to, SkString(edit.text));
+        paragraph->layout(300);
+        auto reference = make(text);
+
+        REPORTER_ASSERT(reporter, paragraph->lineNumber() == reference->lineNumber());
+        REPORTER_ASSERT(reporter, SkScalarNearlyEqual(paragraph->getHeight(), reference->getHeight()));
+        REPORTER_ASSERT(reporter, SkScalarNearlyEqual(paragraph->getMaxIntrinsicWidth(),
+                                                      reference->getMaxIntrinsicWidth()));
+        REPORTER_ASSERT(reporter, SkScalarNearlyEqual(paragraph->getMinIntrinsicWidth(),
+                                                      reference->getMinIntrinsicWidth()));
+        REPORTER_ASSERT(reporter, SkScalarNearlyEqual(paragraph->getLongestLine(),
+                                                      reference->getLongestLine()));
+        auto boxes = paragraph->getRectsForRange(0, text.size(), RectHeightStyle::kTight,
+                                                 RectWidthStyle::kTight);
+        auto expectedBoxes = reference->getRectsForRange(0, text.size(), RectHeightStyle::kTight,
+                                                         RectWidthStyle::kTight);
+        REPORTER_ASSERT(reporter, boxes.size() == expectedBoxes.size());
+        for (size_t i = 0; i < std::min(boxes.size(), expectedBoxes.size()); ++i) {
+            REPORTER_ASSERT(reporter, SkScalarNearlyEqual(boxes[i].rect.fLeft,
+                                                          expectedBoxes[i].rect.fLeft));
+            REPORTER_ASSERT(reporter, SkScalarNearlyEqual(boxes[i].rect.fRight,
+                                                          expectedBoxes[i].rect.fRight));
+            REPORTER_ASSERT(reporter, SkScalarNearlyEqual(boxes[i].rect.fTop,
+                                                          expectedBoxes[i].rect.fTop));
+        }
+    }
+}
+
+UNIX_ONLY_TEST(SkParagraph_BuildAndLayout, reporter) {
+    sk_sp<ResourceFontCollection> fontCollection = sk_make_sp<ResourceFontCollection>();
+    SKIP_IF_FONTS_NOT_FOUND(reporter, fontCollection)
+    fontCollection->getParagraphCache()->turnOn(false);
+
+    ParagraphStyle paragraph_style;
+    paragraph_style.turnHintingOff();
+    TextStyle text_style;
+    text_style.setFontFamilies({SkString("Roboto")});
+    text_style.setColor(SK_ColorBLACK);
+
+    const int kCount = 100;
+    std::vector<std::unique_ptr<ParagraphBuilderImpl>> builders;
+    std::vector<ParagraphBuilder*> inputs;
+    std::vector<SkString> texts;
+    for (int i = 0; i < kCount; ++i) {
+        texts.push_back(SkStringPrintf("Paragraph %d: %s", i,
+                                       std::string(i % 17 + 1, 'w').c_str()));
+        builders.push_back(std::make_unique<ParagraphBuilderImpl>(
+                paragraph_style, fontCollection, get_unicode()));
+        builders.back()->pushStyle(text_style);
+        builders.back()->addText(texts.back().c_str());
+        inputs.push_back(builders.back().get());
+    }
+
+    auto executor = SkExecutor::MakeFIFOThreadPool(4);
+    auto paragraphs = ParagraphBuilder::BuildAndLayout(inputs, 100, executor.get());
+    REPORTER_ASSERT(reporter, paragraphs.size() == kCount);
+
+    for (int i = 0; i < kCount; ++i) {
+        ParagraphBuilderImpl builder(paragraph_style, fontCollection, get_unicode());
+        builder.pushStyle(text_style);
+        builder.addText(texts[i].c_str());
+        auto expected = builder.Build();
+        expected->layout(100);
+        REPORTER_ASSERT(reporter, paragraphs[i]->lineNumber() == expected->lineNumber());
+        REPORTER_ASSERT(reporter, paragraphs[i]->getHeight() == expected->getHeight());
+        REPORTER_ASSERT(reporter, paragraphs[i]->getMaxIntrinsicWidth() ==
+                                  expected->getMaxIntrinsicWidth());
+    }
+}
+
+UNIX_ONLY_TEST(SkParagraph_MeasureOnly, reporter) {
+    sk_sp<ResourceFontCollection> fontCollection = sk_make_sp<ResourceFontCollection>();
+    SKIP_IF_FONTS_NOT_FOUND(reporter, fontCollection)
+    fontCollection->getParagraphCache()->turnOn(false);
+
+    TextStyle text_style;
+    text_style.setFontFamilies({SkString("Roboto")});
+    text_style.setColor(SK_ColorBLACK);
+    text_style.setFontSize(20);
+    text_style.setDecoration(TextDecoration::kUnderline);
+
+    // Covers wrapping, hard breaks, a trailing hard break (which adds an empty last line) and
+    // running out of lines part way through the text.
+    const char* texts[] = {
+        "Lorem ipsum dolor sit amet,\nconsectetur adipiscing elit, sed do eiusmod "
+        "tempor incididunt ut labore et dolore magna aliqua.",
+        "Lorem ipsum dolor sit amet\n",
+        "Lorem\nipsum\ndolor\nsit\namet\n\n",
+    };
+    for (const char* text : texts) {
+        for (size_t maxLines : {std::numeric_limits<size_t>::max(), (size_t)2, (size_t)1}) {
+            ParagraphStyle paragraph_style;
+            paragraph_style.turnHintingOff();
+            paragraph_style.setMaxLines(maxLines);
+            paragraph_style.setEllipsis(u"\u2026");
+
+            auto build = [&](bool measureOnly) {
+                ParagraphBuilderImpl builder(paragraph_style, fontCollection, get_unicode());
+                builder.setMeasureOnly(measureOnly);
+                builder.pushStyle(text_style);
+                builder.addText(text);
+                return builder.Build();
+            };
+            auto full = build(false);
+            auto measured = build(true);
+
+            for (SkScalar width : {300.f, 120.f, 1000.f}) {
+                full->layout(width);
+                measured->layout(width);
+                REPORTER_ASSERT(reporter, measured->lineNumber() == full->lineNumber());
+                REPORTER_ASSERT(reporter, measured->getHeight() == full->getHeight());
+                REPORTER_ASSERT(reporter, measured->getLongestLine() == full->getLongestLine());
+                REPORTER_ASSERT(reporter, measured->getMinIntrinsicWidth() ==
+                                          full->getMinIntrinsicWidth());
+                REPORTER_ASSERT(reporter, measured->getMaxIntrinsicWidth() ==
+                                          full->getMaxIntrinsicWidth());
+                REPORTER_ASSERT(reporter, measured->getAlphabeticBaseline() ==
+                                          full->getAlphabeticBaseline());
+                REPORTER_ASSERT(reporter, measured->didExceedMaxLines() ==
+                                          full->didExceedMaxLines());
+
+                std::vector<LineMetrics> metrics;
+                measured->getLineMetrics(metrics);
+                REPORTER_ASSERT(reporter, metrics.empty());
+            }
+        }
+    }
+}
+
+UNIX_ONLY_TEST(SkParagraph_FallbackCacheFontManagerChange, reporter) {
+    // Cached fallbacks, including misses, must not outlive the font managers they came from.
+    const SkUnichar unicode = 'A';
+    const SkString locale;
+    sk_sp<SkFontMgr> testMgr = ToolUtils::TestFontMgr();
+    sk_sp<SkTypeface> expected =
+            testMgr->matchFamilyStyleCharacter(nullptr, SkFontStyle(), nullptr, 0, unicode);
+    if (!expected) {
+        return;
+    }
+
+    sk_sp<FontCollection> fontCollection = sk_make_sp<FontCollection>();
+    fontCollection->setDefaultFontManager(SkFontMgr::RefEmpty());
+    REPORTER_ASSERT(reporter,
+                    !fontCollection->defaultFallback(unicode, SkFontStyle(), locale));
+
+    fontCollection->setDefaultFontManager(testMgr);
+    REPORTER_ASSERT(reporter,
+                    fontCollection->defaultFallback(unicode, SkFontStyle(), locale));
+
+    fontCollection->setDefaultFontManager(SkFontMgr::RefEmpty());
+    REPORTER_ASSERT(reporter,
+                    !fontCollection->defaultFallback(unicode, SkFontStyle(), locale));
+
+    fontCollection->setAssetFontManager(testMgr);
+    REPORTER_ASSERT(reporter,
+                    fontCollection->defaultFallback(unicode, SkFontStyle(), locale));
+
+    fontCollection->setAssetFontManager(nullptr);
+    REPORTER_ASSERT(reporter,
+                    !fontCollection->defaultFallback(unicode, SkFontStyle(), locale));
+}
+
 UNIX_ONLY_TEST(SkParagraph_ParagraphWithLineBreak, reporter) {
     sk_sp<ResourceFontCollection> fontCollection = sk_make_sp<ResourceFontCollection>();
     SKIP_IF_FONTS_NOT_FOUND(reporter, fontCollection)
@@ -0,0 +1,103 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkSGCacheEffect_DEFINED
+#define SkSGCacheEffect_DEFINED
+
+#include "include/core/SkImage.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkMatrix.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkRefCnt.h"
+#include "modules/sksg/include/SkSGEffectNode.h"
+#include "modules/sksg/include/SkSGRenderNode.h"
+
+#include <utility>
+
+class GrRecordingContext;
+class SkCanvas;
+
+namespace skgpu::graphite { class Recorder; }
+
+namespace sksg {
+class InvalidationController;
+
+/**
+ * Concrete Effect node, caching the rendered output of its descendants.
+ *
+ * The content is rasterized at device resolution, into an image which is reused for as long as
+ * the content is not invalidated and the device transform only changes by whole pixel
+ * translations.  Any other transform change (scale, rotation, sub-pixel translation) causes the
+ * content to be rasterized again.
+ *
+ * The image is only created once the content renders unchanged, at the same transform, twice in
+ * a row: content which changes every frame is rendered directly, as if the node was not there.
+ *
+ * The image is also rasterized again when the destination changes GPU context or color type
+ * and color space.
+ *
+ * Content is rendered directly when the destination canvas cannot create compatible surfaces
+ * (e.g. when recording a picture), under a perspective transform, when overriding the
+ * shader of the content draws, or when its image would exceed the cache limit shared by all
+ * CacheEffects.
+ *
+ * Rendering updates the cache, so a CacheEffect must not be rendered concurrently.
+ */
+class CacheEffect final : public EffectNode {
+public:
+    static sk_sp<CacheEffect> Make(sk_sp<RenderNode> child) {
+        return child ? sk_sp<CacheEffect>(new CacheEffect(std::move(child))) : nullptr;
+    }
+
+    ~CacheEffect() override;
+
+    /**
+     * Sets the maximum number of bytes used by the images of all CacheEffects in the process,
+     * and returns the previous limit.  Images are not evicted to make room: content which
+     * does not fit is rendered directly, until other caches are released.
+     */
+    static size_t SetCacheLimit(size_t bytes);
+    static size_t GetCacheLimit();
+
+    /** Returns the number of bytes used by the images of all CacheEffects in the process. */
+    static size_t GetCacheUsed();
+
+protected:
+    void onRender(SkCanvas*, const RenderContext*) const override;
+
+    SkRect onRevalidate(InvalidationController*, const SkMatrix&) override;
+
+private:
+    explicit CacheEffect(sk_sp<RenderNode>);
+
+    sk_sp<SkImage> rasterize(SkCanvas*, const SkIRect& device_bounds,
+                             const SkMatrix& cache_matrix) const;
+
+    // Whether the cache was rendered for the destination of canvas, at cache_matrix.
+    bool matches(SkCanvas*, const SkMatrix& cache_matrix) const;
+
+    void resetCache() const;
+
+    // The device transform of the cached content, relative to the cached image origin.
+    mutable SkMatrix                   fCacheMatrix = SkMatrix::I();
+    // The destination the cached content was rendered for.
+    mutable GrRecordingContext*        fCacheContext  = nullptr;
+    mutable skgpu::graphite::Recorder* fCacheRecorder = nullptr;
+    mutable SkColorInfo                fCacheColorInfo;
+    mutable sk_sp<SkImage>             fCacheImage;
+    // The bytes of fCacheImage, charged to the limit shared by all CacheEffects.
+    mutable size_t                     fCacheBytes = 0;
+    // Whether the content was last rendered directly at fCacheMatrix, and has not been
+    // invalidated since.
+    mutable bool                       fIsCandidate = false;
+
+    using INHERITED = EffectNode;
+};
+
+} // namespace sksg
+
+#endif // SkSGCacheEffect_DEFINED
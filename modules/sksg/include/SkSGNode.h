@@ -12,6 +12,7 @@
 #include "include/core/SkRefCnt.h"
 #include "include/private/base/SkAssert.h"
 
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
@@ -39,6 +40,10 @@ public:
     // Tag this node for invalidation and optional damage.
     void invalidate(bool damage = true);
 
+    // Nodes are allocated from the current NodePool, if any (see SkSGNodePool.h).
+    static void* operator new(size_t);
+    static void operator delete(void*, size_t);
+
 protected:
     enum InvalTraits {
         // Nodes with this trait never generate direct damage -- instead,
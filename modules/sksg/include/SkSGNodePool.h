@@ -0,0 +1,74 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkSGNodePool_DEFINED
+#define SkSGNodePool_DEFINED
+
+#include "include/core/SkRefCnt.h"
+
+#include <cstddef>
+#include <memory>
+
+namespace sksg {
+
+/**
+ * Block allocator for scene graph nodes.
+ *
+ * While a NodePool::Scope is active on the current thread, new nodes are allocated sequentially
+ * in large blocks owned by the pool, instead of individually on the heap.  Scenes built in one
+ * go are then laid out compactly, in construction order, which makes traversals (revalidation,
+ * rendering) more cache friendly.
+ *
+ * Each pool-allocated node holds a reference to its pool: the pool blocks are released when
+ * the last of these nodes is destroyed.  The memory of nodes destroyed while their pool's scope
+ * is active, on the scope's thread (e.g. temporaries discarded while building the scene), is
+ * reused for later nodes of the same size.  Otherwise, the memory of individual nodes is not
+ * reused, so pools are best suited for long-lived scenes.
+ *
+ * Nodes allocated outside of a scope come from the heap, with no header: they are over-aligned
+ * instead, which tells them apart from pooled nodes.  All nodes keep the default new alignment.
+ *
+ * Pools are not thread safe: a pool must only be used by one scope at a time.  Pool-allocated
+ * nodes can be destroyed on any thread.
+ */
+class NodePool final : public SkNVRefCnt<NodePool> {
+public:
+    static sk_sp<NodePool> Make();
+
+    ~NodePool();
+
+    class Scope final {
+    public:
+        explicit Scope(sk_sp<NodePool>);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        sk_sp<NodePool> fPool;
+        NodePool*       fPrevPool;
+    };
+
+private:
+    NodePool();
+
+    // Allocates from the current thread's pool if any, or from the heap otherwise.
+    static void* Allocate(size_t);
+    static void  Free(void*, size_t);
+
+    struct Storage;
+
+    const std::unique_ptr<Storage> fStorage;
+    bool                           fInScope = false;
+
+    friend class Node;
+};
+
+} // namespace sksg
+
+#endif // SkSGNodePool_DEFINED
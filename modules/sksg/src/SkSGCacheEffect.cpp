@@ -0,0 +1,185 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "modules/sksg/include/SkSGCacheEffect.h"
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkSamplingOptions.h"
+#include "include/core/SkSurface.h"
+#include "include/core/SkSurfaceProps.h"
+#include "include/private/base/SkAssert.h"
+
+#include <atomic>
+#include <cstdint>
+
+namespace sksg {
+
+namespace {
+
+// Larger content is rendered directly.
+static constexpr int64_t kMaxCachePixels = 2048 * 2048;
+
+static constexpr size_t kDefaultCacheLimit = 64 * 1024 * 1024;
+
+std::atomic<size_t> gCacheLimit{kDefaultCacheLimit};
+std::atomic<size_t> gCacheUsed{0};
+
+// Charges bytes to the shared limit, unless that would exceed it.
+bool try_reserve(size_t bytes) {
+    const auto used = gCacheUsed.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    if (used > gCacheLimit.load(std::memory_order_relaxed)) {
+        gCacheUsed.fetch_sub(bytes, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+size_t CacheEffect::SetCacheLimit(size_t bytes) {
+    return gCacheLimit.exchange(bytes, std::memory_order_relaxed);
+}
+
+size_t CacheEffect::GetCacheLimit() {
+    return gCacheLimit.load(std::memory_order_relaxed);
+}
+
+size_t CacheEffect::GetCacheUsed() {
+    return gCacheUsed.load(std::memory_order_relaxed);
+}
+
+CacheEffect::CacheEffect(sk_sp<RenderNode> child)
+    : INHERITED(std::move(child)) {}
+
+CacheEffect::~CacheEffect() {
+    this->resetCache();
+}
+
+void CacheEffect::resetCache() const {
+    fCacheImage = nullptr;
+    gCacheUsed.fetch_sub(fCacheBytes, std::memory_order_relaxed);
+    fCacheBytes = 0;
+}
+
+bool CacheEffect::matches(SkCanvas* canvas, const SkMatrix& cache_matrix) const {
+    SkASSERT(fCacheImage);
+
+    // isValid() rejects images from a destroyed context, when a new context is allocated at
+    // the same address.
+    return cache_matrix == fCacheMatrix &&
+           canvas->recordingContext() == fCacheContext &&
+           canvas->recorder() == fCacheRecorder &&
+           canvas->imageInfo().colorInfo() == fCacheColorInfo &&
+           fCacheImage->isValid(fCacheContext);
+}
+
+sk_sp<SkImage> CacheEffect::rasterize(SkCanvas* canvas, const SkIRect& device_bounds,
+                                      const SkMatrix& cache_matrix) const {
+    SkASSERT(!fCacheImage && !fCacheBytes);
+
+    SkSurfaceProps props;
+    canvas->getProps(&props);
+
+    const auto info = canvas->imageInfo().makeDimensions(device_bounds.size())
+                                         .makeAlphaType(kPremul_SkAlphaType);
+    const auto bytes = info.computeMinByteSize();
+    if (!try_reserve(bytes)) {
+        return nullptr;
+    }
+
+    auto surface = canvas->makeSurface(info, &props);
+    if (!surface) {
+        gCacheUsed.fetch_sub(bytes, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    surface->getCanvas()->setMatrix(cache_matrix);
+    this->INHERITED::onRender(surface->getCanvas(), nullptr);
+
+    fCacheBytes     = bytes;
+    fCacheContext   = canvas->recordingContext();
+    fCacheRecorder  = canvas->recorder();
+    fCacheColorInfo = canvas->imageInfo().colorInfo();
+
+    return surface->makeImageSnapshot();
+}
+
+void CacheEffect::onRender(SkCanvas* canvas, const RenderContext* ctx) const {
+    const auto ctm = canvas->getTotalMatrix();
+
+    // Shader overrides apply to the individual content draws, not to the cached image.
+    auto cacheable = !ctm.hasPerspective() && !(ctx && ctx->fShader);
+
+    // Outset to also cover the antialiasing fringe.
+    const auto device_bounds = ctm.mapRect(this->bounds()).roundOut().makeOutset(1, 1);
+    cacheable &= !device_bounds.isEmpty() &&
+                 device_bounds.width64() * device_bounds.height64() <= kMaxCachePixels;
+
+    if (!cacheable) {
+        this->resetCache();
+        fIsCandidate = false;
+        this->INHERITED::onRender(canvas, ctx);
+        return;
+    }
+
+    // Rasterizing relative to the device bounds origin makes the cache independent of whole
+    // pixel translations.
+    const auto cache_matrix = SkMatrix(ctm).postTranslate(-device_bounds.x(),
+                                                          -device_bounds.y());
+
+    if (!fCacheImage || !this->matches(canvas, cache_matrix)) {
+        // Only commit to a cache when the content renders unchanged for the second time.
+        const auto is_stable = fIsCandidate && cache_matrix == fCacheMatrix;
+
+        this->resetCache();
+        if (is_stable) {
+            fCacheImage = this->rasterize(canvas, device_bounds, cache_matrix);
+            if (!fCacheImage) {
+                this->resetCache();
+            }
+        }
+        fCacheMatrix = cache_matrix;
+
+        if (!fCacheImage) {
+            fIsCandidate = true;
+            this->INHERITED::onRender(canvas, ctx);
+            return;
+        }
+    }
+
+    SkASSERT(fCacheImage->dimensions() == device_bounds.size());
+
+    SkPaint paint;
+
+    auto local_ctx = ScopedRenderContext(canvas, ctx);
+    if (ctx) {
+        if (ctx->fMaskShader) {
+            // Mask shaders cannot be applied via drawImage - we need layer isolation.
+            local_ctx.setIsolation(this->bounds(), ctm, true);
+        }
+        local_ctx->modulatePaint(ctm, &paint);
+    }
+
+    SkAutoCanvasRestore acr(canvas, true);
+    canvas->resetMatrix();
+    canvas->drawImage(fCacheImage, device_bounds.x(), device_bounds.y(),
+                      SkSamplingOptions(), &paint);
+}
+
+SkRect CacheEffect::onRevalidate(InvalidationController* ic, const SkMatrix& ctm) {
+    SkASSERT(this->hasInval());
+
+    // The content has changed.
+    this->resetCache();
+    fIsCandidate = false;
+
+    return this->INHERITED::onRevalidate(ic, ctm);
+}
+
+} // namespace sksg
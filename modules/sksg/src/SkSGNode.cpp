@@ -9,6 +9,7 @@
 
 #include "include/private/base/SkDebug.h"
 #include "modules/sksg/include/SkSGInvalidationController.h"
+#include "modules/sksg/include/SkSGNodePool.h"
 #include "src/core/SkRectPriv.h"
 
 #include <algorithm>
@@ -49,6 +50,14 @@ Node::Node(uint32_t invalTraits)
     , fFlags(kInvalidated_Flag)
     , fNodeFlags(0) {}
 
+void* Node::operator new(size_t size) {
+    return NodePool::Allocate(size);
+}
+
+void Node::operator delete(void* ptr, size_t size) {
+    NodePool::Free(ptr, size);
+}
+
 Node::~Node() {
     if (fFlags & kObserverArray_Flag) {
         SkASSERT(fInvalObserverArray->empty());
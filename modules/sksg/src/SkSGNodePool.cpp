@@ -0,0 +1,125 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "modules/sksg/include/SkSGNodePool.h"
+
+#include "include/private/base/SkAssert.h"
+#include "src/base/SkArenaAlloc.h"
+#include "src/core/SkTHash.h"
+
+#include <cstdint>
+#include <new>
+#include <utility>
+
+namespace sksg {
+
+namespace {
+
+// All nodes are aligned to kNewAlignment, as ::operator new would align them.  Heap nodes are
+// over-aligned to kHeapAlignment, and pooled nodes are placed kPoolOffset past that alignment,
+// which tells them apart without a header on heap nodes.  Pooled nodes are preceded by a
+// kPoolOffset header, which points to their pool.
+static constexpr size_t kNewAlignment  = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+static constexpr size_t kPoolOffset    = kNewAlignment;
+static constexpr size_t kHeapAlignment = 2 * kNewAlignment;
+static_assert(kPoolOffset >= sizeof(NodePool*));
+
+static constexpr size_t kFirstBlockSize = 16 * 1024;
+
+thread_local NodePool* sCurrentPool = nullptr;
+
+bool is_pooled(const void* node) {
+    return reinterpret_cast<uintptr_t>(node) & kPoolOffset;
+}
+
+NodePool*& pool_of(void* node) {
+    return *reinterpret_cast<NodePool**>(static_cast<char*>(node) - sizeof(NodePool*));
+}
+
+} // namespace
+
+struct NodePool::Storage {
+    SkArenaAlloc fArena{kFirstBlockSize};
+    // Nodes freed while the pool is current on its thread, by size, linked through their first
+    // bytes.
+    skia_private::THashMap<size_t, void*> fFreeNodes;
+};
+
+sk_sp<NodePool> NodePool::Make() {
+    return sk_sp<NodePool>(new NodePool());
+}
+
+NodePool::NodePool()
+    : fStorage(std::make_unique<Storage>()) {}
+
+NodePool::~NodePool() {
+    SkASSERT(!fInScope);
+}
+
+NodePool::Scope::Scope(sk_sp<NodePool> pool)
+    : fPool(std::move(pool))
+    , fPrevPool(sCurrentPool) {
+    SkASSERT(fPool);
+    SkASSERT(!fPool->fInScope);
+
+    fPool->fInScope = true;
+    sCurrentPool = fPool.get();
+}
+
+NodePool::Scope::~Scope() {
+    SkASSERT(sCurrentPool == fPool.get());
+
+    fPool->fInScope = false;
+    sCurrentPool = fPrevPool;
+}
+
+void* NodePool::Allocate(size_t size) {
+    NodePool* pool = sCurrentPool;
+    if (!pool) {
+        void* node = ::operator new(size, std::align_val_t{kHeapAlignment});
+        SkASSERT(!is_pooled(node));
+        return node;
+    }
+
+    void* node;
+    void** free_node = pool->fStorage->fFreeNodes.find(size);
+    if (free_node && *free_node) {
+        node = *free_node;
+        *free_node = *static_cast<void**>(node);
+        SkASSERT(pool_of(node) == pool);
+    } else {
+        node = static_cast<char*>(pool->fStorage->fArena.makeBytesAlignedTo(kPoolOffset + size,
+                                                                              kHeapAlignment))
+             + kPoolOffset;
+        pool_of(node) = pool;
+    }
+    SkASSERT(is_pooled(node));
+    SkASSERT(reinterpret_cast<uintptr_t>(node) % kNewAlignment == 0);
+
+    // Balanced in Free().
+    pool->ref();
+    return node;
+}
+
+void NodePool::Free(void* node, size_t size) {
+    if (!is_pooled(node)) {
+        ::operator delete(node, std::align_val_t{kHeapAlignment});
+        return;
+    }
+
+    NodePool* pool = pool_of(node);
+    if (pool == sCurrentPool) {
+        // Temporaries discarded while building the scene: the next node of the same size reuses
+        // the memory.  Otherwise, the memory is reclaimed when the pool is destroyed.
+        void*& free_node = pool->fStorage->fFreeNodes[size];
+        *static_cast<void**>(node) = free_node;
+        free_node = node;
+    }
+    pool->unref();
+}
+
+} // namespace sksg
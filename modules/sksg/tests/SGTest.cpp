@@ -9,11 +9,13 @@
 
 #if !defined(SK_BUILD_FOR_GOOGLE3)
 
+#include "include/core/SkColor.h"
 #include "include/core/SkRect.h"
 #include "include/private/base/SkTo.h"
 #include "modules/sksg/include/SkSGDraw.h"
 #include "modules/sksg/include/SkSGGroup.h"
 #include "modules/sksg/include/SkSGInvalidationController.h"
+#include "modules/sksg/include/SkSGNodePool.h"
 #include "modules/sksg/include/SkSGPaint.h"
 #include "modules/sksg/include/SkSGRect.h"
 #include "modules/sksg/include/SkSGRenderEffect.h"
@@ -22,6 +24,7 @@
 
 #include "tests/Test.h"
 
+#include <cstdint>
 #include <vector>
 
 static void check_inval(skiatest::Reporter* reporter, const sk_sp<sksg::Node>& root,
@@ -355,4 +358,57 @@ DEF_TEST(SGInvalidation, reporter) {
     inval_group_remove(reporter);
 }
 
+DEF_TEST(SGNodePool, reporter) {
+    sk_sp<sksg::Group> root;
+    sk_sp<sksg::Rect>  rect;
+    {
+        sksg::NodePool::Scope scope(sksg::NodePool::Make());
+
+        root = sksg::Group::Make();
+        for (int i = 0; i < 1000; ++i) {
+            rect = sksg::Rect::Make(SkRect::MakeXYWH(i * 10, 0, 10, 10));
+            root->addChild(sksg::Draw::Make(rect, sksg::Color::Make(SK_ColorBLACK)));
+        }
+
+        // Pooled nodes are aligned like heap nodes.
+        REPORTER_ASSERT(reporter,
+                        reinterpret_cast<uintptr_t>(rect.get()) %
+                                __STDCPP_DEFAULT_NEW_ALIGNMENT__ == 0);
+
+        // Nested scopes restore the outer pool.
+        {
+            sksg::NodePool::Scope nested(sksg::NodePool::Make());
+            root->addChild(sksg::Draw::Make(sksg::Rect::Make(SkRect::MakeXYWH(0, 10, 10, 10)),
+                                            sksg::Color::Make(SK_ColorBLACK)));
+        }
+        root->addChild(sksg::Draw::Make(sksg::Rect::Make(SkRect::MakeXYWH(0, 20, 10, 10)),
+                                        sksg::Color::Make(SK_ColorBLACK)));
+
+        // Nodes discarded while building give their memory to the next node of the same size.
+        const void* discarded = sksg::Color::Make(SK_ColorRED).get();
+        auto reused = sksg::Color::Make(SK_ColorGREEN);
+        REPORTER_ASSERT(reporter, reused.get() == discarded);
+        root->addChild(sksg::Draw::Make(sksg::Rect::Make(SkRect::MakeXYWH(0, 20, 10, 10)),
+                                        std::move(reused)));
+    }
+
+    // Pooled nodes outlive both the scope and the pool handle.
+    check_inval(reporter, root,
+                SkRect::MakeWH(10000, 30),
+                SkRectPriv::MakeLargeS32(),
+                nullptr);
+
+    // Heap-allocated nodes can be mixed with pooled nodes.
+    root->addChild(sksg::Draw::Make(sksg::Rect::Make(SkRect::MakeXYWH(0, 30, 10, 10)),
+                                    sksg::Color::Make(SK_ColorBLACK)));
+    rect->setB(50);
+
+    sksg::InvalidationController ic;
+    REPORTER_ASSERT(reporter, root->revalidate(&ic, SkMatrix::I()) == SkRect::MakeWH(10000, 50));
+
+    // Releasing the scene releases the pools.
+    rect.reset();
+    root.reset();
+}
+
 #endif // !defined(SK_BUILD_FOR_GOOGLE3)
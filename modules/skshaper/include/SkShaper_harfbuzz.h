@@ -14,6 +14,7 @@
 #include "modules/skshaper/include/SkShaper.h"
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 
 class SkFontMgr;
@@ -34,6 +35,23 @@ SKSHAPER_API std::unique_ptr<SkShaper::ScriptRunIterator> ScriptRunIterator(cons
                                                                             SkFourByteTag script);
 
 SKSHAPER_API void PurgeCaches();
+
+/**
+ * Shaped words can be cached and reused across runs which share a font, features, script,
+ * direction and language. A word is only cached when HarfBuzz reports that it can be shaped
+ * separately from its neighbors; words at the edge of a run which borders other runs are never
+ * cached, and such runs are always shaped in full. The cache is shared by all HarfBuzz shapers, is
+ * thread-safe, and is disabled (limit 0) by default. Changing the limit discards its contents.
+ */
+SKSHAPER_API void SetWordCacheLimit(int maxWords);
+
+struct WordCacheStats {
+    uint64_t fHits = 0;    // words served from the cache
+    uint64_t fMisses = 0;  // words which had to be shaped
+    int fCount = 0;        // words currently cached
+};
+SKSHAPER_API WordCacheStats GetWordCacheStats();
+SKSHAPER_API void ResetWordCacheStats();
 }  // namespace SkShapers::HB
 
 #endif
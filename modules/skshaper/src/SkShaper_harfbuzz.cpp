@@ -34,6 +34,7 @@
 #include "modules/skunicode/include/SkUnicode.h"
 #include "src/base/SkTDPQueue.h"
 #include "src/base/SkUTF.h"
+#include "src/core/SkChecksum.h"
 #include "src/core/SkLRUCache.h"
 
 #if !defined(SK_DISABLE_LEGACY_SKSHAPER_FUNCTIONS)
@@ -43,11 +44,15 @@
 #include <hb-ot.h>
 #include <hb.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <cstring>
 #include <memory>
+#include <string>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 using namespace skia_private;
 
@@ -622,6 +627,68 @@ struct ShapedRunGlyphIterator {
     size_t fGlyphIndex;
 };
 
+// Shaped words, keyed by everything which influences shaping (see WordCacheKey) followed by the
+// word's utf8 text. A "word" is a run of non-space characters together with any spaces which
+// follow it. Words are only stored when HarfBuzz reports that their glyphs can be separated from
+// their neighbors without changing the result (i.e. neither edge is unsafe-to-break).
+struct CachedWord {
+    std::vector<ShapedGlyph> fGlyphs;  // fCluster is relative to the start of the word
+    SkVector fAdvance;
+};
+
+struct WordCacheKey {
+    SkTypefaceID fTypefaceID;
+    SkScalar fSize;
+    SkScalar fScaleX;
+    SkScalar fSkewX;
+    uint32_t fFontFlags;  // embolden, subpixel, hinting, etc.
+    uint32_t fFeaturesHash;
+    hb_script_t fScript;
+    hb_direction_t fDirection;
+    hb_language_t fLanguage;
+};
+
+struct WordCache {
+    SkMutex fMutex;
+    std::unique_ptr<SkLRUCache<std::string, CachedWord>> fWords SK_GUARDED_BY(fMutex);
+    uint64_t fHits SK_GUARDED_BY(fMutex) = 0;
+    uint64_t fMisses SK_GUARDED_BY(fMutex) = 0;
+};
+
+static std::atomic<int> gWordCacheLimit{0};
+
+static WordCache& get_word_cache() {
+    static WordCache* gWordCache = new WordCache;
+    return *gWordCache;
+}
+
+static uint32_t font_flags_for_word_cache(const SkFont& font) {
+    return (font.isEmbolden()          ? 1 << 0 : 0) |
+           (font.isSubpixel()          ? 1 << 1 : 0) |
+           (font.isLinearMetrics()     ? 1 << 2 : 0) |
+           (font.isForceAutoHinting()  ? 1 << 3 : 0) |
+           (font.isEmbeddedBitmaps()   ? 1 << 4 : 0) |
+           (font.isBaselineSnap()      ? 1 << 5 : 0) |
+           ((uint32_t)font.getEdging()  << 8) |
+           ((uint32_t)font.getHinting() << 16);
+}
+
+static std::string word_cache_key(const WordCacheKey& prefix, const char* begin, const char* end) {
+    std::string key(reinterpret_cast<const char*>(&prefix), sizeof(prefix));
+    key.append(begin, end - begin);
+    return key;
+}
+
+// Splits [begin, end) into words, each of which absorbs the spaces that follow it.
+static void split_words(const char* begin, const char* end, TArray<const char*>* wordStarts) {
+    wordStarts->push_back(begin);
+    for (const char* ptr = begin + 1; ptr < end; ++ptr) {
+        if (ptr[-1] == ' ' && ptr[0] != ' ') {
+            wordStarts->push_back(ptr);
+        }
+    }
+}
+
 class ShaperHarfBuzz : public SkShaper {
 public:
     ShaperHarfBuzz(sk_sp<SkUnicode>,
@@ -1275,6 +1342,67 @@ static HBLockedFaceCache get_hbFace_cache() {
     return HBLockedFaceCache(gHBFaceCache, gHBFaceCacheMutex);
 }
 
+static void add_to_word_cache(const ShapedRun& run,
+                              const char* utf8,
+                              const char* utf8End,
+                              bool hasPreContext,
+                              bool hasPostContext,
+                              const WordCacheKey& wordKey,
+                              const TArray<const char*>& wordStarts) {
+    // Find the first glyph of each word. A word boundary is only usable when a glyph starts
+    // exactly at it, and HarfBuzz says the glyph can be shaped separately from its predecessor.
+    // The run's own edges are only usable when there is no text beyond them: HarfBuzz shaped the
+    // run against the neighboring text as context, but doesn't report whether that context
+    // changed the result, so a word touching it may not be reusable elsewhere.
+    STArray<16, size_t> firstGlyph;
+    STArray<16, bool> safeStart;
+    size_t glyphIndex = 0;
+    for (int i = 0; i < wordStarts.size(); ++i) {
+        const uint32_t cluster = SkTo<uint32_t>(wordStarts[i] - utf8);
+        while (glyphIndex < run.fNumGlyphs && run.fGlyphs[glyphIndex].fCluster < cluster) {
+            ++glyphIndex;
+        }
+        firstGlyph.push_back(glyphIndex);
+        safeStart.push_back(i == 0 ? !hasPreContext
+                                   : (glyphIndex < run.fNumGlyphs &&
+                                      run.fGlyphs[glyphIndex].fCluster == cluster &&
+                                      !run.fGlyphs[glyphIndex].fUnsafeToBreak));
+    }
+    firstGlyph.push_back(run.fNumGlyphs);
+    safeStart.push_back(!hasPostContext);
+
+    WordCache& cache = get_word_cache();
+    SkAutoMutexExclusive lock(cache.fMutex);
+    int limit = gWordCacheLimit.load(std::memory_order_relaxed);
+    if (limit <= 0) {
+        return;
+    }
+    if (!cache.fWords) {
+        cache.fWords = std::make_unique<SkLRUCache<std::string, CachedWord>>(limit);
+    }
+    for (int i = 0; i < wordStarts.size(); ++i) {
+        if (!safeStart[i] || !safeStart[i + 1] || firstGlyph[i] == firstGlyph[i + 1]) {
+            continue;
+        }
+        const char* wordEnd = i + 1 < wordStarts.size() ? wordStarts[i + 1] : utf8End;
+        std::string key = word_cache_key(wordKey, wordStarts[i], wordEnd);
+        if (cache.fWords->find(key)) {
+            continue;
+        }
+        const uint32_t wordCluster = SkTo<uint32_t>(wordStarts[i] - utf8);
+        CachedWord word;
+        word.fAdvance = {0, 0};
+        word.fGlyphs.reserve(firstGlyph[i + 1] - firstGlyph[i]);
+        for (size_t g = firstGlyph[i]; g < firstGlyph[i + 1]; ++g) {
+            ShapedGlyph glyph = run.fGlyphs[g];
+            glyph.fCluster -= wordCluster;
+            word.fAdvance += glyph.fAdvance;
+            word.fGlyphs.push_back(glyph);
+        }
+        cache.fWords->insert(key, std::move(word));
+    }
+}
+
 ShapedRun ShaperHarfBuzz::shape(char const * const utf8,
                                   size_t const utf8Bytes,
                                   char const * const utf8Start,
@@ -1364,6 +1492,76 @@ ShapedRun ShaperHarfBuzz::shape(char const * const utf8,
         }
     }
 
+    // Consult the word cache. Runs with features that only apply to part of the run can't be
+    // split into words, since the words would no longer know which features apply to them.
+    bool useWordCache = gWordCacheLimit.load(std::memory_order_relaxed) > 0;
+    const bool hasPreContext = utf8Start != utf8;
+    const bool hasPostContext = utf8End != utf8 + utf8Bytes;
+    WordCacheKey wordKey;
+    // Zero the key first so that its padding bytes are deterministic.
+    memset(&wordKey, 0, sizeof(wordKey));
+    TArray<const char*> wordStarts;
+    if (useWordCache) {
+        uint32_t featuresHash = 0;
+        for (const hb_feature_t& feature : hbFeatures) {
+            if (feature.start != HB_FEATURE_GLOBAL_START || feature.end != HB_FEATURE_GLOBAL_END) {
+                useWordCache = false;
+                break;
+            }
+            featuresHash = SkChecksum::Hash32(&feature.tag, sizeof(feature.tag), featuresHash);
+            featuresHash = SkChecksum::Hash32(&feature.value, sizeof(feature.value), featuresHash);
+        }
+        const SkFont& runFont = font.currentFont();
+        wordKey.fTypefaceID = runFont.getTypeface()->uniqueID();
+        wordKey.fSize = runFont.getSize();
+        wordKey.fScaleX = runFont.getScaleX();
+        wordKey.fSkewX = runFont.getSkewX();
+        wordKey.fFontFlags = font_flags_for_word_cache(runFont);
+        wordKey.fFeaturesHash = featuresHash;
+        wordKey.fScript = hb_buffer_get_script(buffer);
+        wordKey.fDirection = direction;
+        wordKey.fLanguage = hbLanguage;
+    }
+    if (useWordCache) {
+        split_words(utf8Start, utf8End, &wordStarts);
+    }
+    // Cached words were shaped without regard to any surrounding text, so a run which is shaped
+    // against context can't be assembled from them; its interior words may still be cached below.
+    if (useWordCache && !hasPreContext && !hasPostContext) {
+        WordCache& cache = get_word_cache();
+        SkAutoMutexExclusive lock(cache.fMutex);
+        STArray<16, const CachedWord*> words;
+        size_t glyphCount = 0;
+        for (int i = 0; cache.fWords && i < wordStarts.size(); ++i) {
+            const char* wordEnd = i + 1 < wordStarts.size() ? wordStarts[i + 1] : utf8End;
+            const CachedWord* word = cache.fWords->find(word_cache_key(wordKey, wordStarts[i],
+                                                                     wordEnd));
+            if (!word) {
+                break;
+            }
+            words.push_back(word);
+            glyphCount += word->fGlyphs.size();
+        }
+        if (words.size() == wordStarts.size() && glyphCount > 0) {
+            cache.fHits += words.size();
+            run = ShapedRun(RunHandler::Range(utf8Start - utf8, utf8runLength),
+                            font.currentFont(), bidi.currentLevel(),
+                            std::unique_ptr<ShapedGlyph[]>(new ShapedGlyph[glyphCount]),
+                            glyphCount);
+            size_t glyphIndex = 0;
+            for (int i = 0; i < words.size(); ++i) {
+                const uint32_t wordCluster = SkTo<uint32_t>(wordStarts[i] - utf8);
+                for (ShapedGlyph glyph : words[i]->fGlyphs) {
+                    glyph.fCluster += wordCluster;
+                    run.fGlyphs[glyphIndex++] = glyph;
+                }
+                run.fAdvance += words[i]->fAdvance;
+            }
+            return run;
+        }
+        cache.fMisses += wordStarts.size() - words.size();
+    }
+
     hb_shape(hbFont.get(), buffer, hbFeatures.data(), hbFeatures.size());
     unsigned len = hb_buffer_get_length(buffer);
     if (len == 0) {
@@ -1415,8 +1613,12 @@ ShapedRun ShaperHarfBuzz::shape(char const * const utf8,
     }
     run.fAdvance = runAdvance;
 
+    if (useWordCache) {
+        add_to_word_cache(run, utf8, utf8End, hasPreContext, hasPostContext, wordKey, wordStarts);
+    }
     return run;
 }
+
 }  // namespace
 
 #if !defined(SK_DISABLE_LEGACY_SKSHAPER_FUNCTIONS)
@@ -1532,7 +1734,36 @@ std::unique_ptr<SkShaper::ScriptRunIterator> ScriptRunIterator(const char* utf8,
 }
 
 void PurgeCaches() {
-    HBLockedFaceCache cache = get_hbFace_cache();
-    cache.reset();
+    {
+        HBLockedFaceCache cache = get_hbFace_cache();
+        cache.reset();
+    }
+    WordCache& wordCache = get_word_cache();
+    SkAutoMutexExclusive lock(wordCache.fMutex);
+    wordCache.fWords.reset();
+}
+
+void SetWordCacheLimit(int maxWords) {
+    WordCache& cache = get_word_cache();
+    SkAutoMutexExclusive lock(cache.fMutex);
+    gWordCacheLimit.store(std::max(maxWords, 0), std::memory_order_relaxed);
+    cache.fWords.reset();
+}
+
+WordCacheStats GetWordCacheStats() {
+    WordCache& cache = get_word_cache();
+    SkAutoMutexExclusive lock(cache.fMutex);
+    WordCacheStats stats;
+    stats.fHits = cache.fHits;
+    stats.fMisses = cache.fMisses;
+    stats.fCount = cache.fWords ? cache.fWords->count() : 0;
+    return stats;
+}
+
+void ResetWordCacheStats() {
+    WordCache& cache = get_word_cache();
+    SkAutoMutexExclusive lock(cache.fMutex);
+    cache.fHits = 0;
+    cache.fMisses = 0;
 }
 }  // namespace SkShapers::HB
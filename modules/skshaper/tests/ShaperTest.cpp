@@ -22,7 +22,9 @@
 
 #include <cinttypes>
 #include <cstdint>
+#include <cstring>
 #include <memory>
+#include <vector>
 
 #if defined(SK_UNICODE_ICU_IMPLEMENTATION)
 #include "modules/skunicode/include/SkUnicode_icu.h"
@@ -226,6 +228,44 @@ void cluster_test(skiatest::Reporter* reporter, const char* resource) {
     shaper_test(reporter, resource, data.get());
 }
 
+// Records every glyph and position emitted by a shaper.
+struct CollectingRunHandler final : public SkShaper::RunHandler {
+    std::vector<SkGlyphID> fGlyphs;
+    std::vector<SkPoint> fPositions;
+    std::vector<uint32_t> fClusters;
+    SkVector fOffset = {0, 0};
+
+    void beginLine() override {}
+    void runInfo(const RunInfo&) override {}
+    void commitRunInfo() override {}
+    Buffer runBuffer(const RunInfo& info) override {
+        size_t start = fGlyphs.size();
+        fGlyphs.resize(start + info.glyphCount);
+        fPositions.resize(start + info.glyphCount);
+        fClusters.resize(start + info.glyphCount);
+        return {&fGlyphs[start], &fPositions[start], nullptr, &fClusters[start], fOffset};
+    }
+    void commitRunBuffer(const RunInfo& info) override { fOffset += info.fAdvance; }
+    void commitLine() override {}
+};
+
+// Reports a single font as two runs, so that the shaper sees a run boundary at `split`.
+class SplitFontRunIterator final : public SkShaper::FontRunIterator {
+public:
+    SplitFontRunIterator(const SkFont& font, size_t split, size_t utf8Bytes)
+            : fFont(font), fSplit(split), fEnd(utf8Bytes) {}
+    void consume() override { fCurrent = (fCurrent < fSplit) ? fSplit : fEnd; }
+    size_t endOfCurrentRun() const override { return fCurrent; }
+    bool atEnd() const override { return fCurrent == fEnd; }
+    const SkFont& currentFont() const override { return fFont; }
+
+private:
+    SkFont fFont;
+    size_t fSplit;
+    size_t fEnd;
+    size_t fCurrent = 0;
+};
+
 #endif  // defined(SK_SHAPER_HARFBUZZ_AVAILABLE) && defined(SK_SHAPER_UNICODE_AVAILABLE)
 
 }  // namespace
@@ -271,4 +311,92 @@ SHAPER_TEST(taitham)
 SHAPER_TEST(tamil)
 #undef SHAPER_TEST
 
+DEF_TEST(Shaper_word_cache, r) {
+    auto unicode = get_unicode();
+    if (!unicode) {
+        ERRORF(r, "Could not create unicode.");
+        return;
+    }
+    auto shaper = SkShapers::HB::ShapeDontWrapOrReorder(unicode, SkFontMgr::RefEmpty());
+    SkFont font = ToolUtils::DefaultFont();
+    const char utf8[] = "the quick brown fox jumps over the lazy dog the quick brown fox";
+    size_t utf8Bytes = strlen(utf8);
+
+    auto shape = [&](CollectingRunHandler* handler) {
+        constexpr SkFourByteTag latn = SkSetFourByteTag('l','a','t','n');
+        auto fontIterator = SkShaper::TrivialFontRunIterator(font, utf8Bytes);
+        auto bidiIterator = SkShaper::TrivialBiDiRunIterator(0, utf8Bytes);
+        auto scriptIterator = SkShaper::TrivialScriptRunIterator(latn, utf8Bytes);
+        auto languageIterator = SkShaper::TrivialLanguageRunIterator("en-US", utf8Bytes);
+        shaper->shape(utf8, utf8Bytes, fontIterator, bidiIterator, scriptIterator,
+                      languageIterator, nullptr, 0, SK_ScalarInfinity, handler);
+    };
+
+    CollectingRunHandler uncached;
+    shape(&uncached);
+
+    // The first pass fills the cache, the second should be served from it. Both must match the
+    // uncached result exactly.
+    SkShapers::HB::SetWordCacheLimit(1000);
+    SkShapers::HB::ResetWordCacheStats();
+    CollectingRunHandler filling, cached;
+    shape(&filling);
+    shape(&cached);
+    SkShapers::HB::WordCacheStats stats = SkShapers::HB::GetWordCacheStats();
+    SkShapers::HB::SetWordCacheLimit(0);
+
+    REPORTER_ASSERT(r, stats.fHits > 0);
+    for (const CollectingRunHandler* handler : {&filling, &cached}) {
+        REPORTER_ASSERT(r, handler->fGlyphs == uncached.fGlyphs);
+        REPORTER_ASSERT(r, handler->fPositions == uncached.fPositions);
+        REPORTER_ASSERT(r, handler->fClusters == uncached.fClusters);
+    }
+}
+
+DEF_TEST(Shaper_word_cache_run_edges, r) {
+    auto unicode = get_unicode();
+    if (!unicode) {
+        ERRORF(r, "Could not create unicode.");
+        return;
+    }
+    auto shaper = SkShapers::HB::ShapeDontWrapOrReorder(unicode, SkFontMgr::RefEmpty());
+    SkFont font = ToolUtils::DefaultFont();
+    // The run boundary falls inside "three", so "th" and "ree " are each shaped against the other
+    // run as context.
+    const char utf8[] = "one two three four";
+    size_t utf8Bytes = strlen(utf8);
+    size_t split = strlen("one two th");
+
+    auto shape = [&](CollectingRunHandler* handler) {
+        constexpr SkFourByteTag latn = SkSetFourByteTag('l','a','t','n');
+        SplitFontRunIterator fontIterator(font, split, utf8Bytes);
+        auto bidiIterator = SkShaper::TrivialBiDiRunIterator(0, utf8Bytes);
+        auto scriptIterator = SkShaper::TrivialScriptRunIterator(latn, utf8Bytes);
+        auto languageIterator = SkShaper::TrivialLanguageRunIterator("en-US", utf8Bytes);
+        shaper->shape(utf8, utf8Bytes, fontIterator, bidiIterator, scriptIterator,
+                      languageIterator, nullptr, 0, SK_ScalarInfinity, handler);
+    };
+
+    CollectingRunHandler uncached;
+    shape(&uncached);
+
+    SkShapers::HB::SetWordCacheLimit(1000);
+    SkShapers::HB::ResetWordCacheStats();
+    CollectingRunHandler filling, reshaped;
+    shape(&filling);
+    shape(&reshaped);
+    SkShapers::HB::WordCacheStats stats = SkShapers::HB::GetWordCacheStats();
+    SkShapers::HB::SetWordCacheLimit(0);
+
+    // Only "one ", "two " and "four" can be cached; the words touching the run boundary can't, and
+    // neither run may be assembled from the cache since each one borders the other.
+    REPORTER_ASSERT(r, stats.fCount <= 3, "%d", stats.fCount);
+    REPORTER_ASSERT(r, stats.fHits == 0);
+    for (const CollectingRunHandler* handler : {&filling, &reshaped}) {
+        REPORTER_ASSERT(r, handler->fGlyphs == uncached.fGlyphs);
+        REPORTER_ASSERT(r, handler->fPositions == uncached.fPositions);
+        REPORTER_ASSERT(r, handler->fClusters == uncached.fClusters);
+    }
+}
+
 #endif  // #if defined(SK_SHAPER_HARFBUZZ_AVAILABLE) && defined(SK_SHAPER_UNICODE_AVAILABLE)
@@ -0,0 +1,103 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkStream.h"
+#include "include/core/SkString.h"
+#include "modules/svg/include/SkSVGDOM.h"
+
+#include <memory>
+
+namespace {
+
+// Filter chains applied to a grid of shapes covering the whole canvas.
+static constexpr char kBlur[] =
+        "<feGaussianBlur stdDeviation='8'/>";
+
+static constexpr char kTurbulence[] =
+        "<feTurbulence baseFrequency='0.01' numOctaves='4' result='noise'/>"
+        "<feComposite in='noise' in2='SourceAlpha' operator='in' result='masked'/>"
+        "<feMerge><feMergeNode in='SourceGraphic'/><feMergeNode in='masked'/></feMerge>";
+
+static constexpr char kLighting[] =
+        "<feGaussianBlur in='SourceAlpha' stdDeviation='3' result='bump'/>"
+        "<feSpecularLighting in='bump' surfaceScale='4' specularExponent='20' result='spec'>"
+        "<fePointLight x='-200' y='-300' z='400'/>"
+        "</feSpecularLighting>"
+        "<feComposite in='spec' in2='SourceGraphic' operator='arithmetic'"
+        " k1='0' k2='1' k3='1' k4='0'/>";
+
+SkString make_filter_svg(const char* effects) {
+    SkString svg;
+    svg.appendf("<svg xmlns='http://www.w3.org/2000/svg' width='1024' height='1024'>"
+                "<defs><filter id='f' x='0' y='0' width='1' height='1'>%s</filter></defs>"
+                "<g filter='url(#f)'>", effects);
+    for (int i = 0; i < 64; ++i) {
+        svg.appendf("<circle cx='%d' cy='%d' r='60' fill='#%06x'/>",
+                    64 + (i % 8) * 128, 64 + (i / 8) * 128, (i * 2654435761u) & 0xffffff);
+    }
+    svg.append("</g></svg>");
+
+    return svg;
+}
+
+// Renders a filtered SVG to a raster canvas, with or without a filter executor.
+class SVGFilterBench final : public Benchmark {
+public:
+    SVGFilterBench(const char* name, const char* effects, bool parallel)
+        : fName(SkStringPrintf("svg_filter_%s_%s", parallel ? "parallel" : "serial", name))
+        , fEffects(effects)
+        , fParallel(parallel) {}
+
+private:
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kRaster;
+    }
+
+    const char* onGetName() override { return fName.c_str(); }
+
+    SkISize onGetSize() override { return {1024, 1024}; }
+
+    void onDelayedSetup() override {
+        if (fParallel) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool();
+        }
+
+        const auto svg = make_filter_svg(fEffects);
+        SkMemoryStream stream(svg.c_str(), svg.size());
+
+        // Cached pictures would evaluate filters serially on playback.
+        fDOM = SkSVGDOM::Builder().setRenderCaching(false)
+                                  .setFilterExecutor(fExecutor.get())
+                                  .make(stream);
+        SkASSERT(fDOM);
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        while (loops-- > 0) {
+            fDOM->render(canvas);
+        }
+    }
+
+    const SkString              fName;
+    const char*                 fEffects;
+    const bool                  fParallel;
+
+    std::unique_ptr<SkExecutor> fExecutor;
+    sk_sp<SkSVGDOM>             fDOM;
+};
+
+} // namespace
+
+DEF_BENCH(return new SVGFilterBench("blur"      , kBlur      , false);)
+DEF_BENCH(return new SVGFilterBench("blur"      , kBlur      , true );)
+DEF_BENCH(return new SVGFilterBench("turbulence", kTurbulence, false);)
+DEF_BENCH(return new SVGFilterBench("turbulence", kTurbulence, true );)
+DEF_BENCH(return new SVGFilterBench("lighting"  , kLighting  , false);)
+DEF_BENCH(return new SVGFilterBench("lighting"  , kLighting  , true );)
@@ -0,0 +1,82 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkData.h"
+#include "include/core/SkStream.h"
+#include "include/core/SkString.h"
+#include "modules/svg/include/SkSVGDOM.h"
+#include "tools/Resources.h"
+
+namespace {
+
+// Approximates a large map: many small paths with ids, inline styles and transforms.
+sk_sp<SkData> make_map_svg() {
+    static constexpr int kRegions = 64,
+                         kPaths   = 128;
+
+    SkDynamicMemoryWStream stream;
+    stream.writeText("<svg xmlns='http://www.w3.org/2000/svg' width='4096' height='4096'>");
+    for (int i = 0; i < kRegions; ++i) {
+        stream.writeText(SkStringPrintf("<g id='region-%d' transform='translate(%d %d)'>",
+                                        i, (i % 8) * 512, (i / 8) * 512).c_str());
+        for (int j = 0; j < kPaths; ++j) {
+            const int x = (j % 16) * 32,
+                      y = (j / 16) * 64;
+            stream.writeText(SkStringPrintf(
+                    "<path id='area-%d-%d' "
+                    "style='fill:#%06x;fill-opacity:0.8;stroke:white;stroke-width:0.5' "
+                    "d='M%d %d l12.5 3.25 l8 9.5 l-4.25 11 l-10 6.75 l-9.5 -4 l-2 -12.25 z'/>",
+                    i, j, (i * 2654435761u + j * 40503u) & 0xffffff, x, y).c_str());
+        }
+        stream.writeText("</g>");
+    }
+    stream.writeText("</svg>");
+
+    return stream.detachAsData();
+}
+
+sk_sp<SkData> load_cowboy_svg() {
+    return GetResourceAsData("Cowboy.svg");
+}
+
+// Builds an SVG DOM from a document in memory.
+class SVGLoadBench final : public Benchmark {
+public:
+    SVGLoadBench(const char* name, sk_sp<SkData> (*loader)())
+        : fName(SkStringPrintf("svg_load_%s", name))
+        , fLoader(loader) {}
+
+private:
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        fData = fLoader();
+        SkASSERT(fData);
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        while (loops-- > 0) {
+            SkMemoryStream stream(fData);
+            auto dom = SkSVGDOM::Builder().make(stream);
+            SkASSERT(dom);
+        }
+    }
+
+    const SkString fName;
+    sk_sp<SkData> (*fLoader)();
+    sk_sp<SkData>  fData;
+};
+
+} // namespace
+
+DEF_BENCH(return new SVGLoadBench("cowboy", load_cowboy_svg);)
+DEF_BENCH(return new SVGLoadBench("map", make_map_svg);)
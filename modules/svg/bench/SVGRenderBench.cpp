@@ -0,0 +1,109 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkData.h"
+#include "include/core/SkSize.h"
+#include "include/core/SkStream.h"
+#include "include/core/SkString.h"
+#include "modules/svg/include/SkSVGDOM.h"
+#include "modules/svg/include/SkSVGNode.h"
+#include "tools/Resources.h"
+
+#include <utility>
+
+namespace {
+
+// Many small paths, grouped in regions.
+sk_sp<SkData> make_regions_svg() {
+    static constexpr int kRegions = 16,
+                         kPaths   = 64;
+
+    SkDynamicMemoryWStream stream;
+    stream.writeText("<svg xmlns='http://www.w3.org/2000/svg' width='1024' height='1024'>");
+    for (int i = 0; i < kRegions; ++i) {
+        stream.writeText(SkStringPrintf("<g id='region-%d' transform='translate(%d %d)'>",
+                                        i, (i % 4) * 256, (i / 4) * 256).c_str());
+        for (int j = 0; j < kPaths; ++j) {
+            stream.writeText(SkStringPrintf(
+                    "<path style='fill:#%06x;stroke:white;stroke-width:0.5' "
+                    "d='M%d %d l12.5 3.25 l8 9.5 l-4.25 11 l-10 6.75 l-9.5 -4 l-2 -12.25 z'/>",
+                    (i * 2654435761u + j * 40503u) & 0xffffff,
+                    (j % 8) * 32, (j / 8) * 32).c_str());
+        }
+        stream.writeText("</g>");
+    }
+    stream.writeText("</svg>");
+
+    return stream.detachAsData();
+}
+
+sk_sp<SkData> load_cowboy_svg() {
+    return GetResourceAsData("Cowboy.svg");
+}
+
+// Renders an SVG DOM repeatedly, optionally modifying one region per frame.
+class SVGRenderBench final : public Benchmark {
+public:
+    SVGRenderBench(const char* name, sk_sp<SkData> (*loader)(), bool cached, bool animated)
+        : fName(SkStringPrintf("svg_render_%s_%s%s",
+                               cached ? "cached" : "uncached", name,
+                               animated ? "_animated" : ""))
+        , fLoader(loader)
+        , fCached(cached)
+        , fAnimated(animated) {}
+
+private:
+    const char* onGetName() override { return fName.c_str(); }
+
+    SkISize onGetSize() override { return {1024, 1024}; }
+
+    void onDelayedSetup() override {
+        auto data = fLoader();
+        SkASSERT(data);
+
+        SkMemoryStream stream(std::move(data));
+        fDOM = SkSVGDOM::Builder().setRenderCaching(fCached).make(stream);
+        SkASSERT(fDOM);
+        fDOM->setContainerSize(SkSize::Make(1024, 1024));
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        while (loops-- > 0) {
+            if (fAnimated) {
+                this->animate();
+            }
+            fDOM->render(canvas);
+        }
+    }
+
+    void animate() {
+        const auto id = SkStringPrintf("region-%d", fFrame % 16);
+        if (auto* node = fDOM->findNodeById(id.c_str())) {
+            (*node)->setAttribute("opacity", fFrame % 2 ? "0.5" : "1");
+        }
+        fFrame++;
+    }
+
+    const SkString  fName;
+    sk_sp<SkData> (*fLoader)();
+    const bool      fCached,
+                    fAnimated;
+
+    sk_sp<SkSVGDOM> fDOM;
+    int             fFrame = 0;
+};
+
+} // namespace
+
+DEF_BENCH(return new SVGRenderBench("cowboy" , load_cowboy_svg , true , false);)
+DEF_BENCH(return new SVGRenderBench("cowboy" , load_cowboy_svg , false, false);)
+DEF_BENCH(return new SVGRenderBench("regions", make_regions_svg, true , false);)
+DEF_BENCH(return new SVGRenderBench("regions", make_regions_svg, false, false);)
+DEF_BENCH(return new SVGRenderBench("regions", make_regions_svg, true , true );)
+DEF_BENCH(return new SVGRenderBench("regions", make_regions_svg, false, true );)
@@ -16,6 +16,8 @@
 #include "modules/svg/include/SkSVGNode.h"
 #include "modules/svg/include/SkSVGTransformableNode.h"
 
+#include <cstdint>
+
 class SkSVGRenderContext;
 
 class SK_API SkSVGContainer : public SkSVGTransformableNode {
@@ -33,6 +35,8 @@ protected:
 
     bool hasChildren() const final;
 
+    uint32_t onChildrenGenerationID() const final;
+
     template <typename NodeType, typename Func>
     void forEachChild(Func func) const {
         for (const auto& child : fChildren) {
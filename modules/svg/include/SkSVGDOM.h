@@ -17,8 +17,12 @@
 #include "modules/svg/include/SkSVGIDMapper.h"
 #include "modules/svg/include/SkSVGSVG.h"
 
+#include <memory>
+
 class SkCanvas;
+class SkExecutor;
 class SkSVGNode;
+class SkSVGRenderCache;
 class SkStream;
 struct SkSVGPresentationContext;
 
@@ -45,14 +49,37 @@ public:
          */
         Builder& setTextShapingFactory(sk_sp<SkShapers::Factory>);
 
+        /**
+         * Specify whether render() should cache the rendered content of the root element
+         * children, as pictures (disabled by default).
+         *
+         * Cached content is invalidated when modified via the node attribute setters,
+         * setAttribute() or appendChild().  Clients mutating the DOM by other means
+         * should not enable caching.  The pictures are limited to 16MB per DOM, and
+         * content which does not fit is rendered directly.
+         */
+        Builder& setRenderCaching(bool);
+
+        /**
+         * Specify an executor for evaluating filter effects in parallel, when rendering to
+         * raster canvases: large filtered content is split into tiles, evaluated concurrently.
+         *
+         * The executor is not owned, and must outlive the DOM.
+         */
+        Builder& setFilterExecutor(SkExecutor*);
+
         sk_sp<SkSVGDOM> make(SkStream&) const;
 
     private:
         sk_sp<SkFontMgr>                             fFontMgr;
         sk_sp<skresources::ResourceProvider>         fResourceProvider;
         sk_sp<SkShapers::Factory>                    fTextShapingFactory;
+        SkExecutor*                                  fFilterExecutor = nullptr;
+        bool                                         fRenderCaching  = false;
     };
 
+    ~SkSVGDOM() override;
+
     static sk_sp<SkSVGDOM> MakeFromStream(SkStream& str) {
         return Builder().make(str);
     }
@@ -100,14 +127,18 @@ private:
              sk_sp<SkFontMgr>,
              sk_sp<skresources::ResourceProvider>,
              SkSVGIDMapper&&,
-             sk_sp<SkShapers::Factory>);
+             sk_sp<SkShapers::Factory>,
+             SkExecutor* filterExecutor,
+             bool renderCaching);
 
     const sk_sp<SkSVGSVG>                       fRoot;
     const sk_sp<SkFontMgr>                      fFontMgr;
     const sk_sp<SkShapers::Factory>             fTextShapingFactory;
     const sk_sp<skresources::ResourceProvider>  fResourceProvider;
     const SkSVGIDMapper                         fIDMapper;
+    SkExecutor* const                           fFilterExecutor;
     SkSize                                      fContainerSize;
+    const std::unique_ptr<SkSVGRenderCache>     fRenderCache;
 };
 
 #endif // SkSVGDOM_DEFINED
@@ -15,6 +15,7 @@
 #include "modules/svg/include/SkSVGAttributeParser.h"
 #include "modules/svg/include/SkSVGTypes.h"
 
+#include <cstdint>
 #include <utility>
 
 class SkMatrix;
@@ -92,6 +93,7 @@ public:                                                                      \
         } else {                                                             \
             dest->set(SkSVGPropertyState::kInherit);                         \
         }                                                                    \
+        this->invalidate();                                                  \
     }                                                                        \
     void set##attr_name(SkSVGProperty<attr_type, attr_inherited>&& v) {      \
         auto* dest = &fPresentationAttributes.f##attr_name;                  \
@@ -101,6 +103,7 @@ public:                                                                      \
         } else {                                                             \
             dest->set(SkSVGPropertyState::kInherit);                         \
         }                                                                    \
+        this->invalidate();                                                  \
     }
 
 class SK_API SkSVGNode : public SkRefCnt {
@@ -122,6 +125,13 @@ public:
     // TODO: consolidate with existing setAttribute
     virtual bool parseAndSetAttribute(const char* name, const char* value);
 
+    // Changes whenever the node is modified through the DOM API (attribute setters,
+    // setAttribute(), appendChild()).
+    uint32_t generationID() const { return fGenerationID; }
+
+    // As above, for the node and all of its descendants.
+    uint32_t subtreeGenerationID() const;
+
     // inherited
     SVG_PRES_ATTR(ClipRule                 , SkSVGFillRule  , true)
     SVG_PRES_ATTR(Color                    , SkSVGColorType , true)
@@ -162,6 +172,12 @@ protected:
 
     static SkMatrix ComputeViewboxMatrix(const SkRect&, const SkRect&, SkSVGPreserveAspectRatio);
 
+    // Records a modification of the node, to be called by all mutators.
+    void invalidate() { fGenerationID = NextGenerationID(); }
+
+    // Returns the most recent subtree generation ID of all children.
+    virtual uint32_t onChildrenGenerationID() const { return 0; }
+
     // Called before onRender(), to apply local attributes to the context.  Unlike onRender(),
     // onPrepareToRender() bubbles up the inheritance chain: overriders should always call
     // INHERITED::onPrepareToRender(), unless they intend to short-circuit rendering
@@ -185,7 +201,10 @@ protected:
     }
 
 private:
+    static uint32_t NextGenerationID();
+
     SkSVGTag                    fTag;
+    uint32_t                    fGenerationID = 0;
 
     // FIXME: this should be sparse
     SkSVGPresentationAttributes fPresentationAttributes;
@@ -208,8 +227,14 @@ private:
             return pr.isValid();                                              \
         }                                                                     \
     public:                                                                   \
-        void set##attr_name(const attr_type& a) { set_cp(a); }                \
-        void set##attr_name(attr_type&& a) { set_mv(std::move(a)); }
+        void set##attr_name(const attr_type& a) {                             \
+            set_cp(a);                                                        \
+            this->invalidate();                                               \
+        }                                                                     \
+        void set##attr_name(attr_type&& a) {                                  \
+            set_mv(std::move(a));                                             \
+            this->invalidate();                                               \
+        }
 
 #define SVG_ATTR(attr_name, attr_type, attr_default)                        \
     private:                                                                \
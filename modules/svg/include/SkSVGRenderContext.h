@@ -30,9 +30,13 @@
 #include <cstdint>
 #include <memory>
 #include <utility>
+#include <vector>
 
 class SkCanvas;
+class SkExecutor;
+class SkImageFilter;
 class SkPaint;
+class SkSVGRenderCache;
 class SkString;
 namespace skresources { class ResourceProvider; }
 
@@ -141,6 +145,19 @@ public:
     // (effectively breaks reference cycles, assuming appropriate return value scoping).
     BorrowedNode findNodeById(const SkSVGIRI&) const;
 
+    // The cache of rendered subtrees, if any.  Inherited by derived contexts.
+    SkSVGRenderCache* renderCache() const { return fRenderCache; }
+    void setRenderCache(SkSVGRenderCache* cache) { fRenderCache = cache; }
+
+    // When set, nodes resolved via findNodeById() are appended to the list: they are
+    // dependencies of the content rendered in this context.  Inherited by derived contexts.
+    void setDependencies(std::vector<const SkSVGNode*>* deps) { fDependencies = deps; }
+
+    // When set, large filtered content drawn to raster canvases is split into tiles, and the
+    // filter evaluated on the executor.  Inherited by derived contexts.
+    SkExecutor* filterExecutor() const { return fFilterExecutor; }
+    void setFilterExecutor(SkExecutor* executor) { fFilterExecutor = executor; }
+
     SkTLazy<SkPaint> fillPaint() const;
     SkTLazy<SkPaint> strokePaint() const;
 
@@ -198,6 +215,7 @@ private:
 
     void applyOpacity(SkScalar opacity, uint32_t flags, bool hasFilter);
     void applyFilter(const SkSVGFuncIRI&);
+    bool deferFilter(sk_sp<SkImageFilter>);
     void applyClip(const SkSVGFuncIRI&);
     void applyMask(const SkSVGFuncIRI&);
 
@@ -222,6 +240,14 @@ private:
 
     // Current object bounding box scope.
     const OBBScope                                fOBBScope;
+
+    SkSVGRenderCache*                             fRenderCache    = nullptr;
+    std::vector<const SkSVGNode*>*                fDependencies   = nullptr;
+    SkExecutor*                                   fFilterExecutor = nullptr;
+
+    // Filtered content, recorded for tiled evaluation on destruction.
+    struct DeferredFilter;
+    std::unique_ptr<DeferredFilter>               fDeferredFilter;
 };
 
 #endif // SkSVGRenderContext_DEFINED
@@ -16,6 +16,7 @@
 #include "modules/svg/include/SkSVGTransformableNode.h"
 #include "modules/svg/include/SkSVGTypes.h"
 
+#include <cstdint>
 #include <vector>
 
 class SkSVGRenderContext;
@@ -60,6 +61,8 @@ protected:
 
     bool parseAndSetAttribute(const char*, const char*) override;
 
+    uint32_t onChildrenGenerationID() const final;
+
 private:
     std::vector<sk_sp<SkSVGTextFragment>> fChildren;
 
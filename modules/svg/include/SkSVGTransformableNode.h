@@ -21,7 +21,10 @@ struct SkRect;
 
 class SK_API SkSVGTransformableNode : public SkSVGNode {
 public:
-    void setTransform(const SkSVGTransformType& t) { fTransform = t; }
+    void setTransform(const SkSVGTransformType& t) {
+        fTransform = t;
+        this->invalidate();
+    }
 
 protected:
     SkSVGTransformableNode(SkSVGTag);
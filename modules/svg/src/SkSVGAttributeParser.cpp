@@ -17,6 +17,9 @@
 #include "src/base/SkUTF.h"
 
 #include <math.h>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
 #include <utility>
 
 namespace {
@@ -46,6 +49,13 @@ inline bool is_hex(char c) {
            is_between(c, '0', '9');
 }
 
+inline bool is_ascii_ident(char c) {
+    return is_between(c, 'a', 'z') ||
+           is_between(c, 'A', 'Z') ||
+           is_between(c, '0', '9') ||
+           c == '_' || c == '-';
+}
+
 }  // namespace
 
 SkSVGAttributeParser::SkSVGAttributeParser(const char attributeString[])
@@ -250,6 +260,28 @@ bool SkSVGAttributeParser::parseLengthUnitToken(SkSVGLength::Unit* unit) {
 bool SkSVGAttributeParser::parseNamedColorToken(SkColor* c) {
     RestoreCurPos restoreCurPos(this);
 
+    // Color keywords are short ASCII identifiers: unless the token has escapes or non-ASCII
+    // characters, look it up from a stack copy instead of allocating an SkString.
+    const char* identEnd = fCurPos;
+    while (identEnd < fEndPos && is_ascii_ident(*identEnd)) { ++identEnd; }
+
+    if (identEnd == fEndPos || (*identEnd != '\\' && static_cast<uint8_t>(*identEnd) < 0x80)) {
+        char ident[32];
+        const size_t identSize = identEnd - fCurPos;
+        if (identSize == 0 || identSize >= std::size(ident)) {
+            return false;
+        }
+        memcpy(ident, fCurPos, identSize);
+        ident[identSize] = '\0';
+        if (!SkParse::FindNamedColor(ident, identSize, c)) {
+            return false;
+        }
+        fCurPos = identEnd;
+
+        restoreCurPos.clear();
+        return true;
+    }
+
     SkString ident;
     if (!this->parseIdentToken(&ident)) {
         return false;
@@ -270,11 +302,12 @@ bool SkSVGAttributeParser::parseHexColorToken(SkColor* c) {
         return false;
     }
 
+    // The hex token is followed by a non-hex character (or the terminator), so FindHex stops
+    // at its end.
     uint32_t v;
-    SkString hexString(fCurPos, hexEnd - fCurPos);
-    SkParse::FindHex(hexString.c_str(), &v);
+    SkParse::FindHex(fCurPos, &v);
 
-    switch (hexString.size()) {
+    switch (hexEnd - fCurPos) {
     case 6:
         // matched #xxxxxxx
         break;
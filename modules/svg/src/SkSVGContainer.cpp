@@ -10,22 +10,40 @@
 #include "include/core/SkPath.h"
 #include "include/pathops/SkPathOps.h"
 #include "include/private/base/SkAssert.h"
+#include "modules/svg/include/SkSVGRenderContext.h"
+#include "modules/svg/src/SkSVGRenderCache.h"
 
+#include <algorithm>
 #include <utility>
-class SkSVGRenderContext;
 
 SkSVGContainer::SkSVGContainer(SkSVGTag t) : INHERITED(t) { }
 
 void SkSVGContainer::appendChild(sk_sp<SkSVGNode> node) {
     SkASSERT(node);
     fChildren.push_back(std::move(node));
+    this->invalidate();
 }
 
 bool SkSVGContainer::hasChildren() const {
     return !fChildren.empty();
 }
 
+uint32_t SkSVGContainer::onChildrenGenerationID() const {
+    uint32_t id = 0;
+    for (const auto& child : fChildren) {
+        id = std::max(id, child->subtreeGenerationID());
+    }
+    return id;
+}
+
 void SkSVGContainer::onRender(const SkSVGRenderContext& ctx) const {
+    if (auto* cache = ctx.renderCache(); cache && cache->isCachedContainer(this)) {
+        for (int i = 0; i < fChildren.size(); ++i) {
+            cache->render(fChildren[i].get(), ctx);
+        }
+        return;
+    }
+
     for (int i = 0; i < fChildren.size(); ++i) {
         fChildren[i]->render(ctx);
     }
@@ -11,6 +11,7 @@
 #include "include/core/SkFontMgr.h"
 #include "include/core/SkString.h"
 #include "include/private/base/SkAssert.h"
+#include "include/private/base/SkTemplates.h"
 #include "include/private/base/SkTo.h"
 #include "modules/skshaper/include/SkShaper_factory.h"
 #include "modules/svg/include/SkSVGAttribute.h"
@@ -52,15 +53,18 @@
 #include "modules/svg/include/SkSVGTypes.h"
 #include "modules/svg/include/SkSVGUse.h"
 #include "modules/svg/include/SkSVGValue.h"
+#include "modules/svg/src/SkSVGRenderCache.h"
 #include "src/base/SkTSearch.h"
 #include "src/core/SkTraceEvent.h"
-#include "src/xml/SkDOM.h"
+#include "src/xml/SkXMLParser.h"
 
 #include <stdint.h>
 #include <array>
 #include <cstring>
+#include <memory>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 namespace {
 
@@ -141,67 +145,75 @@ bool SetPreserveAspectRatioAttribute(const sk_sp<SkSVGNode>& node, SkSVGAttribut
     return true;
 }
 
-SkString TrimmedString(const char* first, const char* last) {
+// Trims the [first, last) range of a buffer in place, and returns it as a C string.
+const char* TrimmedString(char* first, char* last) {
     SkASSERT(first);
     SkASSERT(last);
     SkASSERT(first <= last);
 
-    while (first <= last && *first <= ' ') { first++; }
-    while (first <= last && *last  <= ' ') { last--; }
+    while (first < last && *first      <= ' ') { first++; }
+    while (first < last && *(last - 1) <= ' ') { last--;  }
 
-    SkASSERT(last - first + 1 >= 0);
-    return SkString(first, SkTo<size_t>(last - first + 1));
+    *last = '\0';
+    return first;
 }
 
-// Breaks a "foo: bar; baz: ..." string into key:value pairs.
+// Breaks a "foo: bar; baz: ..." string into key:value pairs, in place.
 class StyleIterator {
 public:
-    StyleIterator(const char* str) : fPos(str) { }
+    StyleIterator(char* str) : fPos(str) { }
 
-    std::tuple<SkString, SkString> next() {
-        SkString name, value;
+    // The returned strings point into the iterated buffer.  The name is empty when done.
+    std::tuple<const char*, const char*> next() {
+        const char* name  = "";
+        const char* value = "";
 
         if (fPos) {
-            const char* sep = this->nextSeparator();
+            char* sep = this->nextSeparator();
             SkASSERT(*sep == ';' || *sep == '\0');
+            char* next = *sep ? sep + 1 : nullptr;
 
-            const char* valueSep = strchr(fPos, ':');
+            char* valueSep = strchr(fPos, ':');
             if (valueSep && valueSep < sep) {
-                name  = TrimmedString(fPos, valueSep - 1);
-                value = TrimmedString(valueSep + 1, sep - 1);
+                name  = TrimmedString(fPos, valueSep);
+                value = TrimmedString(valueSep + 1, sep);
             }
 
-            fPos = *sep ? sep + 1 : nullptr;
+            fPos = next;
         }
 
         return std::make_tuple(name, value);
     }
 
 private:
-    const char* nextSeparator() const {
-        const char* sep = fPos;
+    char* nextSeparator() const {
+        char* sep = fPos;
         while (*sep != ';' && *sep != '\0') {
             sep++;
         }
         return sep;
     }
 
-    const char* fPos;
+    char* fPos;
 };
 
 bool set_string_attribute(const sk_sp<SkSVGNode>& node, const char* name, const char* value);
 
 bool SetStyleAttributes(const sk_sp<SkSVGNode>& node, SkSVGAttribute,
                         const char* stringValue) {
+    // The style is split in a copy of the string, which only allocates for long styles.
+    const size_t size = strlen(stringValue);
+    skia_private::AutoSTMalloc<256, char> buffer(size + 1);
+    memcpy(buffer.get(), stringValue, size + 1);
 
-    SkString name, value;
-    StyleIterator iter(stringValue);
+    const char* name, *value;
+    StyleIterator iter(buffer.get());
     for (;;) {
         std::tie(name, value) = iter.next();
-        if (name.isEmpty()) {
+        if (!*name) {
             break;
         }
-        set_string_attribute(node, name.c_str(), value.c_str());
+        set_string_attribute(node, name, value);
     }
 
     return true;
@@ -294,15 +306,6 @@ SortedDictionaryEntry<sk_sp<SkSVGNode>(*)()> gTagFactories[] = {
     { "use"                , []() -> sk_sp<SkSVGNode> { return SkSVGUse::Make();                 }},
 };
 
-struct ConstructionContext {
-    ConstructionContext(SkSVGIDMapper* mapper) : fParent(nullptr), fIDMapper(mapper) {}
-    ConstructionContext(const ConstructionContext& other, const sk_sp<SkSVGNode>& newParent)
-        : fParent(newParent.get()), fIDMapper(other.fIDMapper) {}
-
-    SkSVGNode*     fParent;
-    SkSVGIDMapper* fIDMapper;
-};
-
 bool set_string_attribute(const sk_sp<SkSVGNode>& node, const char* name, const char* value) {
     if (node->parseAndSetAttribute(name, value)) {
         // Handled by new code path
@@ -331,76 +334,104 @@ bool set_string_attribute(const sk_sp<SkSVGNode>& node, const char* name, const
     return true;
 }
 
-void parse_node_attributes(const SkDOM& xmlDom, const SkDOM::Node* xmlNode,
-                           const sk_sp<SkSVGNode>& svgNode, SkSVGIDMapper* mapper) {
-    const char* name, *value;
-    SkDOM::AttrIter attrIter(xmlDom, xmlNode);
-    while ((name = attrIter.next(&value))) {
-        // We're handling id attributes out of band for now.
-        if (!strcmp(name, "id")) {
-            mapper->set(SkString(value), svgNode);
-            continue;
-        }
-        set_string_attribute(svgNode, name, value);
+sk_sp<SkSVGNode> make_node(const SkSVGNode* parent, const char* elem) {
+    if (strcmp(elem, "svg") == 0) {
+        // Outermost SVG element must be tagged as such.
+        return SkSVGSVG::Make(parent ? SkSVGSVG::Type::kInner
+                                     : SkSVGSVG::Type::kRoot);
     }
-}
-
-sk_sp<SkSVGNode> construct_svg_node(const SkDOM& dom, const ConstructionContext& ctx,
-                                    const SkDOM::Node* xmlNode) {
-    const char* elem = dom.getName(xmlNode);
-    const SkDOM::Type elemType = dom.getType(xmlNode);
-
-    if (elemType == SkDOM::kText_Type) {
-        // Text literals require special handling.
-        SkASSERT(dom.countChildren(xmlNode) == 0);
-        auto txt = SkSVGTextLiteral::Make();
-        txt->setText(SkString(dom.getName(xmlNode)));
-        ctx.fParent->appendChild(std::move(txt));
 
+    const int tagIndex = SkStrSearch(&gTagFactories[0].fKey,
+                                     SkTo<int>(std::size(gTagFactories)),
+                                     elem, sizeof(gTagFactories[0]));
+    if (tagIndex < 0) {
+#if defined(SK_VERBOSE_SVG_PARSING)
+        SkDebugf("unhandled element: <%s>\n", elem);
+#endif
         return nullptr;
     }
+    SkASSERT(SkTo<size_t>(tagIndex) < std::size(gTagFactories));
+
+    return gTagFactories[tagIndex].fValue();
+}
 
-    SkASSERT(elemType == SkDOM::kElement_Type);
+// Constructs the SVG node tree as the document is parsed, without building an intermediate
+// SkDOM: element names, attributes and text are consumed straight from the parser buffers.
+class TreeBuilder final : public SkXMLParser {
+public:
+    explicit TreeBuilder(SkSVGIDMapper* mapper) : fIDMapper(mapper) {}
 
-    auto make_node = [](const ConstructionContext& ctx, const char* elem) -> sk_sp<SkSVGNode> {
-        if (strcmp(elem, "svg") == 0) {
-            // Outermost SVG element must be tagged as such.
-            return SkSVGSVG::Make(ctx.fParent ? SkSVGSVG::Type::kInner
-                                              : SkSVGSVG::Type::kRoot);
+    sk_sp<SkSVGNode> releaseRoot() { return std::move(fRoot); }
+
+private:
+    bool onStartElement(const char elem[]) override {
+        // Unhandled elements are skipped along with their subtree.
+        if (fSkipDepth > 0) {
+            fSkipDepth++;
+            return false;
         }
 
-        const int tagIndex = SkStrSearch(&gTagFactories[0].fKey,
-                                         SkTo<int>(std::size(gTagFactories)),
-                                         elem, sizeof(gTagFactories[0]));
-        if (tagIndex < 0) {
-#if defined(SK_VERBOSE_SVG_PARSING)
-            SkDebugf("unhandled element: <%s>\n", elem);
-#endif
-            return nullptr;
+        auto node = make_node(fStack.empty() ? nullptr : fStack.back().get(), elem);
+        if (!node) {
+            fSkipDepth = 1;
+            return false;
         }
-        SkASSERT(SkTo<size_t>(tagIndex) < std::size(gTagFactories));
 
-        return gTagFactories[tagIndex].fValue();
-    };
+        fStack.push_back(std::move(node));
+        return false;
+    }
 
-    auto node = make_node(ctx, elem);
-    if (!node) {
-        return nullptr;
+    bool onAddAttribute(const char name[], const char value[]) override {
+        if (fSkipDepth > 0) {
+            return false;
+        }
+        SkASSERT(!fStack.empty());
+
+        // We're handling id attributes out of band for now.
+        if (!strcmp(name, "id")) {
+            fIDMapper->set(SkString(value), fStack.back());
+            return false;
+        }
+        set_string_attribute(fStack.back(), name, value);
+        return false;
     }
 
-    parse_node_attributes(dom, xmlNode, node, ctx.fIDMapper);
+    bool onEndElement(const char[]) override {
+        if (fSkipDepth > 0) {
+            fSkipDepth--;
+            return false;
+        }
+        SkASSERT(!fStack.empty());
+
+        auto node = std::move(fStack.back());
+        fStack.pop_back();
+        if (fStack.empty()) {
+            fRoot = std::move(node);
+        } else {
+            fStack.back()->appendChild(std::move(node));
+        }
+        return false;
+    }
 
-    ConstructionContext localCtx(ctx, node);
-    for (auto* child = dom.getFirstChild(xmlNode, nullptr); child;
-         child = dom.getNextSibling(child)) {
-        sk_sp<SkSVGNode> childNode = construct_svg_node(dom, localCtx, child);
-        if (childNode) {
-            node->appendChild(std::move(childNode));
+    bool onText(const char text[], int len) override {
+        if (fSkipDepth > 0 || fStack.empty()) {
+            return false;
         }
+
+        // Text literals require special handling.
+        auto txt = SkSVGTextLiteral::Make();
+        txt->setText(SkString(text, SkTo<size_t>(len)));
+        fStack.back()->appendChild(std::move(txt));
+        return false;
     }
 
-    return node;
-}
+    SkSVGIDMapper*                fIDMapper;
+    sk_sp<SkSVGNode>              fRoot;
+    // The elements being constructed, outermost first.
+    std::vector<sk_sp<SkSVGNode>> fStack;
+    // The nesting depth within a skipped element.
+    int                           fSkipDepth = 0;
+};
 
 } // anonymous namespace
 
@@ -419,17 +450,25 @@ SkSVGDOM::Builder& SkSVGDOM::Builder::setTextShapingFactory(sk_sp<SkShapers::Fac
     return *this;
 }
 
+SkSVGDOM::Builder& SkSVGDOM::Builder::setRenderCaching(bool enabled) {
+    fRenderCaching = enabled;
+    return *this;
+}
+
+SkSVGDOM::Builder& SkSVGDOM::Builder::setFilterExecutor(SkExecutor* executor) {
+    fFilterExecutor = executor;
+    return *this;
+}
+
 sk_sp<SkSVGDOM> SkSVGDOM::Builder::make(SkStream& str) const {
     TRACE_EVENT0("skia", TRACE_FUNC);
-    SkDOM xmlDom;
-    if (!xmlDom.build(str)) {
+    SkSVGIDMapper mapper;
+    TreeBuilder builder(&mapper);
+    if (!builder.parse(str)) {
         return nullptr;
     }
 
-    SkSVGIDMapper mapper;
-    ConstructionContext ctx(&mapper);
-
-    auto root = construct_svg_node(xmlDom, ctx, xmlDom.getRootNode());
+    auto root = builder.releaseRoot();
     if (!root || root->tag() != SkSVGTag::kSvg) {
         return nullptr;
     }
@@ -447,37 +486,53 @@ sk_sp<SkSVGDOM> SkSVGDOM::Builder::make(SkStream& str) const {
                                         std::move(fFontMgr),
                                         std::move(resource_provider),
                                         std::move(mapper),
-                                        std::move(factory)));
+                                        std::move(factory),
+                                        fFilterExecutor,
+                                        fRenderCaching));
 }
 
 SkSVGDOM::SkSVGDOM(sk_sp<SkSVGSVG> root,
                    sk_sp<SkFontMgr> fmgr,
                    sk_sp<skresources::ResourceProvider> rp,
                    SkSVGIDMapper&& mapper,
-                   sk_sp<SkShapers::Factory> fact)
+                   sk_sp<SkShapers::Factory> fact,
+                   SkExecutor* filterExecutor,
+                   bool renderCaching)
         : fRoot(std::move(root))
         , fFontMgr(std::move(fmgr))
         , fTextShapingFactory(std::move(fact))
         , fResourceProvider(std::move(rp))
         , fIDMapper(std::move(mapper))
-        , fContainerSize(fRoot->intrinsicSize(SkSVGLengthContext(SkSize::Make(0, 0)))) {
+        , fFilterExecutor(filterExecutor)
+        , fContainerSize(fRoot->intrinsicSize(SkSVGLengthContext(SkSize::Make(0, 0))))
+        , fRenderCache(renderCaching ? std::make_unique<SkSVGRenderCache>() : nullptr) {
     SkASSERT(fResourceProvider);
     SkASSERT(fTextShapingFactory);
 }
 
+SkSVGDOM::~SkSVGDOM() = default;
+
 void SkSVGDOM::render(SkCanvas* canvas) const {
     TRACE_EVENT0("skia", TRACE_FUNC);
     if (fRoot) {
+        if (fRenderCache) {
+            fRenderCache->validate(fRoot.get(), fContainerSize);
+        }
+
         SkSVGLengthContext       lctx(fContainerSize);
         SkSVGPresentationContext pctx;
-        fRoot->render(SkSVGRenderContext(canvas,
-                                         fFontMgr,
-                                         fResourceProvider,
-                                         fIDMapper,
-                                         lctx,
-                                         pctx,
-                                         {nullptr, nullptr},
-                                         fTextShapingFactory));
+        SkSVGRenderContext       ctx(canvas,
+                                     fFontMgr,
+                                     fResourceProvider,
+                                     fIDMapper,
+                                     lctx,
+                                     pctx,
+                                     {nullptr, nullptr},
+                                     fTextShapingFactory);
+        ctx.setRenderCache(fRenderCache.get());
+        ctx.setFilterExecutor(fFilterExecutor);
+
+        fRoot->render(ctx);
     }
 }
 
@@ -486,15 +541,17 @@ void SkSVGDOM::renderNode(SkCanvas* canvas, SkSVGPresentationContext& pctx, cons
 
     if (fRoot) {
         SkSVGLengthContext lctx(fContainerSize);
-        fRoot->renderNode(SkSVGRenderContext(canvas,
-                                             fFontMgr,
-                                             fResourceProvider,
-                                             fIDMapper,
-                                             lctx,
-                                             pctx,
-                                             {nullptr, nullptr},
-                                             fTextShapingFactory),
-                          SkSVGIRI(SkSVGIRI::Type::kLocal, SkSVGStringType(id)));
+        SkSVGRenderContext ctx(canvas,
+                               fFontMgr,
+                               fResourceProvider,
+                               fIDMapper,
+                               lctx,
+                               pctx,
+                               {nullptr, nullptr},
+                               fTextShapingFactory);
+        ctx.setFilterExecutor(fFilterExecutor);
+
+        fRoot->renderNode(ctx, SkSVGIRI(SkSVGIRI::Type::kLocal, SkSVGStringType(id)));
     }
 }
 
@@ -503,7 +560,7 @@ const SkSize& SkSVGDOM::containerSize() const {
 }
 
 void SkSVGDOM::setContainerSize(const SkSize& containerSize) {
-    // TODO: inval
+    // Cached content is invalidated on the next render.
     fContainerSize = containerSize;
 }
 
@@ -18,6 +18,7 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstddef>
 
 SkSVGNode::SkSVGNode(SkSVGTag t) : fTag(t) {
@@ -31,6 +32,17 @@ SkSVGNode::SkSVGNode(SkSVGTag t) : fTag(t) {
 
 SkSVGNode::~SkSVGNode() { }
 
+uint32_t SkSVGNode::NextGenerationID() {
+    // IDs are process-wide, so a subtree generation ID (the max of all its nodes) changes
+    // whenever any node in the subtree is modified.
+    static std::atomic<uint32_t> gNextID{1};
+    return gNextID.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint32_t SkSVGNode::subtreeGenerationID() const {
+    return std::max(fGenerationID, this->onChildrenGenerationID());
+}
+
 void SkSVGNode::render(const SkSVGRenderContext& ctx) const {
     SkSVGRenderContext localContext(ctx, this);
 
@@ -80,6 +92,7 @@ bool SkSVGNode::onPrepareToRender(SkSVGRenderContext* ctx) const {
 
 void SkSVGNode::setAttribute(SkSVGAttribute attr, const SkSVGValue& v) {
     this->onSetAttribute(attr, v);
+    this->invalidate();
 }
 
 template <typename T>
@@ -0,0 +1,140 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "modules/svg/src/SkSVGRenderCache.h"
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkPictureRecorder.h"
+#include "modules/svg/include/SkSVGNode.h"
+#include "modules/svg/include/SkSVGRenderContext.h"
+#include "src/core/SkRectPriv.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+void SkSVGRenderCache::validate(const SkSVGNode* root, const SkSize& containerSize) {
+    // The root attributes and the container size determine the context all cached content is
+    // rendered in.
+    if (root != fRoot ||
+        root->generationID() != fRootGenerationID ||
+        containerSize != fContainerSize) {
+        this->reset();
+        fRoot             = root;
+        fRootGenerationID = root->generationID();
+        fContainerSize    = containerSize;
+    }
+
+    // Children which were not rendered last time have been removed, or are no longer reached.
+    std::vector<const SkSVGNode*> unused;
+    fEntries.foreach([&](const SkSVGNode* child, const Entry& entry) {
+        if (entry.fLastRenderID != fRenderID) {
+            unused.push_back(child);
+        }
+    });
+    for (const auto* child : unused) {
+        if (const auto& picture = fEntries.find(child)->fPicture) {
+            fBytesUsed -= picture->approximateBytesUsed();
+        }
+        fEntries.remove(child);
+    }
+
+    fRenderID++;
+}
+
+void SkSVGRenderCache::reset() {
+    fEntries.reset();
+    fBytesUsed = 0;
+}
+
+bool SkSVGRenderCache::Entry::isValid(const SkSVGNode* child) const {
+    if (child->subtreeGenerationID() != fGenerationID) {
+        return false;
+    }
+
+    // Referenced nodes are owned by the ID mapper, and outlive the cache.
+    for (const auto& [node, id] : fDependencies) {
+        if (node->subtreeGenerationID() != id) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void SkSVGRenderCache::RenderChild(const SkSVGNode* child,
+                                   const SkSVGRenderContext& ctx,
+                                   Entry* entry) {
+    std::vector<const SkSVGNode*> deps;
+    {
+        SkSVGRenderContext localContext(ctx);
+        // References to the cached container (e.g. via <use>) render directly.
+        localContext.setRenderCache(nullptr);
+        localContext.setDependencies(&deps);
+
+        child->render(localContext);
+    }
+
+    std::sort(deps.begin(), deps.end());
+    deps.erase(std::unique(deps.begin(), deps.end()), deps.end());
+
+    entry->fGenerationID = child->subtreeGenerationID();
+    entry->fDependencies.clear();
+    entry->fDependencies.reserve(deps.size());
+    entry->fCacheable = true;
+    for (const auto* node : deps) {
+        entry->fDependencies.emplace_back(node, node->subtreeGenerationID());
+
+        if (ctx.filterExecutor() && node->tag() == SkSVGTag::kFilter) {
+            entry->fCacheable = false;
+        }
+    }
+}
+
+void SkSVGRenderCache::render(const SkSVGNode* child, const SkSVGRenderContext& ctx) {
+    Entry* entry = fEntries.find(child);
+
+    if (!entry || !entry->isValid(child)) {
+        // New or modified content: render directly, and cache on the next render if unchanged.
+        if (entry && entry->fPicture) {
+            fBytesUsed -= entry->fPicture->approximateBytesUsed();
+        }
+        entry = fEntries.set(child, Entry());
+        entry->fLastRenderID = fRenderID;
+        RenderChild(child, ctx, entry);
+        return;
+    }
+
+    entry->fLastRenderID = fRenderID;
+
+    if (!entry->fCacheable || entry->fOverLimit) {
+        RenderChild(child, ctx, entry);
+        return;
+    }
+
+    if (!entry->fPicture) {
+        // Content is recorded without culling, in the container coordinate system: the
+        // current transform and clip only apply on playback.
+        SkPictureRecorder recorder;
+        SkSVGRenderContext recordingContext(ctx,
+                                            recorder.beginRecording(SkRectPriv::MakeLargeS32()));
+        RenderChild(child, recordingContext, entry);
+
+        auto picture = recorder.finishRecordingAsPicture();
+        const auto bytes = picture->approximateBytesUsed();
+        if (fBytesUsed + bytes > kByteLimit) {
+            // Play this recording back once, and render directly until the content changes.
+            entry->fOverLimit = true;
+            ctx.canvas()->drawPicture(picture);
+            return;
+        }
+        fBytesUsed += bytes;
+        entry->fPicture = std::move(picture);
+    }
+
+    ctx.canvas()->drawPicture(entry->fPicture);
+}
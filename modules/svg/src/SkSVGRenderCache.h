@@ -0,0 +1,84 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkSVGRenderCache_DEFINED
+#define SkSVGRenderCache_DEFINED
+
+#include "include/core/SkPicture.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkSize.h"
+#include "src/core/SkTHash.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+class SkSVGNode;
+class SkSVGRenderContext;
+
+/**
+ * Caches the rendered content of the outermost <svg> element children, as pictures.
+ *
+ * A cached picture is reused for as long as neither the child subtree nor any of the nodes it
+ * references (paint servers, clip paths, masks, filters, <use> targets, ...) have been
+ * modified, as tracked by their subtree generation IDs.
+ *
+ * Pictures are only recorded once a subtree renders unchanged for the second time: subtrees
+ * which change on every render are rendered directly, as if not cached.  So are subtrees using
+ * filters when a filter executor is set, as their tiled parallel evaluation only applies when
+ * rendering directly to a raster canvas.
+ *
+ * Entries for children which were not rendered by the last render are dropped.  The pictures
+ * are limited to kByteLimit in total; content which does not fit is rendered directly.
+ *
+ * Rendering updates the cache, so it must not be used concurrently.
+ */
+class SkSVGRenderCache {
+public:
+    inline static constexpr size_t kByteLimit = 16 * 1024 * 1024;
+
+    // Called before each render.  Drops all cached content when the outermost element or the
+    // container size change, and the content of children the previous render did not reach.
+    void validate(const SkSVGNode* root, const SkSize& containerSize);
+
+    bool isCachedContainer(const SkSVGNode* node) const { return node == fRoot; }
+
+    // Renders a child of the cached container, in the container context.
+    void render(const SkSVGNode* child, const SkSVGRenderContext&);
+
+private:
+    struct Entry {
+        // The child subtree generation ID, and the referenced nodes subtree generation IDs,
+        // when the child was last rendered.
+        uint32_t                                         fGenerationID;
+        std::vector<std::pair<const SkSVGNode*, uint32_t>> fDependencies;
+
+        sk_sp<SkPicture>                                 fPicture;
+        bool                                             fCacheable;
+        // Set when fPicture did not fit in the byte limit.
+        bool                                             fOverLimit = false;
+        uint32_t                                         fLastRenderID;
+
+        bool isValid(const SkSVGNode* child) const;
+    };
+
+    // Renders the child into the context canvas, collecting its dependencies.
+    static void RenderChild(const SkSVGNode* child, const SkSVGRenderContext&, Entry*);
+
+    void reset();
+
+    skia_private::THashMap<const SkSVGNode*, Entry> fEntries;
+    size_t                                          fBytesUsed = 0;
+    uint32_t                                        fRenderID  = 0;
+
+    const SkSVGNode* fRoot             = nullptr;
+    uint32_t         fRootGenerationID = 0;
+    SkSize           fContainerSize    = {0, 0};
+};
+
+#endif // SkSVGRenderCache_DEFINED
@@ -10,11 +10,20 @@
 #include "include/core/SkBlendMode.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkImage.h"
 #include "include/core/SkImageFilter.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkMatrix.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkPath.h"
 #include "include/core/SkPathEffect.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkPictureRecorder.h"
+#include "include/core/SkPixmap.h"
 #include "include/core/SkString.h"
+#include "include/core/SkSurface.h"
+#include "include/core/SkSurfaceProps.h"
 #include "include/effects/SkDashPathEffect.h"
 #include "include/private/base/SkDebug.h"
 #include "include/private/base/SkSpan_impl.h"
@@ -26,8 +35,13 @@
 #include "modules/svg/include/SkSVGMask.h"
 #include "modules/svg/include/SkSVGNode.h"
 #include "modules/svg/include/SkSVGTypes.h"
+#include "src/core/SkRectPriv.h"
+#include "src/core/SkTaskGroup.h"
 
+#include <cstdint>
 #include <cstring>
+#include <memory>
+#include <utility>
 #include <vector>
 
 using namespace skia_private;
@@ -150,8 +164,77 @@ static sk_sp<SkPathEffect> dash_effect(const SkSVGPresentationAttributes& props,
     return SkDashPathEffect::Make(intervals.begin(), intervals.size(), phase);
 }
 
+// Filtered content covering at least kFilterMinTiles tiles is evaluated in parallel.
+constexpr int kFilterTileSize = 256,
+              kFilterMinTiles = 2;
+
 }  // namespace
 
+struct SkSVGRenderContext::DeferredFilter {
+    SkPictureRecorder    fRecorder;
+    sk_sp<SkImageFilter> fFilter;
+    SkMatrix             fCTM;
+    // The filter output device bounds.
+    SkIRect              fBounds;
+
+    // The destination canvas, and its save count before the content was redirected.
+    SkCanvas*            fCanvas;
+    int                  fCanvasSaveCount;
+
+    // Evaluates the filter tiles in parallel, then draws them to the destination canvas.
+    void draw(SkExecutor* executor) {
+        const auto content = fRecorder.finishRecordingAsPicture();
+
+        SkSurfaceProps props;
+        fCanvas->getProps(&props);
+        const auto info = fCanvas->imageInfo().makeAlphaType(kPremul_SkAlphaType);
+
+        const int cols = (fBounds.width()  + kFilterTileSize - 1) / kFilterTileSize,
+                  rows = (fBounds.height() + kFilterTileSize - 1) / kFilterTileSize;
+
+        auto tile_bounds = [&](int i) {
+            auto tile = SkIRect::MakeXYWH(fBounds.x() + (i % cols) * kFilterTileSize,
+                                          fBounds.y() + (i / cols) * kFilterTileSize,
+                                          kFilterTileSize, kFilterTileSize);
+            SkAssertResult(tile.intersect(fBounds));
+            return tile;
+        };
+
+        // Each tile evaluates the whole filter graph for its own output region: the layer
+        // content required for that region, including any filter margin, is played back
+        // from the recording.
+        std::vector<sk_sp<SkImage>> tiles(cols * rows);
+        SkTaskGroup tasks(*executor);
+        tasks.batch(cols * rows, [&](int i) {
+            const auto tile = tile_bounds(i);
+            auto surface = SkSurfaces::Raster(info.makeDimensions(tile.size()), &props);
+            if (!surface) {
+                return;
+            }
+
+            auto* canvas = surface->getCanvas();
+            canvas->translate(-tile.x(), -tile.y());
+            canvas->concat(fCTM);
+
+            SkPaint filterPaint;
+            filterPaint.setImageFilter(fFilter);
+            canvas->saveLayer(nullptr, &filterPaint);
+            canvas->drawPicture(content);
+            canvas->restore();
+
+            tiles[i] = surface->makeImageSnapshot();
+        });
+        tasks.wait();
+
+        SkAutoCanvasRestore acr(fCanvas, true);
+        fCanvas->resetMatrix();
+        for (int i = 0; i < cols * rows; ++i) {
+            const auto tile = tile_bounds(i);
+            fCanvas->drawImage(tiles[i], tile.x(), tile.y());
+        }
+    }
+};
+
 SkSVGPresentationContext::SkSVGPresentationContext()
     : fInherited(SkSVGPresentationAttributes::MakeInitial())
 {}
@@ -182,7 +265,11 @@ SkSVGRenderContext::SkSVGRenderContext(const SkSVGRenderContext& other)
                              *other.fLengthContext,
                              *other.fPresentationContext,
                              other.fOBBScope,
-                             other.fTextShapingFactory) {}
+                             other.fTextShapingFactory) {
+    fRenderCache    = other.fRenderCache;
+    fDependencies   = other.fDependencies;
+    fFilterExecutor = other.fFilterExecutor;
+}
 
 SkSVGRenderContext::SkSVGRenderContext(const SkSVGRenderContext& other, SkCanvas* canvas)
         : SkSVGRenderContext(canvas,
@@ -192,7 +279,11 @@ SkSVGRenderContext::SkSVGRenderContext(const SkSVGRenderContext& other, SkCanvas
                              *other.fLengthContext,
                              *other.fPresentationContext,
                              other.fOBBScope,
-                             other.fTextShapingFactory) {}
+                             other.fTextShapingFactory) {
+    fRenderCache    = other.fRenderCache;
+    fDependencies   = other.fDependencies;
+    fFilterExecutor = other.fFilterExecutor;
+}
 
 SkSVGRenderContext::SkSVGRenderContext(const SkSVGRenderContext& other, const SkSVGNode* node)
         : SkSVGRenderContext(other.fCanvas,
@@ -202,10 +293,22 @@ SkSVGRenderContext::SkSVGRenderContext(const SkSVGRenderContext& other, const Sk
                              *other.fLengthContext,
                              *other.fPresentationContext,
                              OBBScope{node, this},
-                             other.fTextShapingFactory) {}
+                             other.fTextShapingFactory) {
+    fRenderCache    = other.fRenderCache;
+    fDependencies   = other.fDependencies;
+    fFilterExecutor = other.fFilterExecutor;
+}
 
 SkSVGRenderContext::~SkSVGRenderContext() {
     fCanvas->restoreToCount(fCanvasSaveCount);
+
+    if (fDeferredFilter) {
+        fCanvas          = fDeferredFilter->fCanvas;
+        fCanvasSaveCount = fDeferredFilter->fCanvasSaveCount;
+
+        fDeferredFilter->draw(fFilterExecutor);
+        fCanvas->restoreToCount(fCanvasSaveCount);
+    }
 }
 
 SkSVGRenderContext::BorrowedNode SkSVGRenderContext::findNodeById(const SkSVGIRI& iri) const {
@@ -213,7 +316,11 @@ SkSVGRenderContext::BorrowedNode SkSVGRenderContext::findNodeById(const SkSVGIRI
         SkDebugf("non-local iri references not currently supported");
         return BorrowedNode(nullptr);
     }
-    return BorrowedNode(fIDMapper.find(iri.iri()));
+    sk_sp<SkSVGNode>* node = fIDMapper.find(iri.iri());
+    if (node && *node && fDependencies) {
+        fDependencies->push_back(node->get());
+    }
+    return BorrowedNode(node);
 }
 
 void SkSVGRenderContext::applyPresentationAttributes(const SkSVGPresentationAttributes& attrs,
@@ -322,7 +429,7 @@ void SkSVGRenderContext::applyFilter(const SkSVGFuncIRI& filter) {
 
     const SkSVGFilter* filterNode = reinterpret_cast<const SkSVGFilter*>(node.get());
     sk_sp<SkImageFilter> imageFilter = filterNode->buildFilterDAG(*this);
-    if (imageFilter) {
+    if (imageFilter && !this->deferFilter(imageFilter)) {
         SkPaint filterPaint;
         filterPaint.setImageFilter(imageFilter);
         // Balanced in the destructor, via restoreToCount().
@@ -330,6 +437,44 @@ void SkSVGRenderContext::applyFilter(const SkSVGFuncIRI& filter) {
     }
 }
 
+bool SkSVGRenderContext::deferFilter(sk_sp<SkImageFilter> filter) {
+    // Only raster destinations benefit from evaluating filters on the CPU in parallel.
+    SkPixmap pixmap;
+    if (!fFilterExecutor || !fCanvas->peekPixels(&pixmap)) {
+        return false;
+    }
+
+    const auto ctm = fCanvas->getTotalMatrix();
+    if (ctm.hasPerspective()) {
+        return false;
+    }
+
+    auto local_bounds = SkRectPriv::MakeLargeS32();
+    if (filter->canComputeFastBounds()) {
+        local_bounds = filter->computeFastBounds(local_bounds);
+    }
+
+    auto bounds = ctm.mapRect(local_bounds).roundOut();
+    if (!bounds.intersect(fCanvas->getDeviceClipBounds()) ||
+        bounds.width64() * bounds.height64() < kFilterMinTiles * kFilterTileSize * kFilterTileSize) {
+        return false;
+    }
+
+    fDeferredFilter = std::make_unique<DeferredFilter>();
+    fDeferredFilter->fFilter          = std::move(filter);
+    fDeferredFilter->fCTM             = ctm;
+    fDeferredFilter->fBounds          = bounds;
+    fDeferredFilter->fCanvas          = fCanvas;
+    fDeferredFilter->fCanvasSaveCount = fCanvasSaveCount;
+
+    // Content rendered in this context (and in derived contexts) is recorded in local
+    // coordinates, without culling: it may contribute to the filter output outside the clip.
+    fCanvas          = fDeferredFilter->fRecorder.beginRecording(SkRectPriv::MakeLargeS32());
+    fCanvasSaveCount = fCanvas->getSaveCount();
+
+    return true;
+}
+
 void SkSVGRenderContext::saveOnce() {
     // The canvas only needs to be saved once, per local SkSVGRenderContext.
     if (fCanvas->getSaveCount() == fCanvasSaveCount) {
@@ -572,12 +572,21 @@ void SkSVGTextContainer::appendChild(sk_sp<SkSVGNode> child) {
     case SkSVGTag::kTSpan:
         fChildren.push_back(
             sk_sp<SkSVGTextFragment>(static_cast<SkSVGTextFragment*>(child.release())));
+        this->invalidate();
         break;
     default:
         break;
     }
 }
 
+uint32_t SkSVGTextContainer::onChildrenGenerationID() const {
+    uint32_t id = 0;
+    for (const auto& frag : fChildren) {
+        id = std::max(id, frag->subtreeGenerationID());
+    }
+    return id;
+}
+
 void SkSVGTextContainer::onShapeText(const SkSVGRenderContext& ctx, SkSVGTextContext* tctx,
                                      SkSVGXmlSpace) const {
     SkASSERT(tctx);
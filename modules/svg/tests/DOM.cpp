@@ -0,0 +1,71 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkColor.h"
+#include "include/core/SkStream.h"
+#include "modules/svg/include/SkSVGDOM.h"
+#include "modules/svg/include/SkSVGNode.h"
+#include "modules/svg/include/SkSVGSVG.h"
+#include "modules/svg/include/SkSVGTypes.h"
+#include "tests/Test.h"
+
+#include <cstring>
+
+namespace {
+
+sk_sp<SkSVGDOM> make_dom(const char* svg) {
+    SkMemoryStream stream(svg, strlen(svg));
+    return SkSVGDOM::Builder().make(stream);
+}
+
+bool has_fill(SkSVGDOM* dom, const char* id, SkColor color) {
+    sk_sp<SkSVGNode>* node = dom->findNodeById(id);
+    if (!node || !(*node)->getFill().isValue()) {
+        return false;
+    }
+    const SkSVGPaint& fill = *(*node)->getFill();
+    return fill.type() == SkSVGPaint::Type::kColor &&
+           fill.color().type() == SkSVGColor::Type::kColor &&
+           fill.color().color() == color;
+}
+
+} // namespace
+
+DEF_TEST(Svg_DOM_Builder, r) {
+    auto dom = make_dom(R"EOF(
+    <svg width="100" height="100" xmlns="http://www.w3.org/2000/svg">
+        <g id="group" style="fill: #f00 ; stroke:blue">
+            <unknown id="skipped"><rect id="nested" width="10" height="10"/></unknown>
+            <rect id="rect" width="10" height="10" style="fill:lime"/>
+            <rect id="escaped" width="10" height="10" style="fill:\62 lue"/>
+            <rect id="hex" width="10" height="10" fill="#00ff00"/>
+            <text id="text">Hello<tspan id="tspan">World</tspan></text>
+        </g>
+    </svg>
+    )EOF");
+    REPORTER_ASSERT(r, dom);
+    if (!dom) {
+        return;
+    }
+
+    REPORTER_ASSERT(r, has_fill(dom.get(), "group", SK_ColorRED));
+    REPORTER_ASSERT(r, has_fill(dom.get(), "rect", SK_ColorGREEN));
+    REPORTER_ASSERT(r, has_fill(dom.get(), "escaped", SK_ColorBLUE));
+    REPORTER_ASSERT(r, has_fill(dom.get(), "hex", SK_ColorGREEN));
+
+    // Unhandled elements are skipped, along with their subtree.
+    REPORTER_ASSERT(r, !dom->findNodeById("skipped"));
+    REPORTER_ASSERT(r, !dom->findNodeById("nested"));
+
+    REPORTER_ASSERT(r, dom->findNodeById("text"));
+    REPORTER_ASSERT(r, dom->findNodeById("tspan"));
+
+    // The root element must be an <svg> element, and the document well formed.
+    REPORTER_ASSERT(r, !make_dom(R"(<g xmlns="http://www.w3.org/2000/svg"/>)"));
+    REPORTER_ASSERT(r, !make_dom(R"(<svg xmlns="http://www.w3.org/2000/svg"><g></svg>)"));
+    REPORTER_ASSERT(r, !make_dom(""));
+}
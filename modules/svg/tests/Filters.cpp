@@ -5,8 +5,15 @@
  * found in the LICENSE file.
  */
 
+#include <cstdlib>
+#include <memory>
 #include <string>
 
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkImageInfo.h"
 #include "include/core/SkStream.h"
 #include "include/utils/SkNoDrawCanvas.h"
 #include "modules/svg/include/SkSVGDOM.h"
@@ -32,3 +39,73 @@ DEF_TEST(Svg_Filters_NonePaintInputs, r) {
     SkNoDrawCanvas canvas(500, 500);
     svg_dom->render(&canvas);
 }
+
+DEF_TEST(Svg_Filters_ParallelTiles, r) {
+    // Filters spanning several tiles, with blur margins, independent branches and
+    // source-less primitives.
+    const std::string svgText = R"EOF(
+    <svg width="700" height="500" xmlns="http://www.w3.org/2000/svg">
+        <defs>
+            <filter id="blur">
+                <feGaussianBlur stdDeviation="12"/>
+            </filter>
+            <filter id="merge" x="0" y="0" width="1" height="1">
+                <feTurbulence baseFrequency="0.02" numOctaves="2" result="noise"/>
+                <feOffset in="SourceGraphic" dx="17" dy="-9" result="offset"/>
+                <feComposite in="noise" in2="SourceAlpha" operator="in" result="masked"/>
+                <feMerge>
+                    <feMergeNode in="masked"/>
+                    <feMergeNode in="offset"/>
+                </feMerge>
+            </filter>
+            <filter id="light">
+                <feDiffuseLighting in="SourceAlpha" surfaceScale="5" lighting-color="#fc8">
+                    <feDistantLight azimuth="45" elevation="30"/>
+                </feDiffuseLighting>
+            </filter>
+        </defs>
+        <g filter="url(#blur)" transform="translate(13.5 7.25)">
+            <rect x="100" y="100" width="300" height="200" fill="#f80"/>
+            <circle cx="400" cy="300" r="120" fill="#08f"/>
+        </g>
+        <rect x="20" y="20" width="660" height="150" fill="#0a4" filter="url(#merge)"/>
+        <circle cx="350" cy="350" r="140" fill="#444" filter="url(#light)"/>
+    </svg>
+    )EOF";
+
+    const auto render = [&](SkExecutor* executor) {
+        auto str = SkMemoryStream::MakeDirect(svgText.c_str(), svgText.size());
+        auto svg_dom = SkSVGDOM::Builder().setFilterExecutor(executor).make(*str);
+
+        SkBitmap bitmap;
+        bitmap.allocPixels(SkImageInfo::MakeN32Premul(700, 500));
+        bitmap.eraseColor(SK_ColorWHITE);
+        SkCanvas canvas(bitmap);
+        if (svg_dom) {
+            svg_dom->render(&canvas);
+        }
+
+        return bitmap;
+    };
+
+    auto executor = SkExecutor::MakeFIFOThreadPool(4);
+    const auto expected = render(nullptr),
+               actual   = render(executor.get());
+
+    int mismatches = 0;
+    for (int y = 0; y < expected.height(); ++y) {
+        for (int x = 0; x < expected.width(); ++x) {
+            const auto e = expected.getColor(x, y),
+                       a = actual.getColor(x, y);
+            // Tiles are evaluated independently, which may round differently at the seams.
+            static constexpr int kTolerance = 1;
+            if (std::abs((int)SkColorGetA(e) - (int)SkColorGetA(a)) > kTolerance ||
+                std::abs((int)SkColorGetR(e) - (int)SkColorGetR(a)) > kTolerance ||
+                std::abs((int)SkColorGetG(e) - (int)SkColorGetG(a)) > kTolerance ||
+                std::abs((int)SkColorGetB(e) - (int)SkColorGetB(a)) > kTolerance) {
+                mismatches++;
+            }
+        }
+    }
+    REPORTER_ASSERT(r, mismatches == 0, "%d mismatched pixels", mismatches);
+}
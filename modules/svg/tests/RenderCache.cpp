@@ -0,0 +1,116 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkSize.h"
+#include "include/core/SkStream.h"
+#include "modules/svg/include/SkSVGDOM.h"
+#include "modules/svg/include/SkSVGNode.h"
+#include "tests/Test.h"
+
+#include <cstring>
+
+class SkMatrix;
+class SkPaint;
+class SkPicture;
+
+namespace {
+
+// A gradient filled group on the left, and a group of <use> elements on the right.
+static constexpr char kSvg[] = R"EOF(
+<svg width="100" height="100" xmlns="http://www.w3.org/2000/svg"
+     xmlns:xlink="http://www.w3.org/1999/xlink">
+    <defs>
+        <linearGradient id="grad">
+            <stop id="stop0" offset="0" stop-color="#f00"/>
+            <stop id="stop1" offset="1" stop-color="#f00"/>
+        </linearGradient>
+        <rect id="shape" width="50" height="50" fill="#00f"/>
+    </defs>
+    <g>
+        <rect width="50" height="50" fill="url(#grad)"/>
+        <rect y="50" width="50" height="50" fill="url(#grad)"/>
+    </g>
+    <g>
+        <use x="50" xlink:href="#shape"/>
+        <use x="50" y="50" xlink:href="#shape"/>
+    </g>
+</svg>
+)EOF";
+
+class DrawPictureCountingCanvas final : public SkCanvas {
+public:
+    explicit DrawPictureCountingCanvas(const SkBitmap& bitmap) : SkCanvas(bitmap) {}
+
+    int count() const { return fCount; }
+
+private:
+    void onDrawPicture(const SkPicture* picture, const SkMatrix* matrix,
+                       const SkPaint* paint) override {
+        fCount++;
+        this->SkCanvas::onDrawPicture(picture, matrix, paint);
+    }
+
+    int fCount = 0;
+};
+
+} // namespace
+
+DEF_TEST(Svg_DOM_RenderCache, r) {
+    SkMemoryStream stream(kSvg, strlen(kSvg));
+    auto dom = SkSVGDOM::Builder().setRenderCaching(true).make(stream);
+    REPORTER_ASSERT(r, dom);
+    if (!dom) {
+        return;
+    }
+
+    SkBitmap bitmap;
+    bitmap.allocPixels(SkImageInfo::MakeN32Premul(100, 100));
+    DrawPictureCountingCanvas canvas(bitmap);
+
+    auto render = [&](SkColor left, SkColor right, int expected_pictures, const char* step) {
+        bitmap.eraseColor(SK_ColorWHITE);
+        dom->render(&canvas);
+
+        REPORTER_ASSERT(r, bitmap.getColor(25, 25) == left , "%s", step);
+        REPORTER_ASSERT(r, bitmap.getColor(25, 75) == left , "%s", step);
+        REPORTER_ASSERT(r, bitmap.getColor(75, 25) == right, "%s", step);
+        REPORTER_ASSERT(r, bitmap.getColor(75, 75) == right, "%s", step);
+        REPORTER_ASSERT(r, canvas.count() == expected_pictures,
+                        "%s: %d pictures", step, canvas.count());
+    };
+
+    // Content renders directly the first time, and from pictures once unchanged.
+    render(SK_ColorRED, SK_ColorBLUE, 0, "initial");
+    render(SK_ColorRED, SK_ColorBLUE, 2, "cached");
+    render(SK_ColorRED, SK_ColorBLUE, 4, "cached again");
+
+    // Modifying a <use> target only invalidates the referencing group.
+    (*dom->findNodeById("shape"))->setAttribute("fill", "#0f0");
+    render(SK_ColorRED, SK_ColorGREEN, 5, "use target modified");
+    render(SK_ColorRED, SK_ColorGREEN, 7, "use target cached");
+
+    // As does modifying a descendant of a paint server.
+    (*dom->findNodeById("stop0"))->setAttribute("stop-color", "#00f");
+    (*dom->findNodeById("stop1"))->setAttribute("stop-color", "#00f");
+    render(SK_ColorBLUE, SK_ColorGREEN, 8, "gradient modified");
+    render(SK_ColorBLUE, SK_ColorGREEN, 10, "gradient cached");
+
+    // Container size changes invalidate everything.
+    dom->setContainerSize(SkSize::Make(200, 200));
+    render(SK_ColorBLUE, SK_ColorGREEN, 10, "container size modified");
+    render(SK_ColorBLUE, SK_ColorGREEN, 12, "container size cached");
+
+    // Caching is disabled by default.
+    SkMemoryStream uncached_stream(kSvg, strlen(kSvg));
+    dom = SkSVGDOM::Builder().make(uncached_stream);
+    render(SK_ColorRED, SK_ColorBLUE, 12, "uncached");
+    render(SK_ColorRED, SK_ColorBLUE, 12, "uncached again");
+}
@@ -19,6 +19,7 @@
 #include "include/private/base/SkTo.h"
 #include "src/base/SkArenaAlloc.h"
 #include "src/base/SkBezierCurves.h"
+#include "src/core/SkGlyphImageAllocator.h"
 #include "src/core/SkReadBuffer.h"
 #include "src/core/SkScalerContext.h"
 #include "src/core/SkWriteBuffer.h"
@@ -174,7 +175,8 @@ size_t SkGlyph::formatAlignment() const {
     return format_alignment(this->maskFormat());
 }
 
-size_t SkGlyph::allocImage(SkArenaAlloc* alloc) {
+template <typename Alloc>
+size_t SkGlyph::allocImage(Alloc* alloc) {
     SkASSERT(!this->isEmpty());
     auto size = this->imageSize();
     fImage = alloc->makeBytesAlignedTo(size, this->formatAlignment());
@@ -182,7 +184,8 @@ size_t SkGlyph::allocImage(SkArenaAlloc* alloc) {
     return size;
 }
 
-bool SkGlyph::setImage(SkArenaAlloc* alloc, SkScalerContext* scalerContext) {
+template <typename Alloc>
+bool SkGlyph::setImage(Alloc* alloc, SkScalerContext* scalerContext) {
     if (!this->setImageHasBeenCalled()) {
         // It used to be that getImage() could change the fMaskFormat. Extra checking to make
         // sure there are no regressions.
@@ -195,7 +198,8 @@ bool SkGlyph::setImage(SkArenaAlloc* alloc, SkScalerContext* scalerContext) {
     return false;
 }
 
-bool SkGlyph::setImage(SkArenaAlloc* alloc, const void* image) {
+template <typename Alloc>
+bool SkGlyph::setImage(Alloc* alloc, const void* image) {
     if (!this->setImageHasBeenCalled()) {
         this->allocImage(alloc);
         memcpy(fImage, image, this->imageSize());
@@ -204,7 +208,8 @@ bool SkGlyph::setImage(SkArenaAlloc* alloc, const void* image) {
     return false;
 }
 
-size_t SkGlyph::setMetricsAndImage(SkArenaAlloc* alloc, const SkGlyph& from) {
+template <typename Alloc>
+size_t SkGlyph::setMetricsAndImage(Alloc* alloc, const SkGlyph& from) {
     // Since the code no longer tries to find replacement glyphs, the image should always be
     // nullptr.
     SkASSERT(fImage == nullptr || from.fImage == nullptr);
@@ -362,7 +367,14 @@ void SkGlyph::flattenImage(SkWriteBuffer& buffer) const {
     }
 }
 
-size_t SkGlyph::addImageFromBuffer(SkReadBuffer& buffer, SkArenaAlloc* alloc) {
+static void release_image(SkArenaAlloc*, void*, size_t) {}
+
+static void release_image(SkGlyphImageAllocator* alloc, void* image, size_t size) {
+    alloc->release(image, size);
+}
+
+template <typename Alloc>
+size_t SkGlyph::addImageFromBuffer(SkReadBuffer& buffer, Alloc* alloc) {
     SkASSERT(buffer.isValid());
 
     // If the glyph is empty or too big, then no image data is received.
@@ -377,11 +389,22 @@ size_t SkGlyph::addImageFromBuffer(SkReadBuffer& buffer, SkArenaAlloc* alloc) {
     if (buffer.isValid()) {
         this->installImage(imageData);
         memoryIncrease += this->imageSize();
+    } else {
+        release_image(alloc, imageData, this->imageSize());
     }
 
     return memoryIncrease;
 }
 
+template bool SkGlyph::setImage(SkArenaAlloc*, SkScalerContext*);
+template bool SkGlyph::setImage(SkGlyphImageAllocator*, SkScalerContext*);
+template bool SkGlyph::setImage(SkArenaAlloc*, const void*);
+template bool SkGlyph::setImage(SkGlyphImageAllocator*, const void*);
+template size_t SkGlyph::setMetricsAndImage(SkArenaAlloc*, const SkGlyph&);
+template size_t SkGlyph::setMetricsAndImage(SkGlyphImageAllocator*, const SkGlyph&);
+template size_t SkGlyph::addImageFromBuffer(SkReadBuffer&, SkArenaAlloc*);
+template size_t SkGlyph::addImageFromBuffer(SkReadBuffer&, SkGlyphImageAllocator*);
+
 void SkGlyph::flattenPath(SkWriteBuffer& buffer) const {
     SkASSERT(this->setPathHasBeenCalled());
 
@@ -34,6 +34,7 @@
 class SkArenaAlloc;
 class SkCanvas;
 class SkGlyph;
+class SkGlyphImageAllocator;
 class SkReadBuffer;
 class SkScalerContext;
 class SkWriteBuffer;
@@ -447,13 +448,18 @@ public:
     // If we haven't already tried to associate an image with this glyph
     // (i.e. setImageHasBeenCalled() returns false), then use the
     // SkScalerContext or const void* argument to set the image.
-    bool setImage(SkArenaAlloc* alloc, SkScalerContext* scalerContext);
-    bool setImage(SkArenaAlloc* alloc, const void* image);
+    // The image is allocated from alloc, which is either an SkArenaAlloc or an
+    // SkGlyphImageAllocator; images from the latter must be released by the owner of the glyph.
+    template <typename Alloc>
+    bool setImage(Alloc* alloc, SkScalerContext* scalerContext);
+    template <typename Alloc>
+    bool setImage(Alloc* alloc, const void* image);
 
     // Merge the 'from' glyph into this glyph using alloc to allocate image data. Return the number
     // of bytes allocated. Copy the width, height, top, left, format, and image into this glyph
     // making a copy of the image using the alloc.
-    size_t setMetricsAndImage(SkArenaAlloc* alloc, const SkGlyph& from);
+    template <typename Alloc>
+    size_t setMetricsAndImage(Alloc* alloc, const SkGlyph& from);
 
     // Returns true if the image has been set.
     bool setImageHasBeenCalled() const {
@@ -539,7 +545,8 @@ public:
     void flattenImage(SkWriteBuffer&) const;
 
     // Read the image data, store it in the alloc, and add it to the glyph.
-    size_t addImageFromBuffer(SkReadBuffer&, SkArenaAlloc*);
+    template <typename Alloc>
+    size_t addImageFromBuffer(SkReadBuffer&, Alloc*);
 
     // Flatten just the path data.
     void flattenPath(SkWriteBuffer&) const;
@@ -597,7 +604,8 @@ private:
         bool fHasDrawable{false};
     };
 
-    size_t allocImage(SkArenaAlloc* alloc);
+    template <typename Alloc>
+    size_t allocImage(Alloc* alloc);
 
     void installImage(void* imageData) {
         SkASSERT(!this->setImageHasBeenCalled());
@@ -0,0 +1,187 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkGlyphImageAllocator.h"
+
+#include "include/private/base/SkAssert.h"
+#include "include/private/base/SkMalloc.h"
+#include "include/private/base/SkTo.h"
+
+#include <algorithm>
+#include <iterator>
+
+// Multiples of 16, spaced so that rounding up wastes at most a third of a block.
+static constexpr size_t kBlockSizes[] = {
+    16, 32, 48, 64, 96, 128, 192, 256, 384, 512, 768, 1024, 1536, 2048, 3072, 4096,
+};
+
+struct SkGlyphImageAllocator::Slab {
+    char* fMemory;
+    int fSizeClass;
+    int fBlockCount;
+    int fUsed = 0;      // Blocks handed out and not released.
+    int fCarved = 0;    // Blocks taken from the untouched end of fMemory.
+    void* fFreeList = nullptr;
+    Slab* fPrev = nullptr;
+    Slab* fNext = nullptr;
+    bool fIsAvailable = false;
+
+    size_t blockSize() const { return kBlockSizes[fSizeClass]; }
+};
+
+SkGlyphImageAllocator::SkGlyphImageAllocator() {
+    static_assert(std::size(kBlockSizes) == kSizeClassCount);
+    static_assert(kBlockSizes[kSizeClassCount - 1] == kMaxBlockSize);
+}
+
+SkGlyphImageAllocator::~SkGlyphImageAllocator() {
+    for (SizeClass& sizeClass : fSizeClasses) {
+        SkAutoMutexExclusive lock{sizeClass.fMutex};
+        for (auto& [address, slab] : sizeClass.fSlabs) {
+            sk_free(slab->fMemory);
+            delete slab;
+        }
+    }
+}
+
+SkGlyphImageAllocator* SkGlyphImageAllocator::Global() {
+    static auto* allocator = new SkGlyphImageAllocator;
+    return allocator;
+}
+
+int SkGlyphImageAllocator::SizeClassFor(size_t size) {
+    SkASSERT(size <= kMaxBlockSize);
+    return SkToInt(std::lower_bound(std::begin(kBlockSizes), std::end(kBlockSizes), size) -
+                   std::begin(kBlockSizes));
+}
+
+size_t SkGlyphImageAllocator::AllocationSize(size_t size) {
+    return size > kMaxBlockSize ? size : kBlockSizes[SizeClassFor(size)];
+}
+
+void SkGlyphImageAllocator::SizeClass::unlinkAvailable(Slab* slab) {
+    SkASSERT(slab->fIsAvailable);
+    if (slab->fPrev) {
+        slab->fPrev->fNext = slab->fNext;
+    } else {
+        fAvailable = slab->fNext;
+    }
+    if (slab->fNext) {
+        slab->fNext->fPrev = slab->fPrev;
+    }
+    slab->fPrev = slab->fNext = nullptr;
+    slab->fIsAvailable = false;
+}
+
+void* SkGlyphImageAllocator::makeBytesAlignedTo(size_t size, size_t align) {
+    SkASSERT(align <= alignof(std::max_align_t));
+
+    if (size > kMaxBlockSize) {
+        fLargeBytes.fetch_add(size, std::memory_order_relaxed);
+        return sk_malloc_throw(size);
+    }
+
+    const int index = SizeClassFor(size);
+    SizeClass& sizeClass = fSizeClasses[index];
+    SkAutoMutexExclusive lock{sizeClass.fMutex};
+
+    Slab* slab = sizeClass.fAvailable;
+    if (slab == nullptr) {
+        slab = new Slab{static_cast<char*>(sk_malloc_throw(kSlabSize)),
+                        index,
+                        SkToInt(kSlabSize / kBlockSizes[index])};
+        sizeClass.fSlabs[reinterpret_cast<uintptr_t>(slab->fMemory)] = slab;
+        slab->fIsAvailable = true;
+        sizeClass.fAvailable = slab;
+    }
+
+    void* block;
+    if (slab->fFreeList != nullptr) {
+        block = slab->fFreeList;
+        slab->fFreeList = *static_cast<void**>(block);
+    } else {
+        block = slab->fMemory + slab->fCarved * slab->blockSize();
+        slab->fCarved++;
+    }
+    slab->fUsed++;
+    sizeClass.fBytesInUse += slab->blockSize();
+
+    if (slab->fUsed == slab->fBlockCount) {
+        sizeClass.unlinkAvailable(slab);
+    }
+    return block;
+}
+
+void SkGlyphImageAllocator::release(const void* ptr, size_t size) {
+    if (ptr == nullptr) {
+        return;
+    }
+
+    if (size > kMaxBlockSize) {
+        SkASSERT(fLargeBytes.load(std::memory_order_relaxed) >= size);
+        fLargeBytes.fetch_sub(size, std::memory_order_relaxed);
+        sk_free(const_cast<void*>(ptr));
+        return;
+    }
+
+    // The block came from a slab of the size class of its size, so only that class is locked.
+    SizeClass& sizeClass = fSizeClasses[SizeClassFor(size)];
+    SkAutoMutexExclusive lock{sizeClass.fMutex};
+
+    const uintptr_t address = reinterpret_cast<uintptr_t>(ptr);
+    auto it = sizeClass.fSlabs.upper_bound(address);
+    SkASSERT(it != sizeClass.fSlabs.begin());
+    Slab* slab = std::prev(it)->second;
+    SkASSERT(address < reinterpret_cast<uintptr_t>(slab->fMemory) + kSlabSize);
+
+    void* block = const_cast<void*>(ptr);
+    *static_cast<void**>(block) = slab->fFreeList;
+    slab->fFreeList = block;
+    slab->fUsed--;
+    sizeClass.fBytesInUse -= slab->blockSize();
+
+    if (!slab->fIsAvailable) {
+        slab->fNext = sizeClass.fAvailable;
+        if (slab->fNext) {
+            slab->fNext->fPrev = slab;
+        }
+        sizeClass.fAvailable = slab;
+        slab->fIsAvailable = true;
+    }
+
+    // Give an empty slab back to the system, unless it is the only one left with room for
+    // its size class.
+    const bool hasOtherAvailable = sizeClass.fAvailable != slab || slab->fNext != nullptr;
+    if (slab->fUsed == 0 && hasOtherAvailable) {
+        sizeClass.unlinkAvailable(slab);
+        sizeClass.fSlabs.erase(std::prev(it));
+        sk_free(slab->fMemory);
+        delete slab;
+    }
+}
+
+size_t SkGlyphImageAllocator::bytesInUse() const {
+    size_t bytes = fLargeBytes.load(std::memory_order_relaxed);
+    for (const SizeClass& sizeClass : fSizeClasses) {
+        SkAutoMutexExclusive lock{sizeClass.fMutex};
+        bytes += sizeClass.fBytesInUse;
+    }
+    return bytes;
+}
+
+size_t SkGlyphImageAllocator::bytesReserved() const {
+    return this->slabCount() * kSlabSize + fLargeBytes.load(std::memory_order_relaxed);
+}
+
+int SkGlyphImageAllocator::slabCount() const {
+    size_t count = 0;
+    for (const SizeClass& sizeClass : fSizeClasses) {
+        SkAutoMutexExclusive lock{sizeClass.fMutex};
+        count += sizeClass.fSlabs.size();
+    }
+    return SkToInt(count);
+}
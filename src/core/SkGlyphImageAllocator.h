@@ -0,0 +1,80 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkGlyphImageAllocator_DEFINED
+#define SkGlyphImageAllocator_DEFINED
+
+#include "include/private/base/SkMutex.h"
+#include "include/private/base/SkThreadAnnotations.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+
+// A slab allocator for glyph images shared by all the strikes in the process. Images are rounded
+// up to one of a small set of size classes and carved out of fixed size slabs, each slab holding
+// blocks of a single size class. Unlike a per-strike SkArenaAlloc, released blocks are reused by
+// any strike, and a slab is returned to the system as soon as its last block is released (except
+// for the last slab with free blocks of a size class, which is kept to avoid thrashing). Images
+// larger than the largest size class are allocated directly with sk_malloc.
+//
+// All the methods are thread safe. Each size class has its own lock, so threads rasterizing
+// glyphs of different sizes don't wait on each other.
+class SkGlyphImageAllocator {
+public:
+    inline static constexpr size_t kSlabSize = 64 * 1024;
+    inline static constexpr size_t kMaxBlockSize = 4096;
+
+    SkGlyphImageAllocator();
+    ~SkGlyphImageAllocator();
+
+    SkGlyphImageAllocator(const SkGlyphImageAllocator&) = delete;
+    SkGlyphImageAllocator& operator=(const SkGlyphImageAllocator&) = delete;
+
+    // The allocator used by all the strikes.
+    static SkGlyphImageAllocator* Global();
+
+    // Same signature as SkArenaAlloc, so SkGlyph can allocate its image from either. The
+    // alignment must not exceed that of sk_malloc.
+    void* makeBytesAlignedTo(size_t size, size_t align);
+
+    // Returns memory from makeBytesAlignedTo; size must be the size it was allocated with.
+    void release(const void* ptr, size_t size);
+
+    // The number of bytes actually used by an allocation of the given size.
+    static size_t AllocationSize(size_t size);
+
+    // Bytes handed out and not yet released, rounded up to their size classes.
+    size_t bytesInUse() const;
+    // Bytes held from the system: all the slabs, plus the large allocations.
+    size_t bytesReserved() const;
+    int slabCount() const;
+
+private:
+    struct Slab;
+
+    struct SizeClass {
+        mutable SkMutex fMutex;
+        // A doubly linked list of the slabs that have free blocks.
+        Slab* fAvailable SK_GUARDED_BY(fMutex) = nullptr;
+        // All the slabs, by the address of their memory, to find the slab of a released block.
+        std::map<uintptr_t, Slab*> fSlabs SK_GUARDED_BY(fMutex);
+        size_t fBytesInUse SK_GUARDED_BY(fMutex) = 0;
+
+        void unlinkAvailable(Slab* slab) SK_REQUIRES(fMutex);
+    };
+
+    inline static constexpr int kSizeClassCount = 16;
+
+    static int SizeClassFor(size_t size);
+
+    SizeClass fSizeClasses[kSizeClassCount];
+    std::atomic<size_t> fLargeBytes{0};
+};
+
+#endif  // SkGlyphImageAllocator_DEFINED
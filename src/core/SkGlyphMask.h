@@ -0,0 +1,34 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkGlyphMask_DEFINED
+#define SkGlyphMask_DEFINED
+
+#include <cstdint>
+
+// Row operations used when post-processing glyph masks after the scaler has rasterized them.
+namespace SkOpts {
+    // Filters 4x horizontally oversampled A8 coverage into the r, g and b coverage of count LCD
+    // pixels. Pixel i is filtered from samples[4*i, 4*i + 12), so samples must hold 4*count + 8
+    // values: the row of 4*(count - 2) samples with 8 zeros of padding on each side.
+    extern void (*lcd_filter_row)(const uint8_t samples[], int count,
+                                  uint8_t r[], uint8_t g[], uint8_t b[]);
+
+    // Expands a 1 bit per pixel row (most significant bit first) to 0x00 or 0xFF A8 coverage.
+    extern void (*a1_to_a8_row)(uint8_t dst[], const uint8_t src[], int count);
+
+    // Packs an A8 row to 1 bit per pixel, setting the bits of the values >= cutoff. Writes
+    // (count + 7) / 8 bytes; unused bits of the last byte are cleared.
+    extern void (*a8_to_a1_row)(uint8_t dst[], const uint8_t src[], int count, uint8_t cutoff);
+
+    // Converts an A8 row to gray LCD16.
+    extern void (*a8_to_lcd16_row)(uint16_t dst[], const uint8_t src[], int count);
+
+    void Init_GlyphMask();
+}  // namespace SkOpts
+
+#endif  // SkGlyphMask_DEFINED
@@ -171,6 +171,13 @@ SkGlyphRunListPainterCPU::SkGlyphRunListPainterCPU(const SkSurfaceProps& props,
         , fColorType{colorType}
         , fScalerContextFlags{compute_scaler_context_flags(cs)} {}
 
+const SkSurfaceProps& SkGlyphRunListPainterCPU::propsFor(const SkPaint& paint) const {
+    // The bitmap blitters can only draw lcd text to a N32 bitmap in srcOver. Otherwise,
+    // convert the lcd text into A8 text. The props communicate this to the scaler.
+    return (kN32_SkColorType == fColorType && paint.isSrcOver()) ? fDeviceProps
+                                                                 : fBitmapFallbackProps;
+}
+
 void SkGlyphRunListPainterCPU::drawForBitmapDevice(SkCanvas* canvas,
                                                    const BitmapDevicePainter* bitmapDevice,
                                                    const sktext::GlyphRunList& glyphRunList,
@@ -188,11 +195,7 @@ void SkGlyphRunListPainterCPU::drawForBitmapDevice(SkCanvas* canvas,
     rejectedPositions.resize(maxGlyphRunSize);
     const auto rejectedBuffer = SkMakeZip(rejectedGlyphIDs, rejectedPositions);
 
-    // The bitmap blitters can only draw lcd text to a N32 bitmap in srcOver. Otherwise,
-    // convert the lcd text into A8 text. The props communicate this to the scaler.
-    auto& props = (kN32_SkColorType == fColorType && paint.isSrcOver())
-                          ? fDeviceProps
-                          : fBitmapFallbackProps;
+    auto& props = this->propsFor(paint);
 
     SkPoint drawOrigin = glyphRunList.origin();
     SkMatrix positionMatrix{drawMatrix};
@@ -380,3 +383,58 @@ void SkGlyphRunListPainterCPU::drawForBitmapDevice(SkCanvas* canvas,
         //  rejects in a more sophisticated stage.
     }
 }
+
+void SkGlyphRunListPainterCPU::prefetchForBitmapDevice(const sktext::GlyphRunList& glyphRunList,
+                                                       const SkPaint& paint,
+                                                       const SkMatrix& drawMatrix) const {
+    STArray<64, const SkGlyph*> acceptedPackedGlyphIDs;
+    STArray<64, SkPoint> acceptedPositions;
+    STArray<64, SkGlyphID> rejectedGlyphIDs;
+    STArray<64, SkPoint> rejectedPositions;
+    const int maxGlyphRunSize = glyphRunList.maxGlyphRunSize();
+    acceptedPackedGlyphIDs.resize(maxGlyphRunSize);
+    acceptedPositions.resize(maxGlyphRunSize);
+    const auto acceptedBuffer = SkMakeZip(acceptedPackedGlyphIDs, acceptedPositions);
+    rejectedGlyphIDs.resize(maxGlyphRunSize);
+    rejectedPositions.resize(maxGlyphRunSize);
+    const auto rejectedBuffer = SkMakeZip(rejectedGlyphIDs, rejectedPositions);
+
+    auto& props = this->propsFor(paint);
+
+    SkPoint drawOrigin = glyphRunList.origin();
+    SkMatrix positionMatrix{drawMatrix};
+    positionMatrix.preTranslate(drawOrigin.x(), drawOrigin.y());
+    for (auto& glyphRun : glyphRunList) {
+        const SkFont& runFont = glyphRun.font();
+
+        SkZip<const SkGlyphID, const SkPoint> source = glyphRun.source();
+
+        // Preparing the glyphs for drawing puts their paths or images in the strike; the
+        // accepted glyphs are dropped, and the rejected ones go on to the next stage just as
+        // they do when drawing.
+        if (SkStrikeSpec::ShouldDrawAsPath(paint, runFont, positionMatrix)) {
+            auto [strikeSpec, strikeToSourceScale] =
+                    SkStrikeSpec::MakePath(runFont, paint, props, fScalerContextFlags);
+
+            auto strike = strikeSpec.findOrCreateStrike();
+            auto [accepted, rejected] = prepare_for_path_drawing(strike.get(),
+                                                                 source,
+                                                                 acceptedBuffer,
+                                                                 rejectedBuffer);
+            source = rejected;
+        }
+        if (!source.empty() && !positionMatrix.hasPerspective()) {
+            SkStrikeSpec strikeSpec = SkStrikeSpec::MakeMask(
+                    runFont, paint, props, fScalerContextFlags, positionMatrix);
+
+            auto strike = strikeSpec.findOrCreateStrike();
+            (void)prepare_for_direct_mask_drawing(strike.get(),
+                                                  positionMatrix,
+                                                  source,
+                                                  acceptedBuffer,
+                                                  rejectedBuffer);
+        }
+
+        // Drawables, and the few glyphs drawn as scaled bitmaps, are left to the draw.
+    }
+}
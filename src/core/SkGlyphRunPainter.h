@@ -48,7 +48,18 @@ public:
             SkCanvas* canvas, const BitmapDevicePainter* bitmapDevice,
             const sktext::GlyphRunList& glyphRunList, const SkPaint& paint,
             const SkMatrix& drawMatrix);
+
+    // Does the glyph work drawForBitmapDevice would do for glyphRunList -- rasterizing the
+    // masks of the glyphs drawn directly, and generating the paths of the glyphs drawn as
+    // paths -- filling the strike cache without drawing anything. This is safe to call from any
+    // thread, so the work can be done ahead of the draw.
+    void prefetchForBitmapDevice(const sktext::GlyphRunList& glyphRunList,
+                                 const SkPaint& paint,
+                                 const SkMatrix& drawMatrix) const;
+
 private:
+    const SkSurfaceProps& propsFor(const SkPaint& paint) const;
+
     // The props as on the actual device.
     const SkSurfaceProps fDeviceProps;
 
@@ -11,11 +11,13 @@
 #include "src/core/SkBlitMask.h"
 #include "src/core/SkBlitRow.h"
 #include "src/core/SkCpu.h"
+#include "src/core/SkGlyphMask.h"
 #include "src/core/SkImageFilter_Base.h"
 #include "src/core/SkMemset.h"
 #include "src/core/SkOpts.h"
 #include "src/core/SkResourceCache.h"
 #include "src/core/SkStrikeCache.h"
+#include "src/core/SkStrikeDiskCache.h"
 #include "src/core/SkSwizzlePriv.h"
 #include "src/core/SkTypefaceCache.h"
 
@@ -26,6 +28,7 @@ void SkGraphics::Init() {
     SkOpts::Init_BitmapProcState();
     SkOpts::Init_BlitMask();
     SkOpts::Init_BlitRow();
+    SkOpts::Init_GlyphMask();
     SkOpts::Init_Memset();
     SkOpts::Init_Swizzler();
 }
@@ -78,6 +81,15 @@ void SkGraphics::PurgePinnedFontCache() {
     SkStrikeCache::GlobalStrikeCache()->purgePinned();
 }
 
+void SkGraphics::SetFontCacheDiskDirectory(const char* directory) {
+    SkStrikeCache::GlobalStrikeCache()->setDiskCache(
+            directory ? sk_make_sp<SkStrikeDiskCache>(directory) : nullptr);
+}
+
+int SkGraphics::SaveFontCacheToDisk() {
+    return SkStrikeCache::GlobalStrikeCache()->saveToDiskCache();
+}
+
 static int gTypefaceCacheCountLimit = 1024; // historical default value
 
 int SkGraphics::GetTypefaceCacheCountLimit() {
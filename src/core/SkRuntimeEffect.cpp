@@ -13,14 +13,18 @@
 #include "include/core/SkColor.h"
 #include "include/core/SkColorFilter.h"
 #include "include/core/SkData.h"
+#include "include/core/SkFourByteTag.h"
+#include "include/core/SkStream.h"
 #include "include/private/base/SkAlign.h"
 #include "include/private/base/SkDebug.h"
 #include "include/private/base/SkMutex.h"
 #include "include/private/base/SkOnce.h"
 #include "include/private/base/SkTArray.h"
+#include "include/private/base/SkTo.h"
 #include "src/base/SkArenaAlloc.h"
 #include "src/base/SkEnumBitMask.h"
 #include "src/base/SkNoDestructor.h"
+#include "src/base/SkUtils.h"
 #include "src/core/SkBlenderBase.h"
 #include "src/core/SkChecksum.h"
 #include "src/core/SkColorSpacePriv.h"
@@ -220,6 +224,24 @@ const SkSL::RP::Program* SkRuntimeEffect::getRPProgram(SkSL::DebugTracePriv* deb
     // By using an SkOnce, we avoid thread hazards and behave in a conceptually const way, but we
     // can avoid the cost of invoking the RP code generator until it's actually needed.
     fCompileRPProgramOnce([&] {
+        // If a persistent cache was supplied, a previously-compiled program lets us skip inlining
+        // and code generation entirely. Debug traces depend on in-process slot information, so
+        // traced programs are always compiled from scratch and never cached.
+        sk_sp<SkData> cacheKey;
+        if (fPersistentCache && !debugTrace && !kRPEnableLiveTrace) {
+            cacheKey = this->persistentCacheKey();
+            if (sk_sp<SkData> cached = fPersistentCache->load(*cacheKey)) {
+                SkMemoryStream stream(std::move(cached));
+                int numUniformSlots = SkToInt(this->uniformSize() / sizeof(float));
+                const_cast<SkRuntimeEffect*>(this)->fRPProgram = SkSL::RP::Program::Deserialize(
+                        &stream, numUniformSlots, SkToInt(fChildren.size()));
+                if (fRPProgram) {
+                    return;
+                }
+                // The cached data was stale or corrupt; fall through and recompile.
+            }
+        }
+
         // We generally do not run the inliner when an SkRuntimeEffect program is initially created,
         // because the final compile to native shader code will do this. However, in SkRP, there's
         // no additional compilation occurring, so we need to manually inline here if we want the
@@ -258,11 +280,57 @@ const SkSL::RP::Program* SkRuntimeEffect::getRPProgram(SkSL::DebugTracePriv* deb
                 SkDebugf("----- RP unsupported -----\n\n");
             }
         }
+
+        if (cacheKey && fRPProgram) {
+            SkDynamicMemoryWStream stream;
+            if (fRPProgram->serialize(&stream)) {
+                fPersistentCache->store(*cacheKey, *stream.detachAsData());
+            }
+        }
     });
 
     return fRPProgram.get();
 }
 
+static uint64_t hash_specialized_uniforms(const SkSL::ProgramSettings& settings) {
+    uint64_t hash = 0;
+    for (const SkSL::ProgramSettings::SpecializedUniform& uniform :
+         settings.fSpecializedUniforms) {
+        hash = SkChecksum::Hash64(uniform.fName.data(), uniform.fName.size(), hash);
+        hash = SkChecksum::Hash64(uniform.fValues.data(),
+                                  uniform.fValues.size() * sizeof(double),
+                                  hash);
+    }
+    return hash;
+}
+
+sk_sp<SkData> SkRuntimeEffect::persistentCacheKey() const {
+    // The key must cover everything which influences the generated RP program: the source text,
+    // the program kind, which optimizations are enabled, any specialized uniform values, and the
+    // version of the RP encoding.
+    const std::string& source = *fBaseProgram->fSource;
+    struct {
+        uint32_t tag;
+        uint32_t version;
+        int32_t  kind;
+        uint16_t unoptimized;
+        uint16_t optimizeRPStores;
+        uint64_t sourceHash;
+        uint64_t sourceLength;
+        uint64_t specializationHash;
+    } key = {
+        SkSetFourByteTag('r', 't', 'f', 'x'),
+        SkSL::RP::Program::kSerializationVersion,
+        (int32_t)fBaseProgram->fConfig->fKind,
+        (uint16_t)SkToBool(fFlags & kDisableOptimization_Flag),
+        (uint16_t)fBaseProgram->fConfig->fSettings.fOptimizeRPStores,
+        SkChecksum::Hash64(source.data(), source.size()),
+        source.size(),
+        hash_specialized_uniforms(fBaseProgram->fConfig->fSettings),
+    };
+    return SkData::MakeWithCopy(&key, sizeof(key));
+}
+
 SkSpan<const float> SkRuntimeEffectPriv::UniformsAsSpan(
         SkSpan<const SkRuntimeEffect::Uniform> uniforms,
         sk_sp<const SkData> originalData,
@@ -454,6 +522,7 @@ SkSL::ProgramSettings SkRuntimeEffect::MakeSettings(const Options& options) {
     settings.fInlineThreshold = 0;
     settings.fForceNoInline = options.forceUnoptimized;
     settings.fOptimize = !options.forceUnoptimized;
+    settings.fOptimizeRPStores = !options.disableRPStoreOptimizations;
     settings.fMaxVersionAllowed = options.maxVersionAllowed;
 
     // SkSL created by the GPU backend is typically parsed, converted to a backend format,
@@ -659,6 +728,120 @@ sk_sp<SkRuntimeEffect> SkRuntimeEffect::makeUnoptimizedClone() {
     return result.effect;
 }
 
+struct SkRuntimeEffect::SpecializationCache {
+    // Each specialization holds a complete compiled program, so only a handful are retained.
+    static constexpr int kMaxEntries = 8;
+
+    SkMutex fMutex;
+    SkLRUCache<SkString, sk_sp<SkRuntimeEffect>> fEffects SK_GUARDED_BY(fMutex){kMaxEntries};
+};
+
+static int uniform_slot_count(SkRuntimeEffect::Uniform::Type type) {
+    switch (type) {
+        case SkRuntimeEffect::Uniform::Type::kFloat:    return 1;
+        case SkRuntimeEffect::Uniform::Type::kFloat2:   return 2;
+        case SkRuntimeEffect::Uniform::Type::kFloat3:   return 3;
+        case SkRuntimeEffect::Uniform::Type::kFloat4:   return 4;
+        case SkRuntimeEffect::Uniform::Type::kFloat2x2: return 4;
+        case SkRuntimeEffect::Uniform::Type::kFloat3x3: return 9;
+        case SkRuntimeEffect::Uniform::Type::kFloat4x4: return 16;
+        case SkRuntimeEffect::Uniform::Type::kInt:      return 1;
+        case SkRuntimeEffect::Uniform::Type::kInt2:     return 2;
+        case SkRuntimeEffect::Uniform::Type::kInt3:     return 3;
+        case SkRuntimeEffect::Uniform::Type::kInt4:     return 4;
+        default: SkUNREACHABLE;
+    }
+}
+
+static bool uniform_is_int(SkRuntimeEffect::Uniform::Type type) {
+    return type == SkRuntimeEffect::Uniform::Type::kInt  ||
+           type == SkRuntimeEffect::Uniform::Type::kInt2 ||
+           type == SkRuntimeEffect::Uniform::Type::kInt3 ||
+           type == SkRuntimeEffect::Uniform::Type::kInt4;
+}
+
+sk_sp<SkRuntimeEffect> SkRuntimeEffect::makeSpecialized(
+        sk_sp<const SkData> uniforms, SkSpan<const std::string_view> uniformNames) const {
+    if (!uniforms || uniforms->size() != this->uniformSize()) {
+        return nullptr;
+    }
+    if (uniformNames.empty()) {
+        return sk_ref_sp(this);
+    }
+
+    // Gather the requested values, and build a cache key out of the names and raw uniform bytes.
+    SkSL::ProgramSettings settings;
+    SkString key;
+    for (std::string_view name : uniformNames) {
+        const Uniform* uniform = this->findUniform(name);
+        if (!uniform || uniform->isArray() || uniform->isColor()) {
+            return nullptr;
+        }
+        const uint8_t* data = uniforms->bytes() + uniform->offset;
+        key.append(name.data(), name.size());
+        key.append("\0", 1);
+        key.append((const char*)data, uniform->sizeInBytes());
+
+        SkSL::ProgramSettings::SpecializedUniform& specialized =
+                settings.fSpecializedUniforms.emplace_back();
+        specialized.fName = std::string(name);
+        for (int slot = 0; slot < uniform_slot_count(uniform->type); ++slot) {
+            if (uniform_is_int(uniform->type)) {
+                specialized.fValues.push_back(
+                        sk_unaligned_load<int32_t>(data + slot * sizeof(int32_t)));
+            } else {
+                specialized.fValues.push_back(
+                        sk_unaligned_load<float>(data + slot * sizeof(float)));
+            }
+        }
+    }
+
+    fSpecializationCacheOnce([this] {
+        fSpecializationCache = std::make_unique<SpecializationCache>();
+    });
+    {
+        SkAutoMutexExclusive lock(fSpecializationCache->fMutex);
+        if (sk_sp<SkRuntimeEffect>* found = fSpecializationCache->fEffects.find(key)) {
+            return *found;
+        }
+    }
+
+    // As in makeUnoptimizedClone, any restrictions were already enforced when this effect was
+    // made, so we can recompile with maximally-permissive options.
+    Options options;
+    options.forceUnoptimized = SkToBool(fFlags & kDisableOptimization_Flag);
+    options.maxVersionAllowed = SkSL::Version::k300;
+    options.allowPrivateAccess = true;
+    options.disableRPStoreOptimizations = !fBaseProgram->fConfig->fSettings.fOptimizeRPStores;
+    options.persistentCache = fPersistentCache;
+
+    SkSL::ProgramKind kind = fBaseProgram->fConfig->fKind;
+    SkSL::ProgramSettings specializedSettings = MakeSettings(options);
+    specializedSettings.fSpecializedUniforms = std::move(settings.fSpecializedUniforms);
+
+    SkSL::Compiler compiler;
+    std::unique_ptr<SkSL::Program> program =
+            compiler.convertProgram(kind, *fBaseProgram->fSource, specializedSettings);
+    if (!program) {
+        // Substituting constants can expose errors that were previously unreachable, e.g. a
+        // division by zero in constant-folded code. Fall back to the unspecialized effect.
+        return sk_ref_sp(this);
+    }
+
+    Result result = MakeInternal(std::move(program), options, kind);
+    if (!result.effect) {
+        return sk_ref_sp(this);
+    }
+    SkASSERT(result.effect->uniformSize() == this->uniformSize());
+
+    SkAutoMutexExclusive lock(fSpecializationCache->fMutex);
+    if (sk_sp<SkRuntimeEffect>* found = fSpecializationCache->fEffects.find(key)) {
+        // Another thread specialized the effect concurrently; share its result.
+        return *found;
+    }
+    return *fSpecializationCache->fEffects.insert(key, std::move(result.effect));
+}
+
 SkRuntimeEffect::Result SkRuntimeEffect::MakeForColorFilter(SkString sksl, const Options& options) {
     auto programKind = options.allowPrivateAccess ? SkSL::ProgramKind::kPrivateRuntimeColorFilter
                                                   : SkSL::ProgramKind::kRuntimeColorFilter;
@@ -748,6 +931,7 @@ SkRuntimeEffect::SkRuntimeEffect(std::unique_ptr<SkSL::Program> baseProgram,
         : fHash(SkChecksum::Hash32(baseProgram->fSource->c_str(), baseProgram->fSource->size()))
         , fStableKey(options.fStableKey)
         , fBaseProgram(std::move(baseProgram))
+        , fPersistentCache(options.persistentCache)
         , fMain(main)
         , fUniforms(std::move(uniforms))
         , fChildren(std::move(children))
@@ -759,9 +943,13 @@ SkRuntimeEffect::SkRuntimeEffect(std::unique_ptr<SkSL::Program> baseProgram,
     // Everything from SkRuntimeEffect::Options which could influence the compiled result needs to
     // be accounted for in `fHash`. If you've added a new field to Options and caused the static-
     // assert below to trigger, please incorporate your field into `fHash` and update KnownOptions
-    // to match the layout of Options.
+    // to match the layout of Options. (`persistentCache` only changes where the compiled program
+    // comes from, not what it contains, so it is deliberately left out of the hash.)
     struct KnownOptions {
-        bool forceUnoptimized, allowPrivateAccess;
+        bool forceUnoptimized;
+        PersistentCache* persistentCache;
+        bool allowPrivateAccess;
+        bool disableRPStoreOptimizations;
         uint32_t fStableKey;
         SkSL::Version maxVersionAllowed;
     };
@@ -770,10 +958,18 @@ SkRuntimeEffect::SkRuntimeEffect(std::unique_ptr<SkSL::Program> baseProgram,
                                sizeof(options.forceUnoptimized), fHash);
     fHash = SkChecksum::Hash32(&options.allowPrivateAccess,
                                sizeof(options.allowPrivateAccess), fHash);
+    fHash = SkChecksum::Hash32(&options.disableRPStoreOptimizations,
+                               sizeof(options.disableRPStoreOptimizations), fHash);
     fHash = SkChecksum::Hash32(&options.fStableKey,
                                sizeof(options.fStableKey), fHash);
     fHash = SkChecksum::Hash32(&options.maxVersionAllowed,
                                sizeof(options.maxVersionAllowed), fHash);
+
+    // Specialized effects share their source text with the original effect, so the specialized
+    // uniform values must also contribute to the hash.
+    if (uint64_t specializationHash = hash_specialized_uniforms(fBaseProgram->fConfig->fSettings)) {
+        fHash = SkChecksum::Hash32(&specializationHash, sizeof(specializationHash), fHash);
+    }
 }
 
 SkRuntimeEffect::~SkRuntimeEffect() = default;
@@ -101,6 +101,10 @@ public:
         options->fStableKey = stableKey;
     }
 
+    static void DisableRPStoreOptimizations(SkRuntimeEffect::Options* options) {
+        options->disableRPStoreOptimizations = true;
+    }
+
     static SkRuntimeEffect::Uniform VarAsUniform(const SkSL::Variable&,
                                                  const SkSL::Context&,
                                                  size_t* offset);
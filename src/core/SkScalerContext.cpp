@@ -25,6 +25,7 @@
 #include "include/private/base/SkFixed.h"
 #include "include/private/base/SkMalloc.h"
 #include "include/private/base/SkMutex.h"
+#include "include/private/base/SkTemplates.h"
 #include "include/private/base/SkTo.h"
 #include "src/base/SkArenaAlloc.h"
 #include "src/base/SkAutoMalloc.h"
@@ -34,6 +35,7 @@
 #include "src/core/SkDrawBase.h"
 #include "src/core/SkFontPriv.h"
 #include "src/core/SkGlyph.h"
+#include "src/core/SkGlyphMask.h"
 #include "src/core/SkMaskFilterBase.h"
 #include "src/core/SkPaintPriv.h"
 #include "src/core/SkRasterClip.h"
@@ -328,8 +330,6 @@ static void applyLUTToA8Mask(SkMaskBuilder& mask, const uint8_t* lut) {
 static void pack4xHToMask(const SkPixmap& src, SkMaskBuilder& dst,
                           const SkMaskGamma::PreBlend& maskPreBlend,
                           const bool doBGR, const bool doVert) {
-#define SAMPLES_PER_PIXEL 4
-#define LCD_PER_PIXEL 3
     SkASSERT(kAlpha_8_SkColorType == src.colorType());
 
     const bool toA8 = SkMask::kA8_Format == dst.fFormat;
@@ -349,35 +349,17 @@ static void pack4xHToMask(const SkPixmap& src, SkMaskBuilder& dst,
 
     uint8_t* dstImage = dst.image();
     size_t dstRB = dst.fRowBytes;
-    // An N tap FIR is defined by
-    // out[n] = coeff[0]*x[n] + coeff[1]*x[n-1] + ... + coeff[N]*x[n-N]
-    // or
-    // out[n] = sum(i, 0, N, coeff[i]*x[n-i])
-
-    // The strategy is to use one FIR (different coefficients) for each of r, g, and b.
-    // This means using every 4th FIR output value of each FIR and discarding the rest.
-    // The FIRs are aligned, and the coefficients reach 5 samples to each side of their 'center'.
-    // (For r and b this is technically incorrect, but the coeffs outside round to zero anyway.)
-
-    // These are in some fixed point repesentation.
-    // Adding up to more than one simulates ink spread.
-    // For implementation reasons, these should never add up to more than two.
-
-    // Coefficients determined by a gausian where 5 samples = 3 std deviations (0x110 'contrast').
-    // Calculated using tools/generate_fir_coeff.py
-    // With this one almost no fringing is ever seen, but it is imperceptibly blurry.
-    // The lcd smoothed text is almost imperceptibly different from gray,
-    // but is still sharper on small stems and small rounded corners than gray.
-    // This also seems to be about as wide as one can get and only have a three pixel kernel.
-    // TODO: calculate these at runtime so parameters can be adjusted (esp contrast).
-    static const unsigned int coefficients[LCD_PER_PIXEL][SAMPLES_PER_PIXEL*3] = {
-        //The red subpixel is centered inside the first sample (at 1/6 pixel), and is shifted.
-        { 0x03, 0x0b, 0x1c, 0x33,  0x40, 0x39, 0x24, 0x10,  0x05, 0x01, 0x00, 0x00, },
-        //The green subpixel is centered between two samples (at 1/2 pixel), so is symetric
-        { 0x00, 0x02, 0x08, 0x16,  0x2b, 0x3d, 0x3d, 0x2b,  0x16, 0x08, 0x02, 0x00, },
-        //The blue subpixel is centered inside the last sample (at 5/6 pixel), and is shifted.
-        { 0x00, 0x00, 0x01, 0x05,  0x10, 0x24, 0x39, 0x40,  0x33, 0x1c, 0x0b, 0x03, },
-    };
+    // The 4 samples under each output pixel and the 4 on either side are filtered by three FIRs,
+    // one for each of r, g and b (see SkOpts::lcd_filter_row). Each row is copied into a buffer
+    // padded with 8 zeros on each side so the filter never reads outside it.
+    const int width = sample_width / 4 + 2;
+    skia_private::AutoSTMalloc<256, uint8_t> buffer(sample_width + 16 + 3 * width);
+    uint8_t* padded = buffer.get();
+    uint8_t* firR = padded + sample_width + 16;
+    uint8_t* firG = firR + width;
+    uint8_t* firB = firG + width;
+    memset(padded, 0, 8);
+    memset(padded + 8 + sample_width, 0, 8);
 
     size_t dstPB = toA8 ? sizeof(uint8_t) : sizeof(uint16_t);
     for (int y = 0; y < height; ++y) {
@@ -391,35 +373,19 @@ static void pack4xHToMask(const SkPixmap& src, SkMaskBuilder& dst,
             dstPDelta = dstPB;
         }
 
-        const uint8_t* srcP = src.addr8(0, y);
-
-        // TODO: this fir filter implementation is straight forward, but slow.
-        // It should be possible to make it much faster.
-        for (int sample_x = -4; sample_x < sample_width + 4; sample_x += 4) {
-            int fir[LCD_PER_PIXEL] = { 0 };
-            for (int sample_index = std::max(0, sample_x - 4), coeff_index = sample_index - (sample_x - 4)
-                ; sample_index < std::min(sample_x + 8, sample_width)
-                ; ++sample_index, ++coeff_index)
-            {
-                int sample_value = srcP[sample_index];
-                for (int subpxl_index = 0; subpxl_index < LCD_PER_PIXEL; ++subpxl_index) {
-                    fir[subpxl_index] += coefficients[subpxl_index][coeff_index] * sample_value;
-                }
-            }
-            for (int subpxl_index = 0; subpxl_index < LCD_PER_PIXEL; ++subpxl_index) {
-                fir[subpxl_index] /= 0x100;
-                fir[subpxl_index] = std::min(fir[subpxl_index], 255);
-            }
+        memcpy(padded + 8, src.addr8(0, y), sample_width);
+        SkOpts::lcd_filter_row(padded, width, firR, firG, firB);
 
+        for (int x = 0; x < width; ++x) {
             U8CPU r, g, b;
             if (doBGR) {
-                r = fir[2];
-                g = fir[1];
-                b = fir[0];
+                r = firB[x];
+                g = firG[x];
+                b = firR[x];
             } else {
-                r = fir[0];
-                g = fir[1];
-                b = fir[2];
+                r = firR[x];
+                g = firG[x];
+                b = firB[x];
             }
             if constexpr (kSkShowTextBlitCoverage) {
                 r = std::max(r, 10u);
@@ -445,49 +411,20 @@ static void pack4xHToMask(const SkPixmap& src, SkMaskBuilder& dst,
     }
 }
 
-static inline int convert_8_to_1(unsigned byte) {
-    SkASSERT(byte <= 0xFF);
-    return byte >> 7;
-}
-
-static uint8_t pack_8_to_1(const uint8_t alpha[8]) {
-    unsigned bits = 0;
-    for (int i = 0; i < 8; ++i) {
-        bits <<= 1;
-        bits |= convert_8_to_1(alpha[i]);
-    }
-    return SkToU8(bits);
-}
-
 static void packA8ToA1(SkMaskBuilder& dstMask, const uint8_t* src, size_t srcRB) {
     const int height = dstMask.fBounds.height();
     const int width = dstMask.fBounds.width();
-    const int octs = width >> 3;
-    const int leftOverBits = width & 7;
 
     uint8_t* dst = dstMask.image();
-    const int dstPad = dstMask.fRowBytes - SkAlign8(width)/8;
-    SkASSERT(dstPad >= 0);
+    SkASSERT(dstMask.fRowBytes >= SkAlign8(width)/8);
 
     SkASSERT(width >= 0);
     SkASSERT(srcRB >= (size_t)width);
-    const size_t srcPad = srcRB - width;
 
     for (int y = 0; y < height; ++y) {
-        for (int i = 0; i < octs; ++i) {
-            *dst++ = pack_8_to_1(src);
-            src += 8;
-        }
-        if (leftOverBits > 0) {
-            unsigned bits = 0;
-            int shift = 7;
-            for (int i = 0; i < leftOverBits; ++i, --shift) {
-                bits |= convert_8_to_1(*src++) << shift;
-            }
-            *dst++ = bits;
-        }
-        src += srcPad;
-        dst += dstPad;
+        SkOpts::a8_to_a1_row(dst, src, width, 0x80);
+        src += srcRB;
+        dst += dstMask.fRowBytes;
     }
 }
 
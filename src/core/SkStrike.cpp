@@ -7,6 +7,7 @@
 
 #include "src/core/SkStrike.h"
 
+#include "include/core/SkData.h"
 #include "include/core/SkDrawable.h"
 #include "include/core/SkFontStyle.h"
 #include "include/core/SkMatrix.h"
@@ -16,7 +17,9 @@
 #include "include/core/SkTypeface.h"
 #include "include/private/base/SkDebug.h"
 #include "include/private/base/SkTFitsIn.h"
+#include "include/private/base/SkTo.h"
 #include "src/core/SkGlyph.h"
+#include "src/core/SkGlyphImageAllocator.h"
 #include "src/core/SkMask.h"
 #include "src/core/SkReadBuffer.h"
 #include "src/core/SkScalerContext.h"
@@ -28,6 +31,7 @@
 #include <new>
 #include <optional>
 #include <utility>
+#include <vector>
 
 using namespace skglyph;
 
@@ -53,10 +57,21 @@ SkStrike::SkStrike(SkStrikeCache* strikeCache,
         , fStrikeSpec{strikeSpec}
         , fStrikeCache{strikeCache}
         , fScalerContext{std::move(scaler)}
+        , fImageAllocator{SkGlyphImageAllocator::Global()}
         , fPinner{std::move(pinner)} {
     SkASSERT(fScalerContext != nullptr);
 }
 
+SkStrike::~SkStrike() {
+    // No other references to the strike are left, so the lock is only for the annotations.
+    SkAutoMutexExclusive lock{fStrikeLock};
+    for (SkGlyph* glyph : fGlyphForIndex) {
+        if (glyph->setImageHasBeenCalled()) {
+            fImageAllocator->release(glyph->image(), glyph->imageSize());
+        }
+    }
+}
+
 class SK_SCOPED_CAPABILITY SkStrike::Monitor {
 public:
     Monitor(SkStrike* strike) SK_ACQUIRE(strike->fStrikeLock)
@@ -161,6 +176,103 @@ bool SkStrike::mergeFromBuffer(SkReadBuffer& buffer) {
     return true;
 }
 
+bool SkStrike::preloadFromBuffer(SkReadBuffer& buffer) {
+    // Decode all the glyphs before merging any, so that a buffer which turns out to be bad part
+    // way through leaves the strike untouched instead of partly filled.
+    SkArenaAlloc scratch{kMinAllocAmount};
+    auto readGlyphs = [&](std::vector<SkGlyph>* glyphs, auto&& addData) {
+        const int count = buffer.readInt();
+        // Every glyph takes at least a byte, which bounds the reservation below.
+        if (!buffer.validate(0 <= count && SkToSizeT(count) <= buffer.available())) {
+            return false;
+        }
+        glyphs->reserve(count);
+        for (int i = 0; i < count; ++i) {
+            std::optional<SkGlyph> glyph = SkGlyph::MakeFromBuffer(buffer);
+            if (!buffer.validate(glyph.has_value())) {
+                return false;
+            }
+            addData(&glyph.value());
+            if (!buffer.isValid()) {
+                return false;
+            }
+            glyphs->push_back(*glyph);
+        }
+        return true;
+    };
+    std::vector<SkGlyph> images;
+    std::vector<SkGlyph> paths;
+    if (!readGlyphs(&images, [&](SkGlyph* g) { g->addImageFromBuffer(buffer, &scratch); }) ||
+        !readGlyphs(&paths, [&](SkGlyph* g) { g->addPathFromBuffer(buffer, &scratch); })) {
+        return false;
+    }
+    // Drawables are never stored, and the whole buffer must have been read.
+    if (!buffer.validate(buffer.readInt() == 0 && buffer.available() == 0)) {
+        return false;
+    }
+
+    // No other thread can see the strike yet; the lock is for the annotations.
+    SkAutoMutexExclusive lock{fStrikeLock};
+    fMemoryIncrease = 0;
+    for (const SkGlyph& from : images) {
+        this->preloadGlyph(from);
+    }
+    for (const SkGlyph& from : paths) {
+        SkGlyph* glyph = this->preloadGlyph(from);
+        if (glyph->setPath(&fAlloc, from.path(), from.pathIsHairline(), from.pathIsModified())) {
+            fMemoryIncrease += glyph->path()->approximateBytesUsed();
+        }
+    }
+
+    // The strike is not in the cache, so only its own accounting is updated. The cache adds
+    // fMemoryUsed to its total when the strike is attached.
+    fMemoryUsed += fMemoryIncrease;
+    fMemoryIncrease = 0;
+    return true;
+}
+
+SkGlyph* SkStrike::preloadGlyph(const SkGlyph& from) {
+    SkGlyphDigest* digest = fDigestForPackedGlyphID.find(from.getPackedID());
+    if (digest != nullptr) {
+        // The buffer may hold the same glyph twice; keep the first image.
+        SkGlyph* glyph = fGlyphForIndex[digest->index()];
+        if (!glyph->setImageHasBeenCalled()) {
+            fMemoryIncrease += glyph->setMetricsAndImage(fImageAllocator, from);
+        }
+        return glyph;
+    }
+    SkGlyph* glyph = fAlloc.make<SkGlyph>(from.getPackedID());
+    fMemoryIncrease += glyph->setMetricsAndImage(fImageAllocator, from) + sizeof(SkGlyph);
+    (void)this->addGlyphAndDigest(glyph);
+    return glyph;
+}
+
+sk_sp<SkData> SkStrike::flattenForDiskCache() {
+    std::vector<SkGlyph> images;
+    std::vector<SkGlyph> paths;
+    {
+        Monitor m{this};
+        if (!fHasUnsavedGlyphs) {
+            return nullptr;
+        }
+        for (const SkGlyph* glyph : fGlyphForIndex) {
+            if (glyph->setImageHasBeenCalled()) {
+                images.push_back(*glyph);
+            }
+            if (glyph->setPathHasBeenCalled()) {
+                paths.push_back(*glyph);
+            }
+        }
+        fHasUnsavedGlyphs = false;
+    }
+
+    // The copies share the images and paths of the strike's glyphs, which live as long as the
+    // strike, so they can be written without holding the lock.
+    SkBinaryWriteBuffer buffer({});
+    FlattenGlyphsByType(buffer, images, paths, {});
+    return buffer.snapshotAsData();
+}
+
 SkGlyph* SkStrike::mergeGlyphAndImage(SkPackedGlyphID toID, const SkGlyph& fromGlyph) {
     Monitor m{this};
     // TODO(herb): remove finding the glyph when setting the metrics and image are separated
@@ -173,12 +285,12 @@ SkGlyph* SkStrike::mergeGlyphAndImage(SkPackedGlyphID toID, const SkGlyph& fromG
                 SkDEBUGFAIL("Re-adding image to existing glyph. This should not happen.");
             }
             // TODO: assert that any metrics on fromGlyph are the same.
-            fMemoryIncrease += glyph->setMetricsAndImage(&fAlloc, fromGlyph);
+            fMemoryIncrease += glyph->setMetricsAndImage(fImageAllocator, fromGlyph);
         }
         return glyph;
     } else {
         SkGlyph* glyph = fAlloc.make<SkGlyph>(toID);
-        fMemoryIncrease += glyph->setMetricsAndImage(&fAlloc, fromGlyph) + sizeof(SkGlyph);
+        fMemoryIncrease += glyph->setMetricsAndImage(fImageAllocator, fromGlyph) + sizeof(SkGlyph);
         (void)this->addGlyphAndDigest(glyph);
         return glyph;
     }
@@ -312,7 +424,15 @@ void SkStrike::dumpMemoryStatistics(SkTraceMemoryDump* dump) const {
                                        rec.fTypefaceID,
                                        this);
 
+    size_t imageBytes = 0;
+    for (const SkGlyph* glyph : fGlyphForIndex) {
+        if (glyph->setImageHasBeenCalled() && glyph->image() != nullptr) {
+            imageBytes += SkGlyphImageAllocator::AllocationSize(glyph->imageSize());
+        }
+    }
+
     dump->dumpNumericValue(dumpName.c_str(), "size", "bytes", fMemoryUsed);
+    dump->dumpNumericValue(dumpName.c_str(), "image_size", "bytes", imageBytes);
     dump->dumpNumericValue(dumpName.c_str(),
                            "glyph_count", "objects",
                            fDigestForPackedGlyphID.count());
@@ -357,8 +477,9 @@ SkGlyphDigest* SkStrike::addGlyphAndDigest(SkGlyph* glyph) {
 }
 
 bool SkStrike::prepareForImage(SkGlyph* glyph) {
-    if (glyph->setImage(&fAlloc, fScalerContext.get())) {
+    if (glyph->setImage(fImageAllocator, fScalerContext.get())) {
         fMemoryIncrease += glyph->imageSize();
+        fHasUnsavedGlyphs = true;
     }
     return glyph->image() != nullptr;
 }
@@ -366,6 +487,7 @@ bool SkStrike::prepareForImage(SkGlyph* glyph) {
 bool SkStrike::prepareForPath(SkGlyph* glyph) {
     if (glyph->setPath(&fAlloc, fScalerContext.get())) {
         fMemoryIncrease += glyph->path()->approximateBytesUsed();
+        fHasUnsavedGlyphs = true;
     }
     return glyph->path() !=nullptr;
 }
@@ -405,7 +527,7 @@ bool SkStrike::mergeGlyphAndImageFromBuffer(SkReadBuffer& buffer) {
     if (!buffer.validate(glyph != nullptr)) {
         return false;
     }
-    fMemoryIncrease += glyph->addImageFromBuffer(buffer, &fAlloc);
+    fMemoryIncrease += glyph->addImageFromBuffer(buffer, fImageAllocator);
     return buffer.isValid();
 }
 
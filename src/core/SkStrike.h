@@ -25,8 +25,10 @@
 #include <memory>
 #include <vector>
 
+class SkData;
 class SkDescriptor;
 class SkDrawable;
+class SkGlyphImageAllocator;
 class SkPath;
 class SkReadBuffer;
 class SkStrikeCache;
@@ -48,6 +50,7 @@ public:
              std::unique_ptr<SkScalerContext> scaler,
              const SkFontMetrics* metrics,
              std::unique_ptr<SkStrikePinner> pinner);
+    ~SkStrike() override;
 
     void lock() override SK_ACQUIRE(fStrikeLock);
     void unlock() override SK_RELEASE_CAPABILITY(fStrikeLock);
@@ -57,6 +60,15 @@ public:
     bool prepareForDrawable(SkGlyph*) override SK_REQUIRES(fStrikeLock);
 
     bool mergeFromBuffer(SkReadBuffer& buffer) SK_EXCLUDES(fStrikeLock);
+
+    // Fills a strike that is not in a strike cache yet with the glyphs in buffer, written by
+    // FlattenGlyphsByType. Used to preload the glyphs stored by the SkStrikeDiskCache.
+    bool preloadFromBuffer(SkReadBuffer& buffer) SK_EXCLUDES(fStrikeLock);
+
+    // If the scaler has generated images or paths since the strike was created or last
+    // flattened, returns all the glyphs with images and paths written by FlattenGlyphsByType.
+    // Otherwise, returns nullptr.
+    sk_sp<SkData> flattenForDiskCache() SK_EXCLUDES(fStrikeLock);
     static void FlattenGlyphsByType(SkWriteBuffer& buffer,
                                     SkSpan<SkGlyph> images,
                                     SkSpan<SkGlyph> paths,
@@ -149,6 +161,8 @@ private:
     bool mergeGlyphAndImageFromBuffer(SkReadBuffer& buffer) SK_REQUIRES(fStrikeLock);
     bool mergeGlyphAndPathFromBuffer(SkReadBuffer& buffer) SK_REQUIRES(fStrikeLock);
     bool mergeGlyphAndDrawableFromBuffer(SkReadBuffer& buffer) SK_REQUIRES(fStrikeLock);
+    // Finds or adds the glyph for from, copying its metrics and image, if any, into the strike.
+    SkGlyph* preloadGlyph(const SkGlyph& from) SK_REQUIRES(fStrikeLock);
 
     // Maintain memory use statistics.
     void updateMemoryUsage(size_t increase) SK_EXCLUDES(fStrikeLock);
@@ -190,6 +204,9 @@ private:
     // Used while changing the strike to track memory increase.
     size_t fMemoryIncrease SK_GUARDED_BY(fStrikeLock) {0};
 
+    // Set when the scaler generates an image or a path, so the strike is worth saving to disk.
+    bool fHasUnsavedGlyphs SK_GUARDED_BY(fStrikeLock) {false};
+
     // So, we don't grow our arrays a lot.
     inline static constexpr size_t kMinGlyphCount = 8;
     inline static constexpr size_t kMinGlyphImageSize = 16 /* height */ * 8 /* width */;
@@ -197,6 +214,11 @@ private:
 
     SkArenaAlloc            fAlloc SK_GUARDED_BY(fStrikeLock) {kMinAllocAmount};
 
+    // Glyph images are not allocated from fAlloc, but from this allocator shared by all
+    // strikes, so their memory is reused as soon as the strike is deleted. The strike
+    // releases the images of its glyphs when it is deleted.
+    SkGlyphImageAllocator* const fImageAllocator;
+
     // The following are protected by the SkStrikeCache's mutex.
     SkStrike*                       fNext{nullptr};
     SkStrike*                       fPrev{nullptr};
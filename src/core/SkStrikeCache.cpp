@@ -14,11 +14,13 @@
 #include "include/private/base/SkDebug.h"
 #include "include/private/base/SkMutex.h"
 #include "src/core/SkDescriptor.h"
+#include "src/core/SkGlyphImageAllocator.h"
 #include "src/core/SkStrike.h"
 #include "src/core/SkStrikeSpec.h"
 
 #include <algorithm>
 #include <utility>
+#include <vector>
 
 class SkScalerContext;
 struct SkFontMetrics;
@@ -37,10 +39,29 @@ SkStrikeCache* SkStrikeCache::GlobalStrikeCache() {
 }
 
 auto SkStrikeCache::findOrCreateStrike(const SkStrikeSpec& strikeSpec) -> sk_sp<SkStrike> {
+    sk_sp<SkStrikeDiskCache> diskCache;
+    {
+        SkAutoMutexExclusive ac(fLock);
+        sk_sp<SkStrike> strike = this->internalFindStrikeOrNull(strikeSpec.descriptor());
+        if (strike == nullptr && fDiskCache == nullptr) {
+            strike = this->internalCreateStrike(strikeSpec);
+        }
+        if (strike != nullptr) {
+            this->internalPurge();
+            return strike;
+        }
+        diskCache = fDiskCache;
+    }
+
+    // Loading reads a file, so it is done without the cache locked. Another thread may create the
+    // same strike in the meantime, in which case the strike it attached is used.
+    sk_sp<SkStrike> loaded = this->makeStrike(strikeSpec, nullptr, nullptr, diskCache.get());
+
     SkAutoMutexExclusive ac(fLock);
     sk_sp<SkStrike> strike = this->internalFindStrikeOrNull(strikeSpec.descriptor());
     if (strike == nullptr) {
-        strike = this->internalCreateStrike(strikeSpec);
+        strike = loaded;
+        this->internalAttachToHead(std::move(loaded));
     }
     this->internalPurge();
     return strike;
@@ -76,6 +97,8 @@ void SkStrikeCache::DumpMemoryStatistics(SkTraceMemoryDump* dump) {
                            SkGraphics::GetFontCacheCountUsed());
     dump->dumpNumericValue(kGlyphCacheDumpName, "budget_glyph_count", "objects",
                            SkGraphics::GetFontCacheCountLimit());
+    dump->dumpNumericValue(kGlyphCacheDumpName, "image_reserved_size", "bytes",
+                           SkGlyphImageAllocator::Global()->bytesReserved());
 
     if (dump->getRequestedDetails() == SkTraceMemoryDump::kLight_LevelOfDetail) {
         dump->setMemoryBacking(kGlyphCacheDumpName, "malloc", nullptr);
@@ -126,21 +149,72 @@ sk_sp<SkStrike> SkStrikeCache::createStrike(
         const SkStrikeSpec& strikeSpec,
         SkFontMetrics* maybeMetrics,
         std::unique_ptr<SkStrikePinner> pinner) {
+    sk_sp<SkStrikeDiskCache> diskCache;
+    {
+        SkAutoMutexExclusive ac(fLock);
+        if (fDiskCache == nullptr) {
+            return this->internalCreateStrike(strikeSpec, maybeMetrics, std::move(pinner));
+        }
+        diskCache = fDiskCache;
+    }
+
+    sk_sp<SkStrike> strike =
+            this->makeStrike(strikeSpec, maybeMetrics, std::move(pinner), diskCache.get());
     SkAutoMutexExclusive ac(fLock);
-    return this->internalCreateStrike(strikeSpec, maybeMetrics, std::move(pinner));
+    this->internalAttachToHead(strike);
+    return strike;
 }
 
 auto SkStrikeCache::internalCreateStrike(
         const SkStrikeSpec& strikeSpec,
         SkFontMetrics* maybeMetrics,
         std::unique_ptr<SkStrikePinner> pinner) -> sk_sp<SkStrike> {
+    auto strike = this->makeStrike(strikeSpec, maybeMetrics, std::move(pinner), nullptr);
+    this->internalAttachToHead(strike);
+    return strike;
+}
+
+auto SkStrikeCache::makeStrike(
+        const SkStrikeSpec& strikeSpec,
+        SkFontMetrics* maybeMetrics,
+        std::unique_ptr<SkStrikePinner> pinner,
+        SkStrikeDiskCache* diskCache) -> sk_sp<SkStrike> {
     std::unique_ptr<SkScalerContext> scaler = strikeSpec.createScalerContext();
     auto strike =
         sk_make_sp<SkStrike>(this, strikeSpec, std::move(scaler), maybeMetrics, std::move(pinner));
-    this->internalAttachToHead(strike);
+    if (diskCache != nullptr) {
+        diskCache->load(strike.get());
+    }
     return strike;
 }
 
+void SkStrikeCache::setDiskCache(sk_sp<SkStrikeDiskCache> diskCache) {
+    SkAutoMutexExclusive ac(fLock);
+    fDiskCache = std::move(diskCache);
+}
+
+int SkStrikeCache::saveToDiskCache() {
+    sk_sp<SkStrikeDiskCache> diskCache;
+    std::vector<sk_sp<SkStrike>> strikes;
+    {
+        SkAutoMutexExclusive ac(fLock);
+        if (fDiskCache == nullptr) {
+            return 0;
+        }
+        diskCache = fDiskCache;
+        for (SkStrike* strike = fHead; strike != nullptr; strike = strike->fNext) {
+            strikes.push_back(sk_ref_sp(strike));
+        }
+    }
+
+    // Write the files without holding the cache lock.
+    int saved = 0;
+    for (const sk_sp<SkStrike>& strike : strikes) {
+        saved += diskCache->save(strike.get()) ? 1 : 0;
+    }
+    return saved;
+}
+
 void SkStrikeCache::purgePinned(size_t minBytesNeeded) {
     SkAutoMutexExclusive ac(fLock);
     this->internalPurge(minBytesNeeded, /* checkPinners= */ true);
@@ -13,6 +13,7 @@
 #include "include/private/base/SkMutex.h"
 #include "include/private/base/SkThreadAnnotations.h"
 #include "src/core/SkStrike.h"
+#include "src/core/SkStrikeDiskCache.h"
 #include "src/core/SkTHash.h"
 #include "src/text/StrikeForGPU.h"
 
@@ -74,6 +75,15 @@ public:
     size_t setCacheSizeLimit(size_t limit) SK_EXCLUDES(fLock);
     size_t getTotalMemoryUsed() const SK_EXCLUDES(fLock);
 
+    // When set, new strikes are preloaded with the glyphs stored in diskCache. Loading happens
+    // without the cache locked, before the strike is attached and can be seen by other threads.
+    // Pass nullptr to stop using the disk cache.
+    void setDiskCache(sk_sp<SkStrikeDiskCache> diskCache) SK_EXCLUDES(fLock);
+
+    // Stores the glyphs of the strikes in the cache that have generated new glyphs since they
+    // were loaded or last saved. Returns the number of strikes written.
+    int saveToDiskCache() SK_EXCLUDES(fLock);
+
 private:
     friend class SkStrike;  // for SkStrike::updateDelta
     static constexpr char kGlyphCacheDumpName[] = "skia/sk_glyph_cache";
@@ -82,6 +92,12 @@ private:
             const SkStrikeSpec& strikeSpec,
             SkFontMetrics* maybeMetrics = nullptr,
             std::unique_ptr<SkStrikePinner> = nullptr) SK_REQUIRES(fLock);
+    // Makes a strike that is not in the cache yet, filled from diskCache if it is not nullptr.
+    // Does not use the cache's state, so it may be called with or without fLock held.
+    sk_sp<SkStrike> makeStrike(const SkStrikeSpec& strikeSpec,
+                               SkFontMetrics* maybeMetrics,
+                               std::unique_ptr<SkStrikePinner> pinner,
+                               SkStrikeDiskCache* diskCache);
 
     // The following methods can only be called when mutex is already held.
     void internalRemoveStrike(SkStrike* strike) SK_REQUIRES(fLock);
@@ -112,6 +128,7 @@ private:
     int32_t fCacheCountLimit{SK_DEFAULT_FONT_CACHE_COUNT_LIMIT};
     int32_t fCacheCount SK_GUARDED_BY(fLock) {0};
     int32_t fPinnerCount SK_GUARDED_BY(fLock) {0};
+    sk_sp<SkStrikeDiskCache> fDiskCache SK_GUARDED_BY(fLock);
 };
 
 #endif  // SkStrikeCache_DEFINED
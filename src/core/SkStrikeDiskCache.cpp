@@ -0,0 +1,240 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkStrikeDiskCache.h"
+
+#include "include/core/SkData.h"
+#include "include/core/SkFontArguments.h"
+#include "include/core/SkMilestone.h"
+#include "include/core/SkStream.h"
+#include "include/private/base/SkThreadID.h"
+#include "include/private/base/SkTo.h"
+#include "src/base/SkTime.h"
+#include "src/core/SkChecksum.h"
+#include "src/core/SkDescriptor.h"
+#include "src/core/SkFontDescriptor.h"
+#include "src/core/SkOSFile.h"
+#include "src/core/SkReadBuffer.h"
+#include "src/core/SkScalerContext.h"
+#include "src/core/SkStrike.h"
+#include "src/core/SkStrikeSpec.h"
+#include "src/utils/SkOSPath.h"
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace {
+struct FileHeader {
+    inline static constexpr uint32_t kMagic = SkSetFourByteTag('s', 'k', 'g', 'c');
+
+    uint32_t fMagic;
+    uint32_t fVersion;
+    uint64_t fTypefaceHash;
+    uint32_t fDescriptorLength;
+    uint32_t fGlyphDataLength;
+    uint32_t fGlyphDataChecksum;
+    // The glyphs a scaler generates may change between Skia releases.
+    uint32_t fMilestone;
+};
+static_assert(sizeof(FileHeader) == 32);
+
+struct Key {
+    SkAutoDescriptor fDescriptor;  // with the typeface ID cleared
+    uint64_t fTypefaceHash;
+    SkString fPath;
+};
+
+// Returns a copy of desc with the typeface ID cleared, so it describes the strike in any process.
+std::optional<SkAutoDescriptor> process_independent_descriptor(const SkDescriptor& desc) {
+    SkAutoDescriptor result{desc};
+    SkDescriptor& descriptor = *result.getDesc();
+
+    uint32_t size;
+    // findEntry returns a const void*, remove the const in order to update in place.
+    void* ptr = const_cast<void*>(descriptor.findEntry(kRec_SkDescriptorTag, &size));
+    SkScalerContextRec rec;
+    if (!ptr || size != sizeof(rec)) {
+        return std::nullopt;
+    }
+    std::memcpy((void*)&rec, ptr, size);
+    rec.fTypefaceID = 0;
+    std::memcpy(ptr, &rec, size);
+
+    descriptor.computeChecksum();
+    return result;
+}
+}  // namespace
+
+SkStrikeDiskCache::SkStrikeDiskCache(const char* directory) : fDirectory{directory} {
+    if (!sk_isdir(directory)) {
+        sk_mkdir(directory);
+    }
+}
+
+std::optional<uint64_t> SkStrikeDiskCache::typefaceHash(const SkTypeface& typeface) {
+    {
+        SkAutoMutexExclusive lock{fMutex};
+        if (std::optional<uint64_t>* hash = fTypefaceHashes.find(typeface.uniqueID())) {
+            return *hash;
+        }
+    }
+
+    std::optional<uint64_t> hash;
+    int ttcIndex = 0;
+    std::unique_ptr<SkStreamAsset> stream = typeface.openStream(&ttcIndex);
+    if (stream != nullptr) {
+        sk_sp<SkData> fontData;
+        if (const void* base = stream->getMemoryBase()) {
+            fontData = SkData::MakeWithoutCopy(base, stream->getLength());
+        } else {
+            fontData = SkData::MakeFromStream(stream.get(), stream->getLength());
+        }
+        if (fontData != nullptr) {
+            uint64_t h = SkChecksum::Hash64(fontData->data(), fontData->size(), ttcIndex);
+
+            // The instances of a variable font share the font data.
+            using Coordinate = SkFontArguments::VariationPosition::Coordinate;
+            const int axisCount = typeface.getVariationDesignPosition(nullptr, 0);
+            if (axisCount > 0) {
+                std::vector<Coordinate> coordinates(axisCount);
+                if (typeface.getVariationDesignPosition(coordinates.data(), axisCount) ==
+                    axisCount) {
+                    h = SkChecksum::Hash64(
+                            coordinates.data(), axisCount * sizeof(Coordinate), h);
+                }
+            }
+
+            // The same font data may be rasterized differently by another font backend.
+            SkFontDescriptor descriptor;
+            bool isLocal = false;
+            typeface.getFontDescriptor(&descriptor, &isLocal);
+            const SkTypeface::FactoryId factoryId = descriptor.getFactoryId();
+            hash = SkChecksum::Hash64(&factoryId, sizeof(factoryId), h);
+        }
+    }
+
+    SkAutoMutexExclusive lock{fMutex};
+    fTypefaceHashes.set(typeface.uniqueID(), hash);
+    return hash;
+}
+
+static std::optional<Key> make_key(const SkStrikeSpec& strikeSpec,
+                                   std::optional<uint64_t> typefaceHash,
+                                   const SkString& directory) {
+    if (!typefaceHash.has_value()) {
+        return std::nullopt;
+    }
+    std::optional<SkAutoDescriptor> descriptor =
+            process_independent_descriptor(strikeSpec.descriptor());
+    if (!descriptor.has_value()) {
+        return std::nullopt;
+    }
+    // Different releases use different files, rather than replacing each other's.
+    SkString fileName = SkStringPrintf("%08x%016llx-m%d.skglyphs",
+                                       descriptor->getDesc()->getChecksum(),
+                                       (unsigned long long)*typefaceHash,
+                                       SK_MILESTONE);
+    return Key{std::move(*descriptor),
+               *typefaceHash,
+               SkOSPath::Join(directory.c_str(), fileName.c_str())};
+}
+
+std::optional<SkString> SkStrikeDiskCache::pathFor(const SkStrikeSpec& strikeSpec) {
+    std::optional<Key> key =
+            make_key(strikeSpec, this->typefaceHash(strikeSpec.typeface()), fDirectory);
+    if (!key.has_value()) {
+        return std::nullopt;
+    }
+    return key->fPath;
+}
+
+bool SkStrikeDiskCache::load(SkStrike* strike) {
+    const SkStrikeSpec& strikeSpec = strike->strikeSpec();
+    std::optional<Key> key =
+            make_key(strikeSpec, this->typefaceHash(strikeSpec.typeface()), fDirectory);
+    if (!key.has_value()) {
+        return false;
+    }
+
+    // MakeFromFileName maps the file.
+    sk_sp<SkData> data = SkData::MakeFromFileName(key->fPath.c_str());
+    if (data == nullptr || data->size() < sizeof(FileHeader)) {
+        return false;
+    }
+
+    FileHeader header;
+    std::memcpy(&header, data->data(), sizeof(header));
+    const SkDescriptor& descriptor = *key->fDescriptor.getDesc();
+    if (header.fMagic != FileHeader::kMagic ||
+        header.fVersion != kVersion ||
+        header.fMilestone != SK_MILESTONE ||
+        header.fTypefaceHash != key->fTypefaceHash ||
+        header.fDescriptorLength != descriptor.getLength() ||
+        data->size() != sizeof(FileHeader) +
+                        (size_t)header.fDescriptorLength +
+                        (size_t)header.fGlyphDataLength) {
+        return false;
+    }
+
+    const uint8_t* bytes = data->bytes() + sizeof(FileHeader);
+    if (std::memcmp(bytes, &descriptor, descriptor.getLength()) != 0) {
+        return false;
+    }
+
+    // Descriptor lengths are a multiple of 4, so the glyph data is aligned for SkReadBuffer.
+    const uint8_t* glyphData = bytes + header.fDescriptorLength;
+    if (SkChecksum::Hash32(glyphData, header.fGlyphDataLength) != header.fGlyphDataChecksum) {
+        return false;
+    }
+
+    SkReadBuffer buffer{glyphData, header.fGlyphDataLength};
+    return strike->preloadFromBuffer(buffer);
+}
+
+bool SkStrikeDiskCache::save(SkStrike* strike) {
+    std::optional<Key> key = make_key(
+            strike->strikeSpec(), this->typefaceHash(strike->strikeSpec().typeface()), fDirectory);
+    if (!key.has_value()) {
+        return false;
+    }
+    sk_sp<SkData> glyphData = strike->flattenForDiskCache();
+    if (glyphData == nullptr) {
+        return false;
+    }
+
+    const SkDescriptor& descriptor = *key->fDescriptor.getDesc();
+    const FileHeader header = {
+        FileHeader::kMagic,
+        kVersion,
+        key->fTypefaceHash,
+        descriptor.getLength(),
+        SkToU32(glyphData->size()),
+        SkChecksum::Hash32(glyphData->data(), glyphData->size()),
+        SK_MILESTONE,
+    };
+
+    // Another thread or process may be writing the same strike; each writes its own file.
+    const SkString tempPath = SkStringPrintf("%s.%x-%llx.tmp",
+                                             key->fPath.c_str(),
+                                             (unsigned)SkGetThreadID(),
+                                             (unsigned long long)SkTime::GetNSecs());
+    bool written;
+    {
+        SkFILEWStream stream{tempPath.c_str()};
+        written = stream.isValid() &&
+                  stream.write(&header, sizeof(header)) &&
+                  stream.write(&descriptor, descriptor.getLength()) &&
+                  stream.write(glyphData->data(), glyphData->size());
+    }
+    if (!written || std::rename(tempPath.c_str(), key->fPath.c_str()) != 0) {
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkStrikeDiskCache_DEFINED
+#define SkStrikeDiskCache_DEFINED
+
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkString.h"
+#include "include/core/SkTypeface.h"
+#include "include/core/SkTypes.h"
+#include "include/private/base/SkMutex.h"
+#include "include/private/base/SkThreadAnnotations.h"
+#include "src/core/SkTHash.h"
+
+#include <cstdint>
+#include <optional>
+
+class SkStrike;
+class SkStrikeSpec;
+
+// Stores the glyph images and paths of strikes in a directory, so that a later process can load
+// them instead of asking the scaler context to generate them again.
+//
+// There is a file per strike, named after the hash of the strike's descriptor, the hash of the
+// font data and font backend of its typeface, and the Skia milestone. The typeface ID in the
+// descriptor is cleared before hashing it, as it is only meaningful within a process. A file
+// holds a header, the descriptor, and the glyphs in the format of SkStrike::FlattenGlyphsByType.
+// It is memory mapped when loaded, and ignored unless its version, milestone, descriptor and
+// checksum all match, so a stale, truncated or corrupt file just means the glyphs are generated
+// as usual. Files are written to a temporary
+// name and renamed into place, so a process never maps a file that is being written.
+//
+// Typefaces without font data (openStream() returns nullptr) are never stored.
+class SkStrikeDiskCache : public SkNVRefCnt<SkStrikeDiskCache> {
+public:
+    // Bump when the file format or the format of the flattened glyphs changes.
+    inline static constexpr uint32_t kVersion = 2;
+
+    explicit SkStrikeDiskCache(const char* directory);
+
+    // Fills strike, which must not be in a strike cache yet, with the glyphs stored for it.
+    // Returns false if there is no valid file for the strike.
+    bool load(SkStrike* strike);
+
+    // Stores the glyphs of strike if it has generated new ones since it was loaded or last
+    // saved. Returns true if a file was written.
+    bool save(SkStrike* strike);
+
+    // The path of the file for strikeSpec, or nothing if the strike can't be stored.
+    std::optional<SkString> pathFor(const SkStrikeSpec& strikeSpec);
+
+private:
+    std::optional<uint64_t> typefaceHash(const SkTypeface& typeface) SK_EXCLUDES(fMutex);
+
+    const SkString fDirectory;
+
+    SkMutex fMutex;
+    // Hashing the font data is expensive, so it is done once per typeface.
+    skia_private::THashMap<SkTypefaceID, std::optional<uint64_t>> fTypefaceHashes
+            SK_GUARDED_BY(fMutex);
+};
+
+#endif  // SkStrikeDiskCache_DEFINED
@@ -9,15 +9,187 @@
 
 #include "include/gpu/ShaderErrorHandler.h"
 #include "include/private/base/SkDebug.h"
+#include "include/private/base/SkMutex.h"
+#include "include/private/base/SkThreadAnnotations.h"
+#include "src/base/SkNoDestructor.h"
+#include "src/base/SkTime.h"
+#include "src/core/SkLRUCache.h"
 #include "src/sksl/SkSLCompiler.h"
+#include "src/sksl/SkSLProgramSettings.h"
 #include "src/sksl/ir/SkSLProgram.h"
 #include "src/utils/SkShaderUtils.h"
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace skgpu {
 
+namespace {
+
+struct CompileStatsTracker {
+    SkMutex fMutex;
+    SkSLCompileStats fStats SK_GUARDED_BY(fMutex);
+};
+
+CompileStatsTracker& compile_stats() {
+    static SkNoDestructor<CompileStatsTracker> sTracker;
+    return *sTracker;
+}
+
+template <typename T>
+void append_bytes(std::string* key, const T& value) {
+    key->append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+std::string make_cache_key(bool (*toBackend)(SkSL::Program&, const SkSL::ShaderCaps*, std::string*),
+                           const std::string& sksl,
+                           SkSL::ProgramKind programKind,
+                           const SkSL::ProgramSettings& settings) {
+    // Everything from ProgramSettings which could influence the compiled result needs to be
+    // accounted for in the key. If you've added a new field to ProgramSettings and caused the
+    // static-assert below to trigger, please incorporate your field into the key and update
+    // KnownSettings to match the layout of ProgramSettings.
+    struct KnownSettings {
+        bool fFragColorIsInOut;
+        bool fForceHighPrecision;
+        bool fSharpenTextures;
+        bool fForceNoRTFlip;
+        int fRTFlipOffset;
+        int fRTFlipBinding;
+        int fRTFlipSet;
+        int fDefaultUniformSet;
+        int fDefaultUniformBinding;
+        bool fOptimize;
+        bool fRemoveDeadFunctions;
+        bool fRemoveDeadVariables;
+        bool fOptimizeRPStores;
+        int fInlineThreshold;
+        bool fForceNoInline;
+        bool fAllowNarrowingConversions;
+        bool fValidateSPIRV;
+        bool fUsePushConstants;
+        SkSL::Version fMaxVersionAllowed;
+        bool fUseMemoryPool;
+        std::vector<SkSL::ProgramSettings::SpecializedUniform> fSpecializedUniforms;
+    };
+    static_assert(sizeof(SkSL::ProgramSettings) == sizeof(KnownSettings));
+
+    std::string key;
+    append_bytes(&key, toBackend);
+    append_bytes(&key, programKind);
+    append_bytes(&key, SkSL::Compiler::OptimizerOverride());
+    append_bytes(&key, SkSL::Compiler::InlinerOverride());
+    append_bytes(&key, settings.fFragColorIsInOut);
+    append_bytes(&key, settings.fForceHighPrecision);
+    append_bytes(&key, settings.fSharpenTextures);
+    append_bytes(&key, settings.fForceNoRTFlip);
+    append_bytes(&key, settings.fRTFlipOffset);
+    append_bytes(&key, settings.fRTFlipBinding);
+    append_bytes(&key, settings.fRTFlipSet);
+    append_bytes(&key, settings.fDefaultUniformSet);
+    append_bytes(&key, settings.fDefaultUniformBinding);
+    append_bytes(&key, settings.fOptimize);
+    append_bytes(&key, settings.fRemoveDeadFunctions);
+    append_bytes(&key, settings.fRemoveDeadVariables);
+    append_bytes(&key, settings.fOptimizeRPStores);
+    append_bytes(&key, settings.fInlineThreshold);
+    append_bytes(&key, settings.fForceNoInline);
+    append_bytes(&key, settings.fAllowNarrowingConversions);
+    append_bytes(&key, settings.fValidateSPIRV);
+    append_bytes(&key, settings.fUsePushConstants);
+    append_bytes(&key, settings.fMaxVersionAllowed);
+    // fUseMemoryPool only affects how the compiler allocates IR, not what it generates.
+    for (const SkSL::ProgramSettings::SpecializedUniform& uniform :
+         settings.fSpecializedUniforms) {
+        append_bytes(&key, uniform.fName.size());
+        key.append(uniform.fName);
+        append_bytes(&key, uniform.fValues.size());
+        key.append(reinterpret_cast<const char*>(uniform.fValues.data()),
+                   uniform.fValues.size() * sizeof(double));
+    }
+    key.append(sksl);
+    return key;
+}
+
+}  // namespace
+
+SkSLCompileStats GetSkSLCompileStats() {
+    CompileStatsTracker& tracker = compile_stats();
+    SkAutoMutexExclusive lock(tracker.fMutex);
+    return tracker.fStats;
+}
+
+void ResetSkSLCompileStats() {
+    CompileStatsTracker& tracker = compile_stats();
+    SkAutoMutexExclusive lock(tracker.fMutex);
+    tracker.fStats = {};
+}
+
+struct SkSLCompileCache::Impl {
+    struct Entry {
+        std::string fOutput;
+        SkSL::ProgramInterface fInterface;
+    };
+
+    explicit Impl(int maxEntries) : fEntries(maxEntries) {}
+
+    mutable SkMutex fMutex;
+    SkLRUCache<std::string, Entry> fEntries SK_GUARDED_BY(fMutex);
+    int fHits SK_GUARDED_BY(fMutex) = 0;
+    int fMisses SK_GUARDED_BY(fMutex) = 0;
+};
+
+SkSLCompileCache::SkSLCompileCache(int maxEntries)
+        : fImpl(std::make_unique<Impl>(maxEntries)) {}
+
+SkSLCompileCache::~SkSLCompileCache() = default;
+
+int SkSLCompileCache::count() const {
+    SkAutoMutexExclusive lock(fImpl->fMutex);
+    return fImpl->fEntries.count();
+}
+
+void SkSLCompileCache::purgeAll() {
+    SkAutoMutexExclusive lock(fImpl->fMutex);
+    fImpl->fEntries.reset();
+}
+
+int SkSLCompileCache::hits() const {
+    SkAutoMutexExclusive lock(fImpl->fMutex);
+    return fImpl->fHits;
+}
+
+int SkSLCompileCache::misses() const {
+    SkAutoMutexExclusive lock(fImpl->fMutex);
+    return fImpl->fMisses;
+}
+
+bool SkSLCompileCache::find(const std::string& key,
+                            std::string* output,
+                            SkSL::ProgramInterface* outInterface) {
+    SkAutoMutexExclusive lock(fImpl->fMutex);
+    Impl::Entry* entry = fImpl->fEntries.find(key);
+    if (!entry) {
+        fImpl->fMisses++;
+        return false;
+    }
+    fImpl->fHits++;
+    *output = entry->fOutput;
+    if (outInterface) {
+        *outInterface = entry->fInterface;
+    }
+    return true;
+}
+
+void SkSLCompileCache::add(const std::string& key,
+                           const std::string& output,
+                           const SkSL::ProgramInterface& interface) {
+    SkAutoMutexExclusive lock(fImpl->fMutex);
+    // Another thread may have compiled the same stage while we were working on it.
+    fImpl->fEntries.insert_or_update(key, Impl::Entry{output, interface});
+}
+
 bool SkSLToBackend(const SkSL::ShaderCaps* caps,
                    bool (*toBackend)(SkSL::Program&, const SkSL::ShaderCaps*, std::string*),
                    const char* backendLabel,
@@ -26,7 +198,19 @@ bool SkSLToBackend(const SkSL::ShaderCaps* caps,
                    const SkSL::ProgramSettings& settings,
                    std::string* output,
                    SkSL::ProgramInterface* outInterface,
-                   ShaderErrorHandler* errorHandler) {
+                   ShaderErrorHandler* errorHandler,
+                   SkSLCompileCache* cache) {
+    std::string cacheKey;
+    if (cache) {
+        cacheKey = make_cache_key(toBackend, sksl, programKind, settings);
+        if (cache->find(cacheKey, output, outInterface)) {
+            CompileStatsTracker& tracker = compile_stats();
+            SkAutoMutexExclusive lock(tracker.fMutex);
+            tracker.fStats.fCacheHits++;
+            return true;
+        }
+    }
+
 #ifdef SK_DEBUG
     std::string src = SkShaderUtils::PrettyPrint(sksl);
 #else
@@ -34,7 +218,19 @@ bool SkSLToBackend(const SkSL::ShaderCaps* caps,
 #endif
     SkSL::Compiler compiler;
     std::unique_ptr<SkSL::Program> program = compiler.convertProgram(programKind, src, settings);
-    if (!program || !(*toBackend)(*program, caps, output)) {
+    const double codeGenStartMs = SkTime::GetMSecs();
+    const bool success = program && (*toBackend)(*program, caps, output);
+    {
+        CompileStatsTracker& tracker = compile_stats();
+        SkAutoMutexExclusive lock(tracker.fMutex);
+        tracker.fStats.fCacheMisses++;
+        tracker.fStats.fParseMs += compiler.lastTimings().fParseMs;
+        tracker.fStats.fOptimizeMs += compiler.lastTimings().fOptimizeMs;
+        if (program) {
+            tracker.fStats.fCodeGenMs += SkTime::GetMSecs() - codeGenStartMs;
+        }
+    }
+    if (!success) {
         errorHandler->compileError(src.c_str(),
                                    compiler.errorText().c_str(),
                                    /*shaderWasCached=*/false);
@@ -72,6 +268,9 @@ bool SkSLToBackend(const SkSL::ShaderCaps* caps,
     if (outInterface) {
         *outInterface = program->fInterface;
     }
+    if (cache) {
+        cache->add(cacheKey, *output, program->fInterface);
+    }
     return true;
 }
 
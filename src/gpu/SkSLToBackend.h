@@ -9,6 +9,7 @@
 #define skgpu_SkSLToBackend_DEFINED
 
 #include <cstdint>
+#include <memory>
 #include <string>
 
 namespace SkSL {
@@ -25,7 +26,61 @@ namespace skgpu {
 
 class ShaderErrorHandler;
 
-/** Wrapper for the SkSL compiler with useful logging and error handling. */
+/**
+ * Aggregate statistics for every shader stage compiled through SkSLToBackend in this process.
+ */
+struct SkSLCompileStats {
+    int fCacheHits = 0;
+    int fCacheMisses = 0;
+    // Time spent parsing SkSL into IR, optimizing the IR, and generating backend code.
+    double fParseMs = 0;
+    double fOptimizeMs = 0;
+    double fCodeGenMs = 0;
+};
+
+SkSLCompileStats GetSkSLCompileStats();
+void ResetSkSLCompileStats();
+
+/**
+ * Remembers the backend output of recently compiled shader stages, so that identical SkSL is only
+ * compiled once. This is common when many pipelines share a vertex stage, or when pipelines differ
+ * only in fixed-function state and so generate the same fragment stage. Entries are keyed on the
+ * SkSL text, program kind, settings and backend; the shader caps are not part of the key, so a
+ * cache must only be used with a single set of caps (e.g. one per context). Thread-safe.
+ *
+ * Reuse is at whole-stage granularity. The shared snippet functions which stages are assembled
+ * from live in the SkSL modules, which are parsed and optimized once per process by the module
+ * loader, so a stage that misses here still only parses its own generated code. The hit and miss
+ * counts tell how often whole stages repeat in a given stream of draws.
+ */
+class SkSLCompileCache {
+public:
+    static constexpr int kDefaultMaxEntries = 64;
+
+    explicit SkSLCompileCache(int maxEntries = kDefaultMaxEntries);
+    ~SkSLCompileCache();
+
+    int count() const;
+    void purgeAll();
+
+    // Lookups which found, or did not find, a compiled stage since the cache was created.
+    int hits() const;
+    int misses() const;
+
+    // Used by SkSLToBackend; `key` is an opaque description of all of the compilation inputs.
+    bool find(const std::string& key, std::string* output, SkSL::ProgramInterface* outInterface);
+    void add(const std::string& key, const std::string& output,
+             const SkSL::ProgramInterface& interface);
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> fImpl;
+};
+
+/**
+ * Wrapper for the SkSL compiler with useful logging and error handling. When `cache` is non-null,
+ * successful results are stored in it and reused by later calls with the same inputs.
+ */
 bool SkSLToBackend(const SkSL::ShaderCaps* caps,
                    bool (*toBackend)(SkSL::Program&, const SkSL::ShaderCaps*, std::string*),
                    const char* backendLabel,
@@ -34,7 +89,8 @@ bool SkSLToBackend(const SkSL::ShaderCaps* caps,
                    const SkSL::ProgramSettings& settings,
                    std::string* output,
                    SkSL::ProgramInterface* outInterface,
-                   ShaderErrorHandler* errorHandler);
+                   ShaderErrorHandler* errorHandler,
+                   SkSLCompileCache* cache = nullptr);
 
 }  // namespace skgpu
 
@@ -27,6 +27,7 @@
 #include "src/core/SkTraceEvent.h"
 #include "src/gpu/AtlasTypes.h"
 #include "src/gpu/SkBackingFit.h"
+#include "src/gpu/SkSLToBackend.h"
 #include "src/gpu/ganesh/GrAuditTrail.h"
 #include "src/gpu/ganesh/GrColorInfo.h"
 #include "src/gpu/ganesh/GrDrawingManager.h"
@@ -142,6 +143,9 @@ void GrDirectContextPriv::dumpGpuStats(SkString* out) const {
     if (auto builder = this->context()->fGpu->pipelineBuilder()) {
         builder->stats()->dump(out);
     }
+    const skgpu::SkSLCompileCache* skslCache = this->context()->fGpu->skslCompileCache();
+    out->appendf("SkSL Compile Cache Hits: %d\n", skslCache->hits());
+    out->appendf("SkSL Compile Cache Misses: %d\n", skslCache->misses());
 #endif
 }
 
@@ -152,6 +156,11 @@ void GrDirectContextPriv::dumpGpuStatsKeyValuePairs(TArray<SkString>* keys,
     if (auto builder = this->context()->fGpu->pipelineBuilder()) {
         builder->stats()->dumpKeyValuePairs(keys, values);
     }
+    const skgpu::SkSLCompileCache* skslCache = this->context()->fGpu->skslCompileCache();
+    keys->push_back(SkString("sksl_compile_cache_hits"));
+    values->push_back(skslCache->hits());
+    keys->push_back(SkString("sksl_compile_cache_misses"));
+    values->push_back(skslCache->misses());
 #endif
 }
 
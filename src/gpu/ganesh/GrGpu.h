@@ -18,6 +18,7 @@
 #include "include/gpu/ganesh/GrTypes.h"
 #include "include/private/base/SkTArray.h"
 #include "include/private/gpu/ganesh/GrTypesPriv.h"
+#include "src/gpu/SkSLToBackend.h"
 #include "src/gpu/ganesh/GrCaps.h"
 #include "src/gpu/ganesh/GrGpuBuffer.h"  // IWYU pragma: keep
 #include "src/gpu/ganesh/GrOpsRenderPass.h"
@@ -73,6 +74,13 @@ public:
     const GrCaps* caps() const { return fCaps.get(); }
     sk_sp<const GrCaps> refCaps() const { return fCaps; }
 
+    /**
+     * Backend output for shader stages compiled with this GPU's caps. Programs which differ only in
+     * state that doesn't reach the shader text (e.g. blend or stencil settings) share their stages,
+     * which then only need to be compiled once. The cache is internally synchronized.
+     */
+    skgpu::SkSLCompileCache* skslCompileCache() const { return &fSkSLCompileCache; }
+
     virtual GrStagingBufferManager* stagingBufferManager() { return nullptr; }
 
     virtual GrRingBuffer* uniformsRingBuffer() { return nullptr; }
@@ -871,6 +879,7 @@ private:
     void callSubmittedProcs(bool success);
 
     sk_sp<const GrCaps>             fCaps;
+    mutable skgpu::SkSLCompileCache fSkSLCompileCache;
 
     uint32_t fResetBits;
     // The context owns us, not vice-versa, so this ptr is not ref'ed by Gpu.
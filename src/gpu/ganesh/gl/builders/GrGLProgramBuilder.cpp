@@ -346,7 +346,8 @@ sk_sp<GrGLProgram> GrGLProgramBuilder::finalize(const GrGLPrecompiledProgram* pr
                                    settings,
                                    &glsl[kFragment_GrShaderType],
                                    &interface,
-                                   errorHandler)) {
+                                   errorHandler,
+                                   this->gpu()->skslCompileCache())) {
                 cleanup_program(fGpu, programID, shadersToDelete);
                 return nullptr;
             }
@@ -375,7 +376,8 @@ sk_sp<GrGLProgram> GrGLProgramBuilder::finalize(const GrGLPrecompiledProgram* pr
                                    settings,
                                    &glsl[kVertex_GrShaderType],
                                    &unusedInterface,
-                                   errorHandler)) {
+                                   errorHandler,
+                                   this->gpu()->skslCompileCache())) {
                 cleanup_program(fGpu, programID, shadersToDelete);
                 return nullptr;
             }
@@ -502,7 +504,8 @@ bool GrGLProgramBuilder::PrecompileProgram(GrDirectContext* dContext,
                                settings,
                                &glsl,
                                &unusedInterface,
-                               errorHandler)) {
+                               errorHandler,
+                               glGpu->skslCompileCache())) {
             return false;
         }
 
@@ -575,14 +575,16 @@ GrMtlPipelineState* GrMtlPipelineStateBuilder::finalize(
                                                         settings,
                                                         &msl[kVertex_GrShaderType],
                                                         &interfaces[kVertex_GrShaderType],
-                                                        errorHandler);
+                                                        errorHandler,
+                                                        fGpu->skslCompileCache());
                         success = success && skgpu::SkSLToMSL(mtlCaps->shaderCaps(),
                                                               cached_sksl[kFragment_GrShaderType],
                                                               SkSL::ProgramKind::kFragment,
                                                               settings,
                                                               &msl[kFragment_GrShaderType],
                                                               &interfaces[kFragment_GrShaderType],
-                                                              errorHandler);
+                                                              errorHandler,
+                                                              fGpu->skslCompileCache());
                         if (!success) {
                             return nullptr;
                         }
@@ -606,7 +608,8 @@ GrMtlPipelineState* GrMtlPipelineStateBuilder::finalize(
                                            settings,
                                            &msl[kVertex_GrShaderType],
                                            &interfaces[kVertex_GrShaderType],
-                                           errorHandler);
+                                           errorHandler,
+                                           fGpu->skslCompileCache());
             }
             if (success && msl[kFragment_GrShaderType].empty()) {
                 success = skgpu::SkSLToMSL(mtlCaps->shaderCaps(),
@@ -615,7 +618,8 @@ GrMtlPipelineState* GrMtlPipelineStateBuilder::finalize(
                                            settings,
                                            &msl[kFragment_GrShaderType],
                                            &interfaces[kFragment_GrShaderType],
-                                           errorHandler);
+                                           errorHandler,
+                                           fGpu->skslCompileCache());
             }
             if (!success) {
                 return nullptr;
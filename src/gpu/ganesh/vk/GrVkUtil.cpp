@@ -82,7 +82,8 @@ bool GrCompileVkShaderModule(GrVkGpu* gpu,
                             settings,
                             outSPIRV,
                             outInterface,
-                            errorHandler)) {
+                            errorHandler,
+                            gpu->skslCompileCache())) {
         return false;
     }
 
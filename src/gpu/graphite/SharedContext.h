@@ -13,6 +13,7 @@
 #include "include/core/SkSize.h"
 
 #include "include/gpu/graphite/GraphiteTypes.h"
+#include "src/gpu/SkSLToBackend.h"
 #include "src/gpu/graphite/GlobalCache.h"
 #include "src/gpu/graphite/ShaderCodeDictionary.h"
 
@@ -50,6 +51,11 @@ public:
     ShaderCodeDictionary* shaderCodeDictionary() { return &fShaderDictionary; }
     const ShaderCodeDictionary* shaderCodeDictionary() const { return &fShaderDictionary; }
 
+    // Backend output for shader stages compiled with this context's caps. Pipelines frequently
+    // share stages (e.g. the vertex stage of a RenderStep), which then only need to be compiled
+    // once. The cache is internally synchronized.
+    SkSLCompileCache* skslCompileCache() const { return &fSkSLCompileCache; }
+
     virtual std::unique_ptr<ResourceProvider> makeResourceProvider(SingleOwner*,
                                                                    uint32_t recorderID,
                                                                    size_t resourceBudget) = 0;
@@ -75,6 +81,7 @@ private:
     GlobalCache fGlobalCache;
     std::unique_ptr<RendererProvider> fRendererProvider;
     ShaderCodeDictionary fShaderDictionary;
+    mutable SkSLCompileCache fSkSLCompileCache;
 };
 
 } // namespace skgpu::graphite
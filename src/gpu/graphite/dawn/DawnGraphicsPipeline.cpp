@@ -366,7 +366,8 @@ sk_sp<DawnGraphicsPipeline> DawnGraphicsPipeline::Make(const DawnSharedContext*
                                settings,
                                &fsCode,
                                &fsInterface,
-                               errorHandler)) {
+                               errorHandler,
+                               sharedContext->skslCompileCache())) {
             return {};
         }
         if (!DawnCompileWGSLShaderModule(sharedContext, fsSkSLInfo.fLabel.c_str(), fsCode,
@@ -386,7 +387,8 @@ sk_sp<DawnGraphicsPipeline> DawnGraphicsPipeline::Make(const DawnSharedContext*
                            settings,
                            &vsCode,
                            &vsInterface,
-                           errorHandler)) {
+                           errorHandler,
+                           sharedContext->skslCompileCache())) {
         return {};
     }
     if (!DawnCompileWGSLShaderModule(sharedContext, vsSkSLInfo.fLabel.c_str(), vsCode,
@@ -32,9 +32,11 @@ inline bool SkSLToWGSL(const SkSL::ShaderCaps* caps,
                        const SkSL::ProgramSettings& settings,
                        std::string* wgsl,
                        SkSL::ProgramInterface* outInterface,
-                       ShaderErrorHandler* errorHandler) {
+                       ShaderErrorHandler* errorHandler,
+                       SkSLCompileCache* cache = nullptr) {
     return SkSLToBackend(caps, &SkSL::ToWGSL, "WGSL",
-                         sksl, programKind, settings, wgsl, outInterface, errorHandler);
+                         sksl, programKind, settings, wgsl, outInterface, errorHandler,
+                         cache);
 }
 
 namespace graphite {
@@ -297,7 +297,8 @@ sk_sp<MtlGraphicsPipeline> MtlGraphicsPipeline::Make(const MtlSharedContext* sha
                    settings,
                    &fsMSL,
                    &fsInterface,
-                   errorHandler)) {
+                   errorHandler,
+                   sharedContext->skslCompileCache())) {
         return nullptr;
     }
 
@@ -312,7 +313,8 @@ sk_sp<MtlGraphicsPipeline> MtlGraphicsPipeline::Make(const MtlSharedContext* sha
                    settings,
                    &vsMSL,
                    &vsInterface,
-                   errorHandler)) {
+                   errorHandler,
+                   sharedContext->skslCompileCache())) {
         return nullptr;
     }
 
@@ -710,7 +710,8 @@ sk_sp<VulkanGraphicsPipeline> VulkanGraphicsPipeline::Make(
                                 settings,
                                 &fsSPIRV,
                                 &fsInterface,
-                                errorHandler)) {
+                                errorHandler,
+                                sharedContext->skslCompileCache())) {
             return nullptr;
         }
 
@@ -731,7 +732,8 @@ sk_sp<VulkanGraphicsPipeline> VulkanGraphicsPipeline::Make(
                             settings,
                             &vsSPIRV,
                             &vsInterface,
-                            errorHandler)) {
+                            errorHandler,
+                            sharedContext->skslCompileCache())) {
         return nullptr;
     }
 
@@ -33,9 +33,11 @@ inline bool SkSLToMSL(const SkSL::ShaderCaps* caps,
                       const SkSL::ProgramSettings& settings,
                       std::string* msl,
                       SkSL::ProgramInterface* outInterface,
-                      ShaderErrorHandler* errorHandler) {
+                      ShaderErrorHandler* errorHandler,
+                      SkSLCompileCache* cache = nullptr) {
     return SkSLToBackend(caps, &SkSL::ToMetal, "MSL",
-                         sksl, programKind, settings, msl, outInterface, errorHandler);
+                         sksl, programKind, settings, msl, outInterface, errorHandler,
+                         cache);
 }
 
 bool MtlFormatIsDepthOrStencil(MTLPixelFormat);
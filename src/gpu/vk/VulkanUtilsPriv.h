@@ -47,9 +47,11 @@ inline bool SkSLToSPIRV(const SkSL::ShaderCaps* caps,
                         const SkSL::ProgramSettings& settings,
                         std::string* spirv,
                         SkSL::ProgramInterface* outInterface,
-                        ShaderErrorHandler* errorHandler) {
+                        ShaderErrorHandler* errorHandler,
+                        SkSLCompileCache* cache = nullptr) {
     return SkSLToBackend(caps, &SkSL::ToSPIRV, /*backendLabel=*/nullptr,
-                         sksl, programKind, settings, spirv, outInterface, errorHandler);
+                         sksl, programKind, settings, spirv, outInterface, errorHandler,
+                         cache);
 }
 
 static constexpr uint32_t VkFormatChannels(VkFormat vkFormat) {
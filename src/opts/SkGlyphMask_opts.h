@@ -0,0 +1,129 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkGlyphMask_opts_DEFINED
+#define SkGlyphMask_opts_DEFINED
+
+#include "include/private/SkColorData.h"
+#include "src/base/SkVx.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace SK_OPTS_NS {
+
+// The coefficients of the three FIRs (r, g and b) turning 4x horizontally oversampled coverage into
+// LCD coverage, in 8.8 fixed point. Each output pixel covers 12 samples: the 4 under it and 4 on
+// either side.
+//
+// Coefficients determined by a gausian where 5 samples = 3 std deviations (0x110 'contrast').
+// Calculated using tools/generate_fir_coeff.py
+// With this one almost no fringing is ever seen, but it is imperceptibly blurry.
+// The lcd smoothed text is almost imperceptibly different from gray,
+// but is still sharper on small stems and small rounded corners than gray.
+// This also seems to be about as wide as one can get and only have a three pixel kernel.
+static constexpr uint32_t kLCDCoefficients[3][12] = {
+    //The red subpixel is centered inside the first sample (at 1/6 pixel), and is shifted.
+    { 0x03, 0x0b, 0x1c, 0x33,  0x40, 0x39, 0x24, 0x10,  0x05, 0x01, 0x00, 0x00, },
+    //The green subpixel is centered between two samples (at 1/2 pixel), so is symetric
+    { 0x00, 0x02, 0x08, 0x16,  0x2b, 0x3d, 0x3d, 0x2b,  0x16, 0x08, 0x02, 0x00, },
+    //The blue subpixel is centered inside the last sample (at 5/6 pixel), and is shifted.
+    { 0x00, 0x00, 0x01, 0x05,  0x10, 0x24, 0x39, 0x40,  0x33, 0x1c, 0x0b, 0x03, },
+};
+
+/*not static*/ inline void lcd_filter_row(const uint8_t samples[], int count,
+                                          uint8_t r[], uint8_t g[], uint8_t b[]) {
+    // Pixel i is filtered from samples[4*i, 4*i + 12). Loading the samples as 32-bit words puts
+    // the 4 samples under each pixel in one lane, so 8 pixels are filtered at a time, one tap
+    // (a byte of a word) at a time.
+    using U32 = skvx::Vec<8, uint32_t>;
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        U32 sumR = 0, sumG = 0, sumB = 0;
+        for (int word = 0; word < 3; ++word) {
+            const U32 quads = U32::Load(samples + 4 * (i + word));
+            for (int phase = 0; phase < 4; ++phase) {
+                const U32 s = (quads >> (8 * phase)) & 0xFF;
+                const int tap = 4 * word + phase;
+                sumR += s * kLCDCoefficients[0][tap];
+                sumG += s * kLCDCoefficients[1][tap];
+                sumB += s * kLCDCoefficients[2][tap];
+            }
+        }
+        skvx::cast<uint8_t>(min(sumR >> 8, 255)).store(r + i);
+        skvx::cast<uint8_t>(min(sumG >> 8, 255)).store(g + i);
+        skvx::cast<uint8_t>(min(sumB >> 8, 255)).store(b + i);
+    }
+    for (; i < count; ++i) {
+        uint32_t sumR = 0, sumG = 0, sumB = 0;
+        for (int tap = 0; tap < 12; ++tap) {
+            const uint32_t s = samples[4 * i + tap];
+            sumR += s * kLCDCoefficients[0][tap];
+            sumG += s * kLCDCoefficients[1][tap];
+            sumB += s * kLCDCoefficients[2][tap];
+        }
+        r[i] = std::min(sumR >> 8, 255u);
+        g[i] = std::min(sumG >> 8, 255u);
+        b[i] = std::min(sumB >> 8, 255u);
+    }
+}
+
+// The bit of each pixel in a byte of a 1 bit per pixel mask, most significant bit first.
+static constexpr uint8_t kBitsOfByte[8] = {0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01};
+
+/*not static*/ inline void a1_to_a8_row(uint8_t dst[], const uint8_t src[], int count) {
+    using U8 = skvx::Vec<8, uint8_t>;
+    const U8 bits = U8::Load(kBitsOfByte);
+    int x = 0;
+    for (; x + 8 <= count; x += 8) {
+        if_then_else((U8(src[x >> 3]) & bits) != 0, U8(0xFF), U8(0)).store(dst + x);
+    }
+    for (; x < count; ++x) {
+        dst[x] = (src[x >> 3] & kBitsOfByte[x & 7]) ? 0xFF : 0x00;
+    }
+}
+
+/*not static*/ inline void a8_to_a1_row(uint8_t dst[], const uint8_t src[], int count,
+                                        uint8_t cutoff) {
+    using U8 = skvx::Vec<8, uint8_t>;
+    const U8 bits = U8::Load(kBitsOfByte);
+    int x = 0;
+    for (; x + 8 <= count; x += 8) {
+        const U8 set = if_then_else(U8::Load(src + x) >= cutoff, bits, U8(0));
+        const auto four = set.lo | set.hi;
+        const auto two = four.lo | four.hi;
+        *dst++ = (two.lo | two.hi).val;
+    }
+    if (x < count) {
+        uint8_t byte = 0;
+        for (int bit = 0; x < count; ++x, ++bit) {
+            if (src[x] >= cutoff) {
+                byte |= kBitsOfByte[bit];
+            }
+        }
+        *dst = byte;
+    }
+}
+
+/*not static*/ inline void a8_to_lcd16_row(uint16_t dst[], const uint8_t src[], int count) {
+    using U16 = skvx::Vec<16, uint16_t>;
+    int x = 0;
+    for (; x + 16 <= count; x += 16) {
+        const U16 a = skvx::cast<uint16_t>(skvx::Vec<16, uint8_t>::Load(src + x));
+        const U16 lcd = ((a >> (8 - SK_R16_BITS)) << SK_R16_SHIFT) |
+                        ((a >> (8 - SK_G16_BITS)) << SK_G16_SHIFT) |
+                        ((a >> (8 - SK_B16_BITS)) << SK_B16_SHIFT);
+        lcd.store(dst + x);
+    }
+    for (; x < count; ++x) {
+        dst[x] = SkPack888ToRGB16(src[x], src[x], src[x]);
+    }
+}
+
+}  // namespace SK_OPTS_NS
+
+#endif  // SkGlyphMask_opts_DEFINED
@@ -21,6 +21,7 @@
 #include "include/private/SkColorData.h"
 #include "include/private/base/SkTo.h"
 #include "src/core/SkFDot6.h"
+#include "src/core/SkGlyphMask.h"
 #include "src/core/SkSwizzlePriv.h"
 #include "src/core/SkTHash.h"
 
@@ -139,6 +140,16 @@ uint16_t grayToRGB16(U8CPU gray) {
     return SkPack888ToRGB16(gray, gray, gray);
 }
 
+void grayRowToRGB16(uint16_t dst[], const uint8_t src[], int count) {
+    if constexpr (kSkShowTextBlitCoverage) {
+        for (int x = 0; x < count; ++x) {
+            dst[x] = grayToRGB16(src[x]);
+        }
+    } else {
+        SkOpts::a8_to_lcd16_row(dst, src, count);
+    }
+}
+
 int bittst(const uint8_t data[], int bitOffset) {
     SkASSERT(bitOffset >= 0);
     int lowBit = data[bitOffset >> 3] >> (~bitOffset & 7);
@@ -184,9 +195,7 @@ void copyFT2LCD16(const FT_Bitmap& bitmap, SkMaskBuilder* dstMask, int lcdIsBGR,
             break;
         case FT_PIXEL_MODE_GRAY:
             for (int y = height; y --> 0;) {
-                for (int x = 0; x < width; ++x) {
-                    dst[x] = grayToRGB16(src[x]);
-                }
+                grayRowToRGB16(dst, src, width);
                 dst = (uint16_t*)((char*)dst + dstRB);
                 src += bitmap.pitch;
             }
@@ -299,19 +308,7 @@ void copyFTBitmap(const FT_Bitmap& srcFTBitmap, SkMaskBuilder* dstMask) {
         }
     } else if (FT_PIXEL_MODE_MONO == srcFormat && SkMask::kA8_Format == dstFormat) {
         for (size_t y = height; y --> 0;) {
-            uint8_t byte = 0;
-            int bits = 0;
-            const uint8_t* src_row = src;
-            uint8_t* dst_row = dst;
-            for (size_t x = width; x --> 0;) {
-                if (0 == bits) {
-                    byte = *src_row++;
-                    bits = 8;
-                }
-                *dst_row++ = byte & 0x80 ? 0xff : 0x00;
-                bits--;
-                byte <<= 1;
-            }
+            SkOpts::a1_to_a8_row(dst, src, SkToInt(width));
             src += srcPitch;
             dst += dstRowBytes;
         }
@@ -339,49 +336,19 @@ void copyFTBitmap(const FT_Bitmap& srcFTBitmap, SkMaskBuilder* dstMask) {
     }
 }
 
-inline int convert_8_to_1(unsigned byte) {
-    SkASSERT(byte <= 0xFF);
-    // Arbitrary decision that making the cutoff at 1/4 instead of 1/2 in general looks better.
-    return (byte >> 6) != 0;
-}
-
-uint8_t pack_8_to_1(const uint8_t alpha[8]) {
-    unsigned bits = 0;
-    for (int i = 0; i < 8; ++i) {
-        bits <<= 1;
-        bits |= convert_8_to_1(alpha[i]);
-    }
-    return SkToU8(bits);
-}
-
 void packA8ToA1(SkMaskBuilder* dstMask, const uint8_t* src, size_t srcRB) {
     const int height = dstMask->fBounds.height();
     const int width = dstMask->fBounds.width();
-    const int octs = width >> 3;
-    const int leftOverBits = width & 7;
 
     uint8_t* dst = dstMask->image();
-    const int dstPad = dstMask->fRowBytes - SkAlign8(width)/8;
-    SkASSERT(dstPad >= 0);
-
-    const int srcPad = srcRB - width;
-    SkASSERT(srcPad >= 0);
+    SkASSERT(dstMask->fRowBytes >= SkAlign8(width)/8);
+    SkASSERT(srcRB >= (size_t)width);
 
     for (int y = 0; y < height; ++y) {
-        for (int i = 0; i < octs; ++i) {
-            *dst++ = pack_8_to_1(src);
-            src += 8;
-        }
-        if (leftOverBits > 0) {
-            unsigned bits = 0;
-            int shift = 7;
-            for (int i = 0; i < leftOverBits; ++i, --shift) {
-                bits |= convert_8_to_1(*src++) << shift;
-            }
-            *dst++ = bits;
-        }
-        src += srcPad;
-        dst += dstPad;
+        // Arbitrary decision that making the cutoff at 1/4 instead of 1/2 in general looks better.
+        SkOpts::a8_to_a1_row(dst, src, width, 0x40);
+        src += srcRB;
+        dst += dstMask->fRowBytes;
     }
 }
 
@@ -1876,9 +1843,7 @@ void SkScalerContextFTUtils::generateGlyphImage(FT_Face face, const SkGlyph& gly
                 uint8_t* src = dstBitmap.getAddr8(0, 0);
                 uint16_t* dst = reinterpret_cast<uint16_t*>(imageBuffer);
                 for (int y = dstBitmap.height(); y --> 0;) {
-                    for (int x = 0; x < dstBitmap.width(); ++x) {
-                        dst[x] = grayToRGB16(src[x]);
-                    }
+                    grayRowToRGB16(dst, src, dstBitmap.width());
                     dst = (uint16_t*)((char*)dst + glyph.rowBytes());
                     src += dstBitmap.rowBytes();
                 }
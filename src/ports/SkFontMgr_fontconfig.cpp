@@ -25,7 +25,9 @@
 #include "include/private/base/SkThreadAnnotations.h"
 #include "src/base/SkTSort.h"
 #include "src/core/SkAdvancedTypefaceMetrics.h"
+#include "src/core/SkChecksum.h"
 #include "src/core/SkFontDescriptor.h"
+#include "src/core/SkLRUCache.h"
 #include "src/core/SkOSFile.h"
 #include "src/core/SkScalerContext.h"
 #include "src/core/SkTypefaceCache.h"
@@ -752,6 +754,81 @@ class SkFontMgr_fontconfig : public SkFontMgr {
         return face;
     }
 
+    // Text in a script the default fonts don't cover asks for a fallback per character, and
+    // FcFontMatch sorts the whole font set each time. The fallbacks are cached, including the
+    // characters no font has, which are the most expensive to look up.
+    struct FallbackKey {
+        SkString fFamilyName;
+        SkString fLanguages;  // the bcp47 tags, each followed by a '\0'
+        SkFontStyle fStyle;
+        SkUnichar fCharacter;
+
+        bool operator==(const FallbackKey& that) const {
+            return fCharacter == that.fCharacter &&
+                   fStyle == that.fStyle &&
+                   fFamilyName == that.fFamilyName &&
+                   fLanguages == that.fLanguages;
+        }
+    };
+    struct FallbackKeyHash {
+        uint32_t operator()(const FallbackKey& key) const {
+            uint32_t hash = SkChecksum::Hash32(&key.fCharacter, sizeof(key.fCharacter));
+            const int style[] = {key.fStyle.weight(), key.fStyle.width(), key.fStyle.slant()};
+            hash = SkChecksum::Hash32(style, sizeof(style), hash);
+            hash = SkChecksum::Hash32(key.fFamilyName.c_str(), key.fFamilyName.size(), hash);
+            return SkChecksum::Hash32(key.fLanguages.c_str(), key.fLanguages.size(), hash);
+        }
+    };
+    inline static constexpr int kMaxFallbackCacheCount = 1024;
+    mutable SkMutex fFallbackCacheMutex;
+    // A null typeface records that no font has the character.
+    mutable SkLRUCache<FallbackKey, sk_sp<SkTypeface>, FallbackKeyHash> fFallbackCache
+            SK_GUARDED_BY(fFallbackCacheMutex){kMaxFallbackCacheCount};
+
+    sk_sp<SkTypeface> matchFallback(const char familyName[],
+                                    const SkFontStyle& style,
+                                    const char* bcp47[],
+                                    int bcp47Count,
+                                    SkUnichar character) const
+    {
+        SkAutoFcPattern font([&](){
+            FCLocker lock;
+
+            SkAutoFcPattern pattern;
+            if (familyName) {
+                FcValue familyNameValue;
+                familyNameValue.type = FcTypeString;
+                familyNameValue.u.s = reinterpret_cast<const FcChar8*>(familyName);
+                FcPatternAddWeak(pattern, FC_FAMILY, familyNameValue, FcFalse);
+            }
+            fcpattern_from_skfontstyle(style, pattern);
+
+            SkAutoFcCharSet charSet;
+            FcCharSetAddChar(charSet, character);
+            FcPatternAddCharSet(pattern, FC_CHARSET, charSet);
+
+            if (bcp47Count > 0) {
+                SkASSERT(bcp47);
+                SkAutoFcLangSet langSet;
+                for (int i = bcp47Count; i --> 0;) {
+                    FcLangSetAdd(langSet, (const FcChar8*)bcp47[i]);
+                }
+                FcPatternAddLangSet(pattern, FC_LANG, langSet);
+            }
+
+            FcConfigSubstitute(fFC, pattern, FcMatchPattern);
+            FcDefaultSubstitute(pattern);
+
+            FcResult result;
+            SkAutoFcPattern font(FcFontMatch(fFC, pattern, &result));
+            if (!font || !FontAccessible(font) || !FontContainsCharacter(font, character)) {
+                font.reset();
+            }
+            return font;
+        }());
+        return createTypefaceFromFcPattern(std::move(font));
+    }
+
 public:
     /** Takes control of the reference to 'config'. */
     explicit SkFontMgr_fontconfig(FcConfig* config)
@@ -962,42 +1039,24 @@ protected:
                                                   int bcp47Count,
                                                   SkUnichar character) const override
     {
-        SkAutoFcPattern font([&](){
-            FCLocker lock;
-
-            SkAutoFcPattern pattern;
-            if (familyName) {
-                FcValue familyNameValue;
-                familyNameValue.type = FcTypeString;
-                familyNameValue.u.s = reinterpret_cast<const FcChar8*>(familyName);
-                FcPatternAddWeak(pattern, FC_FAMILY, familyNameValue, FcFalse);
-            }
-            fcpattern_from_skfontstyle(style, pattern);
-
-            SkAutoFcCharSet charSet;
-            FcCharSetAddChar(charSet, character);
-            FcPatternAddCharSet(pattern, FC_CHARSET, charSet);
-
-            if (bcp47Count > 0) {
-                SkASSERT(bcp47);
-                SkAutoFcLangSet langSet;
-                for (int i = bcp47Count; i --> 0;) {
-                    FcLangSetAdd(langSet, (const FcChar8*)bcp47[i]);
-                }
-                FcPatternAddLangSet(pattern, FC_LANG, langSet);
+        FallbackKey key{SkString(familyName), SkString(), style, character};
+        for (int i = 0; i < bcp47Count; ++i) {
+            key.fLanguages.append(bcp47[i], strlen(bcp47[i]) + 1);
+        }
+        {
+            SkAutoMutexExclusive ama(fFallbackCacheMutex);
+            if (sk_sp<SkTypeface>* face = fFallbackCache.find(key)) {
+                return *face;
             }
+        }
 
-            FcConfigSubstitute(fFC, pattern, FcMatchPattern);
-            FcDefaultSubstitute(pattern);
+        // Neither lock is held while matching; two threads may both match the same key.
+        sk_sp<SkTypeface> face = this->matchFallback(familyName, style, bcp47, bcp47Count,
+                                                     character);
 
-            FcResult result;
-            SkAutoFcPattern font(FcFontMatch(fFC, pattern, &result));
-            if (!font || !FontAccessible(font) || !FontContainsCharacter(font, character)) {
-                font.reset();
-            }
-            return font;
-        }());
-        return createTypefaceFromFcPattern(std::move(font));
+        SkAutoMutexExclusive ama(fFallbackCacheMutex);
+        fFallbackCache.insert_or_update(key, face);
+        return face;
     }
 
     sk_sp<SkTypeface> onMakeFromStreamIndex(std::unique_ptr<SkStreamAsset> stream,
@@ -8,6 +8,7 @@
 #include "src/sksl/SkSLCompiler.h"
 
 #include "include/private/base/SkDebug.h"
+#include "src/base/SkTime.h"
 #include "src/core/SkTraceEvent.h"
 #include "src/sksl/SkSLAnalysis.h"
 #include "src/sksl/SkSLContext.h"
@@ -114,6 +115,7 @@ void Compiler::FinalizeSettings(ProgramSettings* settings, ProgramKind kind) {
     settings->fInlineThreshold *= (int)settings->fOptimize;
     settings->fRemoveDeadFunctions &= settings->fOptimize;
     settings->fRemoveDeadVariables &= settings->fOptimize;
+    settings->fOptimizeRPStores &= settings->fOptimize;
 
     // Runtime effects always allow narrowing conversions.
     if (ProgramConfig::IsRuntimeEffect(kind)) {
@@ -212,6 +214,8 @@ std::unique_ptr<Program> Compiler::convertProgram(ProgramKind kind,
                                                   std::string programSource,
                                                   const ProgramSettings& settings) {
     TRACE_EVENT0("skia.shaders", "SkSL::Compiler::convertProgram");
+    const double startMs = SkTime::GetMSecs();
+    fLastTimings = {};
 
     // Wrap the program source in a pointer so it is guaranteed to be stable across moves.
     auto sourcePtr = std::make_unique<std::string>(std::move(programSource));
@@ -225,6 +229,9 @@ std::unique_ptr<Program> Compiler::convertProgram(ProgramKind kind,
                                                .programInheritingFrom(module);
 
     this->cleanupContext();
+
+    // releaseProgram has already recorded the optimizer's share of the time.
+    fLastTimings.fParseMs = SkTime::GetMSecs() - startMs - fLastTimings.fOptimizeMs;
     return program;
 }
 
@@ -240,8 +247,12 @@ std::unique_ptr<SkSL::Program> Compiler::releaseProgram(
                                                   std::move(fPool));
     fContext->fSymbolTable = nullptr;
 
-    bool success = this->finalize(*result) &&
-                   this->optimize(*result);
+    bool success = this->finalize(*result);
+    if (success) {
+        const double optimizeStartMs = SkTime::GetMSecs();
+        success = this->optimize(*result);
+        fLastTimings.fOptimizeMs = SkTime::GetMSecs() - optimizeStartMs;
+    }
     if (pool) {
         pool->detachFromThread();
     }
@@ -337,6 +348,8 @@ bool Compiler::optimizeModuleAfterLoading(ProgramKind kind, Module& module) {
 }
 
 bool Compiler::optimize(Program& program) {
+    TRACE_EVENT0("skia.shaders", "SkSL::Compiler::optimize");
+
     // The optimizer only needs to run when it is enabled.
     if (!program.fConfig->fSettings.fOptimize) {
         return true;
@@ -116,11 +116,24 @@ public:
     };
     static void EnableOptimizer(OverrideFlag flag) { sOptimizer = flag; }
     static void EnableInliner(OverrideFlag flag) { sInliner = flag; }
+    static OverrideFlag OptimizerOverride() { return sOptimizer; }
+    static OverrideFlag InlinerOverride() { return sInliner; }
 
     std::unique_ptr<Program> convertProgram(ProgramKind kind,
                                             std::string programSource,
                                             const ProgramSettings& settings);
 
+    /**
+     * Time spent by the most recent call to convertProgram, split into the front end (parsing and
+     * IR generation) and the optimizer. Code generation happens outside of the Compiler, so it is
+     * measured by the caller.
+     */
+    struct Timings {
+        double fParseMs = 0;
+        double fOptimizeMs = 0;
+    };
+    const Timings& lastTimings() const { return fLastTimings; }
+
     void handleError(std::string_view msg, Position pos);
 
     std::string errorText(bool showCount = true);
@@ -219,6 +232,7 @@ private:
     std::unique_ptr<Pool> fPool;
 
     std::string fErrorText;
+    Timings fLastTimings;
 
     static OverrideFlag sOptimizer;
     static OverrideFlag sInliner;
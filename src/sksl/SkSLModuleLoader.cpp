@@ -23,7 +23,13 @@
 #include "src/sksl/ir/SkSLType.h"
 #include "src/sksl/ir/SkSLVariable.h"
 
+#if !defined(SKSL_STANDALONE)
+#include "include/core/SkExecutor.h"
+#include "src/core/SkTaskGroup.h"
+#endif
+
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <string>
 #include <utility>
@@ -93,27 +99,51 @@ struct ModuleLoader::Impl {
 
     void makeRootSymbolTable();
 
-    // This mutex is taken when ModuleLoader::Get is called, and released when the returned
-    // ModuleLoader object falls out of scope.
-    SkMutex fMutex;
+    // Each module is compiled at most once, guarded by its own mutex so that unrelated modules can
+    // be compiled on different threads at the same time. Once a module has been published to
+    // `fModule`, it is immutable and can be fetched without taking any lock.
+    struct ModuleSlot {
+        SkMutex fMutex;
+        std::atomic<const Module*> fModule{nullptr};
+        std::unique_ptr<const Module> fStorage;
+    };
+
+    template <typename Fn>
+    const Module* load(ModuleSlot& slot, Fn&& compileFn) {
+        if (const Module* module = slot.fModule.load(std::memory_order_acquire)) {
+            return module;
+        }
+        SkAutoMutexExclusive lock(slot.fMutex);
+        if (!slot.fStorage) {
+            slot.fStorage = compileFn();
+            slot.fModule.store(slot.fStorage.get(), std::memory_order_release);
+        }
+        return slot.fStorage.get();
+    }
+
+    void unload(ModuleSlot& slot) {
+        SkAutoMutexExclusive lock(slot.fMutex);
+        slot.fModule.store(nullptr, std::memory_order_relaxed);
+        slot.fStorage = nullptr;
+    }
+
     const BuiltinTypes fBuiltinTypes;
 
     std::unique_ptr<const Module> fRootModule;
 
-    std::unique_ptr<const Module> fSharedModule;            // [Root] + Public intrinsics
-    std::unique_ptr<const Module> fGPUModule;               // [Shared] + Non-public intrinsics/
-                                                            //     helper functions
-    std::unique_ptr<const Module> fVertexModule;            // [GPU] + Vertex stage decls
-    std::unique_ptr<const Module> fFragmentModule;          // [GPU] + Fragment stage decls
-    std::unique_ptr<const Module> fComputeModule;           // [GPU] + Compute stage decls
-    std::unique_ptr<const Module> fGraphiteVertexModule;    // [Vert] + Graphite vertex helpers
-    std::unique_ptr<const Module> fGraphiteFragmentModule;  // [Frag] + Graphite fragment helpers
-    std::unique_ptr<const Module> fGraphiteVertexES2Module; // [Vert] + Graphite vertex ES2 helpers
-    std::unique_ptr<const Module> fGraphiteFragmentES2Module;//[Frag] + Graphite fragment ES2 "  "
-
-    std::unique_ptr<const Module> fPublicModule;            // [Shared] minus Private types +
-                                                            //     Runtime effect intrinsics
-    std::unique_ptr<const Module> fRuntimeShaderModule;     // [Public] + Runtime shader decls
+    ModuleSlot fSharedModule;               // [Root] + Public intrinsics
+    ModuleSlot fGPUModule;                  // [Shared] + Non-public intrinsics/helper functions
+    ModuleSlot fVertexModule;               // [GPU] + Vertex stage decls
+    ModuleSlot fFragmentModule;             // [GPU] + Fragment stage decls
+    ModuleSlot fComputeModule;              // [GPU] + Compute stage decls
+    ModuleSlot fGraphiteVertexModule;       // [Vert] + Graphite vertex helpers
+    ModuleSlot fGraphiteFragmentModule;     // [Frag] + Graphite fragment helpers
+    ModuleSlot fGraphiteVertexES2Module;    // [Vert] + Graphite vertex ES2 helpers
+    ModuleSlot fGraphiteFragmentES2Module;  // [Frag] + Graphite fragment ES2 helpers
+
+    ModuleSlot fPublicModule;               // [Shared] minus Private types +
+                                            //     Runtime effect intrinsics
+    ModuleSlot fRuntimeShaderModule;        // [Public] + Runtime shader decls
 };
 
 ModuleLoader ModuleLoader::Get() {
@@ -121,24 +151,22 @@ ModuleLoader ModuleLoader::Get() {
     return ModuleLoader(*sModuleLoaderImpl);
 }
 
-ModuleLoader::ModuleLoader(ModuleLoader::Impl& m) : fModuleLoader(m) {
-    fModuleLoader.fMutex.acquire();
-}
+ModuleLoader::ModuleLoader(ModuleLoader::Impl& m) : fModuleLoader(m) {}
 
-ModuleLoader::~ModuleLoader() {
-    fModuleLoader.fMutex.release();
-}
+ModuleLoader::~ModuleLoader() {}
 
 void ModuleLoader::unloadModules() {
-    fModuleLoader.fSharedModule           = nullptr;
-    fModuleLoader.fGPUModule              = nullptr;
-    fModuleLoader.fVertexModule           = nullptr;
-    fModuleLoader.fFragmentModule         = nullptr;
-    fModuleLoader.fComputeModule          = nullptr;
-    fModuleLoader.fGraphiteVertexModule   = nullptr;
-    fModuleLoader.fGraphiteFragmentModule = nullptr;
-    fModuleLoader.fPublicModule           = nullptr;
-    fModuleLoader.fRuntimeShaderModule    = nullptr;
+    fModuleLoader.unload(fModuleLoader.fSharedModule);
+    fModuleLoader.unload(fModuleLoader.fGPUModule);
+    fModuleLoader.unload(fModuleLoader.fVertexModule);
+    fModuleLoader.unload(fModuleLoader.fFragmentModule);
+    fModuleLoader.unload(fModuleLoader.fComputeModule);
+    fModuleLoader.unload(fModuleLoader.fGraphiteVertexModule);
+    fModuleLoader.unload(fModuleLoader.fGraphiteFragmentModule);
+    fModuleLoader.unload(fModuleLoader.fGraphiteVertexES2Module);
+    fModuleLoader.unload(fModuleLoader.fGraphiteFragmentES2Module);
+    fModuleLoader.unload(fModuleLoader.fPublicModule);
+    fModuleLoader.unload(fModuleLoader.fRuntimeShaderModule);
 }
 
 ModuleLoader::Impl::Impl() {
@@ -240,128 +268,132 @@ void ModuleLoader::addPublicTypeAliases(const SkSL::Module* module) {
 }
 
 const Module* ModuleLoader::loadPublicModule(SkSL::Compiler* compiler) {
-    if (!fModuleLoader.fPublicModule) {
-        const Module* sharedModule = this->loadSharedModule(compiler);
-        fModuleLoader.fPublicModule = compile_and_shrink(compiler,
-                                                         ProgramKind::kFragment,
-                                                         MODULE_DATA(sksl_public),
-                                                         sharedModule);
-        this->addPublicTypeAliases(fModuleLoader.fPublicModule.get());
-    }
-    return fModuleLoader.fPublicModule.get();
+    const Module* sharedModule = this->loadSharedModule(compiler);
+    return fModuleLoader.load(fModuleLoader.fPublicModule, [&] {
+        std::unique_ptr<Module> m = compile_and_shrink(compiler,
+                                                       ProgramKind::kFragment,
+                                                       MODULE_DATA(sksl_public),
+                                                       sharedModule);
+        this->addPublicTypeAliases(m.get());
+        return m;
+    });
 }
 
 const Module* ModuleLoader::loadPrivateRTShaderModule(SkSL::Compiler* compiler) {
-    if (!fModuleLoader.fRuntimeShaderModule) {
-        const Module* publicModule = this->loadPublicModule(compiler);
-        fModuleLoader.fRuntimeShaderModule = compile_and_shrink(compiler,
-                                                                ProgramKind::kFragment,
-                                                                MODULE_DATA(sksl_rt_shader),
-                                                                publicModule);
-    }
-    return fModuleLoader.fRuntimeShaderModule.get();
+    const Module* publicModule = this->loadPublicModule(compiler);
+    return fModuleLoader.load(fModuleLoader.fRuntimeShaderModule, [&] {
+        return compile_and_shrink(compiler,
+                                  ProgramKind::kFragment,
+                                  MODULE_DATA(sksl_rt_shader),
+                                  publicModule);
+    });
 }
 
 const Module* ModuleLoader::loadSharedModule(SkSL::Compiler* compiler) {
-    if (!fModuleLoader.fSharedModule) {
-        const Module* rootModule = this->rootModule();
-        fModuleLoader.fSharedModule = compile_and_shrink(compiler,
-                                                         ProgramKind::kFragment,
-                                                         MODULE_DATA(sksl_shared),
-                                                         rootModule);
-    }
-    return fModuleLoader.fSharedModule.get();
+    const Module* rootModule = this->rootModule();
+    return fModuleLoader.load(fModuleLoader.fSharedModule, [&] {
+        return compile_and_shrink(compiler,
+                                  ProgramKind::kFragment,
+                                  MODULE_DATA(sksl_shared),
+                                  rootModule);
+    });
 }
 
 const Module* ModuleLoader::loadGPUModule(SkSL::Compiler* compiler) {
-    if (!fModuleLoader.fGPUModule) {
-        const Module* sharedModule = this->loadSharedModule(compiler);
-        fModuleLoader.fGPUModule = compile_and_shrink(compiler,
-                                                      ProgramKind::kFragment,
-                                                      MODULE_DATA(sksl_gpu),
-                                                      sharedModule);
-    }
-    return fModuleLoader.fGPUModule.get();
+    const Module* sharedModule = this->loadSharedModule(compiler);
+    return fModuleLoader.load(fModuleLoader.fGPUModule, [&] {
+        return compile_and_shrink(compiler,
+                                  ProgramKind::kFragment,
+                                  MODULE_DATA(sksl_gpu),
+                                  sharedModule);
+    });
 }
 
 const Module* ModuleLoader::loadFragmentModule(SkSL::Compiler* compiler) {
-    if (!fModuleLoader.fFragmentModule) {
-        const Module* gpuModule = this->loadGPUModule(compiler);
-        fModuleLoader.fFragmentModule = compile_and_shrink(compiler,
-                                                           ProgramKind::kFragment,
-                                                           MODULE_DATA(sksl_frag),
-                                                           gpuModule);
-    }
-    return fModuleLoader.fFragmentModule.get();
+    const Module* gpuModule = this->loadGPUModule(compiler);
+    return fModuleLoader.load(fModuleLoader.fFragmentModule, [&] {
+        return compile_and_shrink(compiler,
+                                  ProgramKind::kFragment,
+                                  MODULE_DATA(sksl_frag),
+                                  gpuModule);
+    });
 }
 
 const Module* ModuleLoader::loadVertexModule(SkSL::Compiler* compiler) {
-    if (!fModuleLoader.fVertexModule) {
-        const Module* gpuModule = this->loadGPUModule(compiler);
-        fModuleLoader.fVertexModule = compile_and_shrink(compiler,
-                                                         ProgramKind::kVertex,
-                                                         MODULE_DATA(sksl_vert),
-                                                         gpuModule);
-    }
-    return fModuleLoader.fVertexModule.get();
+    const Module* gpuModule = this->loadGPUModule(compiler);
+    return fModuleLoader.load(fModuleLoader.fVertexModule, [&] {
+        return compile_and_shrink(compiler,
+                                  ProgramKind::kVertex,
+                                  MODULE_DATA(sksl_vert),
+                                  gpuModule);
+    });
 }
 
 const Module* ModuleLoader::loadComputeModule(SkSL::Compiler* compiler) {
-    if (!fModuleLoader.fComputeModule) {
-        const Module* gpuModule = this->loadGPUModule(compiler);
-        fModuleLoader.fComputeModule = compile_and_shrink(compiler,
-                                                          ProgramKind::kCompute,
-                                                          MODULE_DATA(sksl_compute),
-                                                          gpuModule);
-    }
-    return fModuleLoader.fComputeModule.get();
+    const Module* gpuModule = this->loadGPUModule(compiler);
+    return fModuleLoader.load(fModuleLoader.fComputeModule, [&] {
+        return compile_and_shrink(compiler,
+                                  ProgramKind::kCompute,
+                                  MODULE_DATA(sksl_compute),
+                                  gpuModule);
+    });
 }
 
 const Module* ModuleLoader::loadGraphiteFragmentModule(SkSL::Compiler* compiler) {
-    if (!fModuleLoader.fGraphiteFragmentModule) {
-        const Module* fragmentModule = this->loadFragmentModule(compiler);
-        fModuleLoader.fGraphiteFragmentModule = compile_and_shrink(compiler,
-                                                                   ProgramKind::kGraphiteFragment,
-                                                                   MODULE_DATA(sksl_graphite_frag),
-                                                                   fragmentModule);
-    }
-    return fModuleLoader.fGraphiteFragmentModule.get();
+    const Module* fragmentModule = this->loadFragmentModule(compiler);
+    return fModuleLoader.load(fModuleLoader.fGraphiteFragmentModule, [&] {
+        return compile_and_shrink(compiler,
+                                  ProgramKind::kGraphiteFragment,
+                                  MODULE_DATA(sksl_graphite_frag),
+                                  fragmentModule);
+    });
 }
 
 const Module* ModuleLoader::loadGraphiteFragmentES2Module(SkSL::Compiler* compiler) {
-    if (!fModuleLoader.fGraphiteFragmentES2Module) {
-        const Module* fragmentModule = this->loadFragmentModule(compiler);
-        fModuleLoader.fGraphiteFragmentES2Module =
-                compile_and_shrink(compiler,
-                                   ProgramKind::kGraphiteFragmentES2,
-                                   MODULE_DATA(sksl_graphite_frag_es2),
-                                   fragmentModule);
-    }
-    return fModuleLoader.fGraphiteFragmentES2Module.get();
+    const Module* fragmentModule = this->loadFragmentModule(compiler);
+    return fModuleLoader.load(fModuleLoader.fGraphiteFragmentES2Module, [&] {
+        return compile_and_shrink(compiler,
+                                  ProgramKind::kGraphiteFragmentES2,
+                                  MODULE_DATA(sksl_graphite_frag_es2),
+                                  fragmentModule);
+    });
 }
 
 const Module* ModuleLoader::loadGraphiteVertexModule(SkSL::Compiler* compiler) {
-    if (!fModuleLoader.fGraphiteVertexModule) {
-        const Module* vertexModule = this->loadVertexModule(compiler);
-        fModuleLoader.fGraphiteVertexModule = compile_and_shrink(compiler,
-                                                                 ProgramKind::kGraphiteVertex,
-                                                                 MODULE_DATA(sksl_graphite_vert),
-                                                                 vertexModule);
-    }
-    return fModuleLoader.fGraphiteVertexModule.get();
+    const Module* vertexModule = this->loadVertexModule(compiler);
+    return fModuleLoader.load(fModuleLoader.fGraphiteVertexModule, [&] {
+        return compile_and_shrink(compiler,
+                                  ProgramKind::kGraphiteVertex,
+                                  MODULE_DATA(sksl_graphite_vert),
+                                  vertexModule);
+    });
 }
 
 const Module* ModuleLoader::loadGraphiteVertexES2Module(SkSL::Compiler* compiler) {
-    if (!fModuleLoader.fGraphiteVertexES2Module) {
-        const Module* vertexModule = this->loadVertexModule(compiler);
-        fModuleLoader.fGraphiteVertexES2Module =
-                compile_and_shrink(compiler,
-                                   ProgramKind::kGraphiteVertexES2,
-                                   MODULE_DATA(sksl_graphite_vert_es2),
-                                   vertexModule);
+    const Module* vertexModule = this->loadVertexModule(compiler);
+    return fModuleLoader.load(fModuleLoader.fGraphiteVertexES2Module, [&] {
+        return compile_and_shrink(compiler,
+                                  ProgramKind::kGraphiteVertexES2,
+                                  MODULE_DATA(sksl_graphite_vert_es2),
+                                  vertexModule);
+    });
+}
+
+#if !defined(SKSL_STANDALONE)
+void ModuleLoader::WarmUp(SkSpan<const ProgramKind> kinds, SkExecutor& executor) {
+    // Each task loads the module chain for one program kind with its own Compiler. Modules that
+    // are shared between chains are compiled by whichever task reaches them first; the others
+    // block on that module's mutex and then continue down their own (independent) branches.
+    SkTaskGroup taskGroup(executor);
+    for (ProgramKind kind : kinds) {
+        taskGroup.add([kind] {
+            SkSL::Compiler compiler;
+            compiler.moduleForProgramKind(kind);
+        });
     }
-    return fModuleLoader.fGraphiteVertexES2Module.get();
+    taskGroup.wait();
 }
+#endif
 
 void ModuleLoader::Impl::makeRootSymbolTable() {
     auto rootModule = std::make_unique<Module>();
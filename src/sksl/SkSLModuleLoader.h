@@ -8,14 +8,18 @@
 #ifndef SKSL_MODULELOADER
 #define SKSL_MODULELOADER
 
+#include "include/core/SkSpan.h"
 #include "src/sksl/SkSLBuiltinTypes.h"
 #include <memory>
 
+class SkExecutor;
+
 namespace SkSL {
 
 class Compiler;
 struct Module;
 class Type;
+enum class ProgramKind : int8_t;
 
 using BuiltinTypePtr = const std::unique_ptr<Type> BuiltinTypes::*;
 
@@ -32,10 +36,17 @@ public:
     ModuleLoader(ModuleLoader::Impl&);
     ~ModuleLoader();
 
-    // Acquires a mutex-locked reference to the singleton ModuleLoader. When the ModuleLoader is
-    // allowed to fall out of scope, the mutex will be released.
+    // Returns a reference to the singleton ModuleLoader. Each module is guarded by its own lock
+    // while it is being compiled, so multiple threads may load (different) modules concurrently,
+    // and a module which is already loaded is returned without any locking.
     static ModuleLoader Get();
 
+#if !defined(SKSL_STANDALONE)
+    // Loads the modules needed to compile each of `kinds`, compiling independent modules in
+    // parallel on `executor`. Returns once every requested module has been loaded.
+    static void WarmUp(SkSpan<const ProgramKind> kinds, SkExecutor& executor);
+#endif
+
     // The built-in types and root module are universal, immutable, and shared by every Compiler.
     // They are created when the ModuleLoader is instantiated and never change.
     const BuiltinTypes& builtinTypes();
@@ -60,7 +71,8 @@ public:
     // `vec4` are added; SkSL private types like `sampler2D` are replaced with an invalid type.
     void addPublicTypeAliases(const SkSL::Module* module);
 
-    // This unloads every module. It's useful primarily for benchmarking purposes.
+    // This unloads every module. It's useful primarily for benchmarking purposes; it must not be
+    // called while any other thread is compiling SkSL.
     void unloadModules();
 };
 
@@ -14,6 +14,7 @@
 #include "src/sksl/SkSLProgramKind.h"
 
 #include <optional>
+#include <string>
 #include <vector>
 
 namespace SkSL {
@@ -53,6 +54,9 @@ struct ProgramSettings {
     bool fRemoveDeadFunctions = true;
     // (Requires fOptimize = true) Removes variables which are never used.
     bool fRemoveDeadVariables = true;
+    // (Requires fOptimize = true) Runs the whole-program cleanup passes of the raster-pipeline
+    // code generator (dead-store elimination and copy fusion).
+    bool fOptimizeRPStores = true;
     // (Requires fOptimize = true) When greater than zero, enables the inliner. The threshold value
     // sets an upper limit on the acceptable amount of code growth from inlining.
     int fInlineThreshold = SkSL::kDefaultInlineThreshold;
@@ -77,6 +81,15 @@ struct ProgramSettings {
     // investigating memory corruption. (This controls behavior of the SkSL compiler, not the code
     // we generate.)
     bool fUseMemoryPool = true;
+    // Uniforms whose values are known ahead of time. References to these uniforms are replaced
+    // with constant expressions, which allows the optimizer to fold them away. The uniform
+    // declarations themselves are left in place, so the program's uniform layout is unchanged.
+    // Only scalar, vector and matrix uniforms can be specialized.
+    struct SpecializedUniform {
+        std::string fName;
+        std::vector<double> fValues;  // one value per slot
+    };
+    std::vector<SpecializedUniform> fSpecializedUniforms;
 };
 
 /**
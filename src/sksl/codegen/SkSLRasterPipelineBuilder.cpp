@@ -9,6 +9,7 @@
 #include <cstdint>
 #include <optional>
 
+#include "include/core/SkFourByteTag.h"
 #include "include/core/SkStream.h"
 #include "include/private/base/SkMalloc.h"
 #include "include/private/base/SkTFitsIn.h"
@@ -34,6 +35,7 @@
 #include <cstddef>
 #include <cstring>
 #include <iterator>
+#include <limits>
 #include <string>
 #include <string_view>
 #include <tuple>
@@ -1263,6 +1265,197 @@ void Builder::matrix_multiply(int leftColumns, int leftRows, int rightColumns, i
     this->appendInstruction(op, {}, leftColumns, leftRows, rightColumns, rightRows);
 }
 
+static bool is_control_flow_op(BuilderOp op) {
+    switch (op) {
+        case BuilderOp::label:
+        case BuilderOp::jump:
+        case BuilderOp::branch_if_all_lanes_active:
+        case BuilderOp::branch_if_any_lanes_active:
+        case BuilderOp::branch_if_no_lanes_active:
+        case BuilderOp::branch_if_no_active_lanes_eq:
+        case BuilderOp::branch_if_no_active_lanes_on_stack_top_equal:
+        case BuilderOp::invoke_shader:
+        case BuilderOp::invoke_color_filter:
+        case BuilderOp::invoke_blender:
+        case BuilderOp::invoke_to_linear_srgb:
+        case BuilderOp::invoke_from_linear_srgb:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+void Builder::eliminateDeadStores(int numValueSlots) {
+    // Walk the program backwards, tracking value slots which are known to be completely
+    // overwritten before they are next read. An unmasked store whose entire destination is already
+    // in that set can never be observed, so it is removed. Anything we don't model precisely
+    // (control flow, child invocations, and any other op which refers to a slot) conservatively
+    // resets the set.
+    TArray<bool> overwritten;
+    overwritten.push_back_n(numValueSlots, false);
+
+    auto inBounds = [&](Slot index, int count) {
+        return index >= 0 && count >= 0 && index + count <= numValueSlots;
+    };
+    auto markRead = [&](Slot index, int count) {
+        for (int i = 0; i < count; ++i) {
+            overwritten[index + i] = false;
+        }
+    };
+    auto markWritten = [&](Slot index, int count) {
+        for (int i = 0; i < count; ++i) {
+            overwritten[index + i] = true;
+        }
+    };
+    auto isDead = [&](Slot index, int count) {
+        for (int i = 0; i < count; ++i) {
+            if (!overwritten[index + i]) {
+                return false;
+            }
+        }
+        return count > 0;
+    };
+    auto forgetAll = [&] {
+        std::fill(overwritten.begin(), overwritten.end(), false);
+    };
+
+    TArray<bool> removed;
+    removed.push_back_n(fInstructions.size(), false);
+
+    for (int index = fInstructions.size() - 1; index >= 0; --index) {
+        const Instruction& inst = fInstructions[index];
+        switch (inst.fOp) {
+            case BuilderOp::copy_constant:
+            case BuilderOp::copy_immutable_unmasked:
+            case BuilderOp::copy_stack_to_slots_unmasked:
+                // Unmasked write of slots A..A+immA. (The source is not a value slot.)
+                if (!inBounds(inst.fSlotA, inst.fImmA)) {
+                    forgetAll();
+                } else if (isDead(inst.fSlotA, inst.fImmA)) {
+                    removed[index] = true;
+                } else {
+                    markWritten(inst.fSlotA, inst.fImmA);
+                }
+                break;
+
+            case BuilderOp::copy_uniform_to_slots_unmasked:
+                // Unmasked write of slots B..B+immA. (Slot A refers to a uniform.)
+                if (!inBounds(inst.fSlotB, inst.fImmA)) {
+                    forgetAll();
+                } else if (isDead(inst.fSlotB, inst.fImmA)) {
+                    removed[index] = true;
+                } else {
+                    markWritten(inst.fSlotB, inst.fImmA);
+                }
+                break;
+
+            case BuilderOp::copy_slot_unmasked:
+                // Unmasked write of slots A..A+immA, reading from slots B..B+immA.
+                if (!inBounds(inst.fSlotA, inst.fImmA) || !inBounds(inst.fSlotB, inst.fImmA)) {
+                    forgetAll();
+                } else if (isDead(inst.fSlotA, inst.fImmA)) {
+                    removed[index] = true;
+                } else {
+                    markWritten(inst.fSlotA, inst.fImmA);
+                    markRead(inst.fSlotB, inst.fImmA);
+                }
+                break;
+
+            case BuilderOp::copy_slot_masked:
+                // Masked stores preserve the inactive lanes, so they also read their destination.
+                if (!inBounds(inst.fSlotA, inst.fImmA) || !inBounds(inst.fSlotB, inst.fImmA)) {
+                    forgetAll();
+                } else {
+                    markRead(inst.fSlotA, inst.fImmA);
+                    markRead(inst.fSlotB, inst.fImmA);
+                }
+                break;
+
+            case BuilderOp::copy_stack_to_slots:
+                if (!inBounds(inst.fSlotA, inst.fImmA)) {
+                    forgetAll();
+                } else {
+                    markRead(inst.fSlotA, inst.fImmA);
+                }
+                break;
+
+            case BuilderOp::push_slots:
+                if (!inBounds(inst.fSlotA, inst.fImmA)) {
+                    forgetAll();
+                } else {
+                    markRead(inst.fSlotA, inst.fImmA);
+                }
+                break;
+
+            default:
+                if (is_control_flow_op(inst.fOp) || inst.fSlotA != NA || inst.fSlotB != NA) {
+                    forgetAll();
+                }
+                break;
+        }
+    }
+
+    int dst = 0;
+    for (int src = 0; src < fInstructions.size(); ++src) {
+        if (!removed[src]) {
+            fInstructions[dst++] = fInstructions[src];
+        }
+    }
+    fInstructions.resize(dst);
+}
+
+void Builder::fuseAdjacentCopies() {
+    // Removing stores can leave copies next to each other which the append-time peepholes would
+    // have merged, had they been adjacent at the time. Each merge saves at least one stage.
+    int dst = 0;
+    for (int src = 0; src < fInstructions.size(); ++src) {
+        const Instruction& inst = fInstructions[src];
+        if (dst > 0) {
+            Instruction& prev = fInstructions[dst - 1];
+            if (prev.fOp == inst.fOp) {
+                switch (inst.fOp) {
+                    case BuilderOp::copy_constant:
+                        if (prev.fImmB == inst.fImmB && prev.fSlotA + prev.fImmA == inst.fSlotA) {
+                            prev.fImmA += inst.fImmA;
+                            continue;
+                        }
+                        break;
+
+                    case BuilderOp::copy_immutable_unmasked:
+                        if (prev.fSlotA + prev.fImmA == inst.fSlotA &&
+                            prev.fSlotB + prev.fImmA == inst.fSlotB) {
+                            prev.fImmA += inst.fImmA;
+                            continue;
+                        }
+                        break;
+
+                    case BuilderOp::copy_slot_unmasked: {
+                        int combined = prev.fImmA + inst.fImmA;
+                        if (prev.fSlotA + prev.fImmA == inst.fSlotA &&
+                            prev.fSlotB + prev.fImmA == inst.fSlotB &&
+                            !slot_ranges_overlap({prev.fSlotB, combined},
+                                                 {prev.fSlotA, combined})) {
+                            prev.fImmA = combined;
+                            continue;
+                        }
+                        break;
+                    }
+                    default:
+                        break;
+                }
+            }
+        }
+        fInstructions[dst++] = inst;
+    }
+    fInstructions.resize(dst);
+}
+
+void Builder::optimize(int numValueSlots) {
+    this->eliminateDeadStores(numValueSlots);
+    this->fuseAdjacentCopies();
+}
+
 std::unique_ptr<Program> Builder::finish(int numValueSlots,
                                          int numUniformSlots,
                                          int numImmutableSlots,
@@ -3829,4 +4022,420 @@ void Program::dump(SkWStream* out, bool writeInstructionCount) const {
     Dumper(*this).dump(out, writeInstructionCount);
 }
 
+static constexpr uint32_t kSerializedProgramMagic = SkSetFourByteTag('S', 'K', 'R', 'P');
+
+// Any change to the op lists also changes the meaning of every serialized op index, so the number
+// of ops is folded into the version check.
+static constexpr uint32_t kSerializedOpCount = (uint32_t)BuilderOp::unsupported;
+
+bool Program::serialize(SkWStream* out) const {
+    // Trace ops refer to a DebugTracePriv which only exists in this process.
+    if (fDebugTrace) {
+        return false;
+    }
+    bool ok = out->write32(kSerializedProgramMagic) &&
+              out->write32(kSerializationVersion) &&
+              out->write32(kSerializedOpCount) &&
+              out->write32(fNumValueSlots) &&
+              out->write32(fNumUniformSlots) &&
+              out->write32(fNumImmutableSlots) &&
+              out->write32(fNumLabels) &&
+              out->write32(fInstructions.size());
+    for (const Instruction& inst : fInstructions) {
+        ok = ok && out->write32((uint32_t)inst.fOp) &&
+                   out->write32(inst.fSlotA) &&
+                   out->write32(inst.fSlotB) &&
+                   out->write32(inst.fImmA) &&
+                   out->write32(inst.fImmB) &&
+                   out->write32(inst.fImmC) &&
+                   out->write32(inst.fImmD) &&
+                   out->write32(inst.fStackID);
+    }
+    return ok;
+}
+
+// Label IDs and stack IDs size per-program bookkeeping arrays, so a corrupt count could request an
+// arbitrarily large allocation. Real programs stay far below this.
+static constexpr int kMaxSerializedIDs = 1 << 16;
+
+// A serialized program may come from storage we don't control, so before handing one to
+// makeStages, prove that every instruction only touches value, uniform and immutable slots, temp
+// stack entries, labels and children which will actually exist. The stack tracking mirrors
+// tempStackMaxDepths, and the operand checks mirror the pointer arithmetic in makeStages.
+static bool validate_instructions(SkSpan<const Instruction> instrs,
+                                  int numValueSlots,
+                                  int numUniformSlots,
+                                  int numImmutableSlots,
+                                  int numLabels,
+                                  int numChildren) {
+    int numStacks = 1;
+    for (const Instruction& inst : instrs) {
+        if (inst.fStackID < 0 || inst.fStackID >= kMaxSerializedIDs) {
+            return false;
+        }
+        numStacks = std::max(numStacks, inst.fStackID + 1);
+    }
+
+    TArray<int64_t> depth, largest;
+    depth.push_back_n(numStacks, (int64_t)0);
+    largest.push_back_n(numStacks, (int64_t)0);
+    TArray<bool> labelDefined;
+    labelDefined.push_back_n(numLabels, false);
+    TArray<int> branchTargets;
+
+    auto inRange = [](int64_t start, int64_t count, int64_t limit) {
+        return start >= 0 && count >= 0 && start + count <= limit;
+    };
+    auto values     = [&](int64_t s, int64_t n) { return inRange(s, n, numValueSlots); };
+    auto uniforms   = [&](int64_t s, int64_t n) { return inRange(s, n, numUniformSlots); };
+    auto immutables = [&](int64_t s, int64_t n) { return inRange(s, n, numImmutableSlots); };
+    auto stackHas = [&](int stackID, int64_t count) {
+        return stackID >= 0 && stackID < numStacks && count >= 0 && depth[stackID] >= count;
+    };
+    auto isLabel = [&](int labelID) { return labelID >= 0 && labelID < numLabels; };
+    auto branchTo = [&](int labelID) {
+        branchTargets.push_back(labelID);
+        return isLabel(labelID);
+    };
+    // Every packed swizzle component must index one of the `limit` slots it selects from.
+    auto nybblesBelow = [](int components, int numComponents, int64_t limit) {
+        return max_packed_nybble(components, std::max(numComponents, 0)) < limit;
+    };
+
+    for (const Instruction& inst : instrs) {
+        const int own = inst.fStackID;
+        const int64_t fixedRange = (int64_t)inst.fSlotB - inst.fSlotA;
+        bool ok;
+        switch (inst.fOp) {
+            case BuilderOp::label:
+                ok = isLabel(inst.fImmA) && !labelDefined[inst.fImmA];
+                if (ok) {
+                    labelDefined[inst.fImmA] = true;
+                }
+                break;
+
+            case BuilderOp::jump:
+            case BuilderOp::branch_if_any_lanes_active:
+            case BuilderOp::branch_if_no_lanes_active:
+            case BuilderOp::branch_if_all_lanes_active:
+                ok = branchTo(inst.fImmA);
+                break;
+
+            case BuilderOp::branch_if_no_active_lanes_on_stack_top_equal:
+                ok = branchTo(inst.fImmA) && stackHas(own, 1);
+                break;
+
+            case BuilderOp::init_lane_masks:
+            case BuilderOp::mask_off_loop_mask:
+            case BuilderOp::mask_off_return_mask:
+            case BuilderOp::push_condition_mask:
+            case BuilderOp::push_loop_mask:
+            case BuilderOp::push_return_mask:
+            case BuilderOp::push_src_rgba:
+            case BuilderOp::push_dst_rgba:
+            case BuilderOp::push_device_xy01:
+                ok = true;
+                break;
+
+            case BuilderOp::store_src_rg:
+                ok = values(inst.fSlotA, 2);
+                break;
+
+            case BuilderOp::store_src:
+            case BuilderOp::store_dst:
+            case BuilderOp::store_device_xy01:
+            case BuilderOp::load_src:
+            case BuilderOp::load_dst:
+                ok = values(inst.fSlotA, 4);
+                break;
+
+            case BuilderOp::reenable_loop_mask:
+                ok = values(inst.fSlotA, 1);
+                break;
+
+            case BuilderOp::store_immutable_value:
+                ok = immutables(inst.fSlotA, 1);
+                break;
+
+            case ALL_SINGLE_SLOT_UNARY_OP_CASES:
+            case ALL_MULTI_SLOT_UNARY_OP_CASES:
+                ok = stackHas(own, inst.fImmA);
+                break;
+
+            case ALL_IMMEDIATE_BINARY_OP_CASES:
+                ok = (inst.fSlotA == NA) ? stackHas(own, inst.fImmA)
+                                         : values(inst.fSlotA, inst.fImmA);
+                break;
+
+            case ALL_N_WAY_BINARY_OP_CASES:
+            case ALL_MULTI_SLOT_BINARY_OP_CASES:
+            case BuilderOp::select:
+                ok = stackHas(own, 2 * (int64_t)inst.fImmA);
+                break;
+
+            case ALL_N_WAY_TERNARY_OP_CASES:
+            case ALL_MULTI_SLOT_TERNARY_OP_CASES:
+                ok = stackHas(own, 3 * (int64_t)inst.fImmA);
+                break;
+
+            case BuilderOp::copy_slot_masked:
+            case BuilderOp::copy_slot_unmasked:
+                ok = values(inst.fSlotA, inst.fImmA) && values(inst.fSlotB, inst.fImmA);
+                break;
+
+            case BuilderOp::copy_immutable_unmasked:
+                ok = values(inst.fSlotA, inst.fImmA) && immutables(inst.fSlotB, inst.fImmA);
+                break;
+
+            case BuilderOp::refract_4_floats:
+                ok = stackHas(own, 9);
+                break;
+
+            case BuilderOp::inverse_mat2: ok = inst.fImmA == 4  && stackHas(own, 4);  break;
+            case BuilderOp::inverse_mat3: ok = inst.fImmA == 9  && stackHas(own, 9);  break;
+            case BuilderOp::inverse_mat4: ok = inst.fImmA == 16 && stackHas(own, 16); break;
+
+            case BuilderOp::dot_2_floats: ok = inst.fImmA == 2 && stackHas(own, 4); break;
+            case BuilderOp::dot_3_floats: ok = inst.fImmA == 3 && stackHas(own, 6); break;
+            case BuilderOp::dot_4_floats: ok = inst.fImmA == 4 && stackHas(own, 8); break;
+
+            case BuilderOp::swizzle_1:
+                ok = stackHas(own, inst.fImmA) && inst.fImmB >= 0 && inst.fImmB < inst.fImmA;
+                break;
+
+            case BuilderOp::swizzle_2:
+            case BuilderOp::swizzle_3:
+            case BuilderOp::swizzle_4: {
+                int numComponents = 2 + (int)inst.fOp - (int)BuilderOp::swizzle_2;
+                ok = stackHas(own, inst.fImmA) &&
+                     nybblesBelow(inst.fImmB, numComponents, inst.fImmA);
+                break;
+            }
+            case BuilderOp::shuffle:
+                // immA: slots consumed, immB: slots generated, immC/immD: packed offsets
+                ok = stackHas(own, inst.fImmA) && inst.fImmB >= 0 && inst.fImmB <= 16 &&
+                     nybblesBelow(inst.fImmC, std::min(inst.fImmB, 8), inst.fImmA) &&
+                     nybblesBelow(inst.fImmD, inst.fImmB - 8, inst.fImmA);
+                break;
+
+            case BuilderOp::matrix_multiply_2:
+            case BuilderOp::matrix_multiply_3:
+            case BuilderOp::matrix_multiply_4: {
+                // The stage is specialized on the left-matrix width, which must match the height
+                // of the right-matrix; the result is at most 4x4.
+                int width = 2 + (int)inst.fOp - (int)BuilderOp::matrix_multiply_2;
+                ok = inst.fImmA == width && inst.fImmD == width &&
+                     inst.fImmB >= 1 && inst.fImmB <= 4 &&
+                     inst.fImmC >= 1 && inst.fImmC <= 4 &&
+                     stackHas(own, inst.fImmB * inst.fImmC +
+                                   inst.fImmA * inst.fImmB +
+                                   inst.fImmC * inst.fImmD);
+                break;
+            }
+            case BuilderOp::exchange_src:
+            case BuilderOp::pop_src_rgba:
+            case BuilderOp::pop_dst_rgba:
+                ok = stackHas(own, 4);
+                break;
+
+            case BuilderOp::push_slots:
+                ok = values(inst.fSlotA, inst.fImmA);
+                break;
+
+            case BuilderOp::push_immutable:
+                ok = immutables(inst.fSlotA, inst.fImmA);
+                break;
+
+            case BuilderOp::push_uniform:
+                ok = uniforms(inst.fSlotA, inst.fImmA);
+                break;
+
+            case BuilderOp::copy_uniform_to_slots_unmasked:
+                ok = uniforms(inst.fSlotA, inst.fImmA) && values(inst.fSlotB, inst.fImmA);
+                break;
+
+            case BuilderOp::push_constant:
+            case BuilderOp::pad_stack:
+                ok = inst.fImmA >= 0;
+                break;
+
+            case BuilderOp::copy_constant:
+                ok = values(inst.fSlotA, inst.fImmA);
+                break;
+
+            case BuilderOp::discard_stack:
+                ok = stackHas(own, inst.fImmA);
+                break;
+
+            case BuilderOp::push_slots_indirect:
+            case BuilderOp::push_immutable_indirect:
+            case BuilderOp::push_uniform_indirect:
+            case BuilderOp::copy_stack_to_slots_indirect:
+                // SlotA..SlotB is the range the dynamic offset (on stack immB) is clamped into.
+                ok = inst.fImmA >= 0 && inst.fImmA <= fixedRange && stackHas(inst.fImmB, 1);
+                if (inst.fOp == BuilderOp::push_slots_indirect) {
+                    ok = ok && values(inst.fSlotA, fixedRange);
+                } else if (inst.fOp == BuilderOp::push_immutable_indirect) {
+                    ok = ok && immutables(inst.fSlotA, fixedRange);
+                } else if (inst.fOp == BuilderOp::push_uniform_indirect) {
+                    ok = ok && uniforms(inst.fSlotA, fixedRange);
+                } else {
+                    ok = ok && values(inst.fSlotA, fixedRange) && stackHas(own, inst.fImmA);
+                }
+                break;
+
+            case BuilderOp::pop_condition_mask:
+            case BuilderOp::pop_loop_mask:
+            case BuilderOp::pop_and_reenable_loop_mask:
+            case BuilderOp::pop_return_mask:
+            case BuilderOp::merge_loop_mask:
+                ok = stackHas(own, 1);
+                break;
+
+            case BuilderOp::merge_condition_mask:
+            case BuilderOp::merge_inv_condition_mask:
+            case BuilderOp::case_op:
+                ok = stackHas(own, 2);
+                break;
+
+            case BuilderOp::copy_stack_to_slots:
+            case BuilderOp::copy_stack_to_slots_unmasked:
+            case BuilderOp::push_clone:
+                // immA: number of slots, immB: offset from stack top
+                ok = inst.fImmA >= 0 && inst.fImmA <= inst.fImmB && stackHas(own, inst.fImmB);
+                if (inst.fOp != BuilderOp::push_clone) {
+                    ok = ok && values(inst.fSlotA, inst.fImmA);
+                }
+                break;
+
+            case BuilderOp::swizzle_copy_stack_to_slots:
+                // immA: number of components, immB: packed components, immC: offset from top
+                ok = inst.fImmA >= 1 && inst.fImmA <= 4 && inst.fImmA <= inst.fImmC &&
+                     stackHas(own, inst.fImmC) &&
+                     values(inst.fSlotA, max_packed_nybble(inst.fImmB, inst.fImmA) + 1);
+                break;
+
+            case BuilderOp::swizzle_copy_stack_to_slots_indirect:
+                // As above, plus immD: dynamic stack ID
+                ok = inst.fImmA >= 1 && inst.fImmA <= 4 && inst.fImmA <= inst.fImmC &&
+                     stackHas(own, inst.fImmC) && stackHas(inst.fImmD, 1) &&
+                     nybblesBelow(inst.fImmB, inst.fImmA, fixedRange) &&
+                     values(inst.fSlotA, fixedRange);
+                break;
+
+            case BuilderOp::push_clone_from_stack:
+            case BuilderOp::push_clone_indirect_from_stack:
+                // immA: number of slots, immB: other stack ID, immC: offset from its top,
+                // immD: dynamic stack ID (indirect only)
+                ok = inst.fImmA >= 0 && inst.fImmA <= inst.fImmC &&
+                     stackHas(inst.fImmB, inst.fImmC);
+                if (inst.fOp == BuilderOp::push_clone_indirect_from_stack) {
+                    ok = ok && stackHas(inst.fImmD, 1);
+                }
+                break;
+
+            case BuilderOp::continue_op:
+                ok = stackHas(inst.fImmA, 1);
+                break;
+
+            case BuilderOp::invoke_shader:
+            case BuilderOp::invoke_color_filter:
+            case BuilderOp::invoke_blender:
+                ok = inst.fImmA >= 0 && inst.fImmA < numChildren;
+                break;
+
+            case BuilderOp::invoke_to_linear_srgb:
+            case BuilderOp::invoke_from_linear_srgb:
+                ok = stackHas(inst.fImmA, 4);
+                break;
+
+            default:
+                // Trace ops, and native ops that the builder never emits, are not accepted.
+                ok = false;
+                break;
+        }
+        if (!ok) {
+            return false;
+        }
+
+        // Every operand has been range-checked, so the stack delta can't overflow.
+        depth[own] += stack_usage(inst);
+        if (depth[own] < 0) {
+            return false;
+        }
+        largest[own] = std::max(largest[own], depth[own]);
+    }
+
+    // The stacks must be balanced, and small enough that makeStages' offsets fit in an int.
+    const int64_t maxStackSlots = std::numeric_limits<int>::max() /
+                                  (4 * sizeof(float) * SkOpts::raster_pipeline_highp_stride);
+    int64_t totalStackSlots = 0;
+    for (int stackID = 0; stackID < numStacks; ++stackID) {
+        if (depth[stackID] != 0) {
+            return false;
+        }
+        totalStackSlots += largest[stackID];
+    }
+    if (totalStackSlots > maxStackSlots) {
+        return false;
+    }
+
+    // A branch to a label which never appears would be fixed up to a garbage offset.
+    for (int labelID : branchTargets) {
+        if (!labelDefined[labelID]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::unique_ptr<Program> Program::Deserialize(SkStream* in,
+                                              int numUniformSlots,
+                                              int numChildren) {
+    uint32_t magic, version, opCount;
+    if (!in->readU32(&magic) || magic != kSerializedProgramMagic ||
+        !in->readU32(&version) || version != kSerializationVersion ||
+        !in->readU32(&opCount) || opCount != kSerializedOpCount) {
+        return nullptr;
+    }
+
+    int32_t numValueSlots, blobUniformSlots, numImmutableSlots, numLabels, numInstructions;
+    if (!in->readS32(&numValueSlots) || numValueSlots < 0 ||
+        !in->readS32(&blobUniformSlots) || blobUniformSlots != numUniformSlots ||
+        !in->readS32(&numImmutableSlots) || numImmutableSlots < 0 ||
+        !in->readS32(&numLabels) || numLabels < 0 || numLabels > kMaxSerializedIDs ||
+        !in->readS32(&numInstructions) || numInstructions < 0) {
+        return nullptr;
+    }
+    // Every instruction occupies 32 bytes; reject counts that the stream can't possibly hold
+    // before reserving memory for them.
+    if (in->hasLength() &&
+        (size_t)numInstructions > (in->getLength() - in->getPosition()) / (8 * sizeof(int32_t))) {
+        return nullptr;
+    }
+
+    TArray<Instruction> instrs;
+    instrs.reserve_exact(numInstructions);
+    for (int index = 0; index < numInstructions; ++index) {
+        uint32_t op;
+        Instruction inst{BuilderOp::unsupported};
+        if (!in->readU32(&op) || op >= kSerializedOpCount ||
+            !in->readS32(&inst.fSlotA) || !in->readS32(&inst.fSlotB) ||
+            !in->readS32(&inst.fImmA) || !in->readS32(&inst.fImmB) ||
+            !in->readS32(&inst.fImmC) || !in->readS32(&inst.fImmD) ||
+            !in->readS32(&inst.fStackID)) {
+            return nullptr;
+        }
+        inst.fOp = (BuilderOp)op;
+        instrs.push_back(inst);
+    }
+    if (!validate_instructions(instrs, numValueSlots, numUniformSlots, numImmutableSlots,
+                               numLabels, numChildren)) {
+        return nullptr;
+    }
+
+    return std::make_unique<Program>(std::move(instrs), numValueSlots, numUniformSlots,
+                                     numImmutableSlots, numLabels, /*debugTrace=*/nullptr);
+}
+
 }  // namespace SkSL::RP
@@ -23,6 +23,7 @@
 
 class SkArenaAlloc;
 class SkRasterPipeline;
+class SkStream;
 class SkWStream;
 using SkRPOffset = uint32_t;
 
@@ -167,6 +168,22 @@ public:
 
     void dump(SkWStream* out, bool writeInstructionCount = false) const;
 
+    /**
+     * Writes the program's instruction stream to `out` in a compact binary form, which can be
+     * turned back into a Program via `Deserialize`. The encoding is only valid for a matching
+     * build of Skia; `kSerializationVersion` and the op count are embedded and checked on load.
+     * Programs which were built with a debug trace cannot be serialized.
+     *
+     * Deserialize treats its input as untrusted: every instruction's slot, stack, label and child
+     * operands are range-checked, and the program is rejected unless its uniform count matches
+     * `numUniformSlots` and it only invokes children below `numChildren`.
+     */
+    bool serialize(SkWStream* out) const;
+    static std::unique_ptr<Program> Deserialize(SkStream* in, int numUniformSlots, int numChildren);
+
+    /** Bump this whenever the Instruction encoding or the meaning of any BuilderOp changes. */
+    static constexpr uint32_t kSerializationVersion = 1;
+
     int numUniforms() const { return fNumUniformSlots; }
 
 private:
@@ -301,6 +318,14 @@ public:
                                     int numUniformSlots,
                                     int numImmutableSlots,
                                     DebugTracePriv* debugTrace = nullptr);
+
+    /**
+     * Runs whole-program cleanup passes which the append-time peephole optimizations can't see:
+     * unmasked stores that are overwritten before being read are removed, and copies which become
+     * adjacent as a result are fused together. This must not be used on programs that will be
+     * debug-traced, since every store needs to remain observable to the debugger.
+     */
+    void optimize(int numValueSlots);
     /**
      * Peels off a label ID for use in the program. Set the label's position in the program with
      * the `label` instruction. Actually branch to the target with an instruction like
@@ -723,6 +748,8 @@ private:
     Instruction* lastInstructionOnAnyStack(int fromBack = 0);
     void simplifyPopSlotsUnmasked(SlotRange* dst);
     bool simplifyImmediateUnmaskedOp();
+    void eliminateDeadStores(int numValueSlots);
+    void fuseAdjacentCopies();
 
     skia_private::TArray<Instruction> fInstructions;
     int fNumLabels = 0;
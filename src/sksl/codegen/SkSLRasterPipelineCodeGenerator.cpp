@@ -24,6 +24,7 @@
 #include "src/sksl/SkSLIntrinsicList.h"
 #include "src/sksl/SkSLOperator.h"
 #include "src/sksl/SkSLPosition.h"
+#include "src/sksl/SkSLProgramSettings.h"
 #include "src/sksl/analysis/SkSLProgramUsage.h"
 #include "src/sksl/codegen/SkSLRasterPipelineBuilder.h"
 #include "src/sksl/ir/SkSLBinaryExpression.h"
@@ -4078,6 +4079,12 @@ bool Generator::writeProgram(const FunctionDefinition& function) {
 }
 
 std::unique_ptr<RP::Program> Generator::finish() {
+    // Debug traces need to observe every store, and unoptimized programs are only requested for
+    // debugging purposes; everything else gets the whole-program cleanup passes.
+    const ProgramSettings& settings = fProgram.fConfig->fSettings;
+    if (!fDebugTrace && settings.fOptimize && settings.fOptimizeRPStores) {
+        fBuilder.optimize(fProgramSlots.slotCount());
+    }
     return fBuilder.finish(fProgramSlots.slotCount(),
                            fUniformSlots.slotCount(),
                            fImmutableSlots.slotCount(),
@@ -7,11 +7,16 @@
 
 #include "src/sksl/ir/SkSLSymbol.h"
 
+#include "src/sksl/SkSLContext.h"
+#include "src/sksl/SkSLProgramSettings.h"
+#include "src/sksl/ir/SkSLConstructorCompound.h"
 #include "src/sksl/ir/SkSLExpression.h"
 #include "src/sksl/ir/SkSLFieldAccess.h"
 #include "src/sksl/ir/SkSLFieldSymbol.h"
 #include "src/sksl/ir/SkSLFunctionDeclaration.h"
 #include "src/sksl/ir/SkSLFunctionReference.h"
+#include "src/sksl/ir/SkSLLiteral.h"
+#include "src/sksl/ir/SkSLModifierFlags.h"
 #include "src/sksl/ir/SkSLType.h"
 #include "src/sksl/ir/SkSLTypeReference.h"
 #include "src/sksl/ir/SkSLVariable.h"
@@ -21,6 +26,34 @@
 
 namespace SkSL {
 
+static std::unique_ptr<Expression> make_specialized_uniform(const Context& context,
+                                                            Position pos,
+                                                            const Variable& var) {
+    if (!context.fConfig || !var.modifierFlags().isUniform() ||
+        var.storage() != Variable::Storage::kGlobal) {
+        return nullptr;
+    }
+    const Type& type = var.type();
+    if (!(type.isScalar() || type.isVector() || type.isMatrix()) ||
+        !type.componentType().isNumber()) {
+        return nullptr;
+    }
+    for (const ProgramSettings::SpecializedUniform& uniform :
+         context.fConfig->fSettings.fSpecializedUniforms) {
+        if (uniform.fName != var.name()) {
+            continue;
+        }
+        if (uniform.fValues.size() != type.slotCount()) {
+            return nullptr;
+        }
+        if (type.isScalar()) {
+            return Literal::Make(pos, uniform.fValues[0], &type);
+        }
+        return ConstructorCompound::MakeFromConstants(context, pos, type, uniform.fValues.data());
+    }
+    return nullptr;
+}
+
 std::unique_ptr<Expression> Symbol::instantiate(const Context& context, Position pos) const {
     switch (this->kind()) {
         case Symbol::Kind::kFunctionDeclaration:
@@ -29,6 +62,10 @@ std::unique_ptr<Expression> Symbol::instantiate(const Context& context, Position
 
         case Symbol::Kind::kVariable: {
             const Variable* var = &this->as<Variable>();
+            // Uniforms with known values are replaced by constants so they can be folded away.
+            if (std::unique_ptr<Expression> value = make_specialized_uniform(context, pos, *var)) {
+                return value;
+            }
             // default to kRead_RefKind; this will be corrected later if the variable is written to
             return VariableReference::Make(pos, var, VariableReference::RefKind::kRead);
         }
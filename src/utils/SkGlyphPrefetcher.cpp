@@ -0,0 +1,111 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/utils/SkGlyphPrefetcher.h"
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkTextBlob.h"
+#include "include/utils/SkNoDrawCanvas.h"
+#include "src/core/SkGlyphRunPainter.h"
+#include "src/core/SkTaskGroup.h"
+#include "src/text/GlyphRun.h"
+
+#include <utility>
+
+namespace {
+// Follows the draws the way a raster canvas would, prefetching the glyphs of the text instead of
+// drawing it.
+class PrefetchCanvas final : public SkNoDrawCanvas {
+public:
+    PrefetchCanvas(const SkImageInfo& dstInfo, const SkSurfaceProps& props)
+            : SkNoDrawCanvas(dstInfo.width(), dstInfo.height())
+            , fPainter(props, dstInfo.colorType(), dstInfo.colorSpace()) {}
+
+protected:
+    void onDrawTextBlob(const SkTextBlob* blob, SkScalar x, SkScalar y,
+                        const SkPaint& paint) override {
+        this->SkCanvas::onDrawTextBlob(blob, x, y, paint);
+    }
+
+    void onDrawGlyphRunList(const sktext::GlyphRunList& glyphRunList,
+                            const SkPaint& paint) override {
+        const SkRect bounds = glyphRunList.sourceBoundsWithOrigin();
+        SkRect storage;
+        if (paint.canComputeFastBounds() &&
+            this->quickReject(paint.computeFastBounds(bounds, &storage))) {
+            return;
+        }
+        fPainter.prefetchForBitmapDevice(glyphRunList, paint, this->getLocalToDeviceAs3x3());
+    }
+
+    void onDrawPicture(const SkPicture* picture, const SkMatrix* matrix,
+                       const SkPaint* paint) override {
+        this->SkCanvas::onDrawPicture(picture, matrix, paint);
+    }
+
+    void onDrawDrawable(SkDrawable* drawable, const SkMatrix* matrix) override {
+        this->SkCanvas::onDrawDrawable(drawable, matrix);
+    }
+
+private:
+    const SkGlyphRunListPainterCPU fPainter;
+};
+}  // namespace
+
+SkGlyphPrefetcher::SkGlyphPrefetcher(const SkImageInfo& dstInfo,
+                                     const SkSurfaceProps& props,
+                                     SkExecutor* executor)
+        : fDstInfo{dstInfo}
+        , fProps{props}
+        , fTaskGroup{executor ? std::make_unique<SkTaskGroup>(*executor) : nullptr} {}
+
+SkGlyphPrefetcher::~SkGlyphPrefetcher() {
+    this->wait();
+}
+
+void SkGlyphPrefetcher::prefetch(sk_sp<SkTextBlob> blob,
+                                 SkPoint origin,
+                                 const SkPaint& paint,
+                                 const SkMatrix& ctm) {
+    if (!blob) {
+        return;
+    }
+    auto work = [info = fDstInfo, props = fProps, blob = std::move(blob), origin, paint, ctm]() {
+        PrefetchCanvas canvas{info, props};
+        canvas.setMatrix(ctm);
+        canvas.drawTextBlob(blob, origin.x(), origin.y(), paint);
+    };
+    if (fTaskGroup) {
+        fTaskGroup->add(std::move(work));
+    } else {
+        work();
+    }
+}
+
+void SkGlyphPrefetcher::prefetch(sk_sp<SkPicture> picture, const SkMatrix& ctm) {
+    if (!picture) {
+        return;
+    }
+    auto work = [info = fDstInfo, props = fProps, picture = std::move(picture), ctm]() {
+        PrefetchCanvas canvas{info, props};
+        canvas.setMatrix(ctm);
+        canvas.drawPicture(picture);
+    };
+    if (fTaskGroup) {
+        fTaskGroup->add(std::move(work));
+    } else {
+        work();
+    }
+}
+
+void SkGlyphPrefetcher::wait() {
+    if (fTaskGroup) {
+        fTaskGroup->wait();
+    }
+}
@@ -12,13 +12,16 @@
 #include "include/core/SkStream.h"
 #include "include/core/SkString.h"
 #include "include/private/base/SkDebug.h"
+#include "include/private/base/SkAlign.h"
 #include "include/private/base/SkMalloc.h"
 #include "include/private/base/SkTo.h"
 #include "include/utils/SkParse.h"
 #include "src/base/SkArenaAlloc.h"
 #include "src/base/SkUTF.h"
+#include "src/core/SkChecksum.h"
 
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 #include <limits>
@@ -947,6 +950,11 @@ static constexpr size_t kMinChunkSize = 4096;
 
 DOM::DOM(const char* data, size_t size)
     : fAlloc(kMinChunkSize) {
+    if (IsBinary(data, size)) {
+        this->loadBinary(data, size);
+        return;
+    }
+
     DOMParser parser(fAlloc);
 
     fRoot = parser.parse(data, size);
@@ -956,4 +964,254 @@ void DOM::write(SkWStream* stream) const {
     Write(fRoot, stream);
 }
 
+// Binary images hold a header followed by the payload: the external storage of all strings,
+// arrays and objects, laid out in depth-first (pre-order) traversal order, at 8-byte aligned
+// offsets.  The values of the root, arrays and objects hold payload offsets in place of
+// pointers.
+//
+// Loading copies the payload into the arena and walks the values in the same order to turn
+// the offsets back into pointers.  The walk requires each payload to start where the previous
+// one ended, so a valid image has no overlapping or shared payloads.
+namespace {
+
+struct BinaryHeader {
+    // The leading 0x89 can't start a JSON document.
+    inline static constexpr uint8_t kSignature[4] = { 0x89, 'S', 'K', 'J' };
+    inline static constexpr uint32_t kVersion = 1;
+
+    uint8_t  fSignature[4];
+    uint32_t fVersion;
+    uint32_t fPointerSize;
+    uint32_t fPayloadChecksum;
+    uint64_t fPayloadSize;
+    uint64_t fRoot;
+};
+static_assert(sizeof(BinaryHeader) == 32, "");
+static_assert(sizeof(Value) == sizeof(BinaryHeader::fRoot), "");
+
+// Much deeper than any real document; bounds the recursion over corrupt images.
+static constexpr int kMaxBinaryDepth = 512;
+
+// Access to the external storage of values, for writing and relocating binary images.
+class BinaryValue final : public Value {
+public:
+    static BinaryValue& From(Value& v) { return *reinterpret_cast<BinaryValue*>(&v); }
+    static const BinaryValue& From(const Value& v) {
+        return *reinterpret_cast<const BinaryValue*>(&v);
+    }
+
+    bool hasPayload() const {
+        const auto tag = this->getTag();
+        return tag == Tag::kString || tag == Tag::kArray || tag == Tag::kObject;
+    }
+
+    // Payloads are [size_t n] followed by n elements, and a \0 terminator for strings.
+    size_t elementSize() const {
+        return this->getTag() == Tag::kString ? sizeof(char)
+             : this->getTag() == Tag::kArray  ? sizeof(Value)
+                                              : sizeof(Member);
+    }
+
+    size_t extraSize() const { return this->getTag() == Tag::kString ? 1 : 0; }
+
+    const void* payload() const { return this->ptr<void>(); }
+    uintptr_t payloadBits() const { return reinterpret_cast<uintptr_t>(this->payload()); }
+    size_t count() const { return *this->ptr<size_t>(); }
+
+    void setPayload(uintptr_t p) {
+        this->init_tagged_pointer(this->getTag(), reinterpret_cast<void*>(p));
+    }
+
+    // Checks the inline payloads that can be invalid: bools, and short string terminators.
+    bool hasValidInlinePayload() const {
+        switch (this->getTag()) {
+        case Tag::kBool:
+            return *this->cast<uint8_t>() <= 1;
+        case Tag::kShortString:
+            return memchr(this->cast<char>(), '\0', sizeof(Value) - 1) != nullptr;
+        default:
+            return true;
+        }
+    }
+
+    bool isArray() const { return this->getTag() == Tag::kArray; }
+    bool isObject() const { return this->getTag() == Tag::kObject; }
+};
+
+class BinaryWriter {
+public:
+    // Appends the payload of v (and of its descendants) and returns v with the payload offset in
+    // place of its pointer.
+    bool write(const Value& v, Value* result, int depth) {
+        *result = v;
+        const auto& bv = BinaryValue::From(v);
+        if (!bv.hasPayload()) {
+            return true;
+        }
+        if (depth > kMaxBinaryDepth) {
+            return false;
+        }
+
+        const size_t count = bv.count();
+        const size_t size = sizeof(size_t) + count * bv.elementSize() + bv.extraSize();
+        const size_t offset = fPayload.size();
+        fPayload.resize(offset + SkAlign8(size), 0);
+        memcpy(fPayload.data() + offset, bv.payload(), size);
+        BinaryValue::From(*result).setPayload(offset);
+
+        // The children's payloads follow their parent's, in order.
+        const size_t elements = offset + sizeof(size_t);
+        if (bv.isArray()) {
+            const auto& array = v.as<ArrayValue>();
+            for (size_t i = 0; i < count; ++i) {
+                Value child;
+                if (!this->write(array[i], &child, depth + 1)) {
+                    return false;
+                }
+                memcpy(fPayload.data() + elements + i * sizeof(Value), &child, sizeof(Value));
+            }
+        } else if (bv.isObject()) {
+            const auto* members = v.as<ObjectValue>().begin();
+            for (size_t i = 0; i < count; ++i) {
+                Value key, value;
+                if (!this->write(members[i].fKey, &key, depth + 1) ||
+                    !this->write(members[i].fValue, &value, depth + 1)) {
+                    return false;
+                }
+                char* member = fPayload.data() + elements + i * sizeof(Member);
+                memcpy(member + offsetof(Member, fKey), &key, sizeof(Value));
+                memcpy(member + offsetof(Member, fValue), &value, sizeof(Value));
+            }
+        }
+        return true;
+    }
+
+    const std::vector<char>& payload() const { return fPayload; }
+
+private:
+    std::vector<char> fPayload;
+};
+
+class BinaryLoader {
+public:
+    BinaryLoader(char* payload, size_t size) : fPayload(payload), fSize(size) {}
+
+    // Replaces the payload offset of v (and of its descendants) with a pointer.
+    bool relocate(Value& v, int depth) {
+        auto& bv = BinaryValue::From(v);
+        if (!bv.hasPayload()) {
+            return bv.hasValidInlinePayload();
+        }
+        if (depth > kMaxBinaryDepth || bv.payloadBits() != fNext ||
+            fSize - fNext < sizeof(size_t)) {
+            return false;
+        }
+
+        char* payload = fPayload + fNext;
+        size_t count;
+        memcpy(&count, payload, sizeof(size_t));
+        const size_t available = fSize - fNext - sizeof(size_t);
+        if (available < bv.extraSize() ||
+            count > (available - bv.extraSize()) / bv.elementSize()) {
+            return false;
+        }
+        const size_t size = sizeof(size_t) + count * bv.elementSize() + bv.extraSize();
+        if (bv.extraSize() && payload[size - 1] != '\0') {
+            return false;
+        }
+        // The padding must fit too, or fNext would move past the end of the payload.
+        if (SkAlign8(size) > fSize - fNext) {
+            return false;
+        }
+        fNext += SkAlign8(size);
+        bv.setPayload(reinterpret_cast<uintptr_t>(payload));
+
+        if (bv.isArray() || bv.isObject()) {
+            auto* children = reinterpret_cast<Value*>(payload + sizeof(size_t));
+            const size_t childCount = bv.isArray() ? count : count * 2;
+            for (size_t i = 0; i < childCount; ++i) {
+                if (!this->relocate(children[i], depth + 1)) {
+                    return false;
+                }
+            }
+            // Object keys must be strings.
+            for (size_t i = 0; bv.isObject() && i < count; ++i) {
+                if (!children[2 * i].is<StringValue>()) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    bool done() const { return fNext == fSize; }
+
+private:
+    char* const  fPayload;
+    const size_t fSize;
+    size_t       fNext = 0;
+};
+
+} // namespace
+
+bool DOM::IsBinary(const void* data, size_t size) {
+    return data && size >= sizeof(BinaryHeader::kSignature) &&
+           !memcmp(data, BinaryHeader::kSignature, sizeof(BinaryHeader::kSignature));
+}
+
+bool DOM::writeBinary(SkWStream* stream) const {
+    BinaryWriter writer;
+    Value root;
+    if (!writer.write(fRoot, &root, 0)) {
+        return false;
+    }
+
+    const auto& payload = writer.payload();
+    BinaryHeader header;
+    memcpy(header.fSignature, BinaryHeader::kSignature, sizeof(header.fSignature));
+    header.fVersion         = BinaryHeader::kVersion;
+    header.fPointerSize     = sizeof(void*);
+    header.fPayloadChecksum = SkChecksum::Hash32(payload.data(), payload.size());
+    header.fPayloadSize     = payload.size();
+    memcpy(&header.fRoot, &root, sizeof(root));
+
+    return stream->write(&header, sizeof(header)) &&
+           stream->write(payload.data(), payload.size());
+}
+
+void DOM::loadBinary(const void* data, size_t size) {
+    fRoot = NullValue();
+
+    BinaryHeader header;
+    if (size < sizeof(header)) {
+        return;
+    }
+    memcpy(&header, data, sizeof(header));
+    if (header.fVersion     != BinaryHeader::kVersion ||
+        header.fPointerSize != sizeof(void*) ||
+        header.fPayloadSize != size - sizeof(header) ||
+        !SkIsAlign8(header.fPayloadSize)) {
+        return;
+    }
+
+    const auto* src = static_cast<const char*>(data) + sizeof(header);
+    const size_t payloadSize = SkToSizeT(header.fPayloadSize);
+    if (SkChecksum::Hash32(src, payloadSize) != header.fPayloadChecksum) {
+        return;
+    }
+
+    // The payload is copied so it can be relocated in place.
+    char* payload = payloadSize
+            ? static_cast<char*>(fAlloc.makeBytesAlignedTo(payloadSize, kRecAlign))
+            : nullptr;
+    sk_careful_memcpy(payload, src, payloadSize);
+
+    Value root;
+    memcpy(&root, &header.fRoot, sizeof(root));
+    BinaryLoader loader(payload, payloadSize);
+    if (loader.relocate(root, 0) && loader.done()) {
+        fRoot = root;
+    }
+}
+
 } // namespace skjson
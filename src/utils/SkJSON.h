@@ -357,13 +357,35 @@ private:
 
 class DOM final : public SkNoncopyable {
 public:
+    /**
+     * Parses the data as JSON, or loads it as a binary image if it starts with the binary image
+     * signature (see writeBinary()).
+     */
     DOM(const char*, size_t);
 
     const Value& root() const { return fRoot; }
 
     void write(SkWStream*) const;
 
+    /**
+     *  Writes a binary image of the DOM, which the constructor loads without parsing: the values
+     *  are stored in their in-memory layout, with payload offsets in place of pointers.
+     *
+     *  The image is only valid for builds with the same pointer size; other builds load it as
+     *  a null root, like a corrupt image.
+     *
+     *  @return false if the DOM is too deeply nested to be written.
+     */
+    bool writeBinary(SkWStream*) const;
+
+    /**
+     * @return True if the data starts with the binary image signature.
+     */
+    static bool IsBinary(const void* data, size_t size);
+
 private:
+    void loadBinary(const void* data, size_t size);
+
     SkArenaAlloc fAlloc;
     Value        fRoot;
 };
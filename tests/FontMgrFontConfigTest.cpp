@@ -216,3 +216,32 @@ UNIX_ONLY_TEST(FontMgrFontConfig_AllBold, reporter) {
     bool success = bitmap_compare(bitmapData, bitmapMatch);
     REPORTER_ASSERT(reporter, success);
 }
+
+DEF_TEST(FontMgrFontConfig_FallbackCache, reporter) {
+    FcConfig* config = build_fontconfig_with_fontfile("/fonts/Distortable.ttf");
+    sk_sp<SkFontMgr> fontMgr(SkFontMgr_New_FontConfig(config));
+
+    const char* bcp47[] = { "en-US" };
+    sk_sp<SkTypeface> first = fontMgr->matchFamilyStyleCharacter(
+            nullptr, SkFontStyle(), bcp47, std::size(bcp47), 'a');
+    if (!first) {
+        ERRORF(reporter, "Could not find fallback typeface. FcVersion: %d", FcGetVersion());
+        return;
+    }
+    // A character no font has is cached as a miss.
+    REPORTER_ASSERT(reporter, !fontMgr->matchFamilyStyleCharacter(
+            nullptr, SkFontStyle(), bcp47, std::size(bcp47), 0x10FFFD));
+
+    // Remove the only font from the config, so that any lookup which reaches FcFontMatch fails.
+    FcConfigAppFontClear(config);
+
+    // The languages are part of the key, so this is not a cache hit.
+    REPORTER_ASSERT(reporter, !fontMgr->matchFamilyStyleCharacter(
+            nullptr, SkFontStyle(), nullptr, 0, 'a'));
+
+    // These are cache hits, so they don't see that the font is gone.
+    REPORTER_ASSERT(reporter, fontMgr->matchFamilyStyleCharacter(
+            nullptr, SkFontStyle(), bcp47, std::size(bcp47), 'a') == first);
+    REPORTER_ASSERT(reporter, !fontMgr->matchFamilyStyleCharacter(
+            nullptr, SkFontStyle(), bcp47, std::size(bcp47), 0x10FFFD));
+}
@@ -0,0 +1,102 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/private/SkColorData.h"
+#include "include/private/base/SkTo.h"
+#include "src/base/SkRandom.h"
+#include "src/core/SkGlyphMask.h"
+#include "tests/Test.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+// Straightforward scalar versions of the SkOpts row functions to check them against.
+
+static constexpr unsigned kLCDCoefficients[3][12] = {
+    { 0x03, 0x0b, 0x1c, 0x33,  0x40, 0x39, 0x24, 0x10,  0x05, 0x01, 0x00, 0x00, },
+    { 0x00, 0x02, 0x08, 0x16,  0x2b, 0x3d, 0x3d, 0x2b,  0x16, 0x08, 0x02, 0x00, },
+    { 0x00, 0x00, 0x01, 0x05,  0x10, 0x24, 0x39, 0x40,  0x33, 0x1c, 0x0b, 0x03, },
+};
+
+static void lcd_filter_ref(const uint8_t samples[], int count,
+                           uint8_t r[], uint8_t g[], uint8_t b[]) {
+    uint8_t* out[3] = {r, g, b};
+    for (int i = 0; i < count; ++i) {
+        for (int c = 0; c < 3; ++c) {
+            unsigned sum = 0;
+            for (int tap = 0; tap < 12; ++tap) {
+                sum += samples[4 * i + tap] * kLCDCoefficients[c][tap];
+            }
+            out[c][i] = std::min(sum >> 8, 255u);
+        }
+    }
+}
+
+static void a8_to_a1_ref(uint8_t dst[], const uint8_t src[], int count, uint8_t cutoff) {
+    memset(dst, 0, (count + 7) / 8);
+    for (int x = 0; x < count; ++x) {
+        if (src[x] >= cutoff) {
+            dst[x >> 3] |= 0x80 >> (x & 7);
+        }
+    }
+}
+
+static constexpr int kMaxCount = 67;
+
+DEF_TEST(GlyphMask_LCDFilter, r) {
+    SkRandom rand;
+    uint8_t samples[4 * kMaxCount + 8];
+    for (uint8_t& s : samples) {
+        // Saturated coverage is common in glyphs, and is what makes the filter clamp.
+        s = rand.nextBool() ? 0xFF : SkToU8(rand.nextULessThan(256));
+    }
+    for (int count = 0; count <= kMaxCount; ++count) {
+        uint8_t rgb[3][kMaxCount], expected[3][kMaxCount];
+        SkOpts::lcd_filter_row(samples, count, rgb[0], rgb[1], rgb[2]);
+        lcd_filter_ref(samples, count, expected[0], expected[1], expected[2]);
+        for (int c = 0; c < 3; ++c) {
+            REPORTER_ASSERT(r, memcmp(rgb[c], expected[c], count) == 0, "count %d", count);
+        }
+    }
+}
+
+DEF_TEST(GlyphMask_A1RoundTrip, r) {
+    SkRandom rand;
+    uint8_t a8[kMaxCount];
+    for (uint8_t& a : a8) {
+        a = SkToU8(rand.nextULessThan(256));
+    }
+    for (int count = 0; count <= kMaxCount; ++count) {
+        for (uint8_t cutoff : {0x40, 0x80}) {
+            uint8_t a1[(kMaxCount + 7) / 8], expected[(kMaxCount + 7) / 8];
+            SkOpts::a8_to_a1_row(a1, a8, count, cutoff);
+            a8_to_a1_ref(expected, a8, count, cutoff);
+            REPORTER_ASSERT(r, memcmp(a1, expected, (count + 7) / 8) == 0,
+                            "count %d cutoff %d", count, cutoff);
+
+            uint8_t expanded[kMaxCount];
+            SkOpts::a1_to_a8_row(expanded, a1, count);
+            for (int x = 0; x < count; ++x) {
+                REPORTER_ASSERT(r, expanded[x] == (a8[x] >= cutoff ? 0xFF : 0x00),
+                                "count %d x %d", count, x);
+            }
+        }
+    }
+}
+
+DEF_TEST(GlyphMask_A8ToLCD16, r) {
+    uint8_t a8[256];
+    for (int i = 0; i < 256; ++i) {
+        a8[i] = SkToU8(i);
+    }
+    uint16_t lcd[256];
+    SkOpts::a8_to_lcd16_row(lcd, a8, 256);
+    for (int i = 0; i < 256; ++i) {
+        REPORTER_ASSERT(r, lcd[i] == SkPack888ToRGB16(i, i, i), "%d", i);
+    }
+}
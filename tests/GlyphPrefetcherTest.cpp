@@ -0,0 +1,91 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkFont.h"
+#include "include/core/SkFontStyle.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkMatrix.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkPictureRecorder.h"
+#include "include/core/SkSurfaceProps.h"
+#include "include/core/SkTextBlob.h"
+#include "include/utils/SkGlyphPrefetcher.h"
+#include "src/core/SkGlyph.h"
+#include "src/core/SkScalerContext.h"
+#include "src/core/SkStrikeSpec.h"
+#include "tests/Test.h"
+#include "tools/fonts/FontToolUtils.h"
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+static constexpr char kText[] = "Prefetched";
+
+// Each case uses its own font size, so the strikes it checks are not shared with other tests.
+static SkFont make_font(SkScalar size) {
+    SkFont font{ToolUtils::CreatePortableTypeface("serif", SkFontStyle()), size};
+    font.setEdging(SkFont::Edging::kAntiAlias);
+    return font;
+}
+
+// Counts the glyphs of kText that have an image in the strike a raster canvas with the given
+// matrix draws them from, without rasterizing any.
+static int count_glyphs_with_images(const SkFont& font, const SkMatrix& matrix) {
+    std::vector<SkGlyphID> glyphIDs(font.countText(kText, strlen(kText), SkTextEncoding::kUTF8));
+    font.textToGlyphs(kText, strlen(kText), SkTextEncoding::kUTF8,
+                      glyphIDs.data(), glyphIDs.size());
+
+    SkStrikeSpec strikeSpec = SkStrikeSpec::MakeMask(
+            font, SkPaint{}, SkSurfaceProps{}, SkScalerContextFlags::kFakeGammaAndBoostContrast,
+            matrix);
+    SkBulkGlyphMetrics metrics{strikeSpec};
+    int count = 0;
+    for (const SkGlyph* glyph : metrics.glyphs(glyphIDs)) {
+        count += glyph->setImageHasBeenCalled() && glyph->image() != nullptr ? 1 : 0;
+    }
+    return count;
+}
+
+DEF_TEST(GlyphPrefetcher_TextBlob, reporter) {
+    const SkFont font = make_font(31.25f);
+    const SkMatrix ctm = SkMatrix::Translate(10, 40);
+    REPORTER_ASSERT(reporter, count_glyphs_with_images(font, ctm) == 0);
+
+    SkGlyphPrefetcher prefetcher{SkImageInfo::MakeN32Premul(256, 256), SkSurfaceProps{},
+                                 /*executor=*/nullptr};
+    prefetcher.prefetch(SkTextBlob::MakeFromString(kText, font), {0, 0}, SkPaint{}, ctm);
+    REPORTER_ASSERT(reporter, count_glyphs_with_images(font, ctm) > 0);
+}
+
+DEF_TEST(GlyphPrefetcher_Picture, reporter) {
+    const SkFont font = make_font(29.75f);
+    const SkMatrix ctm = SkMatrix::Translate(20, 50);
+
+    SkPictureRecorder recorder;
+    SkCanvas* recordingCanvas = recorder.beginRecording(256, 256);
+    recordingCanvas->translate(20, 50);
+    recordingCanvas->drawTextBlob(SkTextBlob::MakeFromString(kText, font), 0, 0, SkPaint{});
+    // Text outside of the destination is not prefetched.
+    const SkFont offscreenFont = make_font(27.5f);
+    recordingCanvas->drawTextBlob(
+            SkTextBlob::MakeFromString(kText, offscreenFont), 1000, 0, SkPaint{});
+    sk_sp<SkPicture> picture = recorder.finishRecordingAsPicture();
+    REPORTER_ASSERT(reporter, count_glyphs_with_images(font, ctm) == 0);
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(2);
+    SkGlyphPrefetcher prefetcher{SkImageInfo::MakeN32Premul(256, 256), SkSurfaceProps{},
+                                 executor.get()};
+    prefetcher.prefetch(picture);
+    prefetcher.wait();
+    REPORTER_ASSERT(reporter, count_glyphs_with_images(font, ctm) > 0);
+    REPORTER_ASSERT(reporter,
+                    count_glyphs_with_images(offscreenFont, SkMatrix::Translate(1020, 50)) == 0);
+}
@@ -11,6 +11,7 @@
 #include "include/core/SkStream.h"
 #include "include/core/SkString.h"
 #include "src/base/SkArenaAlloc.h"
+#include "src/core/SkChecksum.h"
 #include "src/utils/SkJSON.h"
 #include "tests/Test.h"
 
@@ -535,3 +536,59 @@ DEF_TEST(JSON_Writable, r) {
     REPORTER_ASSERT(r, root.toString() ==
         SkString(R"({"null":42,"num":"foo","new":true,"newobj":{"newprop":-1}})"));
 }
+
+DEF_TEST(JSON_Binary, r) {
+    static constexpr char json[] =
+        R"({"null": null, "bools": [true, false], "num": -1.5, "int": 42,)"
+        R"( "short": "abc", "long": "a string too long to be stored inline",)"
+        R"( "nested": {"empty": {}, "arr": [[], [1, {"a": "b"}]]}})";
+    const DOM dom(json, strlen(json));
+    REPORTER_ASSERT(r, !DOM::IsBinary(json, strlen(json)));
+
+    SkDynamicMemoryWStream stream;
+    REPORTER_ASSERT(r, dom.writeBinary(&stream));
+    const sk_sp<SkData> binary = stream.detachAsData();
+    REPORTER_ASSERT(r, DOM::IsBinary(binary->data(), binary->size()));
+
+    const DOM loaded(static_cast<const char*>(binary->data()), binary->size());
+    REPORTER_ASSERT(r, loaded.root().is<ObjectValue>());
+    REPORTER_ASSERT(r, loaded.root().toString() == dom.root().toString());
+    const ArrayValue& arr = loaded.root()["nested"]["arr"].as<ArrayValue>();
+    REPORTER_ASSERT(r, arr[1].as<ArrayValue>()[1]["a"].as<StringValue>().str() == "b");
+
+    // Truncated and corrupt images load as a null root.
+    for (size_t size = 0; size < binary->size(); size += 7) {
+        const DOM truncated(static_cast<const char*>(binary->data()), size);
+        REPORTER_ASSERT(r, truncated.root().is<NullValue>());
+    }
+    sk_sp<SkData> corrupt = SkData::MakeWithCopy(binary->data(), binary->size());
+    static_cast<char*>(corrupt->writable_data())[binary->size() - 1] ^= 1;
+    const DOM corrupted(static_cast<const char*>(corrupt->data()), corrupt->size());
+    REPORTER_ASSERT(r, corrupted.root().is<NullValue>());
+
+    // An image whose payload ends part way through the padding of its last string, with a
+    // matching size and checksum, must not walk past the end of the payload. The second string's
+    // offset points just past the padded first string.
+    static constexpr char twoStrings[] =
+        R"(["a string of exactly forty characters....", "and another string after it"])";
+    const DOM strings(twoStrings, strlen(twoStrings));
+    SkDynamicMemoryWStream stringsStream;
+    REPORTER_ASSERT(r, strings.writeBinary(&stringsStream));
+    const sk_sp<SkData> stringsBinary = stringsStream.detachAsData();
+
+    static constexpr size_t kHeaderSize = 32,
+                            kChecksumOffset = 12,
+                            kPayloadSizeOffset = 16;
+    // The array payload (count and two values), then the first string (count, 40 chars and \0).
+    const uint64_t oddPayloadSize = sizeof(size_t) + 2 * sizeof(Value) + sizeof(size_t) + 41;
+    REPORTER_ASSERT(r, kHeaderSize + oddPayloadSize < stringsBinary->size());
+
+    sk_sp<SkData> odd = SkData::MakeWithCopy(stringsBinary->data(),
+                                             kHeaderSize + oddPayloadSize);
+    char* oddBytes = static_cast<char*>(odd->writable_data());
+    const uint32_t oddChecksum = SkChecksum::Hash32(oddBytes + kHeaderSize, oddPayloadSize);
+    memcpy(oddBytes + kChecksumOffset, &oddChecksum, sizeof(oddChecksum));
+    memcpy(oddBytes + kPayloadSizeOffset, &oddPayloadSize, sizeof(oddPayloadSize));
+    const DOM oddSized(oddBytes, odd->size());
+    REPORTER_ASSERT(r, oddSized.root().is<NullValue>());
+}
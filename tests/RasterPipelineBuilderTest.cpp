@@ -5,6 +5,7 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkData.h"
 #include "include/core/SkStream.h"
 #include "src/base/SkArenaAlloc.h"
 #include "src/base/SkStringView.h"
@@ -290,6 +291,53 @@ copy_slot_unmasked             v5 = v9
 )");
 }
 
+DEF_TEST(RasterPipelineBuilderOptimizeDeadStores, r) {
+    // Create a very simple nonsense program.
+    SkSL::RP::Builder builder;
+    builder.store_src(four_slots_at(0));
+    builder.copy_slots_unmasked(one_slot_at(4), one_slot_at(0));
+    builder.copy_constant(8, 1);  // dead; overwritten below before it is read
+    builder.copy_slots_unmasked(one_slot_at(5), one_slot_at(1));
+    builder.copy_constant(8, 2);
+    builder.copy_constant(9, 3);  // live; the masked copy keeps inactive lanes of v9
+    builder.enableExecutionMaskWrites();
+    builder.copy_slots_masked(one_slot_at(9), one_slot_at(8));
+    builder.disableExecutionMaskWrites();
+    builder.load_src(four_slots_at(4));
+    builder.optimize(/*numValueSlots=*/10);
+    std::unique_ptr<SkSL::RP::Program> program = builder.finish(/*numValueSlots=*/10,
+                                                                /*numUniformSlots=*/0,
+                                                                /*numImmutableSlots=*/0);
+    check(r, *program,
+R"(store_src                      v0..3 = src.rgba
+copy_2_slots_unmasked          v4..5 = v0..1
+copy_constant                  v8 = 0x00000002 (2.802597e-45)
+copy_constant                  v9 = 0x00000003 (4.203895e-45)
+copy_slot_masked               v9 = Mask(v8)
+load_src                       src.rgba = v4..7
+)");
+}
+
+DEF_TEST(RasterPipelineBuilderOptimizeStopsAtBranches, r) {
+    // Stores on either side of a label cannot be proven dead.
+    SkSL::RP::Builder builder;
+    int label = builder.nextLabelID();
+    builder.copy_constant(0, 1);
+    builder.label(label);
+    builder.copy_constant(0, 2);
+    builder.load_src(four_slots_at(0));
+    builder.optimize(/*numValueSlots=*/4);
+    std::unique_ptr<SkSL::RP::Program> program = builder.finish(/*numValueSlots=*/4,
+                                                                /*numUniformSlots=*/0,
+                                                                /*numImmutableSlots=*/0);
+    check(r, *program,
+R"(copy_constant                  v0 = 0x00000001 (1.401298e-45)
+label                          label 0
+copy_constant                  v0 = 0x00000002 (2.802597e-45)
+load_src                       src.rgba = v0..3
+)");
+}
+
 DEF_TEST(RasterPipelineBuilderPushPopSlots, r) {
     // Create a very simple nonsense program.
     SkSL::RP::Builder builder;
@@ -940,3 +988,75 @@ trace_exit                     TraceExit(FunctionC) when $0 is true
         }
     }
 }
+
+DEF_TEST(RasterPipelineBuilderDeserializeRejectsCorruptPrograms, r) {
+    using BuilderOp = SkSL::RP::BuilderOp;
+
+    SkSL::RP::Builder builder;
+    int skipLabelID = builder.nextLabelID();
+    builder.push_slots(two_slots_at(0));
+    builder.push_slots(two_slots_at(4));
+    builder.binary_op(BuilderOp::add_n_floats, 2);
+    builder.pop_slots_unmasked(two_slots_at(6));
+    builder.branch_if_no_lanes_active(skipLabelID);
+    builder.invoke_shader(0);
+    builder.label(skipLabelID);
+    std::unique_ptr<SkSL::RP::Program> program = builder.finish(/*numValueSlots=*/8,
+                                                                /*numUniformSlots=*/0,
+                                                                /*numImmutableSlots=*/0);
+    SkDynamicMemoryWStream stream;
+    REPORTER_ASSERT(r, program->serialize(&stream));
+    sk_sp<SkData> blob = stream.detachAsData();
+
+    // An intact program round-trips, but only with a matching uniform count and enough children.
+    auto deserialize = [&](const SkData& data, int numUniformSlots = 0, int numChildren = 1) {
+        SkMemoryStream in(data.data(), data.size());
+        return SkSL::RP::Program::Deserialize(&in, numUniformSlots, numChildren);
+    };
+    std::unique_ptr<SkSL::RP::Program> roundTrip = deserialize(*blob);
+    REPORTER_ASSERT(r, roundTrip);
+    if (roundTrip) {
+        REPORTER_ASSERT(r, get_program_dump(*program)->equals(get_program_dump(*roundTrip).get()));
+    }
+    REPORTER_ASSERT(r, !deserialize(*blob, /*numUniformSlots=*/4));
+    REPORTER_ASSERT(r, !deserialize(*blob, /*numUniformSlots=*/0, /*numChildren=*/0));
+
+    // Each instruction is eight int32s following an eight-int32 header: the op, slot A and B,
+    // immediates A through D, and the stack ID.
+    enum Field { kOp, kSlotA, kSlotB, kImmA, kImmB, kImmC, kImmD, kStackID };
+    constexpr int kHeaderSize = 8;
+    constexpr int kInstructionSize = 8;
+    const int numInstructions = (int)(blob->size() / sizeof(int32_t) - kHeaderSize) /
+                                kInstructionSize;
+
+    auto corrupt = [&](BuilderOp op, Field field, int32_t value) {
+        sk_sp<SkData> copy = SkData::MakeWithCopy(blob->data(), blob->size());
+        auto* words = static_cast<int32_t*>(copy->writable_data());
+        for (int index = 0; index < numInstructions; ++index) {
+            int32_t* inst = words + kHeaderSize + index * kInstructionSize;
+            if (inst[kOp] == (int32_t)op) {
+                inst[field] = value;
+                return deserialize(*copy) == nullptr;
+            }
+        }
+        ERRORF(r, "op %d not found in serialized program", (int)op);
+        return false;
+    };
+
+    // Value slots past the end of the program's slot range.
+    REPORTER_ASSERT(r, corrupt(BuilderOp::push_slots, kSlotA, 7));
+    REPORTER_ASSERT(r, corrupt(BuilderOp::push_slots, kSlotA, -1));
+    REPORTER_ASSERT(r, corrupt(BuilderOp::push_slots, kImmA, 1000));
+    // An operation which reads deeper into the stack than has been pushed.
+    REPORTER_ASSERT(r, corrupt(BuilderOp::add_n_floats, kImmA, 3));
+    REPORTER_ASSERT(r, corrupt(BuilderOp::add_n_floats, kStackID, 1));
+    // Stacks which aren't empty when the program ends.
+    REPORTER_ASSERT(r, corrupt(BuilderOp::discard_stack, kImmA, 1));
+    // Label IDs which are out of range.
+    REPORTER_ASSERT(r, corrupt(BuilderOp::branch_if_no_lanes_active, kImmA, 1));
+    REPORTER_ASSERT(r, corrupt(BuilderOp::label, kImmA, -1));
+    // A child which the effect doesn't have.
+    REPORTER_ASSERT(r, corrupt(BuilderOp::invoke_shader, kImmA, 1));
+    // An op which the builder never emits.
+    REPORTER_ASSERT(r, corrupt(BuilderOp::invoke_shader, kOp, (int32_t)BuilderOp::trace_line));
+}
@@ -21,6 +21,7 @@
 #include "src/base/SkArenaAlloc.h"
 #include "src/core/SkCanvasPriv.h"
 #include "src/core/SkGlyph.h"
+#include "src/core/SkGlyphImageAllocator.h"
 #include "src/core/SkMask.h"
 #include "src/core/SkReadBuffer.h"
 #include "src/core/SkWriteBuffer.h"
@@ -28,9 +29,11 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <initializer_list>
 #include <iterator>
 #include <optional>
+#include <vector>
 
 DEF_TEST(SkGlyphRectBasic, reporter) {
     using namespace skglyph;
@@ -192,6 +195,65 @@ DEF_TEST(SkGlyph_SendWithImage, reporter) {
     REPORTER_ASSERT(reporter, !dstGlyph->setImageHasBeenCalled());
 }
 
+DEF_TEST(SkGlyphImageAllocator_Basic, reporter) {
+    SkGlyphImageAllocator alloc;
+    REPORTER_ASSERT(reporter, SkGlyphImageAllocator::AllocationSize(1) == 16);
+    REPORTER_ASSERT(reporter, SkGlyphImageAllocator::AllocationSize(72) == 96);
+    REPORTER_ASSERT(reporter, SkGlyphImageAllocator::AllocationSize(5000) == 5000);
+
+    // Fill two and a half slabs of 64 byte blocks, and one large allocation.
+    constexpr int kBlocksPerSlab = SkGlyphImageAllocator::kSlabSize / 64;
+    std::vector<void*> blocks;
+    for (int i = 0; i < kBlocksPerSlab * 5 / 2; ++i) {
+        void* block = alloc.makeBytesAlignedTo(60, 4);
+        memset(block, i, 60);
+        blocks.push_back(block);
+    }
+    void* large = alloc.makeBytesAlignedTo(5000, 4);
+    REPORTER_ASSERT(reporter, alloc.slabCount() == 3);
+    REPORTER_ASSERT(reporter, alloc.bytesInUse() == blocks.size() * 64 + 5000);
+    REPORTER_ASSERT(reporter,
+                    alloc.bytesReserved() == 3 * SkGlyphImageAllocator::kSlabSize + 5000);
+
+    // Released blocks are reused before new slabs are made.
+    alloc.release(blocks[7], 60);
+    REPORTER_ASSERT(reporter, alloc.makeBytesAlignedTo(60, 4) == blocks[7]);
+
+    // Emptying a slab returns it, except for the last one with room for its size class.
+    alloc.release(large, 5000);
+    for (void* block : blocks) {
+        alloc.release(block, 60);
+    }
+    REPORTER_ASSERT(reporter, alloc.bytesInUse() == 0);
+    REPORTER_ASSERT(reporter, alloc.slabCount() == 1);
+    REPORTER_ASSERT(reporter, alloc.bytesReserved() == SkGlyphImageAllocator::kSlabSize);
+}
+
+DEF_TEST(SkGlyph_ImageFromSharedAllocator, reporter) {
+    SkGlyphImageAllocator alloc;
+    SkGlyph srcGlyph{SkPackedGlyphID{(SkGlyphID)12}};
+    SkGlyphTestPeer::SetGlyph1(&srcGlyph);
+
+    uint8_t imageData[9][8];
+    for (int y = 0; y < 9; ++y) {
+        for (int x = 0; x < 8; ++x) {
+            imageData[y][x] = (uint8_t)(y * 8 + x);
+        }
+    }
+    REPORTER_ASSERT(reporter, srcGlyph.setImage(&alloc, imageData));
+    REPORTER_ASSERT(reporter, alloc.bytesInUse() ==
+                              SkGlyphImageAllocator::AllocationSize(srcGlyph.imageSize()));
+
+    SkGlyph dstGlyph{SkPackedGlyphID{(SkGlyphID)12}};
+    REPORTER_ASSERT(reporter, dstGlyph.setMetricsAndImage(&alloc, srcGlyph) ==
+                              srcGlyph.imageSize());
+    REPORTER_ASSERT(reporter, memcmp(dstGlyph.image(), imageData, dstGlyph.imageSize()) == 0);
+
+    alloc.release(srcGlyph.image(), srcGlyph.imageSize());
+    alloc.release(dstGlyph.image(), dstGlyph.imageSize());
+    REPORTER_ASSERT(reporter, alloc.bytesInUse() == 0);
+}
+
 DEF_TEST(SkGlyph_SendWithPath, reporter) {
     SkArenaAlloc alloc{256};
     SkGlyph srcGlyph{SkPackedGlyphID{(SkGlyphID)12}};
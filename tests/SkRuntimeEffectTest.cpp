@@ -14,7 +14,9 @@
 #include "include/core/SkColorFilter.h"
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImageInfo.h"
+#include "include/core/SkM44.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkPixmap.h"
 #include "include/core/SkRefCnt.h"
@@ -51,6 +53,8 @@
 #include "src/gpu/ganesh/GrPixmap.h"
 #include "src/gpu/ganesh/SurfaceFillContext.h"
 #include "src/gpu/ganesh/effects/GrSkSLFP.h"
+#include "src/sksl/SkSLModuleLoader.h"
+#include "src/sksl/SkSLProgramKind.h"
 #include "src/sksl/SkSLString.h"
 #include "tests/CtsEnforcement.h"
 #include "tests/Test.h"
@@ -1293,6 +1297,31 @@ DEF_TEST(SkRuntimeEffectThreaded, r) {
     }
 }
 
+DEF_TEST(SkSLModuleLoaderWarmUp, r) {
+    // Loading the modules in parallel must leave them usable by compilers on other threads.
+    static constexpr SkSL::ProgramKind kKinds[] = {
+            SkSL::ProgramKind::kFragment,
+            SkSL::ProgramKind::kVertex,
+            SkSL::ProgramKind::kCompute,
+            SkSL::ProgramKind::kRuntimeShader,
+            SkSL::ProgramKind::kPrivateRuntimeShader,
+    };
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    SkSL::ModuleLoader::WarmUp(kKinds, *executor);
+
+    std::thread threads[8];
+    for (auto& thread : threads) {
+        thread = std::thread([r]() {
+            auto [effect, error] = SkRuntimeEffect::MakeForShader(
+                    SkString("half4 main(float2 p) { return half4(p.xyxy); }"));
+            REPORTER_ASSERT(r, effect, "%s", error.c_str());
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
 DEF_TEST(SkRuntimeEffectAllowsPrivateAccess, r) {
     SkRuntimeEffect::Options defaultOptions;
     SkRuntimeEffect::Options optionsWithAccess;
@@ -1353,6 +1382,115 @@ DEF_TEST(SkRuntimeColorFilterSingleColor, r) {
     REPORTER_ASSERT(r, c.fA == 1.0f);
 }
 
+DEF_TEST(SkRuntimeEffectPersistentCache, r) {
+    class MemoryCache : public SkRuntimeEffect::PersistentCache {
+    public:
+        sk_sp<SkData> load(const SkData& key) override {
+            ++fLoads;
+            for (const auto& [k, v] : fEntries) {
+                if (k->equals(&key)) {
+                    return v;
+                }
+            }
+            return nullptr;
+        }
+        void store(const SkData& key, const SkData& data) override {
+            ++fStores;
+            fEntries.push_back({SkData::MakeWithCopy(key.data(), key.size()),
+                                SkData::MakeWithCopy(data.data(), data.size())});
+        }
+
+        int fLoads = 0;
+        int fStores = 0;
+        std::vector<std::pair<sk_sp<SkData>, sk_sp<SkData>>> fEntries;
+    };
+
+    MemoryCache cache;
+    SkRuntimeEffect::Options options;
+    options.persistentCache = &cache;
+
+    auto filter = [&]() {
+        auto [effect, err] = SkRuntimeEffect::MakeForColorFilter(
+                SkString{"half4 main(half4 c) { return c*c; }"}, options);
+        REPORTER_ASSERT(r, effect, "%s", err.c_str());
+        sk_sp<SkColorFilter> cf = effect->makeColorFilter(SkData::MakeEmpty());
+        SkColor4f c = cf->filterColor4f({0.25, 0.5, 0.75, 1.0},
+                                        sk_srgb_singleton(), sk_srgb_singleton());
+        REPORTER_ASSERT(r, c.fR == 0.0625f);
+        REPORTER_ASSERT(r, c.fG == 0.25f);
+        REPORTER_ASSERT(r, c.fB == 0.5625f);
+        REPORTER_ASSERT(r, c.fA == 1.0f);
+    };
+
+    // The first use compiles the program and stores it.
+    filter();
+    REPORTER_ASSERT(r, cache.fLoads == 1);
+    REPORTER_ASSERT(r, cache.fStores == 1);
+
+    // A second effect with the same source is served from the cache.
+    filter();
+    REPORTER_ASSERT(r, cache.fLoads == 2);
+    REPORTER_ASSERT(r, cache.fStores == 1);
+
+    // Corrupt cache data is rejected, and the effect recompiles (and re-stores) its program.
+    REPORTER_ASSERT(r, cache.fEntries.size() == 1);
+    cache.fEntries[0].second = SkData::MakeWithCString("not a program");
+    filter();
+    REPORTER_ASSERT(r, cache.fLoads == 3);
+    REPORTER_ASSERT(r, cache.fStores == 2);
+}
+
+DEF_TEST(SkRuntimeEffectSpecialization, r) {
+    auto [effect, err] = SkRuntimeEffect::MakeForColorFilter(SkString(R"(
+        uniform half4 tint;
+        uniform int mode;
+        layout(color) uniform half4 color;
+        half4 main(half4 c) {
+            if (mode == 1) { return tint; }
+            if (mode == 2) { return c * tint; }
+            return c;
+        }
+    )"));
+    REPORTER_ASSERT(r, effect, "%s", err.c_str());
+
+    struct Uniforms {
+        SkV4 tint;
+        int mode;
+        SkV4 color;
+    };
+    static_assert(sizeof(Uniforms) == 9 * sizeof(float));
+    auto makeData = [](int mode) {
+        Uniforms u = {{0.5f, 0.25f, 1.0f, 1.0f}, mode, {0, 0, 0, 0}};
+        return SkData::MakeWithCopy(&u, sizeof(u));
+    };
+    auto filter = [](const sk_sp<SkRuntimeEffect>& e, sk_sp<SkData> data) {
+        return e->makeColorFilter(std::move(data))->filterColor4f(
+                {1, 1, 1, 1}, sk_srgb_singleton(), sk_srgb_singleton());
+    };
+    REPORTER_ASSERT(r, effect->uniformSize() == sizeof(Uniforms));
+
+    const std::string_view kMode[] = {"mode"};
+    sk_sp<SkRuntimeEffect> specialized = effect->makeSpecialized(makeData(1), kMode);
+    REPORTER_ASSERT(r, specialized && specialized != effect);
+    REPORTER_ASSERT(r, specialized->uniformSize() == effect->uniformSize());
+    REPORTER_ASSERT(r, specialized->findUniform("mode"));
+
+    // The specialized value is baked into the program; the value passed at draw time is ignored.
+    REPORTER_ASSERT(r, filter(effect, makeData(0)) == SkColor4f({1, 1, 1, 1}));
+    REPORTER_ASSERT(r, filter(specialized, makeData(0)) == SkColor4f({0.5f, 0.25f, 1, 1}));
+
+    // Asking for the same specialization again returns the cached effect.
+    REPORTER_ASSERT(r, effect->makeSpecialized(makeData(1), kMode) == specialized);
+    REPORTER_ASSERT(r, effect->makeSpecialized(makeData(2), kMode) != specialized);
+
+    // Unknown and color uniforms can't be specialized.
+    const std::string_view kMissing[] = {"missing"};
+    const std::string_view kColor[] = {"color"};
+    REPORTER_ASSERT(r, !effect->makeSpecialized(makeData(1), kMissing));
+    REPORTER_ASSERT(r, !effect->makeSpecialized(makeData(1), kColor));
+    REPORTER_ASSERT(r, !effect->makeSpecialized(SkData::MakeEmpty(), kMode));
+}
+
 static void test_RuntimeEffectStructNameReuse(skiatest::Reporter* r, GrRecordingContext* rContext) {
     // Test that two different runtime effects can reuse struct names in a single paint operation
     auto [childEffect, err] = SkRuntimeEffect::MakeForShader(SkString(
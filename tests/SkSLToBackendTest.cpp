@@ -0,0 +1,87 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/gpu/ShaderErrorHandler.h"
+#include "src/gpu/SkSLToBackend.h"
+#include "src/sksl/SkSLProgramKind.h"
+#include "src/sksl/SkSLProgramSettings.h"
+#include "src/sksl/SkSLUtil.h"
+#include "src/sksl/ir/SkSLProgram.h"
+#include "tests/Test.h"
+
+#include <atomic>
+#include <string>
+
+static std::atomic<int> gBackendCalls{0};
+
+// A stand-in for a real code generator, so the test doesn't depend on any particular backend.
+static bool to_description(SkSL::Program& program, const SkSL::ShaderCaps*, std::string* out) {
+    gBackendCalls++;
+    *out = program.description();
+    return true;
+}
+
+static bool compile(skgpu::SkSLCompileCache* cache,
+                    const std::string& sksl,
+                    const SkSL::ProgramSettings& settings,
+                    std::string* out) {
+    return skgpu::SkSLToBackend(SkSL::ShaderCapsFactory::Default(),
+                                &to_description,
+                                /*backendLabel=*/nullptr,
+                                sksl,
+                                SkSL::ProgramKind::kFragment,
+                                settings,
+                                out,
+                                /*outInterface=*/nullptr,
+                                skgpu::DefaultShaderErrorHandler(),
+                                cache);
+}
+
+DEF_TEST(SkSLToBackendCache, r) {
+    const std::string kRed = "void main() { sk_FragColor = half4(1, 0, 0, 1); }";
+    const std::string kBlue = "void main() { sk_FragColor = half4(0, 0, 1, 1); }";
+    SkSL::ProgramSettings settings;
+    skgpu::SkSLCompileCache cache;
+    // Stats are process-wide and other tests may be compiling shaders concurrently, so only
+    // lower bounds can be checked.
+    const skgpu::SkSLCompileStats before = skgpu::GetSkSLCompileStats();
+    gBackendCalls = 0;
+
+    std::string red, blue, cachedRed;
+    REPORTER_ASSERT(r, compile(&cache, kRed, settings, &red));
+    REPORTER_ASSERT(r, compile(&cache, kBlue, settings, &blue));
+    REPORTER_ASSERT(r, gBackendCalls == 2);
+    REPORTER_ASSERT(r, cache.count() == 2);
+    REPORTER_ASSERT(r, red != blue);
+
+    // Compiling the same SkSL again is served from the cache.
+    REPORTER_ASSERT(r, compile(&cache, kRed, settings, &cachedRed));
+    REPORTER_ASSERT(r, gBackendCalls == 2);
+    REPORTER_ASSERT(r, cachedRed == red);
+
+    // Different settings produce a different cache entry.
+    settings.fOptimize = false;
+    REPORTER_ASSERT(r, compile(&cache, kRed, settings, &cachedRed));
+    REPORTER_ASSERT(r, gBackendCalls == 3);
+    REPORTER_ASSERT(r, cache.count() == 3);
+
+    // Without a cache, every request is compiled.
+    REPORTER_ASSERT(r, compile(/*cache=*/nullptr, kRed, settings, &cachedRed));
+    REPORTER_ASSERT(r, gBackendCalls == 4);
+
+    const skgpu::SkSLCompileStats after = skgpu::GetSkSLCompileStats();
+    REPORTER_ASSERT(r, after.fCacheHits - before.fCacheHits >= 1);
+    REPORTER_ASSERT(r, after.fCacheMisses - before.fCacheMisses >= 4);
+    REPORTER_ASSERT(r, after.fParseMs > before.fParseMs);
+
+    // The cache's own counts only cover lookups made with it.
+    REPORTER_ASSERT(r, cache.hits() == 1);
+    REPORTER_ASSERT(r, cache.misses() == 3);
+
+    cache.purgeAll();
+    REPORTER_ASSERT(r, cache.count() == 0);
+}
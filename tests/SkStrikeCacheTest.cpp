@@ -5,21 +5,35 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkData.h"
 #include "include/core/SkFont.h"
 #include "include/core/SkFontStyle.h"
+#include "include/core/SkFontTypes.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkRefCnt.h"
+#include "include/core/SkStream.h"
 #include "include/core/SkSurfaceProps.h"
 #include "include/core/SkTypeface.h"
+#include "src/core/SkGlyph.h"
+#include "src/core/SkOSFile.h"
+#include "src/core/SkReadBuffer.h"
 #include "src/core/SkScalerContext.h"
 #include "src/core/SkStrike.h"  // IWYU pragma: keep
 #include "src/core/SkStrikeCache.h"
+#include "src/core/SkStrikeDiskCache.h"
 #include "src/core/SkStrikeSpec.h"
+#include "src/utils/SkOSPath.h"
 #include "tests/Test.h"
 #include "tools/ToolUtils.h"
 #include "tools/fonts/FontToolUtils.h"
 
+#include <cstdio>
+#include <cstring>
+#include <optional>
+#include <utility>
+#include <vector>
+
 DEF_TEST(SkStrikeCache_CachePurge, Reporter) {
     SkStrikeCache cache;
 
@@ -61,3 +75,144 @@ DEF_TEST(SkStrikeCache_CachePurge, Reporter) {
 
 
 }
+
+// Returns the images of glyphIDs in strike, without generating any. A glyph without an image is
+// returned as an empty vector.
+static std::vector<std::vector<uint8_t>> glyph_images(SkStrike* strike,
+                                                      SkSpan<const SkGlyphID> glyphIDs) {
+    std::vector<const SkGlyph*> results(glyphIDs.size());
+    std::vector<std::vector<uint8_t>> images;
+    for (const SkGlyph* glyph : strike->metrics(glyphIDs, results.data())) {
+        if (glyph->setImageHasBeenCalled() && glyph->image() != nullptr) {
+            const uint8_t* image = static_cast<const uint8_t*>(glyph->image());
+            images.emplace_back(image, image + glyph->imageSize());
+        } else {
+            images.emplace_back();
+        }
+    }
+    return images;
+}
+
+DEF_TEST(SkStrikeCache_DiskCache, reporter) {
+    SkString tmpDir = skiatest::GetTmpDir();
+    if (tmpDir.isEmpty()) {
+        return;
+    }
+    SkString directory = SkOSPath::Join(tmpDir.c_str(), "SkStrikeCache_DiskCache");
+    auto diskCache = sk_make_sp<SkStrikeDiskCache>(directory.c_str());
+
+    SkFont font{ToolUtils::CreatePortableTypeface("serif", SkFontStyle()), 19.5f};
+    font.setEdging(SkFont::Edging::kAntiAlias);
+    SkStrikeSpec strikeSpec = SkStrikeSpec::MakeMask(
+            font, SkPaint{}, SkSurfaceProps(0, kUnknown_SkPixelGeometry),
+            SkScalerContextFlags::kNone, SkMatrix::I());
+
+    const char text[] = "DiskCache";
+    std::vector<SkGlyphID> glyphIDs(font.countText(text, strlen(text), SkTextEncoding::kUTF8));
+    font.textToGlyphs(text, strlen(text), SkTextEncoding::kUTF8, glyphIDs.data(), glyphIDs.size());
+    std::vector<SkPackedGlyphID> packedIDs(glyphIDs.begin(), glyphIDs.end());
+
+    std::optional<SkString> path = diskCache->pathFor(strikeSpec);
+    REPORTER_ASSERT(reporter, path.has_value());
+    if (!path.has_value()) {
+        return;
+    }
+    std::remove(path->c_str());
+
+    std::vector<std::vector<uint8_t>> rasterized;
+    {
+        SkStrikeCache cache;
+        cache.setDiskCache(diskCache);
+        sk_sp<SkStrike> strike = strikeSpec.findOrCreateStrike(&cache);
+        std::vector<const SkGlyph*> results(packedIDs.size());
+        strike->prepareImages(packedIDs, results.data());
+        rasterized = glyph_images(strike.get(), glyphIDs);
+
+        REPORTER_ASSERT(reporter, cache.saveToDiskCache() == 1);
+        // Nothing new to save.
+        REPORTER_ASSERT(reporter, cache.saveToDiskCache() == 0);
+    }
+    REPORTER_ASSERT(reporter, sk_exists(path->c_str()));
+
+    {
+        // A new cache, as in a new process, loads the images instead of rasterizing them.
+        SkStrikeCache cache;
+        cache.setDiskCache(diskCache);
+        sk_sp<SkStrike> strike = strikeSpec.findOrCreateStrike(&cache);
+        REPORTER_ASSERT(reporter, glyph_images(strike.get(), glyphIDs) == rasterized);
+        REPORTER_ASSERT(reporter, cache.saveToDiskCache() == 0);
+    }
+
+    {
+        // A corrupt file is ignored.
+        sk_sp<SkData> data = SkData::MakeFromFileName(path->c_str());
+        REPORTER_ASSERT(reporter, data != nullptr);
+        if (data == nullptr) {
+            return;
+        }
+        sk_sp<SkData> corrupt = SkData::MakeWithCopy(data->data(), data->size());
+        data.reset();
+        static_cast<uint8_t*>(corrupt->writable_data())[corrupt->size() - 1] ^= 0xFF;
+        {
+            SkFILEWStream stream{path->c_str()};
+            stream.write(corrupt->data(), corrupt->size());
+        }
+
+        SkStrikeCache cache;
+        cache.setDiskCache(diskCache);
+        sk_sp<SkStrike> strike = strikeSpec.findOrCreateStrike(&cache);
+        for (const std::vector<uint8_t>& image : glyph_images(strike.get(), glyphIDs)) {
+            REPORTER_ASSERT(reporter, image.empty());
+        }
+    }
+    std::remove(path->c_str());
+}
+
+DEF_TEST(SkStrikeCache_PreloadRejectsTruncatedBuffer, reporter) {
+    SkFont font{ToolUtils::CreatePortableTypeface("serif", SkFontStyle()), 19.5f};
+    font.setEdging(SkFont::Edging::kAntiAlias);
+    SkStrikeSpec strikeSpec = SkStrikeSpec::MakeMask(
+            font, SkPaint{}, SkSurfaceProps(0, kUnknown_SkPixelGeometry),
+            SkScalerContextFlags::kNone, SkMatrix::I());
+
+    const char text[] = "Preload";
+    std::vector<SkGlyphID> glyphIDs(font.countText(text, strlen(text), SkTextEncoding::kUTF8));
+    font.textToGlyphs(text, strlen(text), SkTextEncoding::kUTF8, glyphIDs.data(), glyphIDs.size());
+    std::vector<SkPackedGlyphID> packedIDs(glyphIDs.begin(), glyphIDs.end());
+
+    SkStrikeCache cache;
+    sk_sp<SkData> glyphData;
+    std::vector<std::vector<uint8_t>> rasterized;
+    {
+        sk_sp<SkStrike> strike = strikeSpec.findOrCreateStrike(&cache);
+        std::vector<const SkGlyph*> results(packedIDs.size());
+        strike->prepareImages(packedIDs, results.data());
+        strike->preparePaths(glyphIDs, results.data());
+        rasterized = glyph_images(strike.get(), glyphIDs);
+        glyphData = strike->flattenForDiskCache();
+    }
+    REPORTER_ASSERT(reporter, glyphData != nullptr && glyphData->size() > 4);
+    if (glyphData == nullptr || glyphData->size() <= 4) {
+        return;
+    }
+
+    auto preload = [&](size_t size) {
+        auto strike = sk_make_sp<SkStrike>(
+                &cache, strikeSpec, strikeSpec.createScalerContext(), nullptr, nullptr);
+        SkReadBuffer buffer{glyphData->data(), size};
+        bool loaded = strike->preloadFromBuffer(buffer);
+        return std::make_pair(loaded, glyph_images(strike.get(), glyphIDs));
+    };
+
+    // Dropping the end of the buffer loses the last path, which must not leave the images that
+    // were read before it in the strike.
+    auto [truncatedLoaded, truncatedImages] = preload(glyphData->size() - 4);
+    REPORTER_ASSERT(reporter, !truncatedLoaded);
+    for (const std::vector<uint8_t>& image : truncatedImages) {
+        REPORTER_ASSERT(reporter, image.empty());
+    }
+
+    auto [loaded, images] = preload(glyphData->size());
+    REPORTER_ASSERT(reporter, loaded);
+    REPORTER_ASSERT(reporter, images == rasterized);
+}
@@ -51,6 +51,8 @@ CORE_TESTS = [
     "FontScanner.cpp",
     "FrontBufferedStreamTest.cpp",
     "GeometryTest.cpp",
+    "GlyphMaskTest.cpp",
+    "GlyphPrefetcherTest.cpp",
     "HSVRoundTripTest.cpp",
     "HashTest.cpp",
     "HighContrastFilterTest.cpp",
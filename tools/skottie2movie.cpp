@@ -7,11 +7,14 @@
 
 #include "experimental/ffmpeg/SkVideoEncoder.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkGraphics.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkSurface.h"
 #include "include/private/base/SkTPin.h"
 #include "modules/skottie/include/Skottie.h"
+#include "modules/skottie/utils/SkottieUtils.h"
 #include "modules/skresources/include/SkResources.h"
 #include "src/base/SkTime.h"
 #include "src/utils/SkOSPath.h"
@@ -25,6 +28,10 @@
 #include "include/gpu/ganesh/SkSurfaceGanesh.h"
 #include "modules/skshaper/utils/FactoryHelpers.h"
 
+#include <algorithm>
+#include <memory>
+#include <vector>
+
 #if defined(SK_BUILD_FOR_MAC) && defined(SK_FONTMGR_CORETEXT_AVAILABLE)
 #include "include/ports/SkFontMgr_mac_ct.h"
 #elif defined(SK_BUILD_FOR_UNIX) && defined(SK_FONTMGR_FONTCONFIG_AVAILABLE)
@@ -41,6 +48,7 @@ static DEFINE_bool2(verbose, v, false, "verbose mode");
 static DEFINE_bool2(loop, l, false, "loop mode for profiling");
 static DEFINE_int(set_dst_width, 0, "set destination width (height will be computed)");
 static DEFINE_bool2(gpu, g, false, "use GPU for rendering");
+static DEFINE_int(threads, 1, "number of threads used to render frames on the CPU");
 
 static void produce_frame(SkSurface* surf, skottie::Animation* anim, double frame) {
     anim->seekFrame(frame);
@@ -89,15 +97,30 @@ int main(int argc, char** argv) {
     sk_sp<SkFontMgr> fontMgr = SkFontMgr_New_Custom_Empty();
 #endif
 
-    auto animation = skottie::Animation::Builder()
-        .setResourceProvider(skresources::FileResourceProvider::Make(assetPath))
-        .setTextShapingFactory(SkShapers::BestAvailable())
-        .setFontManager(fontMgr)
-        .makeFromFile(FLAGS_input[0]);
-    if (!animation) {
+    // One animation instance per rendering thread.
+    const int instanceCount = FLAGS_gpu ? 1 : std::max(FLAGS_threads, 1);
+    const auto json = SkData::MakeFromFileName(FLAGS_input[0]);
+    skottie::Animation::Builder builder;
+    builder.setResourceProvider(skresources::FileResourceProvider::Make(assetPath))
+           .setTextShapingFactory(SkShapers::BestAvailable())
+           .setFontManager(fontMgr);
+    auto instances = json
+            ? builder.makeInstances(static_cast<const char*>(json->data()), json->size(),
+                                    instanceCount)
+            : std::vector<sk_sp<skottie::Animation>>();
+    if (instances.empty()) {
         SkDebugf("failed to load %s\n", FLAGS_input[0]);
         return -1;
     }
+    auto animation = instances[0];
+
+    std::unique_ptr<SkExecutor> executor;
+    std::unique_ptr<skottie_utils::ParallelFrameRenderer> renderer;
+    if (instanceCount > 1) {
+        executor = SkExecutor::MakeFIFOThreadPool(instanceCount);
+        renderer = std::make_unique<skottie_utils::ParallelFrameRenderer>(std::move(instances),
+                                                                          executor.get());
+    }
 
     SkISize dim = animation->size().toRound();
     double duration = animation->duration();
@@ -133,52 +156,65 @@ int main(int argc, char** argv) {
             return -1;
         }
 
-        // lazily allocate the surfaces
-        if (!surf) {
-            if (FLAGS_gpu) {
-                grctx = factory.getContextInfo(contextType).directContext();
-                surf = SkSurfaces::RenderTarget(grctx,
-                                                skgpu::Budgeted::kNo,
-                                                info,
-                                                0,
-                                                GrSurfaceOrigin::kTopLeft_GrSurfaceOrigin,
-                                                nullptr);
+        if (renderer) {
+            renderer->renderFrames(0, fps_scale, frames + 1,
+                                   [&info](int) { return SkSurfaces::Raster(info); },
+                                   [&encoder](int, sk_sp<SkSurface> frameSurf) {
+                                       SkPixmap pm;
+                                       SkAssertResult(frameSurf->peekPixels(&pm));
+                                       encoder.addFrame(pm);
+                                   },
+                                   SK_ColorWHITE);
+        } else {
+            // lazily allocate the surfaces
+            if (!surf) {
+                if (FLAGS_gpu) {
+                    grctx = factory.getContextInfo(contextType).directContext();
+                    surf = SkSurfaces::RenderTarget(grctx,
+                                                    skgpu::Budgeted::kNo,
+                                                    info,
+                                                    0,
+                                                    GrSurfaceOrigin::kTopLeft_GrSurfaceOrigin,
+                                                    nullptr);
+                    if (!surf) {
+                        grctx = nullptr;
+                    }
+                }
                 if (!surf) {
-                    grctx = nullptr;
+                    surf = SkSurfaces::Raster(info);
                 }
-            }
-            if (!surf) {
-                surf = SkSurfaces::Raster(info);
-            }
-            surf->getCanvas()->scale(scale, scale);
-        }
-
-        for (int i = 0; i <= frames; ++i) {
-            const double frame = i * fps_scale;
-            if (FLAGS_verbose) {
-                SkDebugf("rendering frame %g\n", frame);
+                surf->getCanvas()->scale(scale, scale);
             }
 
-            produce_frame(surf.get(), animation.get(), frame);
+            for (int i = 0; i <= frames; ++i) {
+                const double frame = i * fps_scale;
+                if (FLAGS_verbose) {
+                    SkDebugf("rendering frame %g\n", frame);
+                }
 
-            AsyncRec asyncRec = { info, &encoder };
-            if (grctx) {
-                auto read_pixels_cb = [](SkSurface::ReadPixelsContext ctx,
-                                         std::unique_ptr<const SkSurface::AsyncReadResult> result) {
-                    if (result && result->count() == 1) {
-                        AsyncRec* rec = reinterpret_cast<AsyncRec*>(ctx);
-                        rec->encoder->addFrame({rec->info, result->data(0), result->rowBytes(0)});
-                    }
-                };
-                surf->asyncRescaleAndReadPixels(info, {0, 0, info.width(), info.height()},
-                                                SkSurface::RescaleGamma::kSrc,
-                                                SkImage::RescaleMode::kNearest,
-                                                read_pixels_cb, &asyncRec);
-                grctx->submit();
-            } else {
-                SkPixmap pm;
-                SkAssertResult(surf->peekPixels(&pm));
-                encoder.addFrame(pm);
+                produce_frame(surf.get(), animation.get(), frame);
+
+                AsyncRec asyncRec = { info, &encoder };
+                if (grctx) {
+                    auto read_pixels_cb =
+                            [](SkSurface::ReadPixelsContext ctx,
+                               std::unique_ptr<const SkSurface::AsyncReadResult> result) {
+                        if (result && result->count() == 1) {
+                            AsyncRec* rec = reinterpret_cast<AsyncRec*>(ctx);
+                            rec->encoder->addFrame(
+                                    {rec->info, result->data(0), result->rowBytes(0)});
+                        }
+                    };
+                    surf->asyncRescaleAndReadPixels(info, {0, 0, info.width(), info.height()},
+                                                    SkSurface::RescaleGamma::kSrc,
+                                                    SkImage::RescaleMode::kNearest,
+                                                    read_pixels_cb, &asyncRec);
+                    grctx->submit();
+                } else {
+                    SkPixmap pm;
+                    SkAssertResult(surf->peekPixels(&pm));
+                    encoder.addFrame(pm);
+                }
             }
         }
 